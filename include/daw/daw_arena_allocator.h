@@ -0,0 +1,355 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw/ciso646.h"
+#include "daw/daw_attributes.h"
+#include "daw/daw_check_exceptions.h"
+#include "daw/daw_likely.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+namespace daw::memory {
+	namespace arena_impl {
+		[[nodiscard]] constexpr std::size_t align_up( std::size_t value,
+		                                              std::size_t align ) noexcept {
+			return ( value + align - 1U ) & ~( align - 1U );
+		}
+
+		/// Header at the start of every block the arena gets from upstream.  The
+		/// usable memory follows it
+		struct block_header {
+			block_header *next;
+			std::size_t size;
+
+			[[nodiscard]] std::byte *begin( ) noexcept {
+				return reinterpret_cast<std::byte *>( this ) +
+				       align_up( sizeof( block_header ),
+				                 alignof( std::max_align_t ) );
+			}
+
+			[[nodiscard]] std::byte *end( ) noexcept {
+				return reinterpret_cast<std::byte *>( this ) + size;
+			}
+		};
+
+		inline constexpr std::size_t block_header_size =
+		  align_up( sizeof( block_header ), alignof( std::max_align_t ) );
+	} // namespace arena_impl
+
+	/// A point in a monotonic_arena that it can be rewound to
+	struct arena_marker {
+		arena_impl::block_header *block = nullptr;
+		std::byte *position = nullptr;
+	};
+
+	///
+	/// Monotonic bump allocator.  Allocation is a pointer bump in the current
+	/// block and deallocation does nothing; memory is reclaimed all at once
+	/// with reset( ) or back to a mark( ) with rewind( ).  Blocks from upstream
+	/// are kept and reused after a reset/rewind, so a per-request arena that is
+	/// reset between requests stops allocating once it has warmed up.
+	/// Not thread safe.  Must outlive everything allocated from it
+	///
+	class monotonic_arena {
+		using block_header = arena_impl::block_header;
+
+		block_header *m_first = nullptr;
+		block_header *m_current = nullptr;
+		std::byte *m_position = nullptr;
+		std::byte *m_end = nullptr;
+		std::size_t m_next_block_size;
+
+		[[nodiscard]] static block_header *new_block( std::size_t size ) {
+			auto *mem = ::operator new( size );
+			return ::new( mem ) block_header{ nullptr, size };
+		}
+
+		void use_block( block_header *block ) noexcept {
+			m_current = block;
+			m_position = block->begin( );
+			m_end = block->end( );
+		}
+
+		/// Move to a block that can hold size bytes at align, reusing a
+		/// following block if one is big enough
+		DAW_ATTRIB_NOINLINE void next_block( std::size_t size, std::size_t align ) {
+			std::size_t const needed =
+			  arena_impl::block_header_size + size + align;
+			block_header *const after =
+			  m_current != nullptr ? m_current->next : m_first;
+			if( after != nullptr and after->size >= needed ) {
+				use_block( after );
+				return;
+			}
+			std::size_t block_size = m_next_block_size;
+			while( block_size < needed ) {
+				block_size *= 2U;
+			}
+			m_next_block_size = block_size * 2U;
+			block_header *const block = new_block( block_size );
+			block->next = after;
+			if( m_current != nullptr ) {
+				m_current->next = block;
+			} else {
+				m_first = block;
+			}
+			use_block( block );
+		}
+
+	public:
+		static constexpr std::size_t default_block_size = 4096U;
+
+		explicit monotonic_arena(
+		  std::size_t initial_block_size = default_block_size ) noexcept
+		  : m_next_block_size( initial_block_size < 64U ? 64U
+		                                                : initial_block_size ) {}
+
+		monotonic_arena( monotonic_arena const & ) = delete;
+		monotonic_arena &operator=( monotonic_arena const & ) = delete;
+
+		~monotonic_arena( ) {
+			release( );
+		}
+
+		[[nodiscard]] DAW_ATTRIB_INLINE void *
+		allocate( std::size_t size,
+		          std::size_t align = alignof( std::max_align_t ) ) {
+			auto const pos = reinterpret_cast<std::uintptr_t>( m_position );
+			auto const end = reinterpret_cast<std::uintptr_t>( m_end );
+			auto aligned = arena_impl::align_up( pos, align );
+			if( DAW_UNLIKELY( m_position == nullptr or aligned > end or
+			                  size > end - aligned ) ) {
+				// The new block always has room for size at align
+				next_block( size, align );
+				aligned = arena_impl::align_up(
+				  reinterpret_cast<std::uintptr_t>( m_position ), align );
+			}
+			m_position = reinterpret_cast<std::byte *>( aligned + size );
+			return reinterpret_cast<void *>( aligned );
+		}
+
+		/// Memory is only reclaimed by reset/rewind
+		DAW_ATTRIB_INLINE void deallocate( void *, std::size_t,
+		                                   std::size_t = 0 ) noexcept {}
+
+		/// A marker to rewind back to, freeing everything allocated after it
+		[[nodiscard]] arena_marker mark( ) const noexcept {
+			return arena_marker{ m_current, m_position };
+		}
+
+		/// Free everything allocated since the marker was taken.  The blocks are
+		/// kept for reuse
+		void rewind( arena_marker marker ) noexcept {
+			if( marker.block == nullptr ) {
+				reset( );
+				return;
+			}
+			m_current = marker.block;
+			m_position = marker.position;
+			m_end = marker.block->end( );
+		}
+
+		/// Free everything allocated, keeping the blocks for reuse
+		void reset( ) noexcept {
+			if( m_first != nullptr ) {
+				use_block( m_first );
+			}
+		}
+
+		/// Free everything and return the blocks to upstream
+		void release( ) noexcept {
+			block_header *block = m_first;
+			while( block != nullptr ) {
+				block_header *const next = block->next;
+				::operator delete( static_cast<void *>( block ) );
+				block = next;
+			}
+			m_first = nullptr;
+			m_current = nullptr;
+			m_position = nullptr;
+			m_end = nullptr;
+		}
+
+		/// Total bytes obtained from upstream
+		[[nodiscard]] std::size_t capacity( ) const noexcept {
+			std::size_t result = 0;
+			for( block_header const *block = m_first; block != nullptr;
+			     block = block->next ) {
+				result += block->size;
+			}
+			return result;
+		}
+	};
+
+	///
+	/// Size class pool for node based containers.  Requests up to
+	/// max_pooled_size bytes are rounded up to a power of two size class and
+	/// served from a free list, with freed chunks going back on their list.
+	/// The size class is at least the alignment, so each chunk is aligned
+	/// for any request it serves.
+	/// New chunks are carved from a monotonic_arena, as are larger requests,
+	/// which are not reused until reset( ).
+	/// Not thread safe.  Must outlive everything allocated from it
+	///
+	class pool_resource {
+		struct free_node {
+			free_node *next;
+		};
+
+		static constexpr std::size_t min_size_shift = 3U;
+		static constexpr std::size_t class_count = 7U;
+
+	public:
+		static constexpr std::size_t min_pooled_size = 1U << min_size_shift;
+		static constexpr std::size_t max_pooled_size =
+		  min_pooled_size << ( class_count - 1U );
+
+	private:
+		monotonic_arena m_arena;
+		std::array<free_node *, class_count> m_free_lists{ };
+
+		[[nodiscard]] static constexpr std::size_t
+		size_class( std::size_t size ) noexcept {
+			std::size_t result = 0;
+			while( ( min_pooled_size << result ) < size ) {
+				++result;
+			}
+			return result;
+		}
+
+		[[nodiscard]] static constexpr bool
+		is_pooled( std::size_t size, std::size_t align ) noexcept {
+			return size <= max_pooled_size and align <= alignof( std::max_align_t );
+		}
+
+		/// Chunks are aligned to their size up to max_align_t, so a chunk at
+		/// least as large as align is aligned for it
+		[[nodiscard]] static constexpr std::size_t
+		chunk_class( std::size_t size, std::size_t align ) noexcept {
+			return size_class( size < align ? align : size );
+		}
+
+	public:
+		explicit pool_resource(
+		  std::size_t initial_block_size = monotonic_arena::default_block_size )
+		  : m_arena( initial_block_size ) {}
+
+		[[nodiscard]] DAW_ATTRIB_INLINE void *
+		allocate( std::size_t size,
+		          std::size_t align = alignof( std::max_align_t ) ) {
+			if( not is_pooled( size, align ) ) {
+				return m_arena.allocate( size, align );
+			}
+			auto const idx = chunk_class( size, align );
+			free_node *const node = m_free_lists[idx];
+			if( node != nullptr ) {
+				m_free_lists[idx] = node->next;
+				return node;
+			}
+			auto const chunk = min_pooled_size << idx;
+			return m_arena.allocate( chunk, chunk < alignof( std::max_align_t )
+			                                  ? chunk
+			                                  : alignof( std::max_align_t ) );
+		}
+
+		DAW_ATTRIB_INLINE void
+		deallocate( void *ptr, std::size_t size,
+		            std::size_t align = alignof( std::max_align_t ) ) noexcept {
+			if( ptr == nullptr or not is_pooled( size, align ) ) {
+				return;
+			}
+			auto const idx = chunk_class( size, align );
+			m_free_lists[idx] = ::new( ptr ) free_node{ m_free_lists[idx] };
+		}
+
+		/// Free everything allocated, keeping the arena's blocks for reuse
+		void reset( ) noexcept {
+			m_free_lists = { };
+			m_arena.reset( );
+		}
+
+		/// Free everything and return the memory to upstream
+		void release( ) noexcept {
+			m_free_lists = { };
+			m_arena.release( );
+		}
+
+		[[nodiscard]] std::size_t capacity( ) const noexcept {
+			return m_arena.capacity( );
+		}
+	};
+
+	///
+	/// A stateful allocator that forwards to a monotonic_arena, pool_resource,
+	/// or anything with allocate( bytes, align ) and deallocate( ptr, bytes,
+	/// align ).  Plugs into the Allocator parameter of std and daw containers.
+	/// Copies and rebinds share the resource and compare equal when they do
+	///
+	template<typename T, typename Resource = monotonic_arena>
+	class arena_allocator {
+		template<typename, typename>
+		friend class arena_allocator;
+
+		Resource *m_resource;
+
+	public:
+		using value_type = T;
+		using resource_type = Resource;
+
+		template<typename U>
+		struct rebind {
+			using other = arena_allocator<U, Resource>;
+		};
+
+		constexpr arena_allocator( Resource &resource ) noexcept
+		  : m_resource( &resource ) {}
+
+		template<typename U>
+		constexpr arena_allocator(
+		  arena_allocator<U, Resource> const &other ) noexcept
+		  : m_resource( other.m_resource ) {}
+
+		[[nodiscard]] T *allocate( std::size_t n ) {
+			if( DAW_UNLIKELY( n > static_cast<std::size_t>( -1 ) / sizeof( T ) ) ) {
+				DAW_THROW_OR_TERMINATE_NA( std::bad_array_new_length );
+			}
+			return static_cast<T *>(
+			  m_resource->allocate( n * sizeof( T ), alignof( T ) ) );
+		}
+
+		void deallocate( T *ptr, std::size_t n ) noexcept {
+			m_resource->deallocate( ptr, n * sizeof( T ), alignof( T ) );
+		}
+
+		[[nodiscard]] constexpr Resource *resource( ) const noexcept {
+			return m_resource;
+		}
+
+		template<typename U>
+		constexpr bool
+		operator==( arena_allocator<U, Resource> const &rhs ) const noexcept {
+			return m_resource == rhs.m_resource;
+		}
+
+		template<typename U>
+		constexpr bool
+		operator!=( arena_allocator<U, Resource> const &rhs ) const noexcept {
+			return m_resource != rhs.m_resource;
+		}
+	};
+
+	template<typename T>
+	using pool_allocator = arena_allocator<T, pool_resource>;
+} // namespace daw::memory
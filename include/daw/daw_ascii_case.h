@@ -0,0 +1,202 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw/ciso646.h"
+#include "daw/daw_attributes.h"
+#include "daw/daw_fnv1a_hash.h"
+#include "daw/daw_string_view.h"
+#include "daw/impl/daw_ascii_case_simd.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+/// ASCII case conversion and case insensitive comparison, search and
+/// hashing.  Only 'A'-'Z' and 'a'-'z' are folded, every other byte, including
+/// UTF-8 sequences, must match exactly.  This is the folding wanted for
+/// protocol tokens such as HTTP header names, not for natural language text
+namespace daw::ascii {
+	inline constexpr std::size_t npos = daw::string_view::npos;
+
+	[[nodiscard]] constexpr char to_lower( char c ) noexcept {
+		return ascii_impl::to_lower( c );
+	}
+
+	[[nodiscard]] constexpr char to_upper( char c ) noexcept {
+		return ascii_impl::to_upper( c );
+	}
+
+	/// Lower case count characters in place
+	inline void to_lower( char *str, std::size_t count ) noexcept {
+		ascii_impl::convert_n<false>( str, count, str );
+	}
+
+	/// Upper case count characters in place
+	inline void to_upper( char *str, std::size_t count ) noexcept {
+		ascii_impl::convert_n<true>( str, count, str );
+	}
+
+	/// Write the lower case of str to dst, which must have room for str.size( )
+	/// characters.  Returns the end of the output
+	inline char *to_lower( daw::string_view str, char *dst ) noexcept {
+		ascii_impl::convert_n<false>( str.data( ), str.size( ), dst );
+		return dst + str.size( );
+	}
+
+	/// Write the upper case of str to dst, which must have room for str.size( )
+	/// characters.  Returns the end of the output
+	inline char *to_upper( daw::string_view str, char *dst ) noexcept {
+		ascii_impl::convert_n<true>( str.data( ), str.size( ), dst );
+		return dst + str.size( );
+	}
+
+	inline void to_lower( std::string &str ) noexcept {
+		to_lower( str.data( ), str.size( ) );
+	}
+
+	inline void to_upper( std::string &str ) noexcept {
+		to_upper( str.data( ), str.size( ) );
+	}
+
+	[[nodiscard]] inline std::string to_lower_copy( daw::string_view str ) {
+		auto result = std::string( str.size( ), '\0' );
+		(void)to_lower( str, result.data( ) );
+		return result;
+	}
+
+	[[nodiscard]] inline std::string to_upper_copy( daw::string_view str ) {
+		auto result = std::string( str.size( ), '\0' );
+		(void)to_upper( str, result.data( ) );
+		return result;
+	}
+
+	[[nodiscard]] inline bool iequal( daw::string_view lhs,
+	                                  daw::string_view rhs ) noexcept {
+		return lhs.size( ) == rhs.size( ) and
+		       ascii_impl::mismatch_n( lhs.data( ), rhs.data( ), lhs.size( ) ) ==
+		         lhs.size( );
+	}
+
+	/// Compares as if both were lower cased first.  Returns a negative value,
+	/// zero or a positive value like std::string_view::compare
+	[[nodiscard]] inline int icompare( daw::string_view lhs,
+	                                   daw::string_view rhs ) noexcept {
+		auto const count = lhs.size( ) < rhs.size( ) ? lhs.size( ) : rhs.size( );
+		auto const pos = ascii_impl::mismatch_n( lhs.data( ), rhs.data( ), count );
+		if( pos != count ) {
+			auto const l = static_cast<unsigned char>( to_lower( lhs[pos] ) );
+			auto const r = static_cast<unsigned char>( to_lower( rhs[pos] ) );
+			return l < r ? -1 : 1;
+		}
+		if( lhs.size( ) == rhs.size( ) ) {
+			return 0;
+		}
+		return lhs.size( ) < rhs.size( ) ? -1 : 1;
+	}
+
+	[[nodiscard]] inline bool istarts_with( daw::string_view str,
+	                                        daw::string_view prefix ) noexcept {
+		return str.size( ) >= prefix.size( ) and
+		       iequal( str.substr( 0, prefix.size( ) ), prefix );
+	}
+
+	[[nodiscard]] inline bool iends_with( daw::string_view str,
+	                                      daw::string_view suffix ) noexcept {
+		return str.size( ) >= suffix.size( ) and
+		       iequal( str.substr( str.size( ) - suffix.size( ) ), suffix );
+	}
+
+	/// The position of the first case insensitive match of needle in
+	/// haystack at or after pos, or npos.  Candidates are found by searching
+	/// for either case of the needle's first character
+	[[nodiscard]] inline std::size_t ifind( daw::string_view haystack,
+	                                        daw::string_view needle,
+	                                        std::size_t pos = 0 ) noexcept {
+		if( pos > haystack.size( ) or
+		    needle.size( ) > haystack.size( ) - pos ) {
+			return npos;
+		}
+		if( needle.empty( ) ) {
+			return pos;
+		}
+		char const lower = to_lower( needle.front( ) );
+		char const upper = to_upper( needle.front( ) );
+		std::size_t const last = haystack.size( ) - needle.size( );
+		char const *const first = haystack.data( );
+		while( pos <= last ) {
+			pos += ascii_impl::find_either( first + pos, last + 1U - pos, lower,
+			                                upper );
+			if( pos > last ) {
+				break;
+			}
+			if( ascii_impl::mismatch_n( first + pos + 1U, needle.data( ) + 1U,
+			                            needle.size( ) - 1U ) ==
+			    needle.size( ) - 1U ) {
+				return pos;
+			}
+			++pos;
+		}
+		return npos;
+	}
+
+	/// The fnv1a hash of the lower case of str, without making a lower case
+	/// copy.  Equal to daw::fnv1a_hash( to_lower_copy( str ) )
+	[[nodiscard]] inline fnv1a_uint_t
+	ifnv1a_hash( daw::string_view str ) noexcept {
+		auto hash = fnv1a_impl::fnv_offset;
+		char const *ptr = str.data( );
+		std::size_t count = str.size( );
+		for( ; count >= 8U; count -= 8U, ptr += 8U ) {
+			auto const word =
+			  ascii_impl::convert_word<false>( ascii_impl::load_word( ptr ) );
+			unsigned char bytes[8];
+			std::memcpy( bytes, &word, sizeof( word ) );
+			for( auto b : bytes ) {
+				hash ^= static_cast<fnv1a_uint_t>( b );
+				hash *= fnv1a_impl::fnv_prime;
+			}
+		}
+		for( ; count > 0; --count, ++ptr ) {
+			hash ^= static_cast<fnv1a_uint_t>(
+			  static_cast<unsigned char>( to_lower( *ptr ) ) );
+			hash *= fnv1a_impl::fnv_prime;
+		}
+		return hash;
+	}
+
+	/// Case insensitive hasher for unordered containers, use with iequal_to
+	struct ihash {
+		using is_transparent = void;
+
+		[[nodiscard]] std::size_t operator( )( daw::string_view str ) const
+		  noexcept {
+			return static_cast<std::size_t>( ifnv1a_hash( str ) );
+		}
+	};
+
+	struct iequal_to {
+		using is_transparent = void;
+
+		[[nodiscard]] bool operator( )( daw::string_view lhs,
+		                                daw::string_view rhs ) const noexcept {
+			return iequal( lhs, rhs );
+		}
+	};
+
+	struct iless {
+		using is_transparent = void;
+
+		[[nodiscard]] bool operator( )( daw::string_view lhs,
+		                                daw::string_view rhs ) const noexcept {
+			return icompare( lhs, rhs ) < 0;
+		}
+	};
+} // namespace daw::ascii
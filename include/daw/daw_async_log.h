@@ -0,0 +1,548 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw_attributes.h"
+#include "daw_move.h"
+#include "daw_print.h"
+#include "daw_remove_cvref.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <format>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined( __cpp_lib_format ) and __cpp_lib_format >= 202207L
+// std::basic_format_string::get( ) is needed to hand the format string to the
+// consumer thread
+#define DAW_ASYNC_LOG_DEFERRED_FORMAT
+#endif
+
+namespace daw {
+	/// What a producer does when its ring buffer is full
+	enum class log_overflow_policy {
+		/// Wait for the consumer to make room
+		block,
+		/// Discard the message and count it in async_logger::dropped( ).  This
+		/// includes messages larger than the ring, which grow it under the other
+		/// policies.  A message that would not fit where the ring wraps even
+		/// once it is empty grows the ring
+		drop,
+		/// Continue in a new ring buffer of twice the size
+		grow
+	};
+
+	struct async_logger_options {
+		/// Bytes in each producer thread's ring buffer, rounded up to a power of 2
+		std::size_t ring_size = 64U * 1024U;
+		log_overflow_policy overflow = log_overflow_policy::block;
+		/// How long the consumer sleeps when it finds no messages
+		std::chrono::microseconds idle_wait = std::chrono::microseconds( 100 );
+	};
+
+	namespace async_log_details {
+		inline constexpr std::size_t cache_line_size = 64;
+
+		enum class record_kind : std::uint32_t { padding, text, deferred };
+
+		struct record_header {
+			std::uint32_t size;
+			record_kind kind;
+		};
+		inline constexpr std::size_t record_align = sizeof( record_header );
+
+		[[nodiscard]] constexpr std::size_t record_bytes( std::size_t size ) {
+			return sizeof( record_header ) +
+			       ( ( size + record_align - 1U ) & ~( record_align - 1U ) );
+		}
+
+		[[nodiscard]] constexpr std::size_t ring_capacity( std::size_t n ) {
+			auto result = std::size_t{ 4096 };
+			while( result < n ) {
+				result *= 2U;
+			}
+			return result;
+		}
+
+		/// A single producer single consumer queue of variable sized records.
+		/// Records are contiguous, a record that would straddle the end of the
+		/// buffer is preceded by a padding record filling it.  When the producer
+		/// outgrows the ring it links the next one and stops writing to this
+		/// one, the consumer follows the link once this ring is drained.
+		class byte_ring {
+			std::unique_ptr<char[]> m_data;
+			std::size_t m_capacity;
+			std::shared_ptr<byte_ring> m_next_owner = nullptr;
+			std::atomic<byte_ring *> m_next = nullptr;
+			std::atomic<bool> m_closed = false;
+			std::atomic<bool> m_abandoned = false;
+
+			alignas( cache_line_size ) std::atomic<std::size_t> m_write = 0;
+			std::size_t m_read_cache = 0;
+
+			alignas( cache_line_size ) std::atomic<std::size_t> m_read = 0;
+
+		public:
+			explicit byte_ring( std::size_t capacity )
+			  : m_data( std::make_unique<char[]>( ring_capacity( capacity ) ) )
+			  , m_capacity( ring_capacity( capacity ) ) {}
+
+			[[nodiscard]] std::size_t capacity( ) const {
+				return m_capacity;
+			}
+
+			/// Producer: the bytes a record of size takes at the write position,
+			/// including the padding before it when it would straddle the end
+			[[nodiscard]] std::size_t bytes_at_write( std::size_t size ) const {
+				auto const needed = record_bytes( size );
+				auto const offset =
+				  m_write.load( std::memory_order_relaxed ) & ( m_capacity - 1U );
+				auto const contiguous = m_capacity - offset;
+				return needed <= contiguous ? needed : contiguous + needed;
+			}
+
+			/// Producer: whether a record of size fits at the write position once
+			/// the consumer has caught up.  A record that has to wrap needs room
+			/// for the padding too, so it may not fit even though it is smaller
+			/// than the ring
+			[[nodiscard]] bool can_fit( std::size_t size ) const {
+				return bytes_at_write( size ) <= m_capacity;
+			}
+
+			/// Producer: copy a record made of the parts into the ring.
+			/// @return false if there is no room
+			template<typename WriteFn>
+			[[nodiscard]] bool try_push( record_kind kind,
+			                             std::size_t size,
+			                             WriteFn &&write_fn ) {
+				auto const needed = record_bytes( size );
+				auto pos = m_write.load( std::memory_order_relaxed );
+				auto const offset = pos & ( m_capacity - 1U );
+				auto const contiguous = m_capacity - offset;
+				auto const total = bytes_at_write( size );
+				if( total > m_capacity - ( pos - m_read_cache ) ) {
+					m_read_cache = m_read.load( std::memory_order_acquire );
+					if( total > m_capacity - ( pos - m_read_cache ) ) {
+						return false;
+					}
+				}
+				if( needed > contiguous ) {
+					auto const pad = record_header{
+					  static_cast<std::uint32_t>( contiguous - sizeof( record_header ) ),
+					  record_kind::padding };
+					std::memcpy( m_data.get( ) + offset, &pad, sizeof( pad ) );
+					pos += contiguous;
+				}
+				char *const ptr = m_data.get( ) + ( pos & ( m_capacity - 1U ) );
+				auto const header =
+				  record_header{ static_cast<std::uint32_t>( size ), kind };
+				std::memcpy( ptr, &header, sizeof( header ) );
+				write_fn( ptr + sizeof( header ) );
+				m_write.store( pos + needed, std::memory_order_release );
+				return true;
+			}
+
+			/// Consumer: pass each record in the ring to f( kind, data, size ).
+			/// @return the number of records read
+			template<typename Func>
+			std::size_t drain( Func &&f ) {
+				auto pos = m_read.load( std::memory_order_relaxed );
+				auto const last = m_write.load( std::memory_order_acquire );
+				std::size_t count = 0;
+				while( pos != last ) {
+					char const *const ptr =
+					  m_data.get( ) + ( pos & ( m_capacity - 1U ) );
+					auto header = record_header{ };
+					std::memcpy( &header, ptr, sizeof( header ) );
+					if( header.kind != record_kind::padding ) {
+						f( header.kind,
+						   ptr + sizeof( header ),
+						   std::size_t{ header.size } );
+						++count;
+					}
+					pos += record_bytes( header.size );
+				}
+				m_read.store( pos, std::memory_order_release );
+				return count;
+			}
+
+			[[nodiscard]] bool is_empty( ) const {
+				return m_read.load( std::memory_order_relaxed ) ==
+				       m_write.load( std::memory_order_acquire );
+			}
+
+			/// Producer: continue in next, this ring receives no more writes
+			void link( std::shared_ptr<byte_ring> next ) {
+				m_next_owner = std::move( next );
+				m_next.store( m_next_owner.get( ), std::memory_order_release );
+			}
+
+			/// Consumer: the ring the producer moved on to, only valid once this
+			/// ring is empty
+			[[nodiscard]] std::shared_ptr<byte_ring> next( ) const {
+				if( m_next.load( std::memory_order_acquire ) == nullptr ) {
+					return nullptr;
+				}
+				return m_next_owner;
+			}
+
+			void close( ) {
+				m_closed.store( true, std::memory_order_release );
+			}
+
+			[[nodiscard]] bool is_closed( ) const {
+				return m_closed.load( std::memory_order_acquire );
+			}
+
+			/// Producer: no more records will be written.  Publishes the last
+			/// ones written, like the write position does
+			void abandon( ) {
+				m_abandoned.store( true, std::memory_order_release );
+			}
+
+			/// Consumer: the producer is gone.  Once this is seen is_empty( )
+			/// reflects all of its records
+			[[nodiscard]] bool is_abandoned( ) const {
+				return m_abandoned.load( std::memory_order_acquire );
+			}
+		};
+
+		template<typename T>
+		inline constexpr bool is_deferrable_v =
+		  std::is_arithmetic_v<daw::remove_cvref_t<T>>;
+
+		/// The payload of a deferred record is this, followed by the arguments
+		struct deferred_header {
+			void ( *format )( std::string &, std::string_view, char const * );
+			char const *fmt_data;
+			std::size_t fmt_size;
+			bool new_line;
+		};
+
+		template<typename T>
+		T read_arg( char const *&ptr ) {
+			T result;
+			std::memcpy( &result, ptr, sizeof( T ) );
+			ptr += sizeof( T );
+			return result;
+		}
+
+		template<typename... Ts>
+		void format_deferred( std::string &out,
+		                      std::string_view fmt,
+		                      char const *ptr ) {
+			// Braced initialization reads the arguments in order
+			auto args = std::tuple<Ts...>{ read_arg<Ts>( ptr )... };
+			std::apply(
+			  [&]( auto &...values ) {
+				  std::vformat_to( std::back_inserter( out ),
+				                   fmt,
+				                   std::make_format_args( values... ) );
+			  },
+			  args );
+		}
+
+		/// A producer thread's ring for one logger.  The ring is abandoned when
+		/// the thread exits, so the consumer knows it can be released
+		struct producer_slot {
+			std::uint64_t logger_id;
+			std::shared_ptr<byte_ring> ring;
+
+			producer_slot( std::uint64_t id, std::shared_ptr<byte_ring> r )
+			  : logger_id( id )
+			  , ring( std::move( r ) ) {}
+
+			producer_slot( producer_slot const & ) = delete;
+			producer_slot &operator=( producer_slot const & ) = delete;
+			producer_slot( producer_slot && ) noexcept = default;
+			producer_slot &operator=( producer_slot && ) noexcept = default;
+
+			~producer_slot( ) {
+				if( ring ) {
+					ring->abandon( );
+				}
+			}
+		};
+
+		inline std::atomic<std::uint64_t> next_logger_id = 1;
+	} // namespace async_log_details
+
+	/// Takes printing off the calling thread.  Each producer thread writes its
+	/// messages to its own lock-free ring buffer and a background thread
+	/// formats them and writes them to the file in batches.  Messages whose
+	/// arguments are all arithmetic are formatted by the background thread,
+	/// others are formatted by the caller and copied.  Messages from one thread
+	/// are written in order, messages from different threads are not ordered.
+	/// All messages queued before destruction are written by the destructor.
+	class async_logger {
+		using byte_ring = async_log_details::byte_ring;
+		using record_kind = async_log_details::record_kind;
+
+		FILE *m_file;
+		async_logger_options m_options;
+		std::uint64_t m_id = async_log_details::next_logger_id.fetch_add( 1 );
+
+		std::mutex m_new_rings_mutex{ };
+		std::vector<std::shared_ptr<byte_ring>> m_new_rings{ };
+		std::atomic<bool> m_has_new_rings = false;
+
+		std::atomic<bool> m_stop = false;
+		std::atomic<std::uint64_t> m_flush_requested = 0;
+		std::atomic<std::uint64_t> m_flush_completed = 0;
+		std::atomic<std::size_t> m_dropped = 0;
+		std::thread m_consumer;
+
+		[[nodiscard]] static std::vector<async_log_details::producer_slot> &
+		producer_slots( ) {
+			static thread_local std::vector<async_log_details::producer_slot> slots;
+			return slots;
+		}
+
+		[[nodiscard]] std::shared_ptr<byte_ring> &producer_ring( ) {
+			auto &slots = producer_slots( );
+			for( auto &slot : slots ) {
+				if( slot.logger_id == m_id ) {
+					return slot.ring;
+				}
+			}
+			std::erase_if( slots, []( auto const &slot ) {
+				return slot.ring->is_closed( );
+			} );
+			auto ring = std::make_shared<byte_ring>( m_options.ring_size );
+			register_ring( ring );
+			return slots.emplace_back( m_id, std::move( ring ) ).ring;
+		}
+
+		void register_ring( std::shared_ptr<byte_ring> ring ) {
+			auto const lck = std::lock_guard( m_new_rings_mutex );
+			m_new_rings.push_back( std::move( ring ) );
+			m_has_new_rings.store( true, std::memory_order_release );
+		}
+
+		template<typename WriteFn>
+		bool push( record_kind kind, std::size_t size, WriteFn const &write_fn ) {
+			auto &ring = producer_ring( );
+			if( ring->try_push( kind, size, write_fn ) ) [[likely]] {
+				return true;
+			}
+			auto const needed = async_log_details::record_bytes( size );
+			auto const policy = m_options.overflow;
+			bool const can_fit = ring->can_fit( size );
+			if( policy == log_overflow_policy::drop and
+			    ( can_fit or needed > ring->capacity( ) ) ) {
+				m_dropped.fetch_add( 1, std::memory_order_relaxed );
+				return false;
+			}
+			if( policy == log_overflow_policy::grow or not can_fit ) {
+				// A record that cannot fit even in the empty ring would block forever,
+				// so the other policies grow too
+				auto next = std::make_shared<byte_ring>(
+				  ( std::max )( ring->capacity( ) * 2U, needed * 2U ) );
+				ring->link( next );
+				ring = std::move( next );
+				(void)ring->try_push( kind, size, write_fn );
+				return true;
+			}
+			while( not ring->try_push( kind, size, write_fn ) ) {
+				std::this_thread::yield( );
+			}
+			return true;
+		}
+
+		template<bool NewLine, typename... Args>
+		bool queue( std::format_string<Args...> fmt, Args &&...args ) {
+#if defined( DAW_ASYNC_LOG_DEFERRED_FORMAT )
+			if constexpr( ( async_log_details::is_deferrable_v<Args> and ... ) ) {
+				auto const fmt_sv = fmt.get( );
+				auto const header = async_log_details::deferred_header{
+				  async_log_details::format_deferred<daw::remove_cvref_t<Args>...>,
+				  fmt_sv.data( ),
+				  fmt_sv.size( ),
+				  NewLine };
+				return push( record_kind::deferred,
+				             ( sizeof( header ) + ... + sizeof( Args ) ),
+				             [&]( char *ptr ) {
+					             std::memcpy( ptr, &header, sizeof( header ) );
+					             ptr += sizeof( header );
+					             ( ( std::memcpy( ptr, &args, sizeof( args ) ),
+					                 ptr += sizeof( args ) ),
+					               ... );
+				             } );
+			} else
+#endif
+			{
+				constexpr std::size_t extra = NewLine ? 1U : 0U;
+				char buff[print_details::stack_buffer_size];
+				auto const r = std::format_to_n(
+				  buff,
+				  static_cast<std::ptrdiff_t>( sizeof( buff ) - extra ),
+				  fmt,
+				  DAW_FWD( args )... );
+				auto const size = static_cast<std::size_t>( r.size );
+				if( size + extra <= sizeof( buff ) ) {
+					if constexpr( NewLine ) {
+						buff[size] = '\n';
+					}
+					return write( std::string_view( buff, size + extra ) );
+				}
+				auto str = std::format( std::move( fmt ), DAW_FWD( args )... );
+				if constexpr( NewLine ) {
+					str += '\n';
+				}
+				return write( str );
+			}
+		}
+
+		void run( ) {
+			auto rings = std::vector<std::shared_ptr<byte_ring>>( );
+			auto out = output_buffer( m_file );
+			auto scratch = std::string( );
+			auto const write_record = [&]( record_kind kind,
+			                               char const *data,
+			                               std::size_t size ) {
+				if( kind == record_kind::text ) {
+					out.write( std::string_view( data, size ) );
+					return;
+				}
+				auto header = async_log_details::deferred_header{ };
+				std::memcpy( &header, data, sizeof( header ) );
+				scratch.clear( );
+				header.format( scratch,
+				               std::string_view( header.fmt_data, header.fmt_size ),
+				               data + sizeof( header ) );
+				if( header.new_line ) {
+					scratch += '\n';
+				}
+				out.write( scratch );
+			};
+			while( true ) {
+				bool const stopping = m_stop.load( std::memory_order_acquire );
+				auto const flush_target =
+				  m_flush_requested.load( std::memory_order_acquire );
+				if( m_has_new_rings.load( std::memory_order_acquire ) ) {
+					auto const lck = std::lock_guard( m_new_rings_mutex );
+					for( auto &r : m_new_rings ) {
+						rings.push_back( std::move( r ) );
+					}
+					m_new_rings.clear( );
+					m_has_new_rings.store( false, std::memory_order_relaxed );
+				}
+				std::size_t count = 0;
+				for( auto &ring : rings ) {
+					count += ring->drain( write_record );
+					// Follow rings the producer grew into, the link is published after
+					// the last write to the old ring
+					while( auto next = ring->next( ) ) {
+						count += ring->drain( write_record );
+						ring = std::move( next );
+						count += ring->drain( write_record );
+					}
+				}
+				// The rings of threads that have exited.  The abandoned flag, not
+				// the reference count, orders their last writes before is_empty( )
+				std::erase_if( rings, []( auto const &ring ) {
+					return ring->is_abandoned( ) and ring->is_empty( ) and
+					       not ring->next( );
+				} );
+				out.flush( );
+				if( flush_target !=
+				    m_flush_completed.load( std::memory_order_relaxed ) ) {
+					std::fflush( m_file );
+					m_flush_completed.store( flush_target, std::memory_order_release );
+				}
+				if( stopping ) {
+					break;
+				}
+				if( count == 0 ) {
+					std::this_thread::sleep_for( m_options.idle_wait );
+				}
+			}
+			for( auto &ring : rings ) {
+				ring->close( );
+			}
+			std::fflush( m_file );
+		}
+
+	public:
+		explicit async_logger( FILE *f = stdout,
+		                       async_logger_options options = { } )
+		  : m_file( f )
+		  , m_options( options )
+		  , m_consumer( [this] {
+			  run( );
+		  } ) {}
+
+		async_logger( async_logger const & ) = delete;
+		async_logger &operator=( async_logger const & ) = delete;
+
+		/// Writes all queued messages and stops the consumer thread.  No thread
+		/// may log to this logger once destruction starts
+		~async_logger( ) {
+			m_stop.store( true, std::memory_order_release );
+			m_consumer.join( );
+			// Closing lets producer threads release their rings
+			auto const lck = std::lock_guard( m_new_rings_mutex );
+			for( auto &ring : m_new_rings ) {
+				ring->close( );
+			}
+		}
+
+		/// Queue a pre-formatted message
+		/// @return false if the message was dropped
+		bool write( std::string_view message ) {
+			return push(
+			  record_kind::text, message.size( ), [&]( char *ptr ) {
+				  std::memcpy( ptr, message.data( ), message.size( ) );
+			  } );
+		}
+
+		template<typename... Args>
+		bool print( std::format_string<Args...> fmt, Args &&...args ) {
+			return queue<false>( std::move( fmt ), DAW_FWD( args )... );
+		}
+
+		template<typename... Args>
+		bool println( std::format_string<Args...> fmt, Args &&...args ) {
+			return queue<true>( std::move( fmt ), DAW_FWD( args )... );
+		}
+
+		/// Wait until everything queued before the call has been written and the
+		/// file flushed.  Must not be called from the consumer
+		void flush( ) {
+			auto const target =
+			  m_flush_requested.fetch_add( 1, std::memory_order_acq_rel ) + 1U;
+			while( m_flush_completed.load( std::memory_order_acquire ) < target ) {
+				std::this_thread::yield( );
+			}
+		}
+
+		/// The number of messages discarded by log_overflow_policy::drop
+		[[nodiscard]] std::size_t dropped( ) const {
+			return m_dropped.load( std::memory_order_relaxed );
+		}
+
+		[[nodiscard]] async_logger_options const &options( ) const {
+			return m_options;
+		}
+	};
+} // namespace daw
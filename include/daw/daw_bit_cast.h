@@ -11,6 +11,7 @@
 #include "ciso646.h"
 #include "daw_cpp_feature_check.h"
 
+#include <cstdint>
 #include <cstring>
 #include <type_traits>
 
@@ -0,0 +1,637 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw/ciso646.h"
+#include "daw/daw_attributes.h"
+#include "daw/daw_check_exceptions.h"
+#include "daw/daw_likely.h"
+#include "daw/daw_move.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#if defined( __cpp_lib_atomic_wait ) and __cpp_lib_atomic_wait >= 201907L
+#define DAW_HAS_ATOMIC_WAIT
+#endif
+
+namespace daw {
+	namespace concurrent_queue_impl {
+		inline constexpr std::size_t cache_line_size = 64;
+
+		/// The capacity rounded up to a power of 2, so that positions map to
+		/// slots with a mask instead of a division
+		[[nodiscard]] constexpr std::size_t
+		ring_capacity( std::size_t capacity ) noexcept {
+			std::size_t result = 2;
+			while( result < capacity ) {
+				result *= 2U;
+			}
+			return result;
+		}
+
+		template<typename T>
+		struct storage_for {
+			alignas( T ) unsigned char data[sizeof( T )];
+
+			[[nodiscard]] T *get( ) noexcept {
+				return std::launder( reinterpret_cast<T *>( data ) );
+			}
+		};
+
+		///
+		/// Lets threads sleep until an atomic changes, while the thread changing
+		/// it only pays for a notify when one is asleep.  Sleepers announce
+		/// themselves before their final check of the value and changers check
+		/// for sleepers after a fence, so a change cannot be missed.  Without
+		/// std::atomic::wait the sleepers keep yielding instead
+		///
+		class waiters {
+			std::atomic<std::uint32_t> m_count = 0;
+
+		public:
+			template<typename T>
+			void wait_while_equal( std::atomic<T> const &value, T old ) noexcept {
+				// The other side is usually about to make progress
+				for( int n = 0; n < 16; ++n ) {
+					if( value.load( std::memory_order_acquire ) != old ) {
+						return;
+					}
+					std::this_thread::yield( );
+				}
+#if defined( DAW_HAS_ATOMIC_WAIT )
+				m_count.fetch_add( 1, std::memory_order_seq_cst );
+				value.wait( old, std::memory_order_seq_cst );
+				m_count.fetch_sub( 1, std::memory_order_relaxed );
+#else
+				while( value.load( std::memory_order_acquire ) == old ) {
+					std::this_thread::yield( );
+				}
+#endif
+			}
+
+			/// Whether any thread may be asleep.  Call after changing the values
+			/// they wait on, and notify them if so
+			[[nodiscard]] DAW_ATTRIB_INLINE bool any( ) const noexcept {
+#if defined( DAW_HAS_ATOMIC_WAIT )
+				std::atomic_thread_fence( std::memory_order_seq_cst );
+				return DAW_UNLIKELY( m_count.load( std::memory_order_relaxed ) != 0 );
+#else
+				return false;
+#endif
+			}
+
+			/// Call after changing value
+			template<typename T>
+			DAW_ATTRIB_INLINE void notify( std::atomic<T> &value ) noexcept {
+#if defined( DAW_HAS_ATOMIC_WAIT )
+				if( any( ) ) {
+					value.notify_all( );
+				}
+#else
+				(void)value;
+#endif
+			}
+		};
+	} // namespace concurrent_queue_impl
+
+	///
+	/// Bounded lock-free queue for one producer thread and one consumer
+	/// thread.  The capacity is rounded up to a power of 2.  Each side owns a
+	/// cache line holding its position and a cached copy of the other side's,
+	/// so the shared positions are only read when the cached one says the
+	/// queue is full or empty.  The try_ members never block, push/pop block
+	/// with std::atomic::wait when it is available
+	///
+	template<typename T>
+	class spsc_queue {
+		static_assert( std::is_nothrow_destructible_v<T> );
+		static constexpr std::size_t cache_line_size =
+		  concurrent_queue_impl::cache_line_size;
+		using storage_t = concurrent_queue_impl::storage_for<T>;
+
+		// Producer
+		alignas( cache_line_size ) std::atomic<std::size_t> m_tail = 0;
+		std::size_t m_head_cache = 0;
+		concurrent_queue_impl::waiters m_tail_waiters;
+
+		// Consumer
+		alignas( cache_line_size ) std::atomic<std::size_t> m_head = 0;
+		std::size_t m_tail_cache = 0;
+		concurrent_queue_impl::waiters m_head_waiters;
+
+		// Shared and read only
+		alignas( cache_line_size ) std::size_t m_mask;
+		std::unique_ptr<storage_t[]> m_slots;
+
+		[[nodiscard]] DAW_ATTRIB_INLINE T *slot( std::size_t pos ) noexcept {
+			return m_slots[pos & m_mask].get( );
+		}
+
+		/// Producer: the free slots, checking the consumer's position only when
+		/// the cached one says there are fewer than wanted
+		[[nodiscard]] DAW_ATTRIB_INLINE std::size_t
+		free_slots( std::size_t tail, std::size_t wanted ) noexcept {
+			auto result = capacity( ) - ( tail - m_head_cache );
+			if( result < wanted ) {
+				m_head_cache = m_head.load( std::memory_order_acquire );
+				result = capacity( ) - ( tail - m_head_cache );
+			}
+			return result;
+		}
+
+		/// Consumer: the filled slots, checking the producer's position only
+		/// when the cached one says there are fewer than wanted
+		[[nodiscard]] DAW_ATTRIB_INLINE std::size_t
+		filled_slots( std::size_t head, std::size_t wanted ) noexcept {
+			auto result = m_tail_cache - head;
+			if( result < wanted ) {
+				m_tail_cache = m_tail.load( std::memory_order_acquire );
+				result = m_tail_cache - head;
+			}
+			return result;
+		}
+
+	public:
+		using value_type = T;
+		using size_type = std::size_t;
+
+		explicit spsc_queue( std::size_t capacity )
+		  : m_mask( concurrent_queue_impl::ring_capacity( capacity ) - 1U )
+		  , m_slots( new storage_t[m_mask + 1U] ) {}
+
+		spsc_queue( spsc_queue const & ) = delete;
+		spsc_queue &operator=( spsc_queue const & ) = delete;
+
+		~spsc_queue( ) {
+			if constexpr( not std::is_trivially_destructible_v<T> ) {
+				auto const tail = m_tail.load( std::memory_order_acquire );
+				for( auto pos = m_head.load( std::memory_order_relaxed ); pos != tail;
+				     ++pos ) {
+					slot( pos )->~T( );
+				}
+			}
+		}
+
+		[[nodiscard]] size_type capacity( ) const noexcept {
+			return m_mask + 1U;
+		}
+
+		/// The number of elements, which may be stale by the time it is used
+		[[nodiscard]] size_type size( ) const noexcept {
+			auto const head = m_head.load( std::memory_order_acquire );
+			return m_tail.load( std::memory_order_acquire ) - head;
+		}
+
+		[[nodiscard]] bool empty( ) const noexcept {
+			return size( ) == 0;
+		}
+
+		/// Producer: construct an element in place
+		/// @return false if the queue is full
+		template<typename... Args>
+		[[nodiscard]] bool try_emplace( Args &&...args ) noexcept(
+		  std::is_nothrow_constructible_v<T, Args...> ) {
+			auto const tail = m_tail.load( std::memory_order_relaxed );
+			if( DAW_UNLIKELY( free_slots( tail, 1 ) == 0 ) ) {
+				return false;
+			}
+			::new( static_cast<void *>( slot( tail ) ) ) T( DAW_FWD( args )... );
+			m_tail.store( tail + 1U, std::memory_order_release );
+			m_tail_waiters.notify( m_tail );
+			return true;
+		}
+
+		[[nodiscard]] bool try_push( T const &value ) noexcept(
+		  std::is_nothrow_copy_constructible_v<T> ) {
+			return try_emplace( value );
+		}
+
+		[[nodiscard]] bool
+		try_push( T &&value ) noexcept( std::is_nothrow_move_constructible_v<T> ) {
+			return try_emplace( std::move( value ) );
+		}
+
+		/// Producer: copy up to count elements starting at first, publishing
+		/// them all at once
+		/// @return the number of elements pushed
+		template<typename ForwardIterator>
+		[[nodiscard]] size_type try_push_n( ForwardIterator first,
+		                                    size_type count ) {
+			auto const tail = m_tail.load( std::memory_order_relaxed );
+			auto const free = free_slots( tail, count );
+			auto const result = free < count ? free : count;
+			size_type n = 0;
+#if defined( DAW_USE_EXCEPTIONS )
+			try {
+#endif
+				for( ; n < result; ++n, ++first ) {
+					::new( static_cast<void *>( slot( tail + n ) ) ) T( *first );
+				}
+#if defined( DAW_USE_EXCEPTIONS )
+			} catch( ... ) {
+				// Nothing is published yet, so the copies made are only ours
+				while( n > 0 ) {
+					--n;
+					slot( tail + n )->~T( );
+				}
+				throw;
+			}
+#endif
+			if( result != 0 ) {
+				m_tail.store( tail + result, std::memory_order_release );
+				m_tail_waiters.notify( m_tail );
+			}
+			return result;
+		}
+
+		/// Consumer: move the front element into out
+		/// @return false if the queue is empty
+		[[nodiscard]] bool try_pop( T &out ) noexcept(
+		  std::is_nothrow_move_assignable_v<T> ) {
+			auto const head = m_head.load( std::memory_order_relaxed );
+			if( DAW_UNLIKELY( filled_slots( head, 1 ) == 0 ) ) {
+				return false;
+			}
+			T *const ptr = slot( head );
+			out = std::move( *ptr );
+			ptr->~T( );
+			m_head.store( head + 1U, std::memory_order_release );
+			m_head_waiters.notify( m_head );
+			return true;
+		}
+
+		[[nodiscard]] std::optional<T> try_pop( ) noexcept(
+		  std::is_nothrow_move_constructible_v<T> ) {
+			auto const head = m_head.load( std::memory_order_relaxed );
+			if( DAW_UNLIKELY( filled_slots( head, 1 ) == 0 ) ) {
+				return std::nullopt;
+			}
+			T *const ptr = slot( head );
+			auto result = std::optional<T>( std::move( *ptr ) );
+			ptr->~T( );
+			m_head.store( head + 1U, std::memory_order_release );
+			m_head_waiters.notify( m_head );
+			return result;
+		}
+
+		/// Consumer: move up to max_count elements to out, releasing their
+		/// slots all at once
+		/// @return the number of elements popped
+		template<typename OutputIterator>
+		[[nodiscard]] size_type try_pop_n( OutputIterator out,
+		                                   size_type max_count ) {
+			auto const head = m_head.load( std::memory_order_relaxed );
+			auto const filled = filled_slots( head, max_count );
+			auto const result = filled < max_count ? filled : max_count;
+			for( size_type n = 0; n < result; ++n ) {
+				T *const ptr = slot( head + n );
+				*out = std::move( *ptr );
+				++out;
+				ptr->~T( );
+			}
+			if( result != 0 ) {
+				m_head.store( head + result, std::memory_order_release );
+				m_head_waiters.notify( m_head );
+			}
+			return result;
+		}
+
+		/// Producer: construct an element in place, waiting for room
+		template<typename... Args>
+		void emplace( Args &&...args ) {
+			// Args are only used by the attempt that succeeds
+			while( not try_emplace( DAW_FWD( args )... ) ) {
+				m_head_waiters.wait_while_equal( m_head, m_head_cache );
+			}
+		}
+
+		void push( T const &value ) {
+			emplace( value );
+		}
+
+		void push( T &&value ) {
+			emplace( std::move( value ) );
+		}
+
+		/// Consumer: remove the front element, waiting for one
+		[[nodiscard]] T pop( ) {
+			while( true ) {
+				if( auto result = try_pop( ) ) {
+					return std::move( *result );
+				}
+				m_tail_waiters.wait_while_equal( m_tail, m_tail_cache );
+			}
+		}
+	};
+
+	///
+	/// Bounded lock-free queue for any number of producer and consumer
+	/// threads, after Dmitry Vyukov's bounded MPMC queue.  Each slot has a
+	/// sequence number saying whether it is ready for the producer or the
+	/// consumer of a given position, so threads only contend on the position
+	/// they claim with a CAS.  Slots are cache line aligned so that
+	/// neighbouring producers and consumers do not false share.  The
+	/// capacity is rounded up to a power of 2
+	///
+	template<typename T>
+	class mpmc_queue {
+		static_assert( std::is_nothrow_destructible_v<T> );
+		static constexpr std::size_t cache_line_size =
+		  concurrent_queue_impl::cache_line_size;
+
+		struct alignas( cache_line_size ) slot_t {
+			std::atomic<std::size_t> sequence;
+			concurrent_queue_impl::storage_for<T> storage;
+		};
+
+		alignas( cache_line_size ) std::atomic<std::size_t> m_enqueue_pos = 0;
+		alignas( cache_line_size ) std::atomic<std::size_t> m_dequeue_pos = 0;
+		// Rarely written
+		alignas( cache_line_size ) concurrent_queue_impl::waiters m_push_waiters;
+		concurrent_queue_impl::waiters m_pop_waiters;
+		std::size_t m_mask;
+		std::unique_ptr<slot_t[]> m_slots;
+
+		[[nodiscard]] DAW_ATTRIB_INLINE slot_t &slot( std::size_t pos ) noexcept {
+			return m_slots[pos & m_mask];
+		}
+
+		/// How far ahead of pos a slot's sequence is.  0 means it is ready for
+		/// pos, negative that it is still in use by the previous lap
+		[[nodiscard]] DAW_ATTRIB_INLINE static std::ptrdiff_t
+		lag( std::size_t sequence, std::size_t pos ) noexcept {
+			return static_cast<std::ptrdiff_t>( sequence - pos );
+		}
+
+		/// Claim up to count consecutive slots from position, where slot n is
+		/// ready when its sequence is pos + n + offset.  The slots checked
+		/// cannot change until claimed, so one CAS claims them all
+		/// @return the first claimed position and the number claimed
+		[[nodiscard]] DAW_ATTRIB_INLINE std::pair<std::size_t, std::size_t>
+		claim( std::atomic<std::size_t> &position, std::size_t offset,
+		       std::size_t count ) noexcept {
+			auto pos = position.load( std::memory_order_relaxed );
+			while( true ) {
+				auto const seq =
+				  slot( pos ).sequence.load( std::memory_order_acquire );
+				auto const diff = lag( seq, pos + offset );
+				if( diff == 0 ) {
+					std::size_t ready = 1;
+					while( ready < count and
+					       slot( pos + ready )
+					           .sequence.load( std::memory_order_acquire ) ==
+					         pos + ready + offset ) {
+						++ready;
+					}
+					if( position.compare_exchange_weak( pos, pos + ready,
+					                                    std::memory_order_relaxed ) ) {
+						return { pos, ready };
+					}
+				} else if( diff < 0 ) {
+					return { pos, 0 };
+				} else {
+					pos = position.load( std::memory_order_relaxed );
+				}
+			}
+		}
+
+		/// Wait for the slot at position to change from what made the last
+		/// attempt fail
+		void wait_for_slot( concurrent_queue_impl::waiters &sleepers,
+		                    std::atomic<std::size_t> const &position,
+		                    std::size_t offset ) noexcept {
+			auto const pos = position.load( std::memory_order_relaxed );
+			auto &seq = slot( pos ).sequence;
+			auto const current = seq.load( std::memory_order_acquire );
+			if( lag( current, pos + offset ) < 0 ) {
+				sleepers.wait_while_equal( seq, current );
+			}
+		}
+
+		/// Wake sleepers waiting on any of the count slots from pos
+		DAW_ATTRIB_INLINE void
+		notify_slots( concurrent_queue_impl::waiters &sleepers, std::size_t pos,
+		              std::size_t count ) noexcept {
+#if defined( DAW_HAS_ATOMIC_WAIT )
+			if( sleepers.any( ) ) {
+				for( std::size_t n = 0; n < count; ++n ) {
+					slot( pos + n ).sequence.notify_all( );
+				}
+			}
+#else
+			(void)sleepers;
+			(void)pos;
+			(void)count;
+#endif
+		}
+
+	public:
+		using value_type = T;
+		using size_type = std::size_t;
+
+		explicit mpmc_queue( std::size_t capacity )
+		  : m_mask( concurrent_queue_impl::ring_capacity( capacity ) - 1U )
+		  , m_slots( new slot_t[m_mask + 1U] ) {
+			for( std::size_t n = 0; n <= m_mask; ++n ) {
+				m_slots[n].sequence.store( n, std::memory_order_relaxed );
+			}
+		}
+
+		mpmc_queue( mpmc_queue const & ) = delete;
+		mpmc_queue &operator=( mpmc_queue const & ) = delete;
+
+		~mpmc_queue( ) {
+			if constexpr( not std::is_trivially_destructible_v<T> ) {
+				auto const last = m_enqueue_pos.load( std::memory_order_acquire );
+				for( auto pos = m_dequeue_pos.load( std::memory_order_relaxed );
+				     pos != last; ++pos ) {
+					slot( pos ).storage.get( )->~T( );
+				}
+			}
+		}
+
+		[[nodiscard]] size_type capacity( ) const noexcept {
+			return m_mask + 1U;
+		}
+
+		/// The number of elements claimed by producers and not by consumers,
+		/// which may be stale by the time it is used
+		[[nodiscard]] size_type size( ) const noexcept {
+			auto const head = m_dequeue_pos.load( std::memory_order_acquire );
+			auto const tail = m_enqueue_pos.load( std::memory_order_acquire );
+			return tail > head ? tail - head : 0;
+		}
+
+		[[nodiscard]] bool empty( ) const noexcept {
+			return size( ) == 0;
+		}
+
+		/// Construct an element in place.  A claimed slot must be published, so
+		/// when constructing T can throw the element is made before claiming
+		/// one and moved in.  args are then used even when the queue is full
+		/// @return false if the queue is full
+		template<typename... Args>
+		[[nodiscard]] bool try_emplace( Args &&...args ) noexcept(
+		  std::is_nothrow_constructible_v<T, Args...> ) {
+			if constexpr( not std::is_nothrow_constructible_v<T, Args...> ) {
+				static_assert( std::is_nothrow_move_constructible_v<T>,
+				               "T must be nothrow move constructible when "
+				               "constructing it can throw" );
+				return try_emplace( T( DAW_FWD( args )... ) );
+			} else {
+				auto const [pos, count] = claim( m_enqueue_pos, 0, 1 );
+				if( DAW_UNLIKELY( count == 0 ) ) {
+					return false;
+				}
+				auto &s = slot( pos );
+				::new( static_cast<void *>( s.storage.get( ) ) )
+				  T( DAW_FWD( args )... );
+				s.sequence.store( pos + 1U, std::memory_order_release );
+				m_pop_waiters.notify( s.sequence );
+				return true;
+			}
+		}
+
+		[[nodiscard]] bool try_push( T const &value ) noexcept(
+		  std::is_nothrow_copy_constructible_v<T> ) {
+			return try_emplace( value );
+		}
+
+		[[nodiscard]] bool
+		try_push( T &&value ) noexcept( std::is_nothrow_move_constructible_v<T> ) {
+			return try_emplace( std::move( value ) );
+		}
+
+		/// Copy up to count elements starting at first into consecutive slots
+		/// claimed with a single CAS.  When the copy can throw, the elements
+		/// are pushed one at a time with try_emplace instead, as claimed slots
+		/// cannot be given back
+		/// @return the number of elements pushed
+		template<typename ForwardIterator>
+		[[nodiscard]] size_type try_push_n( ForwardIterator first,
+		                                    size_type count ) {
+			if constexpr( not std::is_nothrow_constructible_v<T,
+			                                                  decltype( *first )> ) {
+				size_type n = 0;
+				for( ; n < count; ++n, ++first ) {
+					if( not try_emplace( *first ) ) {
+						break;
+					}
+				}
+				return n;
+			} else {
+				if( count == 0 ) {
+					return 0;
+				}
+				auto const [pos, claimed] = claim( m_enqueue_pos, 0, count );
+				for( size_type n = 0; n < claimed; ++n, ++first ) {
+					auto &s = slot( pos + n );
+					::new( static_cast<void *>( s.storage.get( ) ) ) T( *first );
+					s.sequence.store( pos + n + 1U, std::memory_order_release );
+				}
+				notify_slots( m_pop_waiters, pos, claimed );
+				return claimed;
+			}
+		}
+
+		/// Move the front element into out
+		/// @return false if the queue is empty
+		[[nodiscard]] bool try_pop( T &out ) noexcept(
+		  std::is_nothrow_move_assignable_v<T> ) {
+			auto const [pos, count] = claim( m_dequeue_pos, 1, 1 );
+			if( DAW_UNLIKELY( count == 0 ) ) {
+				return false;
+			}
+			auto &s = slot( pos );
+			T *const ptr = s.storage.get( );
+			out = std::move( *ptr );
+			ptr->~T( );
+			s.sequence.store( pos + capacity( ), std::memory_order_release );
+			m_push_waiters.notify( s.sequence );
+			return true;
+		}
+
+		[[nodiscard]] std::optional<T> try_pop( ) noexcept(
+		  std::is_nothrow_move_constructible_v<T> ) {
+			auto const [pos, count] = claim( m_dequeue_pos, 1, 1 );
+			if( DAW_UNLIKELY( count == 0 ) ) {
+				return std::nullopt;
+			}
+			auto &s = slot( pos );
+			T *const ptr = s.storage.get( );
+			auto result = std::optional<T>( std::move( *ptr ) );
+			ptr->~T( );
+			s.sequence.store( pos + capacity( ), std::memory_order_release );
+			m_push_waiters.notify( s.sequence );
+			return result;
+		}
+
+		/// Move up to max_count elements from consecutive slots claimed with a
+		/// single CAS to out
+		/// @return the number of elements popped
+		template<typename OutputIterator>
+		[[nodiscard]] size_type try_pop_n( OutputIterator out,
+		                                   size_type max_count ) {
+			if( max_count == 0 ) {
+				return 0;
+			}
+			auto const [pos, claimed] = claim( m_dequeue_pos, 1, max_count );
+			for( size_type n = 0; n < claimed; ++n ) {
+				auto &s = slot( pos + n );
+				T *const ptr = s.storage.get( );
+				*out = std::move( *ptr );
+				++out;
+				ptr->~T( );
+				s.sequence.store( pos + n + capacity( ), std::memory_order_release );
+			}
+			notify_slots( m_push_waiters, pos, claimed );
+			return claimed;
+		}
+
+		/// Construct an element in place, waiting for room
+		template<typename... Args>
+		void emplace( Args &&...args ) {
+			if constexpr( not std::is_nothrow_constructible_v<T, Args...> ) {
+				// Made once here, as try_emplace would use args on each attempt
+				emplace( T( DAW_FWD( args )... ) );
+			} else {
+				// Args are only used by the attempt that succeeds
+				while( not try_emplace( DAW_FWD( args )... ) ) {
+					wait_for_slot( m_push_waiters, m_enqueue_pos, 0 );
+				}
+			}
+		}
+
+		void push( T const &value ) {
+			emplace( value );
+		}
+
+		void push( T &&value ) {
+			emplace( std::move( value ) );
+		}
+
+		/// Remove the front element, waiting for one
+		[[nodiscard]] T pop( ) {
+			while( true ) {
+				if( auto result = try_pop( ) ) {
+					return std::move( *result );
+				}
+				wait_for_slot( m_pop_waiters, m_dequeue_pos, 1 );
+			}
+		}
+	};
+} // namespace daw
@@ -0,0 +1,348 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "ciso646.h"
+#include "daw_attributes.h"
+#include "daw_cxmath.h"
+#include "daw_exception.h"
+#include "daw_likely.h"
+#include "daw_parse_to.h"
+#include "daw_span.h"
+#include "daw_string_view.h"
+#include "impl/daw_simd_features.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+
+/// A two pass reader for delimited text such as CSV.  The first pass looks at
+/// 64 bytes at a time and builds bitmasks of the delimiter, quote and newline
+/// positions.  The regions inside quotes are the prefix XOR of the quote bits,
+/// a carry-less multiply by all ones, so "" escapes inside a quoted field
+/// cancel out.  The delimiters and newlines outside of quotes are stored as
+/// offsets.  The second pass walks those offsets to hand out fields as
+/// daw::string_view's without looking at the text again
+namespace daw::parser {
+	namespace delimited_index_impl {
+		struct block_masks {
+			std::uint64_t quote;
+			std::uint64_t delimiter;
+			std::uint64_t newline;
+		};
+
+#if defined( DAW_HAS_SSE2 )
+		DAW_ATTRIB_INLINE std::uint64_t match_16( __m128i block,
+		                                          char c ) noexcept {
+			return static_cast<std::uint16_t>( _mm_movemask_epi8(
+			  _mm_cmpeq_epi8( block, _mm_set1_epi8( c ) ) ) );
+		}
+#endif
+
+		/// The bits of the 64 bytes at p that are quote, delimiter and newline
+		DAW_ATTRIB_INLINE block_masks classify( unsigned char const *p,
+		                                        char delimiter,
+		                                        char quote ) noexcept {
+			block_masks result{ 0, 0, 0 };
+#if defined( DAW_HAS_AVX2 )
+			for( int half = 0; half < 2; ++half ) {
+				auto const block = _mm256_loadu_si256(
+				  reinterpret_cast<__m256i const *>( p + 32 * half ) );
+				auto const match = [&]( char c ) {
+					return static_cast<std::uint64_t>(
+					         static_cast<std::uint32_t>( _mm256_movemask_epi8(
+					           _mm256_cmpeq_epi8( block, _mm256_set1_epi8( c ) ) ) ) )
+					       << ( 32 * half );
+				};
+				result.quote |= match( quote );
+				result.delimiter |= match( delimiter );
+				result.newline |= match( '\n' );
+			}
+#elif defined( DAW_HAS_SSE2 )
+			for( int part = 0; part < 4; ++part ) {
+				auto const block =
+				  _mm_loadu_si128( reinterpret_cast<__m128i const *>( p + 16 * part ) );
+				result.quote |= match_16( block, quote ) << ( 16 * part );
+				result.delimiter |= match_16( block, delimiter ) << ( 16 * part );
+				result.newline |= match_16( block, '\n' ) << ( 16 * part );
+			}
+#else
+			for( std::size_t n = 0; n < 64; ++n ) {
+				auto const c = static_cast<char>( p[n] );
+				result.quote |= std::uint64_t{ c == quote } << n;
+				result.delimiter |= std::uint64_t{ c == delimiter } << n;
+				result.newline |= std::uint64_t{ c == '\n' } << n;
+			}
+#endif
+			return result;
+		}
+
+		/// Bit n of the result is the XOR of bits 0 to n of bits
+		DAW_ATTRIB_INLINE std::uint64_t prefix_xor( std::uint64_t bits ) noexcept {
+#if defined( DAW_HAS_PCLMUL )
+			auto const product = _mm_clmulepi64_si128(
+			  _mm_set_epi64x( 0, static_cast<long long>( bits ) ),
+			  _mm_set1_epi8( -1 ), 0 );
+			return static_cast<std::uint64_t>( _mm_cvtsi128_si64( product ) );
+#else
+			bits ^= bits << 1U;
+			bits ^= bits << 2U;
+			bits ^= bits << 4U;
+			bits ^= bits << 8U;
+			bits ^= bits << 16U;
+			bits ^= bits << 32U;
+			return bits;
+#endif
+		}
+	} // namespace delimited_index_impl
+
+	/// The structural index of a delimited text buffer.  The buffer must
+	/// outlive the index.  Quoting follows RFC 4180: a field may be wrapped in
+	/// quotes, inside of which delimiters and newlines are data and a quote is
+	/// written twice.  Records end at '\n' and a '\r' before it is dropped
+	class delimited_index {
+		daw::string_view m_data;
+		/// Offsets of the delimiters and newlines outside of quotes, ending with
+		/// a newline or the size of the data.  The storage is not zeroed, as
+		/// that would cost as much as a pass over the data, and is reused by
+		/// assign
+		std::unique_ptr<std::size_t[]> m_structurals;
+		std::size_t m_size = 0;
+		std::size_t m_capacity = 0;
+
+		void reserve( std::size_t capacity ) {
+			auto grown = std::unique_ptr<std::size_t[]>( new std::size_t[capacity] );
+			std::copy_n( m_structurals.get( ), m_size, grown.get( ) );
+			m_structurals = std::move( grown );
+			m_capacity = capacity;
+		}
+
+		void build( char delimiter, char quote ) {
+			auto const *const p =
+			  reinterpret_cast<unsigned char const *>( m_data.data( ) );
+			std::size_t const size = m_data.size( );
+			m_size = 0;
+			// Room for a field every 4 bytes, and grown before each block so the
+			// positions can be written without bounds checks
+			if( m_capacity < size / 4 + 128 ) {
+				reserve( size / 4 + 128 );
+			}
+			std::uint64_t in_quote_carry = 0;
+			auto const index_block = [&]( unsigned char const *block,
+			                              std::size_t base ) {
+				auto const masks =
+				  delimited_index_impl::classify( block, delimiter, quote );
+				auto const in_quote =
+				  delimited_index_impl::prefix_xor( masks.quote ) ^ in_quote_carry;
+				// All ones when the block ends inside of quotes
+				in_quote_carry = static_cast<std::uint64_t>(
+				  static_cast<std::int64_t>( in_quote ) >> 63 );
+				auto bits = ( masks.delimiter | masks.newline ) & ~in_quote;
+				if( DAW_UNLIKELY( m_size + 64 + 8 > m_capacity ) ) {
+					reserve( m_capacity * 2 );
+				}
+				std::size_t *const out = m_structurals.get( ) + m_size;
+				auto const count =
+				  static_cast<std::size_t>( daw::cxmath::popcount( bits ) );
+				// Extract 8 positions at a time; the writes past count are junk that
+				// the next block overwrites
+				for( std::size_t n = 0; n < count; n += 8 ) {
+					for( std::size_t m = 0; m < 8; ++m ) {
+						out[n + m] = base + daw::cxmath::count_trailing_zeros( bits );
+						bits &= bits - 1;
+					}
+				}
+				m_size += count;
+			};
+			std::size_t pos = 0;
+			for( ; pos + 64 <= size; pos += 64 ) {
+				index_block( p + pos, pos );
+			}
+			if( pos < size ) {
+				unsigned char tail[64]{ };
+				std::memcpy( tail, p + pos, size - pos );
+				index_block( tail, pos );
+				// The zero padding may have matched a '\0' delimiter
+				while( m_size > 0 and m_structurals[m_size - 1] >= size ) {
+					--m_size;
+				}
+			}
+			daw::exception::precondition_check<invalid_input_exception>(
+			  in_quote_carry == 0 );
+			if( size > 0 and m_data.back( ) != '\n' ) {
+				m_structurals[m_size++] = size;
+			}
+		}
+
+	public:
+		/// One line of fields.  Fields keep their quotes, as the parse_to
+		/// converters expect
+		class record {
+			daw::string_view m_data;
+			std::size_t m_first;
+			std::size_t const *m_ends;
+			std::size_t m_size;
+
+		public:
+			constexpr record( daw::string_view data,
+			                  std::size_t first,
+			                  std::size_t const *ends,
+			                  std::size_t size ) noexcept
+			  : m_data( data )
+			  , m_first( first )
+			  , m_ends( ends )
+			  , m_size( size ) {}
+
+			/// The number of fields
+			[[nodiscard]] constexpr std::size_t size( ) const noexcept {
+				return m_size;
+			}
+
+			[[nodiscard]] constexpr daw::string_view
+			operator[]( std::size_t n ) const noexcept {
+				std::size_t const first = n == 0 ? m_first : m_ends[n - 1] + 1;
+				std::size_t last = m_ends[n];
+				if( n + 1 == m_size and last > first and
+				    m_data[last - 1] == '\r' ) {
+					--last;
+				}
+				return daw::string_view( m_data.data( ) + first, last - first );
+			}
+
+			/// The whole line, without the line ending
+			[[nodiscard]] constexpr daw::string_view line( ) const noexcept {
+				auto const last = ( *this )[m_size - 1];
+				return daw::string_view( m_data.data( ) + m_first,
+				                         last.data( ) + last.size( ) );
+			}
+
+			/// Convert the first sizeof...( Args ) fields with the parse_to
+			/// converters
+			template<typename... Args>
+			[[nodiscard]] constexpr decltype( auto ) parse( ) const {
+				daw::exception::precondition_check<invalid_input_exception>(
+				  sizeof...( Args ) <= m_size );
+				auto fields = std::array<daw::string_view, sizeof...( Args )>{ };
+				for( std::size_t n = 0; n < fields.size( ); ++n ) {
+					fields[n] = ( *this )[n];
+				}
+				return impl::set_value_from_string_view<Args...>( fields );
+			}
+		};
+
+		class const_iterator {
+			delimited_index const *m_index = nullptr;
+			std::size_t m_pos = 0;
+			std::size_t m_next = 0;
+
+			[[nodiscard]] std::size_t find_end( ) const noexcept {
+				auto const *const s = m_index->m_structurals.get( );
+				std::size_t n = m_pos;
+				while( n < m_index->m_size and s[n] != m_index->m_data.size( ) and
+				       m_index->m_data[s[n]] != '\n' ) {
+					++n;
+				}
+				return n + 1;
+			}
+
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = record;
+			using reference = record;
+			using pointer = void;
+			using difference_type = std::ptrdiff_t;
+
+			const_iterator( ) = default;
+
+			const_iterator( delimited_index const *index, std::size_t pos ) noexcept
+			  : m_index( index )
+			  , m_pos( pos )
+			  , m_next( pos < index->m_size ? find_end( ) : pos ) {}
+
+			[[nodiscard]] record operator*( ) const noexcept {
+				auto const *const s = m_index->m_structurals.get( );
+				return record( m_index->m_data, m_pos == 0 ? 0 : s[m_pos - 1] + 1,
+				               s + m_pos, m_next - m_pos );
+			}
+
+			const_iterator &operator++( ) noexcept {
+				m_pos = m_next;
+				if( m_pos < m_index->m_size ) {
+					m_next = find_end( );
+				}
+				return *this;
+			}
+
+			const_iterator operator++( int ) noexcept {
+				auto result = *this;
+				operator++( );
+				return result;
+			}
+
+			[[nodiscard]] constexpr friend bool
+			operator==( const_iterator const &lhs,
+			            const_iterator const &rhs ) noexcept {
+				return lhs.m_pos == rhs.m_pos;
+			}
+
+			[[nodiscard]] constexpr friend bool
+			operator!=( const_iterator const &lhs,
+			            const_iterator const &rhs ) noexcept {
+				return lhs.m_pos != rhs.m_pos;
+			}
+		};
+
+		using iterator = const_iterator;
+
+		/// Index data.  Throws invalid_input_exception when a quote is not
+		/// closed
+		explicit delimited_index( daw::string_view data,
+		                          char delimiter = ',',
+		                          char quote = '"' )
+		  : m_data( data ) {
+			build( delimiter, quote );
+		}
+
+		/// Index new data, reusing the storage of the last index
+		void assign( daw::string_view data,
+		             char delimiter = ',',
+		             char quote = '"' ) {
+			m_data = data;
+			build( delimiter, quote );
+		}
+
+		[[nodiscard]] const_iterator begin( ) const noexcept {
+			return const_iterator( this, 0 );
+		}
+
+		[[nodiscard]] const_iterator end( ) const noexcept {
+			return const_iterator( this, m_size );
+		}
+
+		/// The offsets of every delimiter and newline outside of quotes
+		[[nodiscard]] daw::span<std::size_t const> structurals( ) const noexcept {
+			return daw::span<std::size_t const>( m_structurals.get( ), m_size );
+		}
+	};
+
+	/// Remove the quotes around a field, if it has them.  Escaped quotes
+	/// inside are left as ""
+	[[nodiscard]] constexpr daw::string_view
+	unquote_field( daw::string_view field, char quote = '"' ) noexcept {
+		if( field.size( ) >= 2 and field.front( ) == quote and
+		    field.back( ) == quote ) {
+			return field.substr( 1, field.size( ) - 2 );
+		}
+		return field;
+	}
+} // namespace daw::parser
@@ -0,0 +1,361 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "ciso646.h"
+#include "daw_check_exceptions.h"
+#include "daw_exception.h"
+#include "impl/daw_bitset_words.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace daw {
+	/// A bitset with its size chosen at runtime.  It has the interface of
+	/// static_bitset and stores the bits in whole 64 bit words, so the bulk
+	/// operations and counts run a word at a time.  Bits past size( ) are kept
+	/// zero.  The bulk operations require both sets to be the same size.
+	class dynamic_bitset {
+		using value_t = bitset_impl::word_t;
+
+		std::vector<value_t> m_data{ };
+		std::size_t m_size = 0;
+
+		static constexpr std::size_t word_index( std::size_t index ) noexcept {
+			return index / bitset_impl::word_bits;
+		}
+
+		static constexpr value_t bit_mask( std::size_t index ) noexcept {
+			return value_t{ 1 } << ( index % bitset_impl::word_bits );
+		}
+
+		/// Zero the bits past m_size in the last word
+		void mask_tail( ) noexcept {
+			if( not m_data.empty( ) ) {
+				m_data.back( ) &= bitset_impl::tail_mask( m_size );
+			}
+		}
+
+		void check_same_size( dynamic_bitset const &rhs ) const {
+			daw::exception::precondition_check<std::invalid_argument>(
+			  m_size == rhs.m_size, "Bitsets must be the same size" );
+		}
+
+	public:
+		using value_type = bool;
+		using size_type = std::size_t;
+		using word_type = value_t;
+
+		/// Returned by find_first/find_next/select when there is no such bit
+		static constexpr std::size_t npos = bitset_impl::npos;
+
+		dynamic_bitset( ) = default;
+
+		/// Construct a bitset of size bits, all set to value
+		explicit dynamic_bitset( std::size_t size, bool value = false )
+		  : m_data( bitset_impl::words_needed( size ), value ? ~value_t{ 0 } : 0U )
+		  , m_size( size ) {
+			mask_tail( );
+		}
+
+		[[nodiscard]] std::size_t size( ) const noexcept {
+			return m_size;
+		}
+
+		[[nodiscard]] bool empty( ) const noexcept {
+			return m_size == 0;
+		}
+
+		/// The number of 64 bit words holding the bits.  Bit n is bit n % 64 of
+		/// word n / 64 and the bits past size( ) are always zero
+		[[nodiscard]] std::size_t word_count( ) const noexcept {
+			return m_data.size( );
+		}
+
+		[[nodiscard]] value_t const *word_data( ) const noexcept {
+			return m_data.data( );
+		}
+
+		/// Change the number of bits, new bits are set to value
+		void resize( std::size_t size, bool value = false ) {
+			auto const old_size = m_size;
+			m_data.resize( bitset_impl::words_needed( size ),
+			               value ? ~value_t{ 0 } : 0U );
+			m_size = size;
+			if( value and old_size < size and
+			    old_size % bitset_impl::word_bits != 0 ) {
+				// Fill the rest of the old last word
+				m_data[word_index( old_size )] |= ~bitset_impl::tail_mask( old_size );
+			}
+			mask_tail( );
+		}
+
+		/// Add a bit at position size( )
+		void push_back( bool value ) {
+			if( m_size % bitset_impl::word_bits == 0 ) {
+				m_data.push_back( 0U );
+			}
+			if( value ) {
+				m_data.back( ) |= bit_mask( m_size );
+			}
+			++m_size;
+		}
+
+		void reserve( std::size_t bits ) {
+			m_data.reserve( bitset_impl::words_needed( bits ) );
+		}
+
+		/// Enable a specific bit in the bitset
+		/// \param index bit position in set
+		void set_bit( std::size_t index ) noexcept {
+			m_data[word_index( index )] |= bit_mask( index );
+		}
+
+		/// Disable a specific bit in the bitset
+		/// \param index bit position in set
+		void clear_bit( std::size_t index ) noexcept {
+			m_data[word_index( index )] &= ~bit_mask( index );
+		}
+
+		/// Toggle a specific bit in the bitset
+		/// \param index bit position in set
+		void flip_bit( std::size_t index ) noexcept {
+			m_data[word_index( index )] ^= bit_mask( index );
+		}
+
+		/// Get a specific bit from the bitset
+		/// \param index bit position in set
+		[[nodiscard]] bool get_bit( std::size_t index ) const noexcept {
+			return ( m_data[word_index( index )] & bit_mask( index ) ) != 0U;
+		}
+
+		/// Set a bit, returning whether it was already set.  Useful as a visited
+		/// set
+		bool test_and_set( std::size_t index ) noexcept {
+			auto &w = m_data[word_index( index )];
+			auto const mask = bit_mask( index );
+			bool const result = ( w & mask ) != 0U;
+			w |= mask;
+			return result;
+		}
+
+		/// Set all bits to zero
+		void clear( ) noexcept {
+			std::fill( m_data.begin( ), m_data.end( ), value_t{ 0 } );
+		}
+
+		/// Set all bits to one
+		void set_all( ) noexcept {
+			std::fill( m_data.begin( ), m_data.end( ), ~value_t{ 0 } );
+			mask_tail( );
+		}
+
+		/// Toggle all bits
+		void flip( ) noexcept {
+			for( auto &w : m_data ) {
+				w = ~w;
+			}
+			mask_tail( );
+		}
+
+		[[nodiscard]] std::size_t one_count( ) const noexcept {
+			return bitset_impl::popcount( m_data.data( ), m_data.size( ) );
+		}
+
+		[[nodiscard]] std::size_t zero_count( ) const noexcept {
+			return m_size - one_count( );
+		}
+
+		/// Are any bits set
+		[[nodiscard]] bool any( ) const noexcept {
+			return std::any_of( m_data.begin( ), m_data.end( ), []( value_t w ) {
+				return w != 0U;
+			} );
+		}
+
+		/// Are no bits set
+		[[nodiscard]] bool none( ) const noexcept {
+			return not any( );
+		}
+
+		/// Are all bits set
+		[[nodiscard]] bool all( ) const noexcept {
+			return one_count( ) == m_size;
+		}
+
+		/// The position of the lowest set bit, or npos
+		[[nodiscard]] std::size_t find_first( ) const noexcept {
+			return bitset_impl::find_next( m_data.data( ), m_data.size( ), 0 );
+		}
+
+		/// The position of the lowest set bit at or after pos, or npos
+		[[nodiscard]] std::size_t find_next( std::size_t pos ) const noexcept {
+			return bitset_impl::find_next( m_data.data( ), m_data.size( ), pos );
+		}
+
+		/// Call f( std::size_t pos ) for each set bit, in ascending order.  This
+		/// skips a whole word of zeros at a time
+		template<typename Func>
+		void for_each_set_bit( Func &&f ) const {
+			bitset_impl::for_each_set_bit( m_data.data( ), m_data.size( ), f );
+		}
+
+		/// The number of set bits in [0, pos)
+		[[nodiscard]] std::size_t rank( std::size_t pos ) const noexcept {
+			if( pos >= m_size ) {
+				return one_count( );
+			}
+			return bitset_impl::rank( m_data.data( ), pos );
+		}
+
+		/// The position of the set bit with k set bits below it, or npos.  For
+		/// repeated queries use bitset_rank_index
+		[[nodiscard]] std::size_t select( std::size_t k ) const noexcept {
+			return bitset_impl::select( m_data.data( ), m_data.size( ), k );
+		}
+
+		// Bitwise operations
+
+		dynamic_bitset &operator|=( dynamic_bitset const &rhs ) {
+			check_same_size( rhs );
+			bitset_impl::apply_words<false>( m_data.data( ),
+			                                 rhs.m_data.data( ),
+			                                 m_data.size( ),
+			                                 bitset_impl::or_op{ } );
+			return *this;
+		}
+
+		dynamic_bitset &operator&=( dynamic_bitset const &rhs ) {
+			check_same_size( rhs );
+			bitset_impl::apply_words<false>( m_data.data( ),
+			                                 rhs.m_data.data( ),
+			                                 m_data.size( ),
+			                                 bitset_impl::and_op{ } );
+			return *this;
+		}
+
+		dynamic_bitset &operator^=( dynamic_bitset const &rhs ) {
+			check_same_size( rhs );
+			bitset_impl::apply_words<false>( m_data.data( ),
+			                                 rhs.m_data.data( ),
+			                                 m_data.size( ),
+			                                 bitset_impl::xor_op{ } );
+			return *this;
+		}
+
+		/// Clear the bits that are set in rhs, *this &= ~rhs without the
+		/// temporary
+		dynamic_bitset &and_not( dynamic_bitset const &rhs ) {
+			check_same_size( rhs );
+			bitset_impl::apply_words<false>( m_data.data( ),
+			                                 rhs.m_data.data( ),
+			                                 m_data.size( ),
+			                                 bitset_impl::and_not_op{ } );
+			return *this;
+		}
+
+		/// *this &= rhs, returning the number of bits set in the result.  This
+		/// saves a second pass over the words when filtering
+		std::size_t and_assign_count( dynamic_bitset const &rhs ) {
+			check_same_size( rhs );
+			return bitset_impl::apply_words<true>( m_data.data( ),
+			                                       rhs.m_data.data( ),
+			                                       m_data.size( ),
+			                                       bitset_impl::and_op{ } );
+		}
+
+		/// *this |= rhs, returning the number of bits set in the result
+		std::size_t or_assign_count( dynamic_bitset const &rhs ) {
+			check_same_size( rhs );
+			return bitset_impl::apply_words<true>( m_data.data( ),
+			                                       rhs.m_data.data( ),
+			                                       m_data.size( ),
+			                                       bitset_impl::or_op{ } );
+		}
+
+		/// The number of bits set in both, ( *this & rhs ).one_count( ) without
+		/// the temporary
+		[[nodiscard]] std::size_t count_and( dynamic_bitset const &rhs ) const {
+			check_same_size( rhs );
+			return bitset_impl::count_words( m_data.data( ),
+			                                 rhs.m_data.data( ),
+			                                 m_data.size( ),
+			                                 bitset_impl::and_op{ } );
+		}
+
+		[[nodiscard]] friend dynamic_bitset operator|( dynamic_bitset lhs,
+		                                               dynamic_bitset const &rhs ) {
+			lhs |= rhs;
+			return lhs;
+		}
+
+		[[nodiscard]] friend dynamic_bitset operator&( dynamic_bitset lhs,
+		                                               dynamic_bitset const &rhs ) {
+			lhs &= rhs;
+			return lhs;
+		}
+
+		[[nodiscard]] friend dynamic_bitset operator^( dynamic_bitset lhs,
+		                                               dynamic_bitset const &rhs ) {
+			lhs ^= rhs;
+			return lhs;
+		}
+
+		[[nodiscard]] dynamic_bitset operator~( ) const {
+			auto result = *this;
+			result.flip( );
+			return result;
+		}
+
+		dynamic_bitset &operator<<=( std::size_t bits ) noexcept {
+			bitset_impl::shift_left( m_data.data( ), m_data.size( ), bits );
+			mask_tail( );
+			return *this;
+		}
+
+		dynamic_bitset &operator>>=( std::size_t bits ) noexcept {
+			bitset_impl::shift_right( m_data.data( ), m_data.size( ), bits );
+			return *this;
+		}
+
+		[[nodiscard]] friend bool operator==( dynamic_bitset const &lhs,
+		                                      dynamic_bitset const &rhs ) noexcept {
+			return lhs.m_size == rhs.m_size and lhs.m_data == rhs.m_data;
+		}
+
+		[[nodiscard]] friend bool operator!=( dynamic_bitset const &lhs,
+		                                      dynamic_bitset const &rhs ) noexcept {
+			return not( lhs == rhs );
+		}
+
+		/// The bits as zeros and ones, highest position first
+		[[nodiscard]] std::string to_string( ) const {
+			auto result = std::string( m_size, '0' );
+			for_each_set_bit( [&]( std::size_t pos ) {
+				result[m_size - 1U - pos] = '1';
+			} );
+			return result;
+		}
+	};
+
+	inline std::string to_string( dynamic_bitset const &bs ) {
+		return bs.to_string( );
+	}
+
+	inline std::ostream &operator<<( std::ostream &os,
+	                                 dynamic_bitset const &bs ) {
+		os << bs.to_string( );
+		return os;
+	}
+} // namespace daw
@@ -12,10 +12,15 @@
 #include "daw_arith_traits.h"
 #include "daw_constant.h"
 #include "daw_cpp_feature_check.h"
+#include "daw_exception.h"
+#include "impl/daw_endian_simd.h"
 
 #include <cstddef>
 #include <cstdint>
 #include <daw/stdinc/enable_if.h>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
 
 namespace daw {
 	enum class endian {
@@ -151,4 +156,105 @@ namespace daw {
 			return to_big_endian( value );
 		}
 	}
+
+	namespace endian_details {
+		template<typename T>
+		DAW_ATTRIB_INLINE void swap_bytes_scalar( T const *src,
+		                                          T *dst,
+		                                          std::size_t count ) noexcept {
+			std::size_t n = 0;
+			for( ; n + 4 <= count; n += 4 ) {
+				T const v0 = src[n];
+				T const v1 = src[n + 1];
+				T const v2 = src[n + 2];
+				T const v3 = src[n + 3];
+				dst[n] = swap_bytes( v0, daw::constant<sizeof( T )>{ } );
+				dst[n + 1] = swap_bytes( v1, daw::constant<sizeof( T )>{ } );
+				dst[n + 2] = swap_bytes( v2, daw::constant<sizeof( T )>{ } );
+				dst[n + 3] = swap_bytes( v3, daw::constant<sizeof( T )>{ } );
+			}
+			for( ; n < count; ++n ) {
+				dst[n] = swap_bytes( src[n], daw::constant<sizeof( T )>{ } );
+			}
+		}
+
+		template<typename T>
+		void swap_bytes_n( T const *src, T *dst, std::size_t count ) noexcept {
+			if constexpr( sizeof( T ) == 1 ) {
+				if( src != dst ) {
+					for( std::size_t n = 0; n < count; ++n ) {
+						dst[n] = src[n];
+					}
+				}
+			} else if constexpr( simd_width == 0 ) {
+				swap_bytes_scalar( src, dst, count );
+			} else {
+				// Bring dst up to a vector boundary so that the stores never split a
+				// cache line.  Elements are at least naturally aligned on the
+				// targets with vector support
+				auto const misalign =
+				  reinterpret_cast<std::uintptr_t>( dst ) % simd_width;
+				std::size_t head =
+				  misalign == 0 ? 0 : ( simd_width - misalign ) / sizeof( T );
+				if( head > count ) {
+					head = count;
+				}
+				swap_bytes_scalar( src, dst, head );
+				src += head;
+				dst += head;
+				count -= head;
+				std::size_t const done =
+				  swap_bytes_simd<sizeof( T )>(
+				    reinterpret_cast<unsigned char const *>( src ),
+				    reinterpret_cast<unsigned char *>( dst ),
+				    count * sizeof( T ) ) /
+				  sizeof( T );
+				swap_bytes_scalar( src + done, dst + done, count - done );
+			}
+		}
+
+		template<typename Range>
+		using range_value_t = std::remove_cv_t<
+		  std::remove_pointer_t<decltype( std::data( std::declval<Range &>( ) ) )>>;
+	} // namespace endian_details
+
+	/// Reverse the bytes of each of the count elements starting at first, in
+	/// place
+	template<typename T,
+	         std::enable_if_t<daw::is_integral_v<T>, std::nullptr_t> = nullptr>
+	void swap_bytes( T *first, std::size_t count ) noexcept {
+		endian_details::swap_bytes_n( first, first, count );
+	}
+
+	/// Write the byte swapped values of [src, src + count) to dst and return
+	/// the end of the output.  The ranges must be the same or not overlap
+	template<typename T,
+	         std::enable_if_t<daw::is_integral_v<T>, std::nullptr_t> = nullptr>
+	T *copy_swap_bytes( T const *src, std::size_t count, T *dst ) noexcept {
+		endian_details::swap_bytes_n( src, dst, count );
+		return dst + count;
+	}
+
+	/// Range form of copy_swap_bytes for contiguous ranges such as std::span,
+	/// daw::span, std::vector or arrays.  dst must be at least as large as src
+	template<typename Source, typename Destination>
+	auto copy_swap_bytes( Source const &src, Destination &&dst ) {
+		daw::exception::precondition_check<std::out_of_range>(
+		  std::size( dst ) >= std::size( src ),
+		  "Destination is smaller than source" );
+		return copy_swap_bytes( std::data( src ), std::size( src ),
+		                        std::data( dst ) );
+	}
+
+	/// Convert each element of a contiguous range, in place, from From byte
+	/// order to To byte order.  Nothing is done when they are the same
+	template<endian From, endian To = endian::native, typename Range>
+	void convert_endian( Range &&values ) noexcept {
+		static_assert(
+		  daw::is_integral_v<endian_details::range_value_t<Range>>,
+		  "Only integral elements can be converted" );
+		if constexpr( From != To ) {
+			swap_bytes( std::data( values ), std::size( values ) );
+		}
+	}
 } // namespace daw
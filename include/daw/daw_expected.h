@@ -9,15 +9,20 @@
 #pragma once
 
 #include "ciso646.h"
+#include "daw_check_exceptions.h"
 #include "daw_move.h"
+#include "daw_remove_cvref.h"
 #include "impl/daw_traits_impl.h"
 #include "traits/daw_traits_concepts.h"
 
 #include <daw/stdinc/move_fwd_exch.h>
 #include <exception>
+#include <memory>
+#include <new>
 #include <string>
 #include <system_error>
 #include <type_traits>
+#include <utility>
 #include <variant>
 
 namespace daw::expected_details {
@@ -430,4 +435,1018 @@ namespace daw {
 	expected_from_exception( std::exception_ptr ptr ) {
 		return expected_t<Result>( ptr );
 	}
+
+	/// The tag type for constructing an expected in the error state
+	struct unexpect_t {
+		explicit unexpect_t( ) = default;
+	};
+	inline constexpr unexpect_t unexpect{ };
+
+	/// Wraps an error so that it converts to an expected<T, E> holding that
+	/// error
+	template<typename E>
+	class unexpected {
+		static_assert( std::is_object_v<E> and not std::is_array_v<E> );
+		E m_error;
+
+	public:
+		template<typename Err = E,
+		         std::enable_if_t<
+		           std::is_constructible_v<E, Err> and
+		             not std::is_same_v<daw::remove_cvref_t<Err>, unexpected> and
+		             not std::is_same_v<daw::remove_cvref_t<Err>, std::in_place_t>,
+		           std::nullptr_t> = nullptr>
+		explicit constexpr unexpected( Err &&e ) noexcept(
+		  std::is_nothrow_constructible_v<E, Err> )
+		  : m_error( DAW_FWD( e ) ) {}
+
+		template<typename... Args>
+		explicit constexpr unexpected( std::in_place_t, Args &&...args ) noexcept(
+		  std::is_nothrow_constructible_v<E, Args...> )
+		  : m_error( DAW_FWD( args )... ) {}
+
+		[[nodiscard]] constexpr E &error( ) & noexcept {
+			return m_error;
+		}
+
+		[[nodiscard]] constexpr E const &error( ) const & noexcept {
+			return m_error;
+		}
+
+		[[nodiscard]] constexpr E &&error( ) && noexcept {
+			return std::move( m_error );
+		}
+
+		template<typename E2>
+		[[nodiscard]] friend constexpr bool
+		operator==( unexpected const &lhs, unexpected<E2> const &rhs ) {
+			return lhs.error( ) == rhs.error( );
+		}
+
+		template<typename E2>
+		[[nodiscard]] friend constexpr bool
+		operator!=( unexpected const &lhs, unexpected<E2> const &rhs ) {
+			return not( lhs.error( ) == rhs.error( ) );
+		}
+	};
+
+	template<typename E>
+	unexpected( E ) -> unexpected<E>;
+
+	/// Thrown by expected<T, E>::value( ) when it holds an error
+	template<typename E>
+	class bad_expected_access : public std::exception {
+		E m_error;
+
+	public:
+		explicit bad_expected_access( E e )
+		  : m_error( std::move( e ) ) {}
+
+		[[nodiscard]] char const *what( ) const noexcept override {
+			return "daw::bad_expected_access";
+		}
+
+		[[nodiscard]] E const &error( ) const & noexcept {
+			return m_error;
+		}
+
+		[[nodiscard]] E &&error( ) && noexcept {
+			return std::move( m_error );
+		}
+	};
+
+	template<typename T, typename E>
+	class expected;
+
+	namespace expected_details {
+		template<typename>
+		inline constexpr bool is_expected_v = false;
+
+		template<typename T, typename E>
+		inline constexpr bool is_expected_v<expected<T, E>> = true;
+
+		template<typename>
+		inline constexpr bool is_unexpected_v = false;
+
+		template<typename E>
+		inline constexpr bool is_unexpected_v<unexpected<E>> = true;
+
+		/// Stands in for the value of an expected<void, E>
+		struct void_value {};
+
+		struct copy_tag_t {};
+
+		/// The value and error share storage.  When both are trivially
+		/// destructible so is the storage
+		template<typename T,
+		         typename E,
+		         bool = std::is_trivially_destructible_v<T> and
+		                std::is_trivially_destructible_v<E>>
+		struct expected_storage {
+			union {
+				T m_value;
+				E m_error;
+			};
+			bool m_has_value;
+
+			template<typename... Args>
+			explicit constexpr expected_storage( std::in_place_t, Args &&...args )
+			  : m_value( DAW_FWD( args )... )
+			  , m_has_value( true ) {}
+
+			template<typename... Args>
+			explicit constexpr expected_storage( unexpect_t, Args &&...args )
+			  : m_error( DAW_FWD( args )... )
+			  , m_has_value( false ) {}
+
+			/// Copy or move the active member of another storage.  Needed when T
+			/// or E is trivially destructible but not trivially copyable, e.g.
+			/// std::pair
+			template<typename Storage>
+			expected_storage( copy_tag_t, Storage &&other )
+			  : m_has_value( other.m_has_value ) {
+				if( m_has_value ) {
+					::new( std::addressof( m_value ) ) T( DAW_FWD( other ).m_value );
+				} else {
+					::new( std::addressof( m_error ) ) E( DAW_FWD( other ).m_error );
+				}
+			}
+
+			constexpr void destroy( ) noexcept {}
+		};
+
+		template<typename T, typename E>
+		struct expected_storage<T, E, false> {
+			union {
+				T m_value;
+				E m_error;
+			};
+			bool m_has_value;
+
+			template<typename... Args>
+			explicit constexpr expected_storage( std::in_place_t, Args &&...args )
+			  : m_value( DAW_FWD( args )... )
+			  , m_has_value( true ) {}
+
+			template<typename... Args>
+			explicit constexpr expected_storage( unexpect_t, Args &&...args )
+			  : m_error( DAW_FWD( args )... )
+			  , m_has_value( false ) {}
+
+			/// Copy or move the active member of another storage
+			template<typename Storage>
+			expected_storage( copy_tag_t, Storage &&other )
+			  : m_has_value( other.m_has_value ) {
+				if( m_has_value ) {
+					::new( std::addressof( m_value ) ) T( DAW_FWD( other ).m_value );
+				} else {
+					::new( std::addressof( m_error ) ) E( DAW_FWD( other ).m_error );
+				}
+			}
+
+			expected_storage( expected_storage const & ) = default;
+			expected_storage( expected_storage && ) = default;
+			expected_storage &operator=( expected_storage const & ) = default;
+			expected_storage &operator=( expected_storage && ) = default;
+
+			~expected_storage( ) {
+				destroy( );
+			}
+
+			void destroy( ) noexcept {
+				if( m_has_value ) {
+					m_value.~T( );
+				} else {
+					m_error.~E( );
+				}
+			}
+		};
+
+		/// When T and E are trivially copyable the defaulted members are used
+		/// and expected is trivially copyable too.  Otherwise the active member
+		/// is copied explicitly
+		template<typename T,
+		         typename E,
+		         bool = std::is_trivially_copyable_v<T> and
+		                std::is_trivially_copyable_v<E>>
+		struct expected_copy : expected_storage<T, E> {
+			using expected_storage<T, E>::expected_storage;
+		};
+
+		template<typename T, typename E>
+		struct expected_copy<T, E, false> : expected_storage<T, E> {
+			using base_t = expected_storage<T, E>;
+			using base_t::base_t;
+
+			expected_copy( expected_copy const &other ) noexcept(
+			  std::is_nothrow_copy_constructible_v<T>
+			    and std::is_nothrow_copy_constructible_v<E> )
+			  : base_t( copy_tag_t{ }, other ) {}
+
+			expected_copy( expected_copy &&other ) noexcept(
+			  std::is_nothrow_move_constructible_v<T>
+			    and std::is_nothrow_move_constructible_v<E> )
+			  : base_t( copy_tag_t{ }, std::move( other ) ) {}
+
+			expected_copy &operator=( expected_copy const &rhs ) {
+				if( this != &rhs ) {
+					assign( rhs );
+				}
+				return *this;
+			}
+
+			expected_copy &operator=( expected_copy &&rhs ) noexcept(
+			  std::is_nothrow_move_constructible_v<T> and
+			  std::is_nothrow_move_assignable_v<T> and
+			  std::is_nothrow_move_constructible_v<E> and
+			  std::is_nothrow_move_assignable_v<E> ) {
+				if( this != &rhs ) {
+					assign( std::move( rhs ) );
+				}
+				return *this;
+			}
+
+			~expected_copy( ) = default;
+
+		private:
+			/// When the states differ the new member is built in a temporary
+			/// first, so a throwing copy leaves *this unchanged
+			template<typename Other>
+			void assign( Other &&rhs ) {
+				if( this->m_has_value and rhs.m_has_value ) {
+					this->m_value = DAW_FWD( rhs ).m_value;
+				} else if( not this->m_has_value and not rhs.m_has_value ) {
+					this->m_error = DAW_FWD( rhs ).m_error;
+				} else if( rhs.m_has_value ) {
+					auto tmp = T( DAW_FWD( rhs ).m_value );
+					this->destroy( );
+					::new( std::addressof( this->m_value ) ) T( std::move( tmp ) );
+					this->m_has_value = true;
+				} else {
+					auto tmp = E( DAW_FWD( rhs ).m_error );
+					this->destroy( );
+					::new( std::addressof( this->m_error ) ) E( std::move( tmp ) );
+					this->m_has_value = false;
+				}
+			}
+		};
+
+		/// Replace the contents of s with a T made from args.  When that can
+		/// throw it is made in a temporary first, so s is unchanged on failure
+		template<typename T, typename E, typename... Args>
+		T &emplace_value( expected_storage<T, E> &s, Args &&...args ) {
+			if constexpr( std::is_nothrow_constructible_v<T, Args...> ) {
+				s.destroy( );
+				::new( std::addressof( s.m_value ) ) T( DAW_FWD( args )... );
+			} else {
+				auto tmp = T( DAW_FWD( args )... );
+				s.destroy( );
+				::new( std::addressof( s.m_value ) ) T( std::move( tmp ) );
+			}
+			s.m_has_value = true;
+			return s.m_value;
+		}
+
+		template<typename T, typename E>
+		inline constexpr bool is_nothrow_swappable_v =
+		  std::is_nothrow_move_constructible_v<T> and
+		  std::is_nothrow_swappable_v<T> and
+		  std::is_nothrow_move_constructible_v<E> and
+		  std::is_nothrow_swappable_v<E>;
+
+		/// Exchange the value of with_value and the error of with_error.  The
+		/// member that cannot throw when moved is set aside first, so that a
+		/// throwing move of the other leaves both unchanged
+		template<typename T, typename E>
+		void swap_value_error( expected_storage<T, E> &with_value,
+		                       expected_storage<T, E> &with_error ) {
+			static_assert( std::is_nothrow_move_constructible_v<T> or
+			                 std::is_nothrow_move_constructible_v<E>,
+			               "swap requires T or E to be nothrow move constructible" );
+			if constexpr( std::is_nothrow_move_constructible_v<E> ) {
+				auto tmp = E( std::move( with_error.m_error ) );
+				with_error.m_error.~E( );
+#if defined( DAW_USE_EXCEPTIONS )
+				try {
+					::new( std::addressof( with_error.m_value ) )
+					  T( std::move( with_value.m_value ) );
+				} catch( ... ) {
+					::new( std::addressof( with_error.m_error ) ) E( std::move( tmp ) );
+					throw;
+				}
+#else
+				::new( std::addressof( with_error.m_value ) )
+				  T( std::move( with_value.m_value ) );
+#endif
+				with_value.m_value.~T( );
+				::new( std::addressof( with_value.m_error ) ) E( std::move( tmp ) );
+			} else {
+				auto tmp = T( std::move( with_value.m_value ) );
+				with_value.m_value.~T( );
+#if defined( DAW_USE_EXCEPTIONS )
+				try {
+					::new( std::addressof( with_value.m_error ) )
+					  E( std::move( with_error.m_error ) );
+				} catch( ... ) {
+					::new( std::addressof( with_value.m_value ) ) T( std::move( tmp ) );
+					throw;
+				}
+#else
+				::new( std::addressof( with_value.m_error ) )
+				  E( std::move( with_error.m_error ) );
+#endif
+				with_error.m_error.~E( );
+				::new( std::addressof( with_error.m_value ) ) T( std::move( tmp ) );
+			}
+			with_value.m_has_value = false;
+			with_error.m_has_value = true;
+		}
+
+		template<typename T, typename E>
+		void swap_storage( expected_storage<T, E> &lhs,
+		                   expected_storage<T, E> &rhs ) {
+			using std::swap;
+			if( lhs.m_has_value and rhs.m_has_value ) {
+				swap( lhs.m_value, rhs.m_value );
+			} else if( not lhs.m_has_value and not rhs.m_has_value ) {
+				swap( lhs.m_error, rhs.m_error );
+			} else if( lhs.m_has_value ) {
+				swap_value_error( lhs, rhs );
+			} else {
+				swap_value_error( rhs, lhs );
+			}
+		}
+
+		/// Whether expected<T, E> can be made from an expected<U, G> whose
+		/// members are passed as UF and GF.  T must not be constructible from
+		/// the expected itself, or the value constructor would be ambiguous
+		template<typename T,
+		         typename E,
+		         typename U,
+		         typename G,
+		         typename UF,
+		         typename GF>
+		inline constexpr bool is_converting_v =
+		  not( std::is_same_v<T, U> and std::is_same_v<E, G> ) and
+		  std::is_constructible_v<T, UF> and std::is_constructible_v<E, GF> and
+		  not std::is_constructible_v<T, expected<U, G> &> and
+		  not std::is_constructible_v<T, expected<U, G> const &> and
+		  not std::is_constructible_v<T, expected<U, G> &&>;
+
+		/// The conversion is implicit only when both members convert implicitly
+		template<typename T, typename E, typename UF, typename GF>
+		inline constexpr bool is_implicit_v =
+		  std::is_convertible_v<UF, T> and std::is_convertible_v<GF, E>;
+
+		/// Removes the copy operations of expected when T or E cannot be copied
+		template<bool CanCopy>
+		struct copy_enabler {};
+
+		template<>
+		struct copy_enabler<false> {
+			copy_enabler( ) = default;
+			copy_enabler( copy_enabler const & ) = delete;
+			copy_enabler( copy_enabler && ) = default;
+			copy_enabler &operator=( copy_enabler const & ) = delete;
+			copy_enabler &operator=( copy_enabler && ) = default;
+			~copy_enabler( ) = default;
+		};
+
+		/// The monadic operations, shared by expected<T, E> and
+		/// expected<void, E>.  Self is a possibly const expected lvalue or
+		/// rvalue.  f is called directly as std::invoke isn't constexpr in C++17
+		template<typename Self, typename F>
+		constexpr auto and_then( Self &&self, F &&f ) {
+			using self_t = daw::remove_cvref_t<Self>;
+			using error_t = typename self_t::error_type;
+			if constexpr( std::is_void_v<typename self_t::value_type> ) {
+				using result_t = daw::remove_cvref_t<std::invoke_result_t<F>>;
+				static_assert( is_expected_v<result_t>,
+				               "and_then must return an expected" );
+				static_assert(
+				  std::is_same_v<typename result_t::error_type, error_t>,
+				  "and_then must return an expected with the same error type" );
+				if( self.has_value( ) ) {
+					return DAW_FWD( f )( );
+				}
+				return result_t( unexpect, DAW_FWD( self ).error( ) );
+			} else {
+				using result_t = daw::remove_cvref_t<
+				  std::invoke_result_t<F, decltype( *DAW_FWD( self ) )>>;
+				static_assert( is_expected_v<result_t>,
+				               "and_then must return an expected" );
+				static_assert(
+				  std::is_same_v<typename result_t::error_type, error_t>,
+				  "and_then must return an expected with the same error type" );
+				if( self.has_value( ) ) {
+					return DAW_FWD( f )( *DAW_FWD( self ) );
+				}
+				return result_t( unexpect, DAW_FWD( self ).error( ) );
+			}
+		}
+
+		template<typename Self, typename F>
+		constexpr auto transform( Self &&self, F &&f ) {
+			using self_t = daw::remove_cvref_t<Self>;
+			using error_t = typename self_t::error_type;
+			if constexpr( std::is_void_v<typename self_t::value_type> ) {
+				using value_t = std::remove_cv_t<std::invoke_result_t<F>>;
+				using result_t = expected<value_t, error_t>;
+				if( not self.has_value( ) ) {
+					return result_t( unexpect, DAW_FWD( self ).error( ) );
+				}
+				if constexpr( std::is_void_v<value_t> ) {
+					DAW_FWD( f )( );
+					return result_t( );
+				} else {
+					return result_t( std::in_place, DAW_FWD( f )( ) );
+				}
+			} else {
+				using value_t = std::remove_cv_t<
+				  std::invoke_result_t<F, decltype( *DAW_FWD( self ) )>>;
+				using result_t = expected<value_t, error_t>;
+				if( not self.has_value( ) ) {
+					return result_t( unexpect, DAW_FWD( self ).error( ) );
+				}
+				if constexpr( std::is_void_v<value_t> ) {
+					DAW_FWD( f )( *DAW_FWD( self ) );
+					return result_t( );
+				} else {
+					return result_t( std::in_place,
+					                 DAW_FWD( f )( *DAW_FWD( self ) ) );
+				}
+			}
+		}
+
+		template<typename Self, typename F>
+		constexpr auto or_else( Self &&self, F &&f ) {
+			using self_t = daw::remove_cvref_t<Self>;
+			using value_t = typename self_t::value_type;
+			using result_t = daw::remove_cvref_t<
+			  std::invoke_result_t<F, decltype( DAW_FWD( self ).error( ) )>>;
+			static_assert( is_expected_v<result_t>,
+			               "or_else must return an expected" );
+			static_assert(
+			  std::is_same_v<typename result_t::value_type, value_t>,
+			  "or_else must return an expected with the same value type" );
+			if( not self.has_value( ) ) {
+				return DAW_FWD( f )( DAW_FWD( self ).error( ) );
+			}
+			if constexpr( std::is_void_v<value_t> ) {
+				return result_t( );
+			} else {
+				return result_t( std::in_place, *DAW_FWD( self ) );
+			}
+		}
+
+		template<typename Self, typename F>
+		constexpr auto transform_error( Self &&self, F &&f ) {
+			using self_t = daw::remove_cvref_t<Self>;
+			using value_t = typename self_t::value_type;
+			using error_t = std::remove_cv_t<
+			  std::invoke_result_t<F, decltype( DAW_FWD( self ).error( ) )>>;
+			using result_t = expected<value_t, error_t>;
+			if( not self.has_value( ) ) {
+				return result_t( unexpect,
+				                 DAW_FWD( f )( DAW_FWD( self ).error( ) ) );
+			}
+			if constexpr( std::is_void_v<value_t> ) {
+				return result_t( );
+			} else {
+				return result_t( std::in_place, *DAW_FWD( self ) );
+			}
+		}
+	} // namespace expected_details
+
+	/// Holds either a T or an error of type E.  Unlike expected_t, the error
+	/// is a plain value: reporting one does not allocate or touch the exception
+	/// machinery, and when T and E are trivially copyable so is the expected.
+	/// This is the type to return from code that fails often, like parsers.
+	template<typename T, typename E>
+	class expected
+	  : private expected_details::expected_copy<T, E>
+	  , private expected_details::copy_enabler<
+	      std::is_copy_constructible_v<T> and std::is_copy_constructible_v<E>> {
+		static_assert( std::is_object_v<T> and not std::is_array_v<T> );
+		static_assert( std::is_object_v<E> and not std::is_array_v<E> );
+		static_assert( not std::is_same_v<std::remove_cv_t<T>, unexpect_t> and
+		               not std::is_same_v<std::remove_cv_t<T>, std::in_place_t> and
+		               not expected_details::is_unexpected_v<std::remove_cv_t<T>> );
+
+		using base_t = expected_details::expected_copy<T, E>;
+
+		template<typename, typename>
+		friend class expected;
+
+		[[nodiscard]] constexpr base_t const &storage( ) const & noexcept {
+			return *this;
+		}
+
+		[[nodiscard]] constexpr base_t &&storage( ) && noexcept {
+			return std::move( *this );
+		}
+
+	public:
+		using value_type = T;
+		using error_type = E;
+		using unexpected_type = unexpected<E>;
+
+		template<typename U>
+		using rebind = expected<U, error_type>;
+
+		/// A value initialized T
+		template<typename U = T,
+		         std::enable_if_t<std::is_default_constructible_v<U>,
+		                          std::nullptr_t> = nullptr>
+		constexpr expected( ) noexcept( std::is_nothrow_default_constructible_v<T> )
+		  : base_t( std::in_place ) {}
+
+		template<
+		  typename U = T,
+		  std::enable_if_t<
+		    std::is_constructible_v<T, U> and
+		      not std::is_same_v<daw::remove_cvref_t<U>, expected> and
+		      not std::is_same_v<daw::remove_cvref_t<U>, std::in_place_t> and
+		      not std::is_same_v<daw::remove_cvref_t<U>, unexpect_t> and
+		      not expected_details::is_unexpected_v<daw::remove_cvref_t<U>>,
+		    std::nullptr_t> = nullptr>
+		constexpr expected( U &&value ) noexcept(
+		  std::is_nothrow_constructible_v<T, U> )
+		  : base_t( std::in_place, DAW_FWD( value ) ) {}
+
+		template<typename... Args>
+		explicit constexpr expected( std::in_place_t, Args &&...args ) noexcept(
+		  std::is_nothrow_constructible_v<T, Args...> )
+		  : base_t( std::in_place, DAW_FWD( args )... ) {}
+
+		template<typename... Args>
+		explicit constexpr expected( unexpect_t, Args &&...args ) noexcept(
+		  std::is_nothrow_constructible_v<E, Args...> )
+		  : base_t( unexpect, DAW_FWD( args )... ) {}
+
+		template<typename G,
+		         std::enable_if_t<std::is_constructible_v<E, G const &>,
+		                          std::nullptr_t> = nullptr>
+		constexpr expected( unexpected<G> const &e ) noexcept(
+		  std::is_nothrow_constructible_v<E, G const &> )
+		  : base_t( unexpect, e.error( ) ) {}
+
+		template<typename G,
+		         std::enable_if_t<std::is_constructible_v<E, G>, std::nullptr_t> =
+		           nullptr>
+		constexpr expected( unexpected<G> &&e ) noexcept(
+		  std::is_nothrow_constructible_v<E, G> )
+		  : base_t( unexpect, std::move( e ).error( ) ) {}
+
+		/// Converts the value or error of an expected<U, G>.  Explicit unless
+		/// both convert implicitly
+		template<
+		  typename U,
+		  typename G,
+		  std::enable_if_t<
+		    expected_details::is_converting_v<T, E, U, G, U const &, G const &> and
+		      expected_details::is_implicit_v<T, E, U const &, G const &>,
+		    std::nullptr_t> = nullptr>
+		expected( expected<U, G> const &other )
+		  : base_t( expected_details::copy_tag_t{ }, other.storage( ) ) {}
+
+		template<
+		  typename U,
+		  typename G,
+		  std::enable_if_t<
+		    expected_details::is_converting_v<T, E, U, G, U const &, G const &> and
+		      not expected_details::is_implicit_v<T, E, U const &, G const &>,
+		    std::nullptr_t> = nullptr>
+		explicit expected( expected<U, G> const &other )
+		  : base_t( expected_details::copy_tag_t{ }, other.storage( ) ) {}
+
+		template<
+		  typename U,
+		  typename G,
+		  std::enable_if_t<expected_details::is_converting_v<T, E, U, G, U, G> and
+		                     expected_details::is_implicit_v<T, E, U, G>,
+		                   std::nullptr_t> = nullptr>
+		expected( expected<U, G> &&other )
+		  : base_t( expected_details::copy_tag_t{ },
+		            std::move( other ).storage( ) ) {}
+
+		template<
+		  typename U,
+		  typename G,
+		  std::enable_if_t<expected_details::is_converting_v<T, E, U, G, U, G> and
+		                     not expected_details::is_implicit_v<T, E, U, G>,
+		                   std::nullptr_t> = nullptr>
+		explicit expected( expected<U, G> &&other )
+		  : base_t( expected_details::copy_tag_t{ },
+		            std::move( other ).storage( ) ) {}
+
+		/// Replaces the value or error with a T made from args
+		template<typename... Args,
+		         std::enable_if_t<std::is_constructible_v<T, Args...>,
+		                          std::nullptr_t> = nullptr>
+		T &emplace( Args &&...args ) noexcept(
+		  std::is_nothrow_constructible_v<T, Args...> ) {
+			return expected_details::emplace_value<T, E>( *this, DAW_FWD( args )... );
+		}
+
+		void swap( expected &other ) noexcept(
+		  expected_details::is_nothrow_swappable_v<T, E> ) {
+			expected_details::swap_storage<T, E>( *this, other );
+		}
+
+		friend void swap( expected &lhs, expected &rhs ) noexcept(
+		  noexcept( lhs.swap( rhs ) ) ) {
+			lhs.swap( rhs );
+		}
+
+		[[nodiscard]] constexpr bool has_value( ) const noexcept {
+			return this->m_has_value;
+		}
+
+		explicit constexpr operator bool( ) const noexcept {
+			return this->m_has_value;
+		}
+
+		/// Unchecked access to the value
+		[[nodiscard]] constexpr T &operator*( ) & noexcept {
+			return this->m_value;
+		}
+
+		[[nodiscard]] constexpr T const &operator*( ) const & noexcept {
+			return this->m_value;
+		}
+
+		[[nodiscard]] constexpr T &&operator*( ) && noexcept {
+			return std::move( this->m_value );
+		}
+
+		[[nodiscard]] constexpr T *operator->( ) noexcept {
+			return std::addressof( this->m_value );
+		}
+
+		[[nodiscard]] constexpr T const *operator->( ) const noexcept {
+			return std::addressof( this->m_value );
+		}
+
+		/// Checked access to the value, throwing bad_expected_access<E> when
+		/// there is an error
+		[[nodiscard]] constexpr T &value( ) & {
+			if( not this->m_has_value ) {
+				DAW_THROW_OR_TERMINATE( bad_expected_access<E>, this->m_error );
+			}
+			return this->m_value;
+		}
+
+		[[nodiscard]] constexpr T const &value( ) const & {
+			if( not this->m_has_value ) {
+				DAW_THROW_OR_TERMINATE( bad_expected_access<E>, this->m_error );
+			}
+			return this->m_value;
+		}
+
+		[[nodiscard]] constexpr T &&value( ) && {
+			if( not this->m_has_value ) {
+				DAW_THROW_OR_TERMINATE( bad_expected_access<E>,
+				                        std::move( this->m_error ) );
+			}
+			return std::move( this->m_value );
+		}
+
+		/// Unchecked access to the error
+		[[nodiscard]] constexpr E &error( ) & noexcept {
+			return this->m_error;
+		}
+
+		[[nodiscard]] constexpr E const &error( ) const & noexcept {
+			return this->m_error;
+		}
+
+		[[nodiscard]] constexpr E &&error( ) && noexcept {
+			return std::move( this->m_error );
+		}
+
+		template<typename U>
+		[[nodiscard]] constexpr T value_or( U &&default_value ) const & {
+			if( this->m_has_value ) {
+				return this->m_value;
+			}
+			return static_cast<T>( DAW_FWD( default_value ) );
+		}
+
+		template<typename U>
+		[[nodiscard]] constexpr T value_or( U &&default_value ) && {
+			if( this->m_has_value ) {
+				return std::move( this->m_value );
+			}
+			return static_cast<T>( DAW_FWD( default_value ) );
+		}
+
+		/// f( value ) -> expected<U, E>, called only when there is a value
+		template<typename F>
+		constexpr auto and_then( F &&f ) & {
+			return expected_details::and_then( *this, DAW_FWD( f ) );
+		}
+
+		template<typename F>
+		constexpr auto and_then( F &&f ) const & {
+			return expected_details::and_then( *this, DAW_FWD( f ) );
+		}
+
+		template<typename F>
+		constexpr auto and_then( F &&f ) && {
+			return expected_details::and_then( std::move( *this ), DAW_FWD( f ) );
+		}
+
+		/// f( value ) -> U, giving an expected<U, E>
+		template<typename F>
+		constexpr auto transform( F &&f ) & {
+			return expected_details::transform( *this, DAW_FWD( f ) );
+		}
+
+		template<typename F>
+		constexpr auto transform( F &&f ) const & {
+			return expected_details::transform( *this, DAW_FWD( f ) );
+		}
+
+		template<typename F>
+		constexpr auto transform( F &&f ) && {
+			return expected_details::transform( std::move( *this ), DAW_FWD( f ) );
+		}
+
+		/// f( error ) -> expected<T, G>, called only when there is an error
+		template<typename F>
+		constexpr auto or_else( F &&f ) & {
+			return expected_details::or_else( *this, DAW_FWD( f ) );
+		}
+
+		template<typename F>
+		constexpr auto or_else( F &&f ) const & {
+			return expected_details::or_else( *this, DAW_FWD( f ) );
+		}
+
+		template<typename F>
+		constexpr auto or_else( F &&f ) && {
+			return expected_details::or_else( std::move( *this ), DAW_FWD( f ) );
+		}
+
+		/// f( error ) -> G, giving an expected<T, G>
+		template<typename F>
+		constexpr auto transform_error( F &&f ) & {
+			return expected_details::transform_error( *this, DAW_FWD( f ) );
+		}
+
+		template<typename F>
+		constexpr auto transform_error( F &&f ) const & {
+			return expected_details::transform_error( *this, DAW_FWD( f ) );
+		}
+
+		template<typename F>
+		constexpr auto transform_error( F &&f ) && {
+			return expected_details::transform_error( std::move( *this ),
+			                                          DAW_FWD( f ) );
+		}
+
+		template<typename T2, typename E2>
+		[[nodiscard]] friend constexpr bool
+		operator==( expected const &lhs, expected<T2, E2> const &rhs ) {
+			if( lhs.has_value( ) != rhs.has_value( ) ) {
+				return false;
+			}
+			if( lhs.has_value( ) ) {
+				return *lhs == *rhs;
+			}
+			return lhs.error( ) == rhs.error( );
+		}
+
+		template<typename T2, typename E2>
+		[[nodiscard]] friend constexpr bool
+		operator!=( expected const &lhs, expected<T2, E2> const &rhs ) {
+			return not( lhs == rhs );
+		}
+
+		template<typename E2>
+		[[nodiscard]] friend constexpr bool
+		operator==( expected const &lhs, unexpected<E2> const &rhs ) {
+			return not lhs.has_value( ) and lhs.error( ) == rhs.error( );
+		}
+
+		template<typename E2>
+		[[nodiscard]] friend constexpr bool
+		operator!=( expected const &lhs, unexpected<E2> const &rhs ) {
+			return not( lhs == rhs );
+		}
+	};
+
+	/// An expected with no value, only success or an error
+	template<typename E>
+	class expected<void, E>
+	  : private expected_details::expected_copy<expected_details::void_value, E>
+	  , private expected_details::copy_enabler<std::is_copy_constructible_v<E>> {
+		static_assert( std::is_object_v<E> and not std::is_array_v<E> );
+
+		using base_t =
+		  expected_details::expected_copy<expected_details::void_value, E>;
+
+		template<typename, typename>
+		friend class expected;
+
+		[[nodiscard]] constexpr base_t const &storage( ) const & noexcept {
+			return *this;
+		}
+
+		[[nodiscard]] constexpr base_t &&storage( ) && noexcept {
+			return std::move( *this );
+		}
+
+	public:
+		using value_type = void;
+		using error_type = E;
+		using unexpected_type = unexpected<E>;
+
+		template<typename U>
+		using rebind = expected<U, error_type>;
+
+		/// Success
+		constexpr expected( ) noexcept
+		  : base_t( std::in_place ) {}
+
+		explicit constexpr expected( std::in_place_t ) noexcept
+		  : base_t( std::in_place ) {}
+
+		template<typename... Args>
+		explicit constexpr expected( unexpect_t, Args &&...args ) noexcept(
+		  std::is_nothrow_constructible_v<E, Args...> )
+		  : base_t( unexpect, DAW_FWD( args )... ) {}
+
+		template<typename G,
+		         std::enable_if_t<std::is_constructible_v<E, G const &>,
+		                          std::nullptr_t> = nullptr>
+		constexpr expected( unexpected<G> const &e ) noexcept(
+		  std::is_nothrow_constructible_v<E, G const &> )
+		  : base_t( unexpect, e.error( ) ) {}
+
+		template<typename G,
+		         std::enable_if_t<std::is_constructible_v<E, G>, std::nullptr_t> =
+		           nullptr>
+		constexpr expected( unexpected<G> &&e ) noexcept(
+		  std::is_nothrow_constructible_v<E, G> )
+		  : base_t( unexpect, std::move( e ).error( ) ) {}
+
+		/// Converts the error of an expected<void, G>.  Explicit unless it
+		/// converts implicitly
+		template<typename G,
+		         std::enable_if_t<not std::is_same_v<E, G> and
+		                            std::is_convertible_v<G const &, E>,
+		                          std::nullptr_t> = nullptr>
+		expected( expected<void, G> const &other )
+		  : base_t( expected_details::copy_tag_t{ }, other.storage( ) ) {}
+
+		template<typename G,
+		         std::enable_if_t<not std::is_same_v<E, G> and
+		                            std::is_constructible_v<E, G const &> and
+		                            not std::is_convertible_v<G const &, E>,
+		                          std::nullptr_t> = nullptr>
+		explicit expected( expected<void, G> const &other )
+		  : base_t( expected_details::copy_tag_t{ }, other.storage( ) ) {}
+
+		template<typename G,
+		         std::enable_if_t<not std::is_same_v<E, G> and
+		                            std::is_convertible_v<G, E>,
+		                          std::nullptr_t> = nullptr>
+		expected( expected<void, G> &&other )
+		  : base_t( expected_details::copy_tag_t{ },
+		            std::move( other ).storage( ) ) {}
+
+		template<typename G,
+		         std::enable_if_t<not std::is_same_v<E, G> and
+		                            std::is_constructible_v<E, G> and
+		                            not std::is_convertible_v<G, E>,
+		                          std::nullptr_t> = nullptr>
+		explicit expected( expected<void, G> &&other )
+		  : base_t( expected_details::copy_tag_t{ },
+		            std::move( other ).storage( ) ) {}
+
+		/// Destroys the error, if any, leaving success
+		void emplace( ) noexcept {
+			(void)expected_details::emplace_value<expected_details::void_value, E>(
+			  *this );
+		}
+
+		void swap( expected &other ) noexcept(
+		  expected_details::is_nothrow_swappable_v<expected_details::void_value,
+		                                           E> ) {
+			expected_details::swap_storage<expected_details::void_value, E>( *this,
+			                                                                 other );
+		}
+
+		friend void swap( expected &lhs, expected &rhs ) noexcept(
+		  noexcept( lhs.swap( rhs ) ) ) {
+			lhs.swap( rhs );
+		}
+
+		[[nodiscard]] constexpr bool has_value( ) const noexcept {
+			return this->m_has_value;
+		}
+
+		explicit constexpr operator bool( ) const noexcept {
+			return this->m_has_value;
+		}
+
+		constexpr void operator*( ) const noexcept {}
+
+		/// Throws bad_expected_access<E> when there is an error
+		constexpr void value( ) const & {
+			if( not this->m_has_value ) {
+				DAW_THROW_OR_TERMINATE( bad_expected_access<E>, this->m_error );
+			}
+		}
+
+		constexpr void value( ) && {
+			if( not this->m_has_value ) {
+				DAW_THROW_OR_TERMINATE( bad_expected_access<E>,
+				                        std::move( this->m_error ) );
+			}
+		}
+
+		/// Unchecked access to the error
+		[[nodiscard]] constexpr E &error( ) & noexcept {
+			return this->m_error;
+		}
+
+		[[nodiscard]] constexpr E const &error( ) const & noexcept {
+			return this->m_error;
+		}
+
+		[[nodiscard]] constexpr E &&error( ) && noexcept {
+			return std::move( this->m_error );
+		}
+
+		template<typename F>
+		constexpr auto and_then( F &&f ) const & {
+			return expected_details::and_then( *this, DAW_FWD( f ) );
+		}
+
+		template<typename F>
+		constexpr auto and_then( F &&f ) && {
+			return expected_details::and_then( std::move( *this ), DAW_FWD( f ) );
+		}
+
+		template<typename F>
+		constexpr auto transform( F &&f ) const & {
+			return expected_details::transform( *this, DAW_FWD( f ) );
+		}
+
+		template<typename F>
+		constexpr auto transform( F &&f ) && {
+			return expected_details::transform( std::move( *this ), DAW_FWD( f ) );
+		}
+
+		template<typename F>
+		constexpr auto or_else( F &&f ) const & {
+			return expected_details::or_else( *this, DAW_FWD( f ) );
+		}
+
+		template<typename F>
+		constexpr auto or_else( F &&f ) && {
+			return expected_details::or_else( std::move( *this ), DAW_FWD( f ) );
+		}
+
+		template<typename F>
+		constexpr auto transform_error( F &&f ) const & {
+			return expected_details::transform_error( *this, DAW_FWD( f ) );
+		}
+
+		template<typename F>
+		constexpr auto transform_error( F &&f ) && {
+			return expected_details::transform_error( std::move( *this ),
+			                                          DAW_FWD( f ) );
+		}
+
+		template<typename E2>
+		[[nodiscard]] friend constexpr bool
+		operator==( expected const &lhs, expected<void, E2> const &rhs ) {
+			if( lhs.has_value( ) != rhs.has_value( ) ) {
+				return false;
+			}
+			return lhs.has_value( ) or lhs.error( ) == rhs.error( );
+		}
+
+		template<typename E2>
+		[[nodiscard]] friend constexpr bool
+		operator!=( expected const &lhs, expected<void, E2> const &rhs ) {
+			return not( lhs == rhs );
+		}
+
+		template<typename E2>
+		[[nodiscard]] friend constexpr bool
+		operator==( expected const &lhs, unexpected<E2> const &rhs ) {
+			return not lhs.has_value( ) and lhs.error( ) == rhs.error( );
+		}
+
+		template<typename E2>
+		[[nodiscard]] friend constexpr bool
+		operator!=( expected const &lhs, unexpected<E2> const &rhs ) {
+			return not( lhs == rhs );
+		}
+	};
 } // namespace daw
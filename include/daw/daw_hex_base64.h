@@ -0,0 +1,374 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw/ciso646.h"
+#include "daw/daw_attributes.h"
+#include "daw/daw_exception.h"
+#include "daw/impl/daw_hex_base64_simd.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+/// Hex and base64 (RFC 4648) encoding and decoding between contiguous
+/// ranges of bytes and characters.  Vector kernels are used when the target
+/// has them and the scalar code finishes the tails and handles the rest.
+/// Decoders report the position of the first character that is not valid
+namespace daw::encoding {
+	struct decode_result {
+		/// Characters consumed.  When not valid, the position of the first
+		/// invalid character
+		std::size_t read = 0;
+		/// Bytes written
+		std::size_t written = 0;
+		bool is_valid = true;
+	};
+
+	enum class hex_case { lower, upper };
+
+	/// The standard alphabet uses '+' and '/' and is padded with '='.  The
+	/// URL and filename safe alphabet uses '-' and '_' and is not padded
+	enum class base64_alphabet { standard, url };
+} // namespace daw::encoding
+
+namespace daw::encoding_impl {
+	inline constexpr unsigned char invalid_value = 0xFFU;
+
+	template<typename Range>
+	using range_value_t =
+	  std::remove_cv_t<std::remove_reference_t<decltype( *std::data(
+	    std::declval<Range &>( ) ) )>>;
+
+	template<typename Range>
+	inline constexpr bool is_byte_range_v = sizeof( range_value_t<Range> ) == 1;
+
+	template<typename Range>
+	[[nodiscard]] unsigned char const *bytes_of( Range const &r ) noexcept {
+		return reinterpret_cast<unsigned char const *>( std::data( r ) );
+	}
+
+	template<typename Range>
+	[[nodiscard]] char const *chars_of( Range const &r ) noexcept {
+		return reinterpret_cast<char const *>( std::data( r ) );
+	}
+
+	[[nodiscard]] constexpr unsigned char hex_value( char c ) noexcept {
+		if( '0' <= c and c <= '9' ) {
+			return static_cast<unsigned char>( c - '0' );
+		}
+		if( 'a' <= c and c <= 'f' ) {
+			return static_cast<unsigned char>( c - 'a' + 10 );
+		}
+		if( 'A' <= c and c <= 'F' ) {
+			return static_cast<unsigned char>( c - 'A' + 10 );
+		}
+		return invalid_value;
+	}
+
+	template<bool Url>
+	inline constexpr char base64_chars[] =
+	  "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+	template<>
+	inline constexpr char base64_chars<true>[] =
+	  "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+	template<bool Url>
+	inline constexpr std::array<unsigned char, 256> base64_values = [] {
+		auto result = std::array<unsigned char, 256>{ };
+		for( auto &v : result ) {
+			v = invalid_value;
+		}
+		for( unsigned n = 0; n < 64U; ++n ) {
+			result[static_cast<unsigned char>( base64_chars<Url>[n] )] =
+			  static_cast<unsigned char>( n );
+		}
+		return result;
+	}( );
+
+	template<bool Upper>
+	void hex_encode_n( unsigned char const *src, std::size_t count,
+	                   char *dst ) noexcept {
+		constexpr char const *digits =
+		  Upper ? "0123456789ABCDEF" : "0123456789abcdef";
+		std::size_t pos = 0;
+#if defined( DAW_HAS_AVX2 )
+		pos = hex_encode_avx2<Upper>( src, count, dst );
+#endif
+#if defined( DAW_HAS_SSE2 )
+		pos += hex_encode_simd<Upper>( src + pos, count - pos, dst + 2U * pos );
+#endif
+		for( ; pos < count; ++pos ) {
+			dst[2U * pos] = digits[src[pos] >> 4U];
+			dst[2U * pos + 1U] = digits[src[pos] & 0x0FU];
+		}
+	}
+
+	[[nodiscard]] inline encoding::decode_result
+	hex_decode_n( char const *src, std::size_t count, unsigned char *dst ) {
+		std::size_t pos = 0;
+#if defined( DAW_HAS_AVX2 )
+		pos = hex_decode_avx2( src, count, dst );
+#endif
+#if defined( DAW_HAS_SSE2 )
+		pos += hex_decode_simd( src + pos, count - pos, dst + pos / 2U );
+#endif
+		for( ; pos + 2U <= count; pos += 2U ) {
+			auto const hi = hex_value( src[pos] );
+			auto const lo = hex_value( src[pos + 1U] );
+			if( ( hi | lo ) == invalid_value ) {
+				return { hi == invalid_value ? pos : pos + 1U, pos / 2U, false };
+			}
+			dst[pos / 2U] = static_cast<unsigned char>( ( hi << 4U ) | lo );
+		}
+		if( pos != count ) {
+			// A digit without its pair
+			return { pos, pos / 2U, false };
+		}
+		return { count, count / 2U, true };
+	}
+
+	template<bool Url>
+	[[nodiscard]] std::size_t base64_encode_n( unsigned char const *src,
+	                                           std::size_t count, char *dst,
+	                                           bool pad ) noexcept {
+		constexpr char const *chars = base64_chars<Url>;
+		std::size_t pos = base64_encode_simd<Url>( src, count, dst );
+		std::size_t out = pos / 3U * 4U;
+		for( ; pos + 3U <= count; pos += 3U, out += 4U ) {
+			std::uint32_t const v = ( std::uint32_t{ src[pos] } << 16U ) |
+			                        ( std::uint32_t{ src[pos + 1U] } << 8U ) |
+			                        src[pos + 2U];
+			dst[out] = chars[v >> 18U];
+			dst[out + 1U] = chars[( v >> 12U ) & 0x3FU];
+			dst[out + 2U] = chars[( v >> 6U ) & 0x3FU];
+			dst[out + 3U] = chars[v & 0x3FU];
+		}
+		if( pos == count ) {
+			return out;
+		}
+		std::uint32_t v = std::uint32_t{ src[pos] } << 16U;
+		bool const two = pos + 2U == count;
+		if( two ) {
+			v |= std::uint32_t{ src[pos + 1U] } << 8U;
+		}
+		dst[out++] = chars[v >> 18U];
+		dst[out++] = chars[( v >> 12U ) & 0x3FU];
+		if( two ) {
+			dst[out++] = chars[( v >> 6U ) & 0x3FU];
+		}
+		if( pad ) {
+			dst[out++] = '=';
+			if( not two ) {
+				dst[out++] = '=';
+			}
+		}
+		return out;
+	}
+
+	/// count is the number of characters without padding
+	template<bool Url>
+	[[nodiscard]] encoding::decode_result
+	base64_decode_n( char const *src, std::size_t count, unsigned char *dst ) {
+		auto const &values = base64_values<Url>;
+		auto const value_of = [&]( std::size_t n ) {
+			return values[static_cast<unsigned char>( src[n] )];
+		};
+		auto const first_invalid = [&]( std::size_t first, std::size_t last ) {
+			while( first < last and value_of( first ) != invalid_value ) {
+				++first;
+			}
+			return first;
+		};
+		std::size_t pos = base64_decode_simd<Url>( src, count, dst );
+		std::size_t out = pos / 4U * 3U;
+		for( ; pos + 4U <= count; pos += 4U, out += 3U ) {
+			auto const a = value_of( pos );
+			auto const b = value_of( pos + 1U );
+			auto const c = value_of( pos + 2U );
+			auto const d = value_of( pos + 3U );
+			if( ( a | b | c | d ) == invalid_value ) {
+				return { first_invalid( pos, pos + 4U ), out, false };
+			}
+			std::uint32_t const v = ( std::uint32_t{ a } << 18U ) |
+			                        ( std::uint32_t{ b } << 12U ) |
+			                        ( std::uint32_t{ c } << 6U ) | d;
+			dst[out] = static_cast<unsigned char>( v >> 16U );
+			dst[out + 1U] = static_cast<unsigned char>( v >> 8U );
+			dst[out + 2U] = static_cast<unsigned char>( v );
+		}
+		auto const tail = count - pos;
+		if( tail == 0 ) {
+			return { count, out, true };
+		}
+		if( auto const bad = first_invalid( pos, count ); bad != count ) {
+			return { bad, out, false };
+		}
+		if( tail == 1 ) {
+			// Six bits are not a byte
+			return { pos, out, false };
+		}
+		std::uint32_t v = ( std::uint32_t{ value_of( pos ) } << 18U ) |
+		                  ( std::uint32_t{ value_of( pos + 1U ) } << 12U );
+		if( tail == 3 ) {
+			v |= std::uint32_t{ value_of( pos + 2U ) } << 6U;
+		}
+		// The bits after the last byte must be zero for the encoding to be
+		// canonical
+		if( ( v & ( tail == 2 ? 0xFFFFU : 0xFFU ) ) != 0 ) {
+			return { count - 1U, out, false };
+		}
+		dst[out++] = static_cast<unsigned char>( v >> 16U );
+		if( tail == 3 ) {
+			dst[out++] = static_cast<unsigned char>( v >> 8U );
+		}
+		return { count, out, true };
+	}
+} // namespace daw::encoding_impl
+
+namespace daw::encoding {
+	[[nodiscard]] constexpr std::size_t
+	hex_encoded_size( std::size_t bytes ) noexcept {
+		return bytes * 2U;
+	}
+
+	[[nodiscard]] constexpr std::size_t
+	hex_decoded_size( std::size_t chars ) noexcept {
+		return chars / 2U;
+	}
+
+	/// Characters needed to base64 encode bytes
+	[[nodiscard]] constexpr std::size_t base64_encoded_size(
+	  std::size_t bytes,
+	  base64_alphabet alphabet = base64_alphabet::standard ) noexcept {
+		if( alphabet == base64_alphabet::standard ) {
+			return ( bytes + 2U ) / 3U * 4U;
+		}
+		return bytes / 3U * 4U + ( bytes % 3U == 0 ? 0U : bytes % 3U + 1U );
+	}
+
+	/// The most bytes that chars characters of base64 can decode to
+	[[nodiscard]] constexpr std::size_t
+	base64_decoded_size( std::size_t chars ) noexcept {
+		return chars / 4U * 3U + ( chars % 4U == 0 ? 0U : chars % 4U - 1U );
+	}
+
+	/// Write the hex digits of the bytes in src to dst.  Returns the number
+	/// of characters written
+	template<typename Source, typename Destination>
+	std::size_t hex_encode( Source const &src, Destination &&dst,
+	                        hex_case letters = hex_case::lower ) {
+		static_assert( encoding_impl::is_byte_range_v<Source> and
+		                 encoding_impl::is_byte_range_v<Destination>,
+		               "Ranges must be of bytes or chars" );
+		auto const size = hex_encoded_size( std::size( src ) );
+		daw::exception::precondition_check<std::out_of_range>(
+		  std::size( dst ) >= size, "Destination is too small" );
+		auto *const out = reinterpret_cast<char *>( std::data( dst ) );
+		if( letters == hex_case::upper ) {
+			encoding_impl::hex_encode_n<true>(
+			  encoding_impl::bytes_of( src ), std::size( src ), out );
+		} else {
+			encoding_impl::hex_encode_n<false>(
+			  encoding_impl::bytes_of( src ), std::size( src ), out );
+		}
+		return size;
+	}
+
+	/// Decode hex digits, of either case, from src into dst
+	template<typename Source, typename Destination>
+	[[nodiscard]] decode_result hex_decode( Source const &src,
+	                                        Destination &&dst ) {
+		static_assert( encoding_impl::is_byte_range_v<Source> and
+		                 encoding_impl::is_byte_range_v<Destination>,
+		               "Ranges must be of bytes or chars" );
+		daw::exception::precondition_check<std::out_of_range>(
+		  std::size( dst ) >= hex_decoded_size( std::size( src ) ),
+		  "Destination is too small" );
+		return encoding_impl::hex_decode_n(
+		  encoding_impl::chars_of( src ), std::size( src ),
+		  reinterpret_cast<unsigned char *>( std::data( dst ) ) );
+	}
+
+	/// Base64 encode the bytes in src to dst.  Returns the number of
+	/// characters written
+	template<typename Source, typename Destination>
+	std::size_t
+	base64_encode( Source const &src, Destination &&dst,
+	               base64_alphabet alphabet = base64_alphabet::standard ) {
+		static_assert( encoding_impl::is_byte_range_v<Source> and
+		                 encoding_impl::is_byte_range_v<Destination>,
+		               "Ranges must be of bytes or chars" );
+		daw::exception::precondition_check<std::out_of_range>(
+		  std::size( dst ) >= base64_encoded_size( std::size( src ), alphabet ),
+		  "Destination is too small" );
+		auto *const out = reinterpret_cast<char *>( std::data( dst ) );
+		if( alphabet == base64_alphabet::url ) {
+			return encoding_impl::base64_encode_n<true>(
+			  encoding_impl::bytes_of( src ), std::size( src ), out, false );
+		}
+		return encoding_impl::base64_encode_n<false>(
+		  encoding_impl::bytes_of( src ), std::size( src ), out, true );
+	}
+
+	/// Decode base64 from src into dst.  Padding is optional for both
+	/// alphabets, but when present the input must be a multiple of 4
+	/// characters.  Whitespace is not skipped
+	template<typename Source, typename Destination>
+	[[nodiscard]] decode_result
+	base64_decode( Source const &src, Destination &&dst,
+	               base64_alphabet alphabet = base64_alphabet::standard ) {
+		static_assert( encoding_impl::is_byte_range_v<Source> and
+		                 encoding_impl::is_byte_range_v<Destination>,
+		               "Ranges must be of bytes or chars" );
+		char const *const chars = encoding_impl::chars_of( src );
+		std::size_t count = std::size( src );
+		if( count % 4U == 0 ) {
+			for( int n = 0; n < 2 and count > 0 and chars[count - 1U] == '='; ++n ) {
+				--count;
+			}
+		}
+		daw::exception::precondition_check<std::out_of_range>(
+		  std::size( dst ) >= base64_decoded_size( count ),
+		  "Destination is too small" );
+		auto *const out = reinterpret_cast<unsigned char *>( std::data( dst ) );
+		auto result =
+		  alphabet == base64_alphabet::url
+		    ? encoding_impl::base64_decode_n<true>( chars, count, out )
+		    : encoding_impl::base64_decode_n<false>( chars, count, out );
+		if( result.is_valid ) {
+			result.read = std::size( src );
+		}
+		return result;
+	}
+
+	template<typename Source>
+	[[nodiscard]] std::string
+	to_hex_string( Source const &src, hex_case letters = hex_case::lower ) {
+		auto result = std::string( hex_encoded_size( std::size( src ) ), '\0' );
+		(void)hex_encode( src, result, letters );
+		return result;
+	}
+
+	template<typename Source>
+	[[nodiscard]] std::string
+	to_base64_string( Source const &src,
+	                  base64_alphabet alphabet = base64_alphabet::standard ) {
+		auto result =
+		  std::string( base64_encoded_size( std::size( src ), alphabet ), '\0' );
+		(void)base64_encode( src, result, alphabet );
+		return result;
+	}
+} // namespace daw::encoding
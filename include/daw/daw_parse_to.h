@@ -16,10 +16,12 @@
 #include "daw_traits.h"
 #include "daw_utility.h"
 #include "impl/daw_make_trait.h"
+#include "impl/daw_parse_digits.h"
 
 #include <array>
 #include <cstddef>
 #include <iterator>
+#include <limits>
 #include <string>
 #include <tuple>
 #include <type_traits>
@@ -42,8 +44,6 @@ namespace daw {
 			namespace helpers {
 				template<typename Result>
 				constexpr Result parse_int( daw::string_view &str ) {
-					intmax_t count = std::numeric_limits<Result>::digits;
-					Result result = 0;
 					bool is_neg = false;
 					if( '-' == str.front( ) ) {
 
@@ -53,18 +53,16 @@ namespace daw {
 						is_neg = true;
 						str.remove_prefix( );
 					}
-					while( count > 0 and !str.empty( ) and is_number( str.front( ) ) ) {
-						result *= static_cast<Result>( 10 );
-						result += static_cast<Result>( str.front( ) - '0' );
-						--count;
-						str.remove_prefix( );
-					}
+					auto const digits = daw::parse_digits_impl::parse_digits(
+					  str.data( ), str.data( ) + str.size( ) );
+					daw::exception::precondition_check<invalid_input_exception>(
+					  digits.last == str.data( ) + str.size( ) );
+					str.remove_prefix( str.size( ) );
 
+					Result result = 0;
 					daw::exception::precondition_check<numeric_overflow_exception>(
-					  str.empty( ) );
-					if( is_neg ) {
-						result *= static_cast<Result>( -1 );
-					}
+					  not digits.overflow and daw::parse_digits_impl::to_integer(
+					                            digits.value, is_neg, result ) );
 					return result;
 				}
 
@@ -9,10 +9,14 @@
 #pragma once
 
 #include "ciso646.h"
+#include "daw_attributes.h"
 #include "daw_exception.h"
+#include "daw_likely.h"
 #include "daw_parser_helper.h"
+#include "impl/daw_parse_digits.h"
 
 #include <limits>
+#include <type_traits>
 
 DAW_UNSAFE_BUFFER_FUNC_START
 namespace daw::parser {
@@ -37,48 +41,91 @@ namespace daw::parser {
 		return result;
 	}
 
-	template<typename ForwardIterator, typename Result>
-	constexpr void parse_unsigned_int( ForwardIterator first,
-	                                   ForwardIterator last,
-	                                   Result &result ) {
-		size_t count = std::numeric_limits<Result>::digits;
+	namespace parser_addons_impl {
+		/// Contiguous char ranges take the SWAR path in parse_digits_impl
+		template<typename ForwardIterator>
+		inline constexpr bool is_char_pointer_v =
+		  std::is_convertible_v<ForwardIterator, char const *>;
+
+		[[noreturn]] DAW_ATTRIB_NOINLINE inline void throw_int_out_of_range( ) {
+			daw::exception::daw_throw<ParserOutOfRangeException>(
+			  "Not enough room to store integer" );
+		}
+
+		template<typename Result>
+		DAW_ATTRIB_INLINE constexpr void parse_digits_to( char const *first,
+		                                                  char const *last,
+		                                                  bool is_neg,
+		                                                  Result &result ) {
+			auto const digits = parse_digits_impl::parse_digits( first, last );
+			if( DAW_UNLIKELY( digits.last != last ) ) {
+				daw::exception::daw_throw<ParserException>( );
+			}
+			if( DAW_UNLIKELY( digits.overflow or
+			                  not parse_digits_impl::to_integer(
+			                    digits.value, is_neg, result ) ) ) {
+				throw_int_out_of_range( );
+			}
+		}
+	} // namespace parser_addons_impl
 
+	template<typename ForwardIterator, typename Result>
+	DAW_ATTRIB_INLINE constexpr void
+	parse_unsigned_int( ForwardIterator first,
+	                    ForwardIterator last,
+	                    Result &result ) {
 		daw::exception::precondition_check<ParserOutOfRangeException>(
 		  '-' != *first, "Negative values are unsupported" );
 
-		result = 0;
-		for( ; first != last and count > 0; ++first, --count ) {
-			result *= static_cast<Result>( 10 );
-			Result val = static_cast<Result>( *first ) - static_cast<Result>( '0' );
-			result += val;
+		if constexpr( parser_addons_impl::is_char_pointer_v<ForwardIterator> ) {
+			parser_addons_impl::parse_digits_to( first, last, false, result );
+		} else {
+			size_t count = std::numeric_limits<Result>::digits;
+			result = 0;
+			for( ; first != last and count > 0; ++first, --count ) {
+				result *= static_cast<Result>( 10 );
+				Result val = static_cast<Result>( *first ) - static_cast<Result>( '0' );
+				result += val;
+			}
+			daw::exception::precondition_check<ParserOutOfRangeException>(
+			  first == last, "Not enough room to store unsigned integer" );
 		}
-		daw::exception::precondition_check<ParserOutOfRangeException>(
-		  first == last, "Not enough room to store unsigned integer" );
 	}
 
 	template<typename ForwardIterator, typename Result>
-	constexpr void
+	DAW_ATTRIB_INLINE constexpr void
 	parse_int( ForwardIterator first, ForwardIterator last, Result &result ) {
-		intmax_t count = std::numeric_limits<Result>::digits;
-		result = 0;
-		bool is_neg = false;
-		if( '-' == *first ) {
-			daw::exception::precondition_check<ParserOutOfRangeException>(
-			  std::numeric_limits<Result>::is_signed,
-			  "Negative values are unsupported with unsigned Result" );
+		if constexpr( parser_addons_impl::is_char_pointer_v<ForwardIterator> ) {
+			// The sign is often unpredictable, so skip it without a branch
+			bool const is_neg = first != last and '-' == *first;
+			if constexpr( not std::numeric_limits<Result>::is_signed ) {
+				daw::exception::precondition_check<ParserOutOfRangeException>(
+				  not is_neg, "Negative values are unsupported with unsigned Result" );
+			}
+			parser_addons_impl::parse_digits_to(
+			  first + static_cast<int>( is_neg ), last, is_neg, result );
+		} else {
+			bool is_neg = false;
+			if( '-' == *first ) {
+				daw::exception::precondition_check<ParserOutOfRangeException>(
+				  std::numeric_limits<Result>::is_signed,
+				  "Negative values are unsupported with unsigned Result" );
 
-			is_neg = true;
-			++first;
-		}
-		for( ; first != last and count > 0; ++first, --count ) {
-			result *= static_cast<Result>( 10 );
-			Result val = *first - '0';
-			result += val;
-		}
-		daw::exception::precondition_check<ParserOutOfRangeException>(
-		  first == last, "Not enough room to store signed integer" );
-		if( is_neg ) {
-			result *= static_cast<Result>( -1 );
+				is_neg = true;
+				++first;
+			}
+			intmax_t count = std::numeric_limits<Result>::digits;
+			result = 0;
+			for( ; first != last and count > 0; ++first, --count ) {
+				result *= static_cast<Result>( 10 );
+				Result val = *first - '0';
+				result += val;
+			}
+			daw::exception::precondition_check<ParserOutOfRangeException>(
+			  first == last, "Not enough room to store signed integer" );
+			if( is_neg ) {
+				result *= static_cast<Result>( -1 );
+			}
 		}
 	}
 
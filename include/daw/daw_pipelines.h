@@ -16,6 +16,7 @@
 #include "pipelines/filter_view.h"
 #include "pipelines/foreach.h"
 #include "pipelines/generate.h"
+#include "pipelines/hash_algorithm.h"
 #include "pipelines/iota_view.h"
 #include "pipelines/map_view.h"
 #include "pipelines/maybe_view.h"
@@ -24,6 +25,7 @@
 #include "pipelines/predicates.h"
 #include "pipelines/print.h"
 #include "pipelines/range.h"
+#include "pipelines/size_hint.h"
 #include "pipelines/skip.h"
 #include "pipelines/swizzle.h"
 #include "pipelines/take_view.h"
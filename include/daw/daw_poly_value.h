@@ -10,8 +10,11 @@
 
 #include "ciso646.h"
 #include "daw_enable_if.h"
+#include "daw_sbo.h"
 #include "daw_traits.h"
 
+#include <cassert>
+#include <cstddef>
 #include <functional>
 #include <memory>
 #include <utility>
@@ -28,6 +31,27 @@ namespace daw {
 				  *static_cast<Child const *>( rhs.get( ) ) );
 			};
 		}
+
+		/// Type erased operations for a Child held in a sbo_storage.  Each
+		/// returns the BaseClass pointer to the value it constructs
+		template<typename BaseClass, typename Storage>
+		struct sbo_vtable {
+			BaseClass *( *copy )( Storage &dest, Storage const &src );
+			BaseClass *( *move )( Storage &dest, Storage &src ) noexcept;
+			void ( *destroy )( Storage &storage ) noexcept;
+		};
+
+		template<typename BaseClass, typename Child, typename Storage>
+		inline constexpr sbo_vtable<BaseClass, Storage> sbo_vtable_for{
+		  []( Storage &dest, Storage const &src ) -> BaseClass * {
+			  return dest.allocate( *src.template get<Child>( ) );
+		  },
+		  []( Storage &dest, Storage &src ) noexcept -> BaseClass * {
+			  return src.template move_to<Child>( dest );
+		  },
+		  []( Storage &storage ) noexcept {
+			  storage.template deallocate<Child>( );
+		  } };
 	} // namespace poly_value_impl
 
 	template<typename T = void>
@@ -179,4 +203,156 @@ namespace daw {
 	poly_value<BaseClass> make_poly_value( Args &&...args ) {
 		return { construct_emplace<ChildClass>, DAW_FWD( args )... };
 	}
+
+	/// A copyable polymorphic value like poly_value that stores children of up
+	/// to BufferSize bytes inline and only allocates for larger ones.  Copy,
+	/// move and destroy go through one static table per child type instead of a
+	/// std::function per value, so a vector of them is contiguous and copying
+	/// does not allocate for small children.  Children that can throw when
+	/// moved are always allocated, so moving a sbo_poly_value never throws.  A
+	/// moved from sbo_poly_value is empty and may only be assigned to or
+	/// destroyed
+	template<typename BaseClass,
+	         std::size_t BufferSize = 4 * sizeof( void * ),
+	         std::size_t Align = alignof( std::max_align_t )>
+	class sbo_poly_value {
+		using storage_t = sbo_storage<BufferSize, Align>;
+		using vtable_t = poly_value_impl::sbo_vtable<BaseClass, storage_t>;
+
+		storage_t m_storage{ };
+		vtable_t const *m_vtable = nullptr;
+		BaseClass *m_ptr = nullptr;
+
+		template<typename T, typename... Args>
+		void construct( Args &&...args ) {
+			static_assert( std::is_base_of_v<BaseClass, T>,
+			               "Type must be derived from BaseClass" );
+			static_assert( std::is_copy_constructible_v<T> and
+			                 std::is_move_constructible_v<T>,
+			               "Type must be copy and move constructible" );
+			m_ptr = m_storage.template emplace<T>( DAW_FWD( args )... );
+			m_vtable = &poly_value_impl::sbo_vtable_for<BaseClass, T, storage_t>;
+		}
+
+	public:
+		sbo_poly_value( ) {
+			construct<BaseClass>( );
+		}
+
+		template<typename T,
+		         daw::enable_when_t<
+		           std::is_base_of_v<BaseClass, daw::remove_cvref_t<T>>> = nullptr>
+		sbo_poly_value( T &&value ) {
+			construct<daw::remove_cvref_t<T>>( DAW_FWD( value ) );
+		}
+
+		template<typename T, typename... Args>
+		sbo_poly_value( construct_emplace_t<T>, Args &&...args ) {
+			construct<T>( DAW_FWD( args )... );
+		}
+
+		sbo_poly_value( sbo_poly_value const &other )
+		  : m_vtable( other.m_vtable ) {
+			if( m_vtable ) {
+				m_ptr = m_vtable->copy( m_storage, other.m_storage );
+			}
+		}
+
+		sbo_poly_value( sbo_poly_value &&other ) noexcept
+		  : m_vtable( other.m_vtable ) {
+			if( m_vtable ) {
+				m_ptr = m_vtable->move( m_storage, other.m_storage );
+				other.m_vtable = nullptr;
+				other.m_ptr = nullptr;
+			}
+		}
+
+		sbo_poly_value &operator=( sbo_poly_value const &rhs ) {
+			if( this != &rhs ) {
+				*this = sbo_poly_value( rhs );
+			}
+			return *this;
+		}
+
+		sbo_poly_value &operator=( sbo_poly_value &&rhs ) noexcept {
+			if( this != &rhs ) {
+				reset( );
+				if( rhs.m_vtable ) {
+					m_ptr = rhs.m_vtable->move( m_storage, rhs.m_storage );
+					m_vtable = rhs.m_vtable;
+					rhs.m_vtable = nullptr;
+					rhs.m_ptr = nullptr;
+				}
+			}
+			return *this;
+		}
+
+		template<typename T,
+		         daw::enable_when_t<
+		           std::is_base_of_v<BaseClass, daw::remove_cvref_t<T>>> = nullptr>
+		sbo_poly_value &operator=( T &&rhs ) {
+			// rhs may be the value held, so construct the new value before
+			// destroying the current one
+			*this = sbo_poly_value( DAW_FWD( rhs ) );
+			return *this;
+		}
+
+		~sbo_poly_value( ) {
+			reset( );
+		}
+
+		/// Destroy the current value and construct a T from args in its place
+		template<typename T, typename... Args>
+		T &emplace( Args &&...args ) {
+			reset( );
+			construct<T>( DAW_FWD( args )... );
+			return *static_cast<T *>( m_ptr );
+		}
+
+		[[nodiscard]] bool has_value( ) const noexcept {
+			return m_vtable != nullptr;
+		}
+
+		/// Is the value stored inline, without a heap allocation
+		[[nodiscard]] bool is_local( ) const noexcept {
+			return m_storage.engaged == storage_t::engaged_types::local;
+		}
+
+		BaseClass const &operator*( ) const {
+			assert( m_ptr );
+			return *m_ptr;
+		}
+
+		BaseClass &operator*( ) {
+			assert( m_ptr );
+			return *m_ptr;
+		}
+
+		BaseClass const *operator->( ) const {
+			assert( m_ptr );
+			return m_ptr;
+		}
+
+		BaseClass *operator->( ) {
+			assert( m_ptr );
+			return m_ptr;
+		}
+
+		operator BaseClass &( ) & noexcept {
+			return *m_ptr;
+		}
+
+		operator BaseClass const &( ) const & noexcept {
+			return *m_ptr;
+		}
+
+	private:
+		void reset( ) noexcept {
+			if( m_vtable ) {
+				m_vtable->destroy( m_storage );
+				m_vtable = nullptr;
+				m_ptr = nullptr;
+			}
+		}
+	};
 } // namespace daw
@@ -8,20 +8,102 @@
 
 #pragma once
 
+#include "daw_attributes.h"
 #include "daw_formatters.h"
 #include "daw_move.h"
 #include "traits/daw_formatter.h"
 
+#include <array>
+#include <cstddef>
 #include <cstdio>
+#include <cstring>
 #include <format>
+#include <iterator>
+#include <string>
+#include <string_view>
 #include <utility>
 
 namespace daw {
+	namespace print_details {
+		/// Output up to this size is formatted on the stack and written with a
+		/// single call, larger output continues in a std::string
+		inline constexpr std::size_t stack_buffer_size = 512;
+
+		/// A format destination that fills a fixed buffer and moves what it has
+		/// to a std::string only when the output does not fit.  Output is
+		/// formatted once whatever its size
+		class spill_buffer {
+			char *m_data;
+			std::size_t m_capacity;
+			std::size_t m_size = 0;
+			std::string m_spill{ };
+
+		public:
+			using value_type = char;
+
+			spill_buffer( char *data, std::size_t capacity ) noexcept
+			  : m_data( data )
+			  , m_capacity( capacity ) {}
+
+			void push_back( char c ) {
+				if( m_size < m_capacity ) {
+					m_data[m_size++] = c;
+					return;
+				}
+				if( m_spill.empty( ) ) {
+					m_spill.reserve( 2 * m_capacity );
+					m_spill.assign( m_data, m_size );
+				}
+				m_spill.push_back( c );
+			}
+
+			/// The output no longer fits in the fixed buffer
+			[[nodiscard]] bool spilled( ) const noexcept {
+				return not m_spill.empty( );
+			}
+
+			[[nodiscard]] std::string_view view( ) const noexcept {
+				if( spilled( ) ) {
+					return m_spill;
+				}
+				return std::string_view( m_data, m_size );
+			}
+		};
+
+		DAW_ATTRIB_INLINE void write_out( FILE *fout,
+		                                  char const *data,
+		                                  std::size_t size ) {
+			(void)std::fwrite( data, 1, size, fout );
+		}
+	} // namespace print_details
+
 	template<typename... Args>
 	DAW_ATTRIB_NOINLINE void
 	print( FILE *fout, std::format_string<Args...> fmt, Args &&...args ) {
-		auto const r = std::format( std::move( fmt ), DAW_FWD( args )... );
-		(void)std::fwrite( std::data( r ), 1, r.size( ), fout );
+		char buff[print_details::stack_buffer_size];
+		auto out = print_details::spill_buffer( buff, sizeof( buff ) );
+		(void)std::format_to(
+		  std::back_inserter( out ), std::move( fmt ), DAW_FWD( args )... );
+		auto const sv = out.view( );
+		print_details::write_out( fout, sv.data( ), sv.size( ) );
+	}
+
+	/// Print at most MaxSize characters of the formatted output, without
+	/// allocating.
+	/// @return true if the output was truncated
+	template<std::size_t MaxSize = print_details::stack_buffer_size,
+	         typename... Args>
+	DAW_ATTRIB_NOINLINE bool
+	print_truncated( FILE *fout,
+	                 std::format_string<Args...> fmt,
+	                 Args &&...args ) {
+		static_assert( MaxSize > 0 );
+		char buff[MaxSize];
+		auto const r = std::format_to_n(
+		  buff, static_cast<std::ptrdiff_t>( MaxSize ), fmt, DAW_FWD( args )... );
+		auto const size = static_cast<std::size_t>( r.size );
+		print_details::write_out( fout, buff, size < MaxSize ? size : MaxSize );
+		return size > MaxSize;
 	}
 
 	template<typename... Args>
@@ -46,8 +128,14 @@ namespace daw {
 	template<typename... Args>
 	DAW_ATTRIB_NOINLINE void
 	println( FILE *f, std::format_string<Args...> fmt, Args &&...args ) {
-		daw::print(
-		  f, "{}\n", std::format( std::move( fmt ), DAW_FWD( args )... ) );
+		char buff[print_details::stack_buffer_size];
+		auto out = print_details::spill_buffer( buff, sizeof( buff ) );
+		(void)std::format_to(
+		  std::back_inserter( out ), std::move( fmt ), DAW_FWD( args )... );
+		// The newline goes with the line so it is written in one call
+		out.push_back( '\n' );
+		auto const sv = out.view( );
+		print_details::write_out( f, sv.data( ), sv.size( ) );
 	}
 
 	template<typename... Args>
@@ -60,8 +148,7 @@ namespace daw {
 	template<typename... Args>
 	DAW_ATTRIB_NOINLINE void println( std::format_string<Args...> fmt,
 	                                  Args &&...args ) {
-		daw::print(
-		  stdout, "{}\n", std::format( std::move( fmt ), DAW_FWD( args )... ) );
+		daw::println( stdout, std::move( fmt ), DAW_FWD( args )... );
 	}
 
 	template<typename... Args>
@@ -73,4 +160,113 @@ namespace daw {
 	DAW_ATTRIB_INLINE void println( ) {
 		std::putchar( '\n' );
 	}
+
+	/// Batches formatted output in a fixed size buffer that is written to a
+	/// FILE with one call when full, on flush, and on destruction.  Messages
+	/// are formatted directly into the buffer, so printing only allocates for
+	/// a single message larger than the buffer.  Not thread safe, use one per
+	/// thread
+	class output_buffer {
+	public:
+		static constexpr std::size_t capacity = 8192;
+
+	private:
+		FILE *m_file;
+		std::size_t m_size = 0;
+		std::array<char, capacity> m_data;
+
+		[[nodiscard]] std::size_t available( ) const {
+			return capacity - m_size;
+		}
+
+	public:
+		explicit output_buffer( FILE *f = stdout ) noexcept
+		  : m_file( f ) {}
+
+		output_buffer( output_buffer const & ) = delete;
+		output_buffer &operator=( output_buffer const & ) = delete;
+
+		~output_buffer( ) {
+			flush( );
+		}
+
+		[[nodiscard]] FILE *file( ) const {
+			return m_file;
+		}
+
+		/// The number of bytes waiting to be written
+		[[nodiscard]] std::size_t size( ) const {
+			return m_size;
+		}
+
+		void flush( ) {
+			if( m_size > 0 ) {
+				print_details::write_out( m_file, m_data.data( ), m_size );
+				m_size = 0;
+			}
+		}
+
+		void write( std::string_view sv ) {
+			if( sv.size( ) > available( ) ) {
+				flush( );
+				if( sv.size( ) >= capacity ) {
+					print_details::write_out( m_file, sv.data( ), sv.size( ) );
+					return;
+				}
+			}
+			std::memcpy( m_data.data( ) + m_size, sv.data( ), sv.size( ) );
+			m_size += sv.size( );
+		}
+
+		void put( char c ) {
+			if( m_size == capacity ) {
+				flush( );
+			}
+			m_data[m_size++] = c;
+		}
+
+		template<typename... Args>
+		void print( std::format_string<Args...> fmt, Args &&...args ) {
+			auto out =
+			  print_details::spill_buffer( m_data.data( ) + m_size, available( ) );
+			(void)std::format_to(
+			  std::back_inserter( out ), std::move( fmt ), DAW_FWD( args )... );
+			if( not out.spilled( ) ) {
+				m_size += out.view( ).size( );
+				return;
+			}
+			// It did not fit.  The partial output past m_size is dropped by flush
+			// and the whole message written from the spilled copy
+			write( out.view( ) );
+		}
+
+		template<typename... Args>
+		void println( std::format_string<Args...> fmt, Args &&...args ) {
+			print( std::move( fmt ), DAW_FWD( args )... );
+			put( '\n' );
+		}
+
+		/// Buffer at most max_size characters of the formatted output, without
+		/// allocating.  max_size is limited to capacity.
+		/// @return true if the output was truncated
+		template<typename... Args>
+		bool print_truncated( std::size_t max_size,
+		                      std::format_string<Args...> fmt,
+		                      Args &&...args ) {
+			if( max_size > capacity ) {
+				max_size = capacity;
+			}
+			if( max_size > available( ) ) {
+				flush( );
+			}
+			auto const r =
+			  std::format_to_n( m_data.data( ) + m_size,
+			                    static_cast<std::ptrdiff_t>( max_size ),
+			                    fmt,
+			                    DAW_FWD( args )... );
+			auto const size = static_cast<std::size_t>( r.size );
+			m_size += size < max_size ? size : max_size;
+			return size > max_size;
+		}
+	};
 } // namespace daw
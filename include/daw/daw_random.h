@@ -10,13 +10,18 @@
 
 #include "ciso646.h"
 #include "daw_arith_traits.h"
+#include "daw_attributes.h"
 #include "daw_exception.h"
 #include "daw_fnv1a_hash.h"
 #include "daw_swap.h"
 #include "daw_traits.h"
+#include "daw_uint_types.h"
 #include "daw_utility.h"
 #include "traits/daw_traits_conditional.h"
 
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
 #include <iterator>
 #include <limits>
 #include <memory>
@@ -24,12 +29,723 @@
 #include <type_traits>
 #include <vector>
 
-namespace daw::impl {
-	static inline auto &global_rng( ) {
-		static thread_local auto e = std::mt19937_64( std::random_device{ }( ) );
-		return e;
+namespace daw {
+	namespace random_impl {
+		[[nodiscard]] constexpr std::uint64_t rotl( std::uint64_t x,
+		                                            unsigned k ) noexcept {
+			return ( x << k ) | ( x >> ( 64U - k ) );
+		}
+
+		/// Engines whose output covers every value of a 32 or 64 bit unsigned
+		/// integer, which the bounded sampling below needs
+		template<typename Engine>
+		inline constexpr bool is_full_range_engine_v =
+		  std::is_unsigned_v<typename Engine::result_type> and
+		  ( Engine::min )( ) == 0 and
+		  ( ( Engine::max )( ) == ( std::numeric_limits<std::uint64_t>::max )( ) or
+		    ( Engine::max )( ) == ( std::numeric_limits<std::uint32_t>::max )( ) );
+
+		template<typename Engine, typename = void>
+		inline constexpr bool has_generate_v = false;
+
+		template<typename Engine>
+		inline constexpr bool has_generate_v<
+		  Engine,
+		  std::void_t<decltype( std::declval<Engine &>( ).generate(
+		    std::declval<std::uint64_t *>( ), std::size_t{ } ) )>> = true;
+
+		/// 64 random bits from a full range engine
+		template<typename Engine>
+		constexpr std::uint64_t bits64( Engine &g ) {
+			static_assert( is_full_range_engine_v<Engine> );
+			if constexpr( ( Engine::max )( ) ==
+			              ( std::numeric_limits<std::uint64_t>::max )( ) ) {
+				return static_cast<std::uint64_t>( g( ) );
+			} else {
+				auto const hi = static_cast<std::uint64_t>( g( ) );
+				return ( hi << 32U ) | static_cast<std::uint64_t>( g( ) );
+			}
+		}
+
+		template<typename Engine>
+		constexpr std::uint32_t bits32( Engine &g ) {
+			static_assert( is_full_range_engine_v<Engine> );
+			if constexpr( ( Engine::max )( ) ==
+			              ( std::numeric_limits<std::uint64_t>::max )( ) ) {
+				// The high bits are the better ones for some engines, e.g. LCGs
+				return static_cast<std::uint32_t>( g( ) >> 32U );
+			} else {
+				return static_cast<std::uint32_t>( g( ) );
+			}
+		}
+
+		/// Lemire's multiply-shift with rejection, mapping a random x to
+		/// [0, range).  Only when the low half of the product falls below
+		/// 2^N % range is a modulo computed and x possibly redrawn.
+		template<typename Engine>
+		constexpr std::uint64_t below64( Engine &g,
+		                                 std::uint64_t x,
+		                                 std::uint64_t range ) {
+			auto m = daw::mul_wide( x, range );
+			if( m.lo < range ) {
+				auto const threshold = ( 0U - range ) % range;
+				while( m.lo < threshold ) {
+					m = daw::mul_wide( bits64( g ), range );
+				}
+			}
+			return m.hi;
+		}
+
+		template<typename Engine>
+		constexpr std::uint32_t below32( Engine &g,
+		                                 std::uint32_t x,
+		                                 std::uint32_t range ) {
+			auto m = std::uint64_t{ x } * range;
+			if( static_cast<std::uint32_t>( m ) < range ) {
+				auto const threshold = static_cast<std::uint32_t>( 0U - range ) % range;
+				while( static_cast<std::uint32_t>( m ) < threshold ) {
+					m = std::uint64_t{ bits32( g ) } * range;
+				}
+			}
+			return static_cast<std::uint32_t>( m >> 32U );
+		}
+
+		template<typename Integer>
+		using unsigned_for_t = std::make_unsigned_t<
+		  conditional_t<std::is_same_v<Integer, bool>, unsigned char, Integer>>;
+
+		/// Map x to [a, b], drawing from g only when x is rejected
+		template<typename Integer, typename Engine>
+		constexpr Integer to_int_range( Engine &g,
+		                                std::uint64_t x,
+		                                Integer a,
+		                                Integer b ) {
+			using unsigned_t = unsigned_for_t<Integer>;
+			auto const range = static_cast<unsigned_t>(
+			  static_cast<unsigned_t>( b ) - static_cast<unsigned_t>( a ) );
+			if( range == ( std::numeric_limits<unsigned_t>::max )( ) ) {
+				return static_cast<Integer>( static_cast<unsigned_t>( x ) );
+			}
+			auto offset = unsigned_t{ };
+			if constexpr( sizeof( unsigned_t ) <= sizeof( std::uint32_t ) ) {
+				offset = static_cast<unsigned_t>(
+				  below32( g,
+				           static_cast<std::uint32_t>( x >> 32U ),
+				           std::uint32_t{ range } + 1U ) );
+			} else {
+				offset = static_cast<unsigned_t>(
+				  below64( g, x, static_cast<std::uint64_t>( range ) + 1U ) );
+			}
+			return static_cast<Integer>(
+			  static_cast<unsigned_t>( static_cast<unsigned_t>( a ) + offset ) );
+		}
+
+		/// Map each random value in bits to an offset in [0, range] in place.
+		/// Ranges below 2^32 take a branch free multiply over the whole block,
+		/// which vectorizes, and only revisit the rare values that may need a
+		/// redraw.
+		template<typename Engine, typename UInt>
+		constexpr void to_offsets( Engine &g,
+		                           std::uint64_t *bits,
+		                           std::size_t count,
+		                           UInt range ) {
+			if( range == ( std::numeric_limits<UInt>::max )( ) ) {
+				return;
+			}
+			if( static_cast<std::uint64_t>( range ) >= 0xFFFF'FFFFULL ) {
+				for( std::size_t n = 0; n < count; ++n ) {
+					bits[n] =
+					  below64( g, bits[n], static_cast<std::uint64_t>( range ) + 1U );
+				}
+				return;
+			}
+			auto const r = static_cast<std::uint32_t>( range ) + 1U;
+			// An integer rather than bool flag keeps the loop vectorizable
+			std::uint32_t maybe_rejected = 0;
+			for( std::size_t n = 0; n < count; ++n ) {
+				auto const m = ( bits[n] >> 32U ) * r;
+				maybe_rejected |= static_cast<std::uint32_t>( m ) < r;
+				bits[n] = m;
+			}
+			if( maybe_rejected != 0 ) {
+				auto const threshold = static_cast<std::uint32_t>( 0U - r ) % r;
+				for( std::size_t n = 0; n < count; ++n ) {
+					while( static_cast<std::uint32_t>( bits[n] ) < threshold ) {
+						bits[n] = std::uint64_t{ bits32( g ) } * r;
+					}
+				}
+			}
+			for( std::size_t n = 0; n < count; ++n ) {
+				bits[n] >>= 32U;
+			}
+		}
+
+		/// Assign value( n ) for n in [0, count) to successive elements from
+		/// first, stopping at last
+		template<typename ForwardIterator, typename Func>
+		DAW_ATTRIB_INLINE constexpr void store_block( ForwardIterator &first,
+		                                              ForwardIterator const &last,
+		                                              std::size_t count,
+		                                              Func const &value ) {
+			using iter_category =
+			  typename std::iterator_traits<ForwardIterator>::iterator_category;
+			if constexpr( std::is_base_of_v<std::random_access_iterator_tag,
+			                                iter_category> ) {
+				// count has already been limited to the remaining size
+				for( std::size_t n = 0; n < count; ++n ) {
+					first[static_cast<std::ptrdiff_t>( n )] = value( n );
+				}
+				first += static_cast<std::ptrdiff_t>( count );
+			} else {
+				for( std::size_t n = 0; n < count and first != last; ++n, ++first ) {
+					*first = value( n );
+				}
+			}
+		}
+
+		/// The top bits of x as a Float in [0, 1)
+		template<typename Float>
+		constexpr Float to_unit_real( std::uint64_t x ) {
+			static_assert( std::is_floating_point_v<Float> );
+			constexpr auto digits = std::numeric_limits<Float>::digits < 64
+			                          ? std::numeric_limits<Float>::digits
+			                          : 64;
+			constexpr auto scale =
+			  Float{ 1 } /
+			  static_cast<Float>( std::uint64_t{ 1 } << ( digits - 1 ) ) / Float{ 2 };
+			return static_cast<Float>( x >> ( 64 - digits ) ) * scale;
+		}
+	} // namespace random_impl
+
+	/// SplitMix64, used to expand a single seed into engine state.  Every seed,
+	/// including 0, gives a distinct well mixed sequence
+	class splitmix64 {
+		std::uint64_t m_state;
+
+	public:
+		using result_type = std::uint64_t;
+
+		explicit constexpr splitmix64( std::uint64_t seed = 0 ) noexcept
+		  : m_state( seed ) {}
+
+		[[nodiscard]] static constexpr result_type min( ) noexcept {
+			return 0;
+		}
+
+		[[nodiscard]] static constexpr result_type max( ) noexcept {
+			return ( std::numeric_limits<result_type>::max )( );
+		}
+
+		constexpr result_type operator( )( ) noexcept {
+			auto z = ( m_state += 0x9E37'79B9'7F4A'7C15ULL );
+			z = ( z ^ ( z >> 30U ) ) * 0xBF58'476D'1CE4'E5B9ULL;
+			z = ( z ^ ( z >> 27U ) ) * 0x94D0'49BB'1331'11EBULL;
+			return z ^ ( z >> 31U );
+		}
+	};
+
+	/// xoshiro256++ by Blackman and Vigna.  A fast general purpose 64 bit
+	/// generator with a period of 2^256 - 1.  jump( ) advances it 2^128 steps
+	/// so that split( ) hands out non-overlapping streams, e.g. one per thread
+	class xoshiro256pp {
+		std::uint64_t m_state[4];
+
+		template<std::size_t>
+		friend class xoshiro256pp_lanes;
+
+		constexpr void apply_jump( std::uint64_t const ( &poly )[4] ) noexcept {
+			std::uint64_t s[4] = { };
+			for( auto const p : poly ) {
+				for( unsigned b = 0; b < 64U; ++b ) {
+					if( p & ( std::uint64_t{ 1 } << b ) ) {
+						for( std::size_t n = 0; n < 4; ++n ) {
+							s[n] ^= m_state[n];
+						}
+					}
+					(void)operator( )( );
+				}
+			}
+			for( std::size_t n = 0; n < 4; ++n ) {
+				m_state[n] = s[n];
+			}
+		}
+
+	public:
+		using result_type = std::uint64_t;
+		static constexpr std::uint64_t default_seed = 0x853C'49E6'748F'EA9BULL;
+
+		explicit constexpr xoshiro256pp(
+		  std::uint64_t seed = default_seed ) noexcept
+		  : m_state{ } {
+			this->seed( seed );
+		}
+
+		constexpr void seed( std::uint64_t value = default_seed ) noexcept {
+			auto sm = splitmix64( value );
+			for( auto &s : m_state ) {
+				s = sm( );
+			}
+		}
+
+		[[nodiscard]] static constexpr result_type min( ) noexcept {
+			return 0;
+		}
+
+		[[nodiscard]] static constexpr result_type max( ) noexcept {
+			return ( std::numeric_limits<result_type>::max )( );
+		}
+
+		constexpr result_type operator( )( ) noexcept {
+			auto const result =
+			  random_impl::rotl( m_state[0] + m_state[3], 23U ) + m_state[0];
+			auto const t = m_state[1] << 17U;
+			m_state[2] ^= m_state[0];
+			m_state[3] ^= m_state[1];
+			m_state[1] ^= m_state[2];
+			m_state[0] ^= m_state[3];
+			m_state[2] ^= t;
+			m_state[3] = random_impl::rotl( m_state[3], 45U );
+			return result;
+		}
+
+		constexpr void discard( unsigned long long n ) noexcept {
+			while( n-- > 0 ) {
+				(void)operator( )( );
+			}
+		}
+
+		/// Advance 2^128 steps
+		constexpr void jump( ) noexcept {
+			constexpr std::uint64_t poly[4] = {
+			  0x180E'C6D3'3CFD'0ABAULL, 0xD5A6'1266'F0C9'392CULL,
+			  0xA958'2618'E03F'C9AAULL, 0x39AB'DC45'29B1'661CULL };
+			apply_jump( poly );
+		}
+
+		/// Advance 2^192 steps
+		constexpr void long_jump( ) noexcept {
+			constexpr std::uint64_t poly[4] = {
+			  0x76E1'5D3E'FEFD'CBBFULL, 0xC500'4E44'1C52'2FB3ULL,
+			  0x7771'0069'854E'E241ULL, 0x3910'9BB0'2ACB'E635ULL };
+			apply_jump( poly );
+		}
+
+		/// A generator for the next 2^128 values of this one, which then jumps
+		/// past them
+		[[nodiscard]] constexpr xoshiro256pp split( ) noexcept {
+			auto result = *this;
+			jump( );
+			return result;
+		}
+
+		constexpr void generate( std::uint64_t *first,
+		                         std::size_t count ) noexcept {
+			// A local copy keeps the state in registers, first may alias it
+			auto rng = *this;
+			for( std::size_t n = 0; n < count; ++n ) {
+				first[n] = rng( );
+			}
+			*this = rng;
+		}
+
+		[[nodiscard]] friend constexpr bool
+		operator==( xoshiro256pp const &lhs, xoshiro256pp const &rhs ) noexcept {
+			for( std::size_t n = 0; n < 4; ++n ) {
+				if( lhs.m_state[n] != rhs.m_state[n] ) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		[[nodiscard]] friend constexpr bool
+		operator!=( xoshiro256pp const &lhs, xoshiro256pp const &rhs ) noexcept {
+			return not( lhs == rhs );
+		}
+	};
+
+	/// Lanes xoshiro256++ streams, each a jump apart, stepped together so that
+	/// generate( ) vectorizes.  Output interleaves the streams.  The default of
+	/// 16 lanes gives enough independent work to hide the latency of each step
+	/// with 256 and 512 bit vectors
+	template<std::size_t Lanes = 16>
+	class xoshiro256pp_lanes {
+		static constexpr std::size_t lanes = Lanes;
+
+		// Stored by state word so that each step is an operation on a vector of
+		// lanes
+		struct lane_state {
+			std::uint64_t s0[lanes];
+			std::uint64_t s1[lanes];
+			std::uint64_t s2[lanes];
+			std::uint64_t s3[lanes];
+
+			DAW_ATTRIB_INLINE constexpr void step( std::uint64_t *out ) noexcept {
+				for( std::size_t n = 0; n < lanes; ++n ) {
+					out[n] = random_impl::rotl( s0[n] + s3[n], 23U ) + s0[n];
+					auto const t = s1[n] << 17U;
+					s2[n] ^= s0[n];
+					s3[n] ^= s1[n];
+					s1[n] ^= s2[n];
+					s0[n] ^= s3[n];
+					s2[n] ^= t;
+					s3[n] = random_impl::rotl( s3[n], 45U );
+				}
+			}
+		};
+
+		lane_state m_state;
+		std::uint64_t m_buffer[lanes];
+		std::size_t m_pos = lanes;
+
+	public:
+		using result_type = std::uint64_t;
+
+		explicit constexpr xoshiro256pp_lanes(
+		  std::uint64_t seed = xoshiro256pp::default_seed ) noexcept
+		  : xoshiro256pp_lanes( xoshiro256pp( seed ) ) {}
+
+		/// Lane n continues from base jumped n times
+		explicit constexpr xoshiro256pp_lanes( xoshiro256pp base ) noexcept
+		  : m_state{ }
+		  , m_buffer{ } {
+			for( std::size_t n = 0; n < lanes; ++n ) {
+				m_state.s0[n] = base.m_state[0];
+				m_state.s1[n] = base.m_state[1];
+				m_state.s2[n] = base.m_state[2];
+				m_state.s3[n] = base.m_state[3];
+				base.jump( );
+			}
+		}
+
+		[[nodiscard]] static constexpr result_type min( ) noexcept {
+			return 0;
+		}
+
+		[[nodiscard]] static constexpr result_type max( ) noexcept {
+			return ( std::numeric_limits<result_type>::max )( );
+		}
+
+		constexpr result_type operator( )( ) noexcept {
+			if( m_pos == lanes ) {
+				m_state.step( m_buffer );
+				m_pos = 0;
+			}
+			return m_buffer[m_pos++];
+		}
+
+		constexpr void generate( std::uint64_t *first,
+		                         std::size_t count ) noexcept {
+			while( count > 0 and m_pos != lanes ) {
+				*first++ = m_buffer[m_pos++];
+				--count;
+			}
+			// A local copy keeps the state in registers, first may alias it
+			auto state = m_state;
+			while( count >= lanes ) {
+				state.step( first );
+				first += lanes;
+				count -= lanes;
+			}
+			m_state = state;
+			while( count-- > 0 ) {
+				*first++ = operator( )( );
+			}
+		}
+	};
+
+	/// wyrand by Wang Yi.  A 64 bit generator with a single word of state that
+	/// is among the fastest that pass BigCrush and PractRand.  split( ) seeds a
+	/// new generator from this one's output; the streams are statistically,
+	/// not provably, independent
+	class wyrand {
+		std::uint64_t m_state;
+
+	public:
+		using result_type = std::uint64_t;
+
+		explicit constexpr wyrand( std::uint64_t seed = 0 ) noexcept
+		  : m_state( seed ) {}
+
+		constexpr void seed( std::uint64_t value = 0 ) noexcept {
+			m_state = value;
+		}
+
+		[[nodiscard]] static constexpr result_type min( ) noexcept {
+			return 0;
+		}
+
+		[[nodiscard]] static constexpr result_type max( ) noexcept {
+			return ( std::numeric_limits<result_type>::max )( );
+		}
+
+		constexpr result_type operator( )( ) noexcept {
+			m_state += 0xA076'1D64'78BD'642FULL;
+			auto const m =
+			  daw::mul_wide( m_state, m_state ^ 0xE703'7ED1'A0B4'28DBULL );
+			return m.lo ^ m.hi;
+		}
+
+		constexpr void discard( unsigned long long n ) noexcept {
+			m_state += 0xA076'1D64'78BD'642FULL * n;
+		}
+
+		[[nodiscard]] constexpr wyrand split( ) noexcept {
+			return wyrand( splitmix64( operator( )( ) )( ) );
+		}
+
+		constexpr void generate( std::uint64_t *first,
+		                         std::size_t count ) noexcept {
+			// Each output only depends on the counter, so this vectorizes where the
+			// target has a wide multiply
+			auto const state = m_state;
+			for( std::size_t n = 0; n < count; ++n ) {
+				auto const s = state + 0xA076'1D64'78BD'642FULL * ( n + 1U );
+				auto const m = daw::mul_wide( s, s ^ 0xE703'7ED1'A0B4'28DBULL );
+				first[n] = m.lo ^ m.hi;
+			}
+			m_state = state + 0xA076'1D64'78BD'642FULL * count;
+		}
+
+		[[nodiscard]] friend constexpr bool
+		operator==( wyrand const &lhs, wyrand const &rhs ) noexcept {
+			return lhs.m_state == rhs.m_state;
+		}
+
+		[[nodiscard]] friend constexpr bool
+		operator!=( wyrand const &lhs, wyrand const &rhs ) noexcept {
+			return lhs.m_state != rhs.m_state;
+		}
+	};
+
+	/// PCG32 (XSH-RR) by O'Neill.  A 64 bit LCG with a permuted 32 bit output.
+	/// Generators with different stream ids produce distinct sequences, and
+	/// advance( ) skips ahead in O(log n)
+	class pcg32 {
+		static constexpr std::uint64_t multiplier = 6364136223846793005ULL;
+		std::uint64_t m_state = 0;
+		std::uint64_t m_inc = 0;
+
+	public:
+		using result_type = std::uint32_t;
+		static constexpr std::uint64_t default_seed = 0x853C'49E6'748F'EA9BULL;
+		static constexpr std::uint64_t default_stream =
+		  0xDA3E'39CB'94B9'5BDBULL >> 1U;
+
+		explicit constexpr pcg32( std::uint64_t seed = default_seed,
+		                          std::uint64_t stream = default_stream ) noexcept {
+			this->seed( seed, stream );
+		}
+
+		constexpr void seed( std::uint64_t value = default_seed,
+		                     std::uint64_t stream = default_stream ) noexcept {
+			m_state = 0;
+			m_inc = ( stream << 1U ) | 1U;
+			(void)operator( )( );
+			m_state += value;
+			(void)operator( )( );
+		}
+
+		[[nodiscard]] static constexpr result_type min( ) noexcept {
+			return 0;
+		}
+
+		[[nodiscard]] static constexpr result_type max( ) noexcept {
+			return ( std::numeric_limits<result_type>::max )( );
+		}
+
+		constexpr result_type operator( )( ) noexcept {
+			auto const old = m_state;
+			m_state = old * multiplier + m_inc;
+			auto const xorshifted =
+			  static_cast<std::uint32_t>( ( ( old >> 18U ) ^ old ) >> 27U );
+			auto const rot = static_cast<unsigned>( old >> 59U );
+			return ( xorshifted >> rot ) | ( xorshifted << ( ( 0U - rot ) & 31U ) );
+		}
+
+		/// Skip delta outputs
+		constexpr void advance( std::uint64_t delta ) noexcept {
+			auto cur_mult = multiplier;
+			auto cur_plus = m_inc;
+			auto acc_mult = std::uint64_t{ 1 };
+			auto acc_plus = std::uint64_t{ 0 };
+			while( delta > 0 ) {
+				if( delta & 1U ) {
+					acc_mult *= cur_mult;
+					acc_plus = acc_plus * cur_mult + cur_plus;
+				}
+				cur_plus = ( cur_mult + 1U ) * cur_plus;
+				cur_mult *= cur_mult;
+				delta >>= 1U;
+			}
+			m_state = acc_mult * m_state + acc_plus;
+		}
+
+		constexpr void discard( unsigned long long n ) noexcept {
+			advance( n );
+		}
+
+		/// A generator on another stream, seeded from this one
+		[[nodiscard]] constexpr pcg32 split( ) noexcept {
+			auto const seed =
+			  ( std::uint64_t{ operator( )( ) } << 32U ) | operator( )( );
+			auto const stream =
+			  ( std::uint64_t{ operator( )( ) } << 32U ) | operator( )( );
+			return pcg32( seed, stream );
+		}
+
+		[[nodiscard]] friend constexpr bool
+		operator==( pcg32 const &lhs, pcg32 const &rhs ) noexcept {
+			return lhs.m_state == rhs.m_state and lhs.m_inc == rhs.m_inc;
+		}
+
+		[[nodiscard]] friend constexpr bool
+		operator!=( pcg32 const &lhs, pcg32 const &rhs ) noexcept {
+			return not( lhs == rhs );
+		}
+	};
+
+	/// A uniformly distributed integer in [0, range) using Lemire's
+	/// multiply-shift method, which needs a division only on the rare
+	/// rejection path.  range must not be 0
+	template<typename UInt, typename Engine>
+	[[nodiscard]] constexpr UInt uniform_below( Engine &g, UInt range ) {
+		static_assert( std::is_unsigned_v<UInt>,
+		               "uniform_below requires an unsigned type" );
+		static_assert( random_impl::is_full_range_engine_v<Engine>,
+		               "Engine must produce every 32 or 64 bit value" );
+		assert( range > 0 );
+		if constexpr( sizeof( UInt ) <= sizeof( std::uint32_t ) ) {
+			return static_cast<UInt>( random_impl::below32(
+			  g, random_impl::bits32( g ), static_cast<std::uint32_t>( range ) ) );
+		} else {
+			return static_cast<UInt>( random_impl::below64(
+			  g, random_impl::bits64( g ), static_cast<std::uint64_t>( range ) ) );
+		}
+	}
+
+	/// A uniformly distributed integer in [a, b].  Engines that do not cover a
+	/// full 32 or 64 bit range go through std::uniform_int_distribution
+	template<typename Integer, typename Engine>
+	[[nodiscard]] constexpr Integer
+	uniform_int( Engine &g, Integer a, Integer b ) {
+		static_assert( std::is_integral_v<Integer>,
+		               "Integer must be a valid integral type" );
+		assert( a <= b );
+		if constexpr( random_impl::is_full_range_engine_v<Engine> ) {
+			return random_impl::to_int_range( g, random_impl::bits64( g ), a, b );
+		} else {
+			using short_t =
+			  conditional_t<std::is_signed_v<Integer>, short, unsigned short>;
+			using int_t =
+			  conditional_t<sizeof( Integer ) < sizeof( short ), short_t, Integer>;
+			return static_cast<Integer>( std::uniform_int_distribution<int_t>(
+			  static_cast<int_t>( a ), static_cast<int_t>( b ) )( g ) );
+		}
+	}
+
+	/// A uniformly distributed Float in [0, 1) made from the top bits of one
+	/// 64 bit draw
+	template<typename Float, typename Engine>
+	[[nodiscard]] constexpr Float uniform_real( Engine &g ) {
+		return random_impl::to_unit_real<Float>( random_impl::bits64( g ) );
+	}
+
+	/// A uniformly distributed Float in [a, b)
+	template<typename Float, typename Engine>
+	[[nodiscard]] constexpr Float uniform_real( Engine &g, Float a, Float b ) {
+		return a + ( b - a ) * uniform_real<Float>( g );
+	}
+
+	/// Fill [first, last) with values uniformly distributed in [a, b] for
+	/// integers and [a, b) for floating point.  Raw bits are generated in
+	/// blocks, with the engine's generate( ) when it has one, and then mapped
+	/// to the range
+	template<typename Engine, typename ForwardIterator, typename Number>
+	void random_fill( Engine &g,
+	                  ForwardIterator first,
+	                  ForwardIterator const last,
+	                  Number a,
+	                  Number b ) {
+		static_assert( std::is_arithmetic_v<Number>,
+		               "Number must be a valid arithmetic type" );
+		static_assert( random_impl::is_full_range_engine_v<Engine>,
+		               "Engine must produce every 32 or 64 bit value" );
+		daw::exception::daw_throw_on_false( a <= b, "a <= b must be true" );
+		using value_t = typename std::iterator_traits<ForwardIterator>::value_type;
+		using iter_category =
+		  typename std::iterator_traits<ForwardIterator>::iterator_category;
+		constexpr std::size_t block_size = 256;
+		std::uint64_t bits[block_size];
+		while( first != last ) {
+			std::size_t count = block_size;
+			if constexpr( std::is_base_of_v<std::random_access_iterator_tag,
+			                                iter_category> ) {
+				auto const remaining = static_cast<std::size_t>( last - first );
+				count = remaining < block_size ? remaining : block_size;
+			}
+			if constexpr( random_impl::has_generate_v<Engine> ) {
+				g.generate( bits, count );
+			} else {
+				for( std::size_t n = 0; n < count; ++n ) {
+					bits[n] = random_impl::bits64( g );
+				}
+			}
+			if constexpr( std::is_floating_point_v<Number> ) {
+				random_impl::store_block( first, last, count, [&]( std::size_t n ) {
+					return static_cast<value_t>(
+					  a + ( b - a ) * random_impl::to_unit_real<Number>( bits[n] ) );
+				} );
+			} else {
+				using unsigned_t = random_impl::unsigned_for_t<Number>;
+				random_impl::to_offsets( g,
+				                         bits,
+				                         count,
+				                         static_cast<unsigned_t>(
+				                           static_cast<unsigned_t>( b ) -
+				                           static_cast<unsigned_t>( a ) ) );
+				random_impl::store_block( first, last, count, [&]( std::size_t n ) {
+					return static_cast<value_t>( static_cast<Number>(
+					  static_cast<unsigned_t>( static_cast<unsigned_t>( a ) +
+					                           static_cast<unsigned_t>( bits[n] ) ) ) );
+				} );
+			}
+		}
 	}
-} // namespace daw::impl
+
+	namespace impl {
+		/// The generator behind randint and the other functions without an
+		/// engine parameter, seeded per thread
+		inline xoshiro256pp &global_rng( ) {
+			static thread_local auto e = [] {
+				auto rd = std::random_device{ };
+				auto const seed = ( static_cast<std::uint64_t>( rd( ) ) << 32U ) ^
+				                  static_cast<std::uint64_t>( rd( ) );
+				return xoshiro256pp( seed );
+			}( );
+			return e;
+		}
+
+		/// Bulk generator for random_fill, made from global_rng( ) on first use
+		inline std::unique_ptr<xoshiro256pp_lanes<>> &global_bulk_rng_ptr( ) {
+			static thread_local auto e = std::unique_ptr<xoshiro256pp_lanes<>>( );
+			return e;
+		}
+
+		inline xoshiro256pp_lanes<> &global_bulk_rng( ) {
+			auto &e = global_bulk_rng_ptr( );
+			if( not e ) {
+				// The lanes start at the global state jumped 0 to lanes - 1 times.
+				// A long jump moves the global engine past all of them, where
+				// split( ) would leave it at the start of lane 1
+				auto &g = global_rng( );
+				e = std::make_unique<xoshiro256pp_lanes<>>( g );
+				g.long_jump( );
+			}
+			return *e;
+		}
+	} // namespace impl
+} // namespace daw
 
 namespace daw {
 	template<typename IntType>
@@ -37,11 +753,7 @@ namespace daw {
 		static_assert( std::is_integral_v<IntType>,
 		               "IntType must be a valid integral type" );
 		daw::exception::daw_throw_on_false( a <= b, "a <= b must be true" );
-		using distribution_type = std::uniform_int_distribution<IntType>;
-		using param_type = typename distribution_type::param_type;
-
-		thread_local auto d = distribution_type( );
-		return d( impl::global_rng( ), param_type( a, b ) );
+		return uniform_int( impl::global_rng( ), a, b );
 	}
 
 	template<typename IntType>
@@ -51,11 +763,13 @@ namespace daw {
 	}
 
 	inline void reseed( ) {
-		impl::global_rng( ) = std::mt19937_64( );
+		impl::global_rng( ) = xoshiro256pp( );
+		impl::global_bulk_rng_ptr( ).reset( );
 	}
 
-	inline void reseed( std::default_random_engine::result_type value ) {
+	inline void reseed( std::uint64_t value ) {
 		impl::global_rng( ).seed( value );
+		impl::global_bulk_rng_ptr( ).reset( );
 	}
 
 	template<typename RandomIterator>
@@ -63,9 +777,14 @@ namespace daw {
 		using diff_t =
 		  typename std::iterator_traits<RandomIterator>::difference_type;
 
+		using udiff_t = std::make_unsigned_t<diff_t>;
+
+		auto &g = impl::global_rng( );
 		diff_t n = last - first;
 		for( diff_t i = n - 1; i > 0; --i ) {
-			daw::cswap( first[i], first[randint<diff_t>( 0, i )] );
+			auto const j = static_cast<diff_t>(
+			  uniform_below( g, static_cast<udiff_t>( i ) + 1U ) );
+			daw::cswap( first[i], first[j] );
 		}
 	}
 
@@ -76,12 +795,23 @@ namespace daw {
 	                         ForwardIterator const last,
 	                         IntType a,
 	                         IntType b ) {
-		static_assert( std::is_integral_v<IntType>,
-		               "IntType must be a valid integral type" );
+		static_assert( std::is_arithmetic_v<IntType>,
+		               "IntType must be a valid arithmetic type" );
 		daw::exception::daw_throw_on_false( a <= b, "a <= b must be true" );
-		while( first != last ) {
-			*first = static_cast<ItValueType>( randint<IntType>( a, b ) );
-			++first;
+		using iter_value_t =
+		  typename std::iterator_traits<ForwardIterator>::value_type;
+		if constexpr( std::is_same_v<ItValueType, iter_value_t> ) {
+			random_fill( impl::global_bulk_rng( ), first, last, a, b );
+		} else {
+			auto &g = impl::global_bulk_rng( );
+			while( first != last ) {
+				if constexpr( std::is_floating_point_v<IntType> ) {
+					*first = static_cast<ItValueType>( uniform_real( g, a, b ) );
+				} else {
+					*first = static_cast<ItValueType>( uniform_int( g, a, b ) );
+				}
+				++first;
+			}
 		}
 	}
 
@@ -157,6 +887,8 @@ namespace daw {
 #endif
 
 	public:
+		using result_type = size_t;
+
 #ifdef USE_CXSEED
 		static_random( ) = default;
 #endif
@@ -167,6 +899,14 @@ namespace daw {
 			m_state = cxrand_impl::rand_lcg<sizeof( size_t )>( m_state );
 			return daw::fnv1a_hash( m_state );
 		}
+
+		[[nodiscard]] static constexpr result_type min( ) noexcept {
+			return 0;
+		}
+
+		[[nodiscard]] static constexpr result_type max( ) noexcept {
+			return ( std::numeric_limits<result_type>::max )( );
+		}
 	};
 
 	template<typename Integer, typename Engine = std::default_random_engine>
@@ -195,7 +935,11 @@ namespace daw {
 			  MinInclusive < MaxInclusive,
 			  "MinInclusive < MaxInclusive must be true" );
 
-			return m_dist( m_engine, param_type( MinInclusive, MaxInclusive ) );
+			if constexpr( random_impl::is_full_range_engine_v<Engine> ) {
+				return uniform_int( m_engine, MinInclusive, MaxInclusive );
+			} else {
+				return m_dist( m_engine, param_type( MinInclusive, MaxInclusive ) );
+			}
 		}
 	};
 
@@ -8,11 +8,15 @@
 #pragma once
 
 #include "ciso646.h"
+#include "daw_check_exceptions.h"
 #include "daw_move.h"
+#include "daw_remove_cvref.h"
 
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <cstdio>
+#include <cstring>
 #include <memory>
 #include <type_traits>
 
@@ -24,12 +28,20 @@ namespace daw {
 		  Size >= sizeof( void * ) ? Size : sizeof( void * );
 
 		std::aligned_storage_t<storage_size, Align> data{ };
-		enum class engaged_types : uint8_t { none, local, allocated };
+		enum class engaged_types : std::uint8_t { none, local, allocated };
 		engaged_types engaged = engaged_types::none;
 
+		/// Whether a T is stored in data, or allocated with a pointer to it stored
+		/// in data.  Only types that cannot throw when moved are stored locally,
+		/// so that moving the storage never throws
+		template<typename T>
+		static constexpr bool is_local_v =
+		  sizeof( T ) <= storage_size and alignof( T ) <= Align and
+		  std::is_nothrow_move_constructible_v<T>;
+
 		template<typename T>
 		[[nodiscard]] T *get( ) {
-			if constexpr( sizeof( T ) <= storage_size ) {
+			if constexpr( is_local_v<T> ) {
 				assert( engaged == engaged_types::local );
 				return reinterpret_cast<T *>( &data );
 			} else {
@@ -41,12 +53,12 @@ namespace daw {
 
 		template<typename T, typename AllocatedType = T>
 		[[nodiscard]] T const *get( ) const {
-			if constexpr( sizeof( AllocatedType ) <= storage_size ) {
-				assert( engaged == engaged_types::allocated );
+			if constexpr( is_local_v<AllocatedType> ) {
+				assert( engaged == engaged_types::local );
 				return reinterpret_cast<T const *>( &data );
 			} else {
 				assert( engaged == engaged_types::allocated );
-				return *reinterpret_cast<T const **>( &data );
+				return *reinterpret_cast<AllocatedType *const *>( &data );
 			}
 		}
 
@@ -54,7 +66,7 @@ namespace daw {
 		         typename Allocator = std::allocator<std::remove_cv_t<T>>>
 		void deallocate( Allocator const &alloc = Allocator{ } ) {
 			static_assert( not std::is_array_v<T>, "Arrays unsupported" );
-			if constexpr( sizeof( T ) <= storage_size ) {
+			if constexpr( is_local_v<T> ) {
 				assert( engaged == engaged_types::local );
 				get<T>( )->~T( );
 			} else {
@@ -68,14 +80,13 @@ namespace daw {
 		}
 
 		template<typename T,
-		         typename Allocator =
-		           std::allocator<std::remove_cv_t<std::remove_cv_t<T>>>>
-		std::remove_cv_t<T> *allocate( T &&value,
-		                               Allocator const &alloc = Allocator{ } ) {
-			using base_type = std::remove_cv_t<T>;
+		         typename Allocator = std::allocator<daw::remove_cvref_t<T>>>
+		daw::remove_cvref_t<T> *allocate( T &&value,
+		                                  Allocator const &alloc = Allocator{ } ) {
+			using base_type = daw::remove_cvref_t<T>;
 			static_assert( not std::is_array_v<base_type>, "Arrays unsupported" );
 			assert( engaged == engaged_types::none );
-			if constexpr( sizeof( base_type ) <= storage_size ) {
+			if constexpr( is_local_v<base_type> ) {
 				if constexpr( std::is_aggregate_v<base_type> ) {
 					auto *result = new( &data ) base_type{ DAW_FWD( value ) };
 					engaged = engaged_types::local;
@@ -100,6 +111,69 @@ namespace daw {
 				return ptr;
 			}
 		}
+
+		/// Construct a T in place from args, allocating it with std::allocator<T>
+		/// when it does not fit in data
+		template<typename T, typename... Args>
+		T *emplace( Args &&...args ) {
+			static_assert( not std::is_array_v<T>, "Arrays unsupported" );
+			assert( engaged == engaged_types::none );
+			if constexpr( is_local_v<T> ) {
+				T *result = nullptr;
+				if constexpr( std::is_aggregate_v<T> ) {
+					result = new( &data ) T{ DAW_FWD( args )... };
+				} else {
+					result = new( &data ) T( DAW_FWD( args )... );
+				}
+				engaged = engaged_types::local;
+				return result;
+			} else {
+				using traits = std::allocator_traits<std::allocator<T>>;
+				auto allocator = std::allocator<T>( );
+				T *ptr = traits::allocate( allocator, 1 );
+#if defined( DAW_USE_EXCEPTIONS )
+				try {
+#endif
+					traits::construct( allocator, ptr, DAW_FWD( args )... );
+#if defined( DAW_USE_EXCEPTIONS )
+				} catch( ... ) {
+					traits::deallocate( allocator, ptr, 1 );
+					throw;
+				}
+#endif
+				new( &data ) T *{ ptr };
+				engaged = engaged_types::allocated;
+				return ptr;
+			}
+		}
+
+		/// Move the T held here into other, which must be empty, and leave this
+		/// empty.  Allocated values hand over their pointer and trivially copyable
+		/// local values are copied bytewise, neither call T's constructors
+		template<typename T>
+		T *move_to( sbo_storage &other ) noexcept {
+			assert( other.engaged == engaged_types::none );
+			if constexpr( is_local_v<T> ) {
+				assert( engaged == engaged_types::local );
+				if constexpr( std::is_trivially_copyable_v<T> ) {
+					std::memcpy( &other.data, &data, sizeof( T ) );
+					other.engaged = engaged_types::local;
+					engaged = engaged_types::none;
+					return other.template get<T>( );
+				} else {
+					T *result = other.template emplace<T>( std::move( *get<T>( ) ) );
+					deallocate<T>( );
+					return result;
+				}
+			} else {
+				assert( engaged == engaged_types::allocated );
+				T *ptr = get<T>( );
+				new( &other.data ) T *{ ptr };
+				other.engaged = engaged_types::allocated;
+				engaged = engaged_types::none;
+				return ptr;
+			}
+		}
 	};
 	static_assert( std::is_aggregate_v<sbo_storage<>> );
 
@@ -22,6 +22,7 @@
 #include <memory>
 #include <new>
 #include <type_traits>
+#include <utility>
 
 #if defined( DAW_HAS_GCC )
 #pragma GCC diagnostic push
@@ -336,6 +337,384 @@ namespace daw {
 			return !empty( );
 		}
 	};
+
+	namespace func_impl {
+		/// Inline buffer for move_only_function.  Callables that do not fit are
+		/// heap allocated and a pointer to them is stored here instead
+		template<std::size_t BufferSize, std::size_t Align>
+		struct mof_storage {
+			static constexpr std::size_t buffer_size =
+			  BufferSize >= sizeof( void * ) ? BufferSize : sizeof( void * );
+			static constexpr std::size_t buffer_align =
+			  Align >= alignof( void * ) ? Align : alignof( void * );
+
+			alignas( buffer_align ) unsigned char m_data[buffer_size];
+
+			/// Stored inline when it fits and moving it cannot throw, so that
+			/// moving the function is noexcept
+			template<typename F>
+			static constexpr bool is_local_v =
+			  sizeof( F ) <= buffer_size and alignof( F ) <= buffer_align and
+			  std::is_nothrow_move_constructible_v<F>;
+
+			template<typename F>
+			[[nodiscard]] F *get( ) const noexcept {
+				auto *data = const_cast<unsigned char *>( m_data );
+				if constexpr( is_local_v<F> ) {
+					return std::launder( reinterpret_cast<F *>( data ) );
+				} else {
+					return *std::launder( reinterpret_cast<F **>( data ) );
+				}
+			}
+
+			template<typename F, typename... Args>
+			void construct( Args &&...args ) {
+				if constexpr( is_local_v<F> ) {
+					::new( static_cast<void *>( m_data ) ) F( DAW_FWD( args )... );
+				} else {
+					::new( static_cast<void *>( m_data ) )
+					  F *( new F( DAW_FWD( args )... ) );
+				}
+			}
+		};
+
+		/// How to move and destroy the callable type erased in a mof_storage.  A
+		/// null member means the bytes can be copied or left as is, so types that
+		/// are trivially copyable or heap allocated skip the indirect call
+		template<typename Storage>
+		struct mof_ops {
+			void ( *relocate )( Storage &dest, Storage &src ) noexcept;
+			void ( *destroy )( Storage &storage ) noexcept;
+		};
+
+		template<typename F, typename Storage>
+		[[nodiscard]] constexpr mof_ops<Storage> make_mof_ops( ) noexcept {
+			if constexpr( not Storage::template is_local_v<F> ) {
+				return { nullptr, []( Storage &storage ) noexcept {
+					        delete storage.template get<F>( );
+				        } };
+			} else if constexpr( std::is_trivially_copyable_v<F> ) {
+				return { nullptr, nullptr };
+			} else {
+				return { []( Storage &dest, Storage &src ) noexcept {
+					        F *f = src.template get<F>( );
+					        dest.template construct<F>( std::move( *f ) );
+					        std::destroy_at( f );
+				        },
+				         []( Storage &storage ) noexcept {
+					         std::destroy_at( storage.template get<F>( ) );
+				         } };
+			}
+		}
+
+		template<typename F, typename Storage>
+		inline constexpr mof_ops<Storage> mof_ops_for = make_mof_ops<F, Storage>( );
+
+		/// How the invoker takes a parameter.  Small trivially copyable values are
+		/// passed in registers instead of through a reference
+		template<typename T>
+		using mof_param_t =
+		  std::conditional_t<daw::all_true_v<not std::is_reference_v<T>,
+		                                     std::is_trivially_copyable_v<T>,
+		                                     sizeof( T ) <= 2 * sizeof( void * )>,
+		                     T,
+		                     T &&>;
+
+		template<typename T>
+		struct is_in_place_type : std::false_type {};
+
+		template<typename T>
+		struct is_in_place_type<std::in_place_type_t<T>> : std::true_type {};
+
+		template<std::size_t BufferSize,
+		         std::size_t Align,
+		         bool IsConst,
+		         bool IsNoexcept,
+		         typename Result,
+		         typename... FuncArgs>
+		class move_only_function_base {
+			using storage_t = mof_storage<BufferSize, Align>;
+			using ops_t = mof_ops<storage_t>;
+			using invoker_t = Result ( * )( storage_t const &,
+			                                mof_param_t<FuncArgs>... );
+
+			storage_t m_storage;
+			invoker_t m_invoke = &invoke_empty;
+			ops_t const *m_ops = nullptr;
+
+			[[noreturn]] static Result invoke_empty( storage_t const &,
+			                                         mof_param_t<FuncArgs>... ) {
+				daw::exception::daw_throw<std::bad_function_call>( );
+			}
+
+			template<typename F>
+			static Result
+			invoke_func( storage_t const &storage,
+			             mof_param_t<FuncArgs>... args ) noexcept( IsNoexcept ) {
+				using ref_t = std::conditional_t<IsConst, F const &, F &>;
+				ref_t f = *storage.template get<F>( );
+				if constexpr( std::is_void_v<Result> ) {
+					(void)std::invoke( static_cast<ref_t>( f ),
+					                   static_cast<FuncArgs &&>( args )... );
+				} else {
+					return std::invoke( static_cast<ref_t>( f ),
+					                    static_cast<FuncArgs &&>( args )... );
+				}
+			}
+
+			template<typename F>
+			static constexpr bool is_callable_v = [] {
+				using ref_t = std::conditional_t<IsConst, F const &, F &>;
+				if constexpr( IsNoexcept ) {
+					return std::is_nothrow_invocable_r_v<Result, ref_t, FuncArgs...>;
+				} else {
+					return std::is_invocable_r_v<Result, ref_t, FuncArgs...>;
+				}
+			}( );
+
+			/// Func can be stored, as a decayed copy, and called.  Other
+			/// move_only_functions, nullptr and in_place_type tags are not
+			/// functions to store
+			template<typename Func>
+			static constexpr bool is_function_v = daw::all_true_v<
+			  not std::is_base_of_v<move_only_function_base,
+			                        daw::remove_cvref_t<Func>>,
+			  not is_in_place_type<daw::remove_cvref_t<Func>>::value,
+			  not std::is_same_v<daw::remove_cvref_t<Func>, std::nullptr_t>,
+			  std::is_constructible_v<std::decay_t<Func>, Func>,
+			  is_callable_v<std::decay_t<Func>>>;
+
+			template<typename F, typename... Args>
+			void emplace_func( Args &&...args ) {
+				m_storage.template construct<F>( DAW_FWD( args )... );
+				m_invoke = &invoke_func<F>;
+				constexpr ops_t const &ops = mof_ops_for<F, storage_t>;
+				if constexpr( ops.relocate != nullptr or ops.destroy != nullptr ) {
+					m_ops = &ops;
+				}
+			}
+
+			void move_from( move_only_function_base &other ) noexcept {
+				if( other.m_ops and other.m_ops->relocate ) {
+					other.m_ops->relocate( m_storage, other.m_storage );
+				} else {
+					m_storage = other.m_storage;
+				}
+				m_invoke = std::exchange( other.m_invoke, &invoke_empty );
+				m_ops = std::exchange( other.m_ops, nullptr );
+			}
+
+		protected:
+			template<typename... Args>
+			Result invoke( Args &&...args ) const noexcept( IsNoexcept ) {
+				return m_invoke( m_storage, DAW_FWD( args )... );
+			}
+
+		public:
+			move_only_function_base( ) noexcept = default;
+			move_only_function_base( std::nullptr_t ) noexcept {}
+
+			template<typename Func,
+			         std::enable_if_t<is_function_v<Func>, std::nullptr_t> = nullptr>
+			move_only_function_base( Func &&f ) {
+				using func_t = std::decay_t<Func>;
+				if constexpr( std::is_pointer_v<func_t> or
+				              std::is_member_pointer_v<func_t> ) {
+					if( f == nullptr ) {
+						return;
+					}
+				}
+				emplace_func<func_t>( DAW_FWD( f ) );
+			}
+
+			template<typename Func,
+			         std::enable_if_t<is_function_v<Func>, std::nullptr_t> = nullptr>
+			move_only_function_base &operator=( Func &&f ) {
+				*this = move_only_function_base( DAW_FWD( f ) );
+				return *this;
+			}
+
+			template<typename Func,
+			         typename... Args,
+			         std::enable_if_t<
+			           std::is_constructible_v<Func, Args...> and is_callable_v<Func>,
+			           std::nullptr_t> = nullptr>
+			explicit move_only_function_base( std::in_place_type_t<Func>,
+			                                  Args &&...args ) {
+				emplace_func<Func>( DAW_FWD( args )... );
+			}
+
+			move_only_function_base( move_only_function_base &&other ) noexcept {
+				move_from( other );
+			}
+
+			move_only_function_base &
+			operator=( move_only_function_base &&rhs ) noexcept {
+				if( this != &rhs ) {
+					reset( );
+					move_from( rhs );
+				}
+				return *this;
+			}
+
+			move_only_function_base( move_only_function_base const & ) = delete;
+			move_only_function_base &
+			operator=( move_only_function_base const & ) = delete;
+
+			~move_only_function_base( ) {
+				reset( );
+			}
+
+			move_only_function_base &operator=( std::nullptr_t ) noexcept {
+				reset( );
+				return *this;
+			}
+
+			void reset( ) noexcept {
+				if( m_ops and m_ops->destroy ) {
+					m_ops->destroy( m_storage );
+				}
+				m_invoke = &invoke_empty;
+				m_ops = nullptr;
+			}
+
+			void swap( move_only_function_base &other ) noexcept {
+				auto tmp = std::move( other );
+				other = std::move( *this );
+				*this = std::move( tmp );
+			}
+
+			[[nodiscard]] bool empty( ) const noexcept {
+				return m_invoke == &invoke_empty;
+			}
+
+			explicit operator bool( ) const noexcept {
+				return not empty( );
+			}
+		};
+	} // namespace func_impl
+
+	/// A move only owning function wrapper in the style of
+	/// std::move_only_function.  Callables up to BufferSize bytes that are
+	/// nothrow movable are stored inline, others are heap allocated.  The
+	/// invoker is a plain function pointer stored in the object, and
+	/// trivially copyable callables move with a memcpy and need no destroy
+	/// call.  Supports const and noexcept qualified signatures.  Calling an
+	/// empty function throws std::bad_function_call
+	template<typename Signature,
+	         std::size_t BufferSize = 4 * sizeof( void * ),
+	         std::size_t Align = alignof( std::max_align_t )>
+	class move_only_function;
+
+	template<typename Result,
+	         typename... FuncArgs,
+	         std::size_t BufferSize,
+	         std::size_t Align>
+	class move_only_function<Result( FuncArgs... ), BufferSize, Align>
+	  : public func_impl::move_only_function_base<BufferSize,
+	                                              Align,
+	                                              false,
+	                                              false,
+	                                              Result,
+	                                              FuncArgs...> {
+		using base_t = func_impl::move_only_function_base<BufferSize,
+		                                                  Align,
+		                                                  false,
+		                                                  false,
+		                                                  Result,
+		                                                  FuncArgs...>;
+
+	public:
+		using base_t::base_t;
+		using base_t::operator=;
+
+		Result operator( )( FuncArgs... args ) {
+			return this->invoke( DAW_FWD( args )... );
+		}
+	};
+
+	template<typename Result,
+	         typename... FuncArgs,
+	         std::size_t BufferSize,
+	         std::size_t Align>
+	class move_only_function<Result( FuncArgs... ) const, BufferSize, Align>
+	  : public func_impl::move_only_function_base<BufferSize,
+	                                              Align,
+	                                              true,
+	                                              false,
+	                                              Result,
+	                                              FuncArgs...> {
+		using base_t = func_impl::move_only_function_base<BufferSize,
+		                                                  Align,
+		                                                  true,
+		                                                  false,
+		                                                  Result,
+		                                                  FuncArgs...>;
+
+	public:
+		using base_t::base_t;
+		using base_t::operator=;
+
+		Result operator( )( FuncArgs... args ) const {
+			return this->invoke( DAW_FWD( args )... );
+		}
+	};
+
+	template<typename Result,
+	         typename... FuncArgs,
+	         std::size_t BufferSize,
+	         std::size_t Align>
+	class move_only_function<Result( FuncArgs... ) noexcept, BufferSize, Align>
+	  : public func_impl::move_only_function_base<BufferSize,
+	                                              Align,
+	                                              false,
+	                                              true,
+	                                              Result,
+	                                              FuncArgs...> {
+		using base_t = func_impl::move_only_function_base<BufferSize,
+		                                                  Align,
+		                                                  false,
+		                                                  true,
+		                                                  Result,
+		                                                  FuncArgs...>;
+
+	public:
+		using base_t::base_t;
+		using base_t::operator=;
+
+		Result operator( )( FuncArgs... args ) noexcept {
+			return this->invoke( DAW_FWD( args )... );
+		}
+	};
+
+	template<typename Result,
+	         typename... FuncArgs,
+	         std::size_t BufferSize,
+	         std::size_t Align>
+	class move_only_function<Result( FuncArgs... ) const noexcept,
+	                         BufferSize,
+	                         Align>
+	  : public func_impl::move_only_function_base<BufferSize,
+	                                              Align,
+	                                              true,
+	                                              true,
+	                                              Result,
+	                                              FuncArgs...> {
+		using base_t = func_impl::move_only_function_base<BufferSize,
+		                                                  Align,
+		                                                  true,
+		                                                  true,
+		                                                  Result,
+		                                                  FuncArgs...>;
+
+	public:
+		using base_t::base_t;
+		using base_t::operator=;
+
+		Result operator( )( FuncArgs... args ) const noexcept {
+			return this->invoke( DAW_FWD( args )... );
+		}
+	};
 } // namespace daw
 
 #if defined( DAW_HAS_GCC )
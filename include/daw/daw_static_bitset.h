@@ -15,12 +15,14 @@
 #include "daw_string_view.h"
 #include "daw_traits.h"
 #include "daw_utility.h"
+#include "impl/daw_bitset_words.h"
 #include "traits/daw_traits_conditional.h"
 
 #include <array>
 #include <cstdint>
 #include <iosfwd>
 #include <iterator>
+#include <string>
 #include <vector>
 
 namespace daw {
@@ -87,18 +89,15 @@ namespace daw {
 			return result;
 		}
 
+		/// The mask of the bits of the last element that are part of the set
 		template<size_t BitWidth, typename value_t>
 		constexpr value_t get_diff_mask( ) noexcept {
-			size_t bw = BitWidth;
-			if( bw > bsizeof<value_t> ) {
-				bw %= bsizeof<value_t>;
-			} else if( bw < bsizeof<value_t> ) {
-				bw = bsizeof<value_t> - bw;
-			}
-			if( bw == 0 ) {
+			constexpr size_t bw = BitWidth % bsizeof<value_t>;
+			if constexpr( bw == 0 ) {
 				return ( std::numeric_limits<value_t>::max )( );
+			} else {
+				return static_cast<value_t>( ( value_t{ 1 } << bw ) - 1U );
 			}
-			return daw::mask_msb<value_t>( bw );
 		}
 	} // namespace bitset_impl
 	inline constexpr bitset_impl::fmt_binary_t const fmt_binary{ };
@@ -108,7 +107,10 @@ namespace daw {
 	template<size_t BitWidth>
 	class static_bitset {
 		static_assert( BitWidth > 0 );
-		using value_t = uintmax_t;
+		using value_t = bitset_impl::word_t;
+
+		template<size_t>
+		friend class static_bitset;
 
 		static constexpr size_t const m_element_capacity =
 		  bitset_impl::get_elements_needed<BitWidth, value_t>( );
@@ -120,7 +122,7 @@ namespace daw {
 			value_t bit;
 		};
 
-		constexpr bit_address_t get_address( size_t index ) noexcept {
+		static constexpr bit_address_t get_address( size_t index ) noexcept {
 			bit_address_t result{ };
 			result.index = static_cast<value_t>( index / daw::bsizeof<value_t> );
 
@@ -131,48 +133,21 @@ namespace daw {
 		}
 
 		static constexpr void set_bit( value_t &value, value_t bit ) noexcept {
-			value |= static_cast<value_t>( bit << 1U );
+			value |= static_cast<value_t>( value_t{ 1 } << bit );
 		}
 
 		static constexpr void clear_bit( value_t &value, value_t bit ) noexcept {
-			value &= static_cast<value_t>( ~static_cast<value_t>( bit << 1U ) );
-		}
-
-		static constexpr bool get_bit( value_t &value, value_t bit ) noexcept {
-			return ( value & static_cast<value_t>( bit << 1U ) ) != 0U;
-		}
-
-		static constexpr size_t count_ones( value_t value ) noexcept {
-			size_t count = 0;
-			while( value ) {
-				value &= value - 1U;
-				++count;
-			}
-			return count;
+			value &= static_cast<value_t>( ~( value_t{ 1 } << bit ) );
 		}
 
-		static constexpr size_t count_zeros( value_t value ) noexcept {
-			return bsizeof<value_t> - count_ones( value );
+		static constexpr bool get_bit( value_t const &value,
+		                               value_t bit ) noexcept {
+			return ( value & static_cast<value_t>( value_t{ 1 } << bit ) ) != 0U;
 		}
 
-		template<size_t N>
-		static constexpr size_t
-		count_ones( std::array<value_t, N> const &values ) noexcept {
-			size_t count = 0;
-			for( size_t n = 0; n < N; ++n ) {
-				count += count_ones( values[n] );
-			}
-			return count;
-		}
-
-		template<size_t N>
-		static constexpr size_t
-		count_zeros( std::array<value_t, N> const &values ) noexcept {
-			size_t count = 0;
-			for( size_t n = 0; n < N; ++n ) {
-				count += count_zeros( values[n] );
-			}
-			return count;
+		/// Zero the bits past BitWidth in the last element
+		constexpr void mask_tail( ) noexcept {
+			m_data.back( ) &= bitset_impl::get_diff_mask<BitWidth, value_t>( );
 		}
 
 	public:
@@ -187,6 +162,10 @@ namespace daw {
 		using const_pointer = const_iterator;
 		using reverse_iterator = std::reverse_iterator<iterator>;
 		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+		using word_type = value_t;
+
+		/// Returned by find_first/find_next/select when there is no such bit
+		static constexpr size_t npos = bitset_impl::npos;
 
 		/// Construct a bitset of all zeros
 		///
@@ -197,12 +176,14 @@ namespace daw {
 		/// \param value lowest bytes in bitset
 		/// \param values bytes in bitset from lowest(left) to highest(right)
 		template<typename... Unsigned>
-		explicit static_bitset( uintmax_t value, Unsigned... values ) noexcept
-		  : m_data{ value, values... } {
+		explicit constexpr static_bitset( uintmax_t value,
+		                                  Unsigned... values ) noexcept
+		  : m_data{ static_cast<value_t>( value ),
+		            static_cast<value_t>( values )... } {
 
 			// Ensure that we do not have any data on the high bits that should not
 			// be there
-			m_data.back( ) &= bitset_impl::get_diff_mask<BitWidth, value_t>( );
+			mask_tail( );
 		}
 
 		/// Construct a bitset from a string of zeros and ones
@@ -239,8 +220,26 @@ namespace daw {
 		  size_t BitWidthOther,
 		  std::enable_if_t<( BitWidth > BitWidthOther ), std::nullptr_t> = nullptr>
 		constexpr static_bitset(
-		  static_bitset<BitWidthOther> const &other ) noexcept
-		  : m_data{ other.m_data } {}
+		  static_bitset<BitWidthOther> const &other ) noexcept {
+			for( size_t n = 0; n < other.m_data.size( ); ++n ) {
+				m_data[n] = other.m_data[n];
+			}
+		}
+
+		/// The number of bits in the set
+		[[nodiscard]] static constexpr size_t size( ) noexcept {
+			return BitWidth;
+		}
+
+		/// The number of 64 bit words holding the bits.  Bit n is bit n % 64 of
+		/// word n / 64 and the bits past size( ) are always zero
+		[[nodiscard]] static constexpr size_t word_count( ) noexcept {
+			return m_element_capacity;
+		}
+
+		[[nodiscard]] constexpr value_t const *word_data( ) const noexcept {
+			return m_data.data( );
+		}
 
 		/// Enable a specific bit in the bitset
 		/// \param index bit position in set
@@ -258,7 +257,7 @@ namespace daw {
 
 		/// Get a specific bit from the bitset
 		/// \param index bit position in set
-		constexpr bool get_bit( size_t index ) noexcept {
+		[[nodiscard]] constexpr bool get_bit( size_t index ) const noexcept {
 			auto const loc = get_address( index );
 			return get_bit( m_data[loc.index], loc.bit );
 		}
@@ -270,37 +269,73 @@ namespace daw {
 			}
 		}
 
+		/// Set all bits to one
+		constexpr void set_all( ) noexcept {
+			for( auto &v : m_data ) {
+				v = ~value_t{ 0 };
+			}
+			mask_tail( );
+		}
+
 		struct static_bitset_iterator {};
 		struct static_bitset_const_iterator {};
 		struct reference {};
 		struct const_reference {};
 
-		constexpr size_t one_count( ) const noexcept {
-			return count_ones( m_data );
+		[[nodiscard]] constexpr size_t one_count( ) const noexcept {
+			return bitset_impl::popcount( m_data.data( ), m_element_capacity );
+		}
+
+		[[nodiscard]] constexpr size_t zero_count( ) const noexcept {
+			return BitWidth - one_count( );
 		}
 
-		constexpr size_t zero_count( ) const noexcept {
-			return count_zeros( m_data );
+		/// Are any bits set
+		[[nodiscard]] constexpr bool any( ) const noexcept {
+			return find_first( ) != npos;
+		}
+
+		/// Are no bits set
+		[[nodiscard]] constexpr bool none( ) const noexcept {
+			return not any( );
+		}
+
+		/// The position of the lowest set bit, or npos
+		[[nodiscard]] constexpr size_t find_first( ) const noexcept {
+			return bitset_impl::find_next( m_data.data( ), m_element_capacity, 0 );
+		}
+
+		/// The position of the lowest set bit at or after pos, or npos
+		[[nodiscard]] constexpr size_t find_next( size_t pos ) const noexcept {
+			return bitset_impl::find_next( m_data.data( ), m_element_capacity, pos );
+		}
+
+		/// Call f( size_t pos ) for each set bit, in ascending order.  This skips
+		/// a whole word of zeros at a time
+		template<typename Func>
+		constexpr void for_each_set_bit( Func &&f ) const {
+			bitset_impl::for_each_set_bit( m_data.data( ), m_element_capacity, f );
+		}
+
+		/// The number of set bits in [0, pos)
+		[[nodiscard]] constexpr size_t rank( size_t pos ) const noexcept {
+			if( pos >= BitWidth ) {
+				return one_count( );
+			}
+			return bitset_impl::rank( m_data.data( ), pos );
+		}
+
+		/// The position of the set bit with k set bits below it, or npos.  For
+		/// repeated queries use bitset_rank_index
+		[[nodiscard]] constexpr size_t select( size_t k ) const noexcept {
+			return bitset_impl::select( m_data.data( ), m_element_capacity, k );
 		}
 
 		std::string to_string( bitset_impl::fmt_binary_t = fmt_binary ) const {
 			std::string result( BitWidth, '0' );
-			size_t pos = m_element_capacity - 1;
-			for( size_t index = 0; index < m_data.size( ); ++index ) {
-				auto value = m_data[index];
-				if( !value ) {
-					pos -= daw::bsizeof<value_t>;
-					continue;
-				}
-				while( value ) {
-					auto tmp = value & 1U;
-					if( tmp == 1 ) {
-						result[pos] = '1';
-					}
-					value >>= 1U;
-					--pos;
-				}
-			}
+			for_each_set_bit( [&]( size_t pos ) {
+				result[BitWidth - 1U - pos] = '1';
+			} );
 			return result;
 		}
 
@@ -345,12 +380,12 @@ namespace daw {
 		// Bitwise operations
 
 		template<size_t BitWidthRhs>
-		constexpr static_bitset
+		constexpr static_bitset &
 		operator|=( static_bitset<BitWidthRhs> const &rhs ) noexcept {
 			size_t const SZ = ( std::min )( m_data.size( ), rhs.m_data.size( ) );
-			for( size_t n = 0; n < SZ; ++n ) {
-				m_data[n] |= rhs.m_data[n];
-			}
+			bitset_impl::apply_words<false>(
+			  m_data.data( ), rhs.m_data.data( ), SZ, bitset_impl::or_op{ } );
+			mask_tail( );
 			return *this;
 		}
 
@@ -372,11 +407,9 @@ namespace daw {
 		constexpr static_bitset &
 		operator&=( static_bitset<BitWidthRhs> const &rhs ) noexcept {
 			size_t const SZ = ( std::min )( m_data.size( ), rhs.m_data.size( ) );
-			size_t n = 0;
-			for( ; n < SZ; ++n ) {
-				m_data[n] &= rhs.m_data[n];
-			}
-			for( ; n < m_data.size( ); ++n ) {
+			bitset_impl::apply_words<false>(
+			  m_data.data( ), rhs.m_data.data( ), SZ, bitset_impl::and_op{ } );
+			for( size_t n = SZ; n < m_data.size( ); ++n ) {
 				m_data[n] = 0U;
 			}
 			return *this;
@@ -390,22 +423,49 @@ namespace daw {
 			return result;
 		}
 
+		template<size_t BitWidthRhs>
+		constexpr static_bitset &
+		operator^=( static_bitset<BitWidthRhs> const &rhs ) noexcept {
+			size_t const SZ = ( std::min )( m_data.size( ), rhs.m_data.size( ) );
+			bitset_impl::apply_words<false>(
+			  m_data.data( ), rhs.m_data.data( ), SZ, bitset_impl::xor_op{ } );
+			mask_tail( );
+			return *this;
+		}
+
 		template<size_t BitWidthRhs>
 		constexpr static_bitset<( std::max )( BitWidth, BitWidthRhs )>
 		operator^( static_bitset<BitWidthRhs> const &rhs ) const noexcept {
-			static_bitset<( std::max )( BitWidth, BitWidthRhs )> result{ };
-			size_t n = 0;
-			for( ; n < m_data.size( ) and n < rhs.m_data.size( ); ++n ) {
-				result.m_data[n] = m_data[n] ^ rhs.m_data[n];
-			}
-			// A xor 0
-			for( ; n < m_data.size( ); ++n ) {
-				result.m_data[n] = m_data[n] ^ 0U;
-			}
-			for( ; n < rhs.m_data.size( ); ++n ) {
-				result.m_data[n] = 0U ^ rhs.m_data[n];
+			if constexpr( BitWidth >= BitWidthRhs ) {
+				static_bitset result( *this );
+				result ^= rhs;
+				return result;
+			} else {
+				static_bitset<BitWidthRhs> result( rhs );
+				result ^= *this;
+				return result;
 			}
-			return result;
+		}
+
+		/// Clear the bits that are set in rhs, *this &= ~rhs without the
+		/// temporary
+		template<size_t BitWidthRhs>
+		constexpr static_bitset &
+		and_not( static_bitset<BitWidthRhs> const &rhs ) noexcept {
+			size_t const SZ = ( std::min )( m_data.size( ), rhs.m_data.size( ) );
+			bitset_impl::apply_words<false>(
+			  m_data.data( ), rhs.m_data.data( ), SZ, bitset_impl::and_not_op{ } );
+			return *this;
+		}
+
+		/// The number of bits set in both, ( *this & rhs ).one_count( ) without
+		/// the temporary
+		template<size_t BitWidthRhs>
+		[[nodiscard]] constexpr size_t
+		count_and( static_bitset<BitWidthRhs> const &rhs ) const noexcept {
+			size_t const SZ = ( std::min )( m_data.size( ), rhs.m_data.size( ) );
+			return bitset_impl::count_words(
+			  m_data.data( ), rhs.m_data.data( ), SZ, bitset_impl::and_op{ } );
 		}
 
 		constexpr static_bitset operator~( ) const noexcept {
@@ -413,6 +473,7 @@ namespace daw {
 			for( size_t n = 0; n < m_data.size( ); ++n ) {
 				result.m_data[n] = ~m_data[n];
 			}
+			result.mask_tail( );
 			return result;
 		}
 
@@ -442,89 +503,18 @@ namespace daw {
 		template<size_t BitWidthRhs>
 		constexpr bool
 		operator!=( static_bitset<BitWidthRhs> const &rhs ) const noexcept {
-			size_t const last = ( std::min )( m_data.size( ), rhs.m_data.size( ) );
-			size_t n = 0;
-			for( ; n < last; ++n ) {
-				if( m_data[n] != rhs.m_data[n] ) {
-					return true;
-				}
-			}
-			for( ; n < m_data.size( ); ++n ) {
-				if( m_data[n] != 0U ) {
-					return true;
-				}
-			}
-			for( ; n < rhs.m_data.size( ); ++n ) {
-				if( 0U != rhs.m_data[n] ) {
-					return true;
-				}
-			}
-			return false;
+			return not operator==( rhs );
 		}
 
 		constexpr static_bitset &operator<<=( size_t bits ) noexcept {
-			if( bits >= BitWidth ) {
-				clear( );
-				return *this;
-			}
-			if( bits < bsizeof<value_t> ) {
-				value_t carry = 0U;
-				for( size_t n = 0; n < m_data.size( ); ++n ) {
-					value_t next_carry = ( m_data[n] & daw::mask_lsb<value_t>( bits ) ) >>
-					                     ( bsizeof<value_t> - bits );
-					m_data[n] <<= bits;
-					m_data[n] |= carry;
-					carry = next_carry;
-				}
-				return *this;
-			}
-			if( bits == bsizeof<value_t> ) {
-				for( size_t n = m_data.size( ); n > 0; --n ) {
-					auto pos = n - 1;
-					m_data[pos] = m_data[pos - 1];
-				}
-				m_data[0] = 0U;
-				return *this;
-			}
-			while( bits >= bsizeof<value_t> ) {
-				operator<<=( bsizeof<value_t> );
-				bits -= bsizeof<value_t>;
-			}
-			return operator<<=( bits );
+			bitset_impl::shift_left( m_data.data( ), m_element_capacity, bits );
+			mask_tail( );
+			return *this;
 		}
 
 		constexpr static_bitset &operator>>=( size_t bits ) noexcept {
-			if( bits >= BitWidth ) {
-				clear( );
-				return *this;
-			}
-			if( bits == 0U ) {
-				return *this;
-			}
-			if( bits < bsizeof<value_t> ) {
-				value_t carry = 0U;
-				for( size_t n = m_data.size( ); n > 0; --n ) {
-					auto const pos = n - 1;
-					value_t next_carry = ( m_data[pos] & daw::mask_msb<value_t>( bits ) )
-					                     << ( bsizeof<value_t> - bits );
-					m_data[pos] >>= bits;
-					m_data[pos] |= carry;
-					carry = next_carry;
-				}
-				return *this;
-			}
-			if( bits == bsizeof<value_t> ) {
-				for( size_t n = 0; n < m_data.size( ); ++n ) {
-					m_data[n] = m_data[n + 1];
-				}
-				m_data.back( ) = 0U;
-				return *this;
-			}
-			while( bits >= bsizeof<value_t> ) {
-				operator>>=( bsizeof<value_t> );
-				bits -= bsizeof<value_t>;
-			}
-			return operator>>=( bits );
+			bitset_impl::shift_right( m_data.data( ), m_element_capacity, bits );
+			return *this;
 		}
 	};
 
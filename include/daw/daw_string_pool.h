@@ -0,0 +1,354 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw/ciso646.h"
+#include "daw/daw_arena_allocator.h"
+#include "daw/daw_attributes.h"
+#include "daw/daw_cxmath.h"
+#include "daw/daw_exception.h"
+#include "daw/daw_fnv1a_hash.h"
+#include "daw/daw_likely.h"
+#include "daw/daw_metro_hash.h"
+#include "daw/daw_string_view.h"
+#include "daw/daw_view.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace daw {
+	/// Hashes interned strings with daw::metro::hash64
+	struct string_pool_metro_hasher {
+		[[nodiscard]] constexpr std::uint64_t
+		operator( )( daw::string_view str ) const {
+			return daw::metro::hash64(
+			  daw::view<char const *>( str.data( ), str.data( ) + str.size( ) ),
+			  0 );
+		}
+	};
+
+	/// Hashes interned strings with daw::fnv1a_hash
+	struct string_pool_fnv1a_hasher {
+		[[nodiscard]] constexpr std::uint64_t
+		operator( )( daw::string_view str ) const noexcept {
+			return static_cast<std::uint64_t>(
+			  daw::fnv1a_hash( str.data( ), str.size( ) ) );
+		}
+	};
+
+	/// Identifies a string interned in a basic_string_pool.  Two handles from
+	/// the same pool are equal exactly when their strings are equal
+	class string_pool_handle {
+		std::uint32_t m_value = 0xFFFF'FFFFU;
+
+	public:
+		constexpr string_pool_handle( ) noexcept = default;
+		explicit constexpr string_pool_handle( std::uint32_t value ) noexcept
+		  : m_value( value ) {}
+
+		[[nodiscard]] constexpr std::uint32_t value( ) const noexcept {
+			return m_value;
+		}
+
+		[[nodiscard]] friend constexpr bool
+		operator==( string_pool_handle lhs, string_pool_handle rhs ) noexcept {
+			return lhs.m_value == rhs.m_value;
+		}
+
+		[[nodiscard]] friend constexpr bool
+		operator!=( string_pool_handle lhs, string_pool_handle rhs ) noexcept {
+			return lhs.m_value != rhs.m_value;
+		}
+
+		/// Orders by handle, not by string
+		[[nodiscard]] friend constexpr bool
+		operator<( string_pool_handle lhs, string_pool_handle rhs ) noexcept {
+			return lhs.m_value < rhs.m_value;
+		}
+	};
+
+	namespace string_pool_impl {
+		/// Interned strings are stored as a 32 bit length followed by the
+		/// characters and a null.  Everything else points at the characters
+		[[nodiscard]] DAW_ATTRIB_INLINE std::uint32_t
+		stored_size( char const *data ) noexcept {
+			std::uint32_t result;
+			std::memcpy( &result, data - sizeof( std::uint32_t ),
+			             sizeof( std::uint32_t ) );
+			return result;
+		}
+
+		/// A table slot.  index is the shard local index plus one, zero is
+		/// empty.  Keeping the data pointer here saves a miss on lookup
+		struct slot {
+			std::uint32_t hash;
+			std::uint32_t index;
+			char const *data;
+		};
+
+		/// Entries live in segments that double in size, so they never move and
+		/// can be read without a lock while others are appended
+		inline constexpr std::size_t first_segment_bits = 6U;
+		inline constexpr std::size_t segment_count = 32U - first_segment_bits + 1U;
+
+		[[nodiscard]] DAW_ATTRIB_INLINE constexpr std::size_t
+		segment_of( std::uint32_t index ) noexcept {
+			auto const n = static_cast<std::uint64_t>( index ) +
+			               ( std::uint64_t{ 1 } << first_segment_bits );
+			return static_cast<std::size_t>(
+			  63U - daw::cxmath::count_leading_zeroes( n ) - first_segment_bits );
+		}
+
+		[[nodiscard]] DAW_ATTRIB_INLINE constexpr std::size_t
+		segment_offset( std::uint32_t index, std::size_t segment ) noexcept {
+			return static_cast<std::size_t>( index ) +
+			       ( std::size_t{ 1 } << first_segment_bits ) -
+			       ( std::size_t{ 1 } << ( segment + first_segment_bits ) );
+		}
+
+		[[nodiscard]] constexpr std::size_t
+		segment_size( std::size_t segment ) noexcept {
+			return std::size_t{ 1 } << ( segment + first_segment_bits );
+		}
+	} // namespace string_pool_impl
+
+	///
+	/// Interns strings.  Each distinct string is copied once into an append only
+	/// arena and identified by a 32 bit string_pool_handle, so repeated
+	/// identifiers can be compared and hashed as integers.  Views of interned
+	/// strings are stable, and null terminated, for the life of the pool.
+	/// The pool is split into 2^ShardBits shards chosen by hash, each with its
+	/// own lock, table and arena, so lookups share a lock and inserts into
+	/// different shards do not contend.  view( ) takes no lock.
+	/// Memory is only freed when the pool is destroyed
+	///
+	template<typename Hasher = string_pool_metro_hasher,
+	         std::size_t ShardBits = 4U>
+	class basic_string_pool {
+		static_assert( ShardBits <= 8U, "At most 256 shards are supported" );
+		using slot = string_pool_impl::slot;
+
+		static constexpr std::size_t shard_count = std::size_t{ 1 } << ShardBits;
+		static constexpr std::uint32_t shard_mask =
+		  static_cast<std::uint32_t>( shard_count - 1U );
+		/// Leaves the all ones value for a default constructed handle
+		static constexpr std::uint32_t max_shard_size = static_cast<std::uint32_t>(
+		  ( std::uint64_t{ 1 } << ( 32U - ShardBits ) ) - 1U );
+
+		struct alignas( 64 ) shard {
+			mutable std::shared_mutex mutex{ };
+			std::vector<slot> table{ };
+			std::uint32_t size = 0;
+			std::array<std::atomic<char const **>,
+			           string_pool_impl::segment_count>
+			  segments{ };
+			daw::memory::monotonic_arena arena{ };
+		};
+
+		std::array<shard, shard_count> m_shards{ };
+		DAW_NO_UNIQUE_ADDRESS Hasher m_hasher{ };
+
+		[[nodiscard]] DAW_ATTRIB_INLINE static char const *
+		get_data( shard const &s, std::uint32_t index ) noexcept {
+			auto const seg = string_pool_impl::segment_of( index );
+			return s.segments[seg].load( std::memory_order_acquire )
+			  [string_pool_impl::segment_offset( index, seg )];
+		}
+
+		/// Must hold s.mutex.  Returns the shard local index
+		[[nodiscard]] static std::optional<std::uint32_t>
+		find_in( shard const &s, std::uint32_t hash, daw::string_view str ) {
+			if( s.table.empty( ) ) {
+				return std::nullopt;
+			}
+			auto const mask = s.table.size( ) - 1U;
+			auto pos = static_cast<std::size_t>( hash ) & mask;
+			while( true ) {
+				slot const sl = s.table[pos];
+				if( sl.index == 0 ) {
+					return std::nullopt;
+				}
+				if( sl.hash == hash ) {
+					auto const size = string_pool_impl::stored_size( sl.data );
+					if( size == str.size( ) and
+					    ( size == 0 or
+					      std::memcmp( sl.data, str.data( ), size ) == 0 ) ) {
+						return sl.index - 1U;
+					}
+				}
+				pos = ( pos + 1U ) & mask;
+			}
+		}
+
+		/// Must hold s.mutex exclusively
+		static void insert_slot( std::vector<slot> &table, slot sl ) noexcept {
+			auto const mask = table.size( ) - 1U;
+			auto pos = static_cast<std::size_t>( sl.hash ) & mask;
+			while( table[pos].index != 0 ) {
+				pos = ( pos + 1U ) & mask;
+			}
+			table[pos] = sl;
+		}
+
+		/// Must hold s.mutex exclusively.  Keeps the load at or below 3/4
+		static void grow_if_needed( shard &s ) {
+			auto const capacity = s.table.size( );
+			if( ( static_cast<std::size_t>( s.size ) + 1U ) * 4U <= capacity * 3U ) {
+				return;
+			}
+			auto table = std::vector<slot>( capacity == 0 ? 16U : capacity * 2U,
+			                                slot{ 0, 0, nullptr } );
+			for( slot const &sl : s.table ) {
+				if( sl.index != 0 ) {
+					insert_slot( table, sl );
+				}
+			}
+			s.table = std::move( table );
+		}
+
+		/// Must hold s.mutex exclusively
+		[[nodiscard]] static std::uint32_t add( shard &s, std::uint32_t hash,
+		                                        daw::string_view str ) {
+			daw::exception::precondition_check<std::length_error>(
+			  s.size < max_shard_size, "string_pool shard is full" );
+			daw::exception::precondition_check<std::length_error>(
+			  str.size( ) <= 0xFFFF'FFFFU, "string is too long to intern" );
+			grow_if_needed( s );
+			std::uint32_t const index = s.size;
+			auto const seg = string_pool_impl::segment_of( index );
+			char const **segment = s.segments[seg].load( std::memory_order_relaxed );
+			if( segment == nullptr ) {
+				auto const count = string_pool_impl::segment_size( seg );
+				segment = static_cast<char const **>( s.arena.allocate(
+				  sizeof( char const * ) * count, alignof( char const * ) ) );
+				s.segments[seg].store( segment, std::memory_order_release );
+			}
+			auto const size = static_cast<std::uint32_t>( str.size( ) );
+			auto *const mem = static_cast<char *>( s.arena.allocate(
+			  sizeof( std::uint32_t ) + str.size( ) + 1U, 1U ) );
+			std::memcpy( mem, &size, sizeof( std::uint32_t ) );
+			char *const data = mem + sizeof( std::uint32_t );
+			if( size != 0 ) {
+				std::memcpy( data, str.data( ), str.size( ) );
+			}
+			data[str.size( )] = '\0';
+			segment[string_pool_impl::segment_offset( index, seg )] = data;
+			insert_slot( s.table, slot{ hash, index + 1U, data } );
+			++s.size;
+			return index;
+		}
+
+		[[nodiscard]] DAW_ATTRIB_INLINE static constexpr string_pool_handle
+		make_handle( std::uint32_t shard_idx, std::uint32_t index ) noexcept {
+			return string_pool_handle(
+			  static_cast<std::uint32_t>( index << ShardBits ) | shard_idx );
+		}
+
+	public:
+		basic_string_pool( ) = default;
+		explicit basic_string_pool( Hasher const &hasher )
+		  : m_hasher( hasher ) {}
+
+		basic_string_pool( basic_string_pool const & ) = delete;
+		basic_string_pool &operator=( basic_string_pool const & ) = delete;
+
+		/// The handle of str, copying it into the pool the first time it is seen
+		[[nodiscard]] string_pool_handle intern( daw::string_view str ) {
+			auto const hash = static_cast<std::uint64_t>( m_hasher( str ) );
+			auto const shard_idx = static_cast<std::uint32_t>( hash ) & shard_mask;
+			auto const table_hash = static_cast<std::uint32_t>( hash >> ShardBits );
+			shard &s = m_shards[shard_idx];
+			{
+				auto const lock = std::shared_lock<std::shared_mutex>( s.mutex );
+				if( auto idx = find_in( s, table_hash, str ); DAW_LIKELY( idx ) ) {
+					return make_handle( shard_idx, *idx );
+				}
+			}
+			auto const lock = std::unique_lock<std::shared_mutex>( s.mutex );
+			// Another thread may have added it between the locks
+			if( auto idx = find_in( s, table_hash, str ); idx ) {
+				return make_handle( shard_idx, *idx );
+			}
+			return make_handle( shard_idx, add( s, table_hash, str ) );
+		}
+
+		/// The handle of str if it has been interned
+		[[nodiscard]] std::optional<string_pool_handle>
+		find( daw::string_view str ) const {
+			auto const hash = static_cast<std::uint64_t>( m_hasher( str ) );
+			auto const shard_idx = static_cast<std::uint32_t>( hash ) & shard_mask;
+			shard const &s = m_shards[shard_idx];
+			auto const lock = std::shared_lock<std::shared_mutex>( s.mutex );
+			if( auto idx =
+			      find_in( s, static_cast<std::uint32_t>( hash >> ShardBits ), str );
+			    idx ) {
+				return make_handle( shard_idx, *idx );
+			}
+			return std::nullopt;
+		}
+
+		/// The string for a handle returned by this pool
+		[[nodiscard]] DAW_ATTRIB_INLINE daw::string_view
+		view( string_pool_handle handle ) const noexcept {
+			shard const &s = m_shards[handle.value( ) & shard_mask];
+			char const *const data = get_data( s, handle.value( ) >> ShardBits );
+			return daw::string_view( data, string_pool_impl::stored_size( data ) );
+		}
+
+		[[nodiscard]] DAW_ATTRIB_INLINE daw::string_view
+		operator[]( string_pool_handle handle ) const noexcept {
+			return view( handle );
+		}
+
+		/// The number of distinct strings interned
+		[[nodiscard]] std::size_t size( ) const {
+			std::size_t result = 0;
+			for( shard const &s : m_shards ) {
+				auto const lock = std::shared_lock<std::shared_mutex>( s.mutex );
+				result += s.size;
+			}
+			return result;
+		}
+
+		[[nodiscard]] bool empty( ) const {
+			return size( ) == 0;
+		}
+
+		/// Bytes held by the pool's arenas and tables
+		[[nodiscard]] std::size_t memory_used( ) const {
+			std::size_t result = sizeof( basic_string_pool );
+			for( shard const &s : m_shards ) {
+				auto const lock = std::shared_lock<std::shared_mutex>( s.mutex );
+				result += s.arena.capacity( ) + s.table.capacity( ) * sizeof( slot );
+			}
+			return result;
+		}
+	};
+
+	using string_pool = basic_string_pool<>;
+} // namespace daw
+
+namespace std {
+	template<>
+	struct hash<daw::string_pool_handle> {
+		[[nodiscard]] constexpr std::size_t
+		operator( )( daw::string_pool_handle handle ) const noexcept {
+			return static_cast<std::size_t>( handle.value( ) );
+		}
+	};
+} // namespace std
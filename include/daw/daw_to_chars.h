@@ -0,0 +1,560 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw/ciso646.h"
+#include "daw/daw_arith_traits.h"
+#include "daw/daw_attributes.h"
+#include "daw/daw_bit_cast.h"
+#include "daw/daw_cxmath.h"
+#include "daw/daw_likely.h"
+#include "daw/impl/daw_make_trait.h"
+#include "daw/impl/daw_to_chars_tables.h"
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+///
+/// Integer and floating point to text.  Integers are written back to front
+/// two digits at a time from a lookup table, with the length found up front
+/// from the bit width.  Floating point uses the Schubfach algorithm to find
+/// the shortest decimal that round trips, and the output matches
+/// std::to_chars( first, last, value ) byte for byte
+///
+namespace daw {
+	namespace to_chars_impl {
+		template<typename T>
+		inline constexpr bool is_integer_v =
+		  std::is_integral_v<T> and not std::is_same_v<T, bool>;
+
+		template<typename T>
+		inline constexpr bool is_float_v =
+		  std::is_same_v<T, float> or std::is_same_v<T, double>;
+
+		inline constexpr std::uint64_t pow10_u64[20] = {
+		  1ULL,
+		  10ULL,
+		  100ULL,
+		  1'000ULL,
+		  10'000ULL,
+		  100'000ULL,
+		  1'000'000ULL,
+		  10'000'000ULL,
+		  100'000'000ULL,
+		  1'000'000'000ULL,
+		  10'000'000'000ULL,
+		  100'000'000'000ULL,
+		  1'000'000'000'000ULL,
+		  10'000'000'000'000ULL,
+		  100'000'000'000'000ULL,
+		  1'000'000'000'000'000ULL,
+		  10'000'000'000'000'000ULL,
+		  100'000'000'000'000'000ULL,
+		  1'000'000'000'000'000'000ULL,
+		  10'000'000'000'000'000'000ULL };
+
+		/// The number of decimal digits in value.  bit_width * log10( 2 ) is
+		/// off by at most one, and a single comparison fixes that
+		[[nodiscard]] DAW_ATTRIB_INLINE constexpr std::size_t
+		count_digits( std::uint64_t value ) noexcept {
+			auto const bits =
+			  64U - daw::cxmath::count_leading_zeroes( value | 1U );
+			auto const t = ( bits * 1233U ) >> 12U;
+			return static_cast<std::size_t>( t ) +
+			       static_cast<std::size_t>( ( value | 1U ) >= pow10_u64[t] );
+		}
+
+		DAW_ATTRIB_INLINE constexpr void copy_pair( char *dest,
+		                                            std::size_t pair ) noexcept {
+			dest[0] = digit_pairs[pair * 2U];
+			dest[1] = digit_pairs[pair * 2U + 1U];
+		}
+
+		/// Write the digits of value so that the last one is at last[-1].  The
+		/// caller has made room for all of them
+		template<typename Unsigned>
+		DAW_ATTRIB_INLINE constexpr void write_digits( char *last,
+		                                               Unsigned value ) noexcept {
+			while( value >= 100U ) {
+				auto const pair = static_cast<std::size_t>( value % 100U );
+				value /= 100U;
+				last -= 2;
+				copy_pair( last, pair );
+			}
+			if( value >= 10U ) {
+				copy_pair( last - 2, static_cast<std::size_t>( value ) );
+			} else {
+				last[-1] = static_cast<char>( '0' + static_cast<char>( value ) );
+			}
+		}
+
+		/// Write exactly 8 digits, including leading zeros
+		DAW_ATTRIB_INLINE constexpr void
+		write_eight_digits( char *first, std::uint32_t value ) noexcept {
+			auto const high = value / 10'000U;
+			auto const low = value % 10'000U;
+			copy_pair( first, high / 100U );
+			copy_pair( first + 2, high % 100U );
+			copy_pair( first + 4, low / 100U );
+			copy_pair( first + 6, low % 100U );
+		}
+
+		/// Write the count digits of value to first.  8 digit groups are split
+		/// off of large values so that the bulk of the work is 32bit arithmetic
+		DAW_ATTRIB_INLINE constexpr void
+		write_digits_n( char *first, std::uint64_t value,
+		                std::size_t count ) noexcept {
+			char *last = first + count;
+			while( value > std::numeric_limits<std::uint32_t>::max( ) ) {
+				last -= 8;
+				write_eight_digits(
+				  last, static_cast<std::uint32_t>( value % 100'000'000U ) );
+				value /= 100'000'000U;
+			}
+			write_digits( last, static_cast<std::uint32_t>( value ) );
+		}
+
+		struct decimal_fp {
+			std::uint64_t significand;
+			int exponent;
+		};
+
+		template<typename Float>
+		struct float_traits;
+
+		template<>
+		struct float_traits<double> {
+			using carrier_t = std::uint64_t;
+			static constexpr int significand_bits = 52;
+			static constexpr int exponent_bits = 11;
+			static constexpr int exponent_bias = 1023 + significand_bits;
+		};
+
+		template<>
+		struct float_traits<float> {
+			using carrier_t = std::uint32_t;
+			static constexpr int significand_bits = 23;
+			static constexpr int exponent_bits = 8;
+			static constexpr int exponent_bias = 127 + significand_bits;
+		};
+
+		[[nodiscard]] DAW_ATTRIB_INLINE constexpr uint128_pair
+		mul_64x64( std::uint64_t a, std::uint64_t b ) noexcept {
+#if defined( DAW_HAS_INT128 )
+			auto const p = static_cast<daw::uint128_t>( a ) * b;
+			return uint128_pair{ static_cast<std::uint64_t>( p >> 64U ),
+			                     static_cast<std::uint64_t>( p ) };
+#else
+			std::uint64_t const a_lo = a & 0xFFFF'FFFFU;
+			std::uint64_t const a_hi = a >> 32U;
+			std::uint64_t const b_lo = b & 0xFFFF'FFFFU;
+			std::uint64_t const b_hi = b >> 32U;
+			std::uint64_t const ll = a_lo * b_lo;
+			std::uint64_t const lh = a_lo * b_hi;
+			std::uint64_t const hl = a_hi * b_lo;
+			std::uint64_t const hh = a_hi * b_hi;
+			std::uint64_t const mid = ( ll >> 32U ) + ( lh & 0xFFFF'FFFFU ) +
+			                          ( hl & 0xFFFF'FFFFU );
+			return uint128_pair{ hh + ( lh >> 32U ) + ( hl >> 32U ) + ( mid >> 32U ),
+			                     ( mid << 32U ) | ( ll & 0xFFFF'FFFFU ) };
+#endif
+		}
+
+		/// floor( e * log10( 2 ) ), or floor( e * log10( 2 ) + log10( 3/4 ) )
+		/// when the lower boundary is closer.  Exact for |e| <= 1650
+		[[nodiscard]] DAW_ATTRIB_INLINE constexpr int
+		floor_log10_pow2( int e, bool lower_closer ) noexcept {
+			return ( e * 1262611 - ( lower_closer ? 524031 : 0 ) ) >> 22;
+		}
+
+		/// floor( e * log2( 10 ) ), exact for |e| <= 1233
+		[[nodiscard]] DAW_ATTRIB_INLINE constexpr int
+		floor_log2_pow10( int e ) noexcept {
+			return ( e * 1741647 ) >> 19;
+		}
+
+		[[nodiscard]] DAW_ATTRIB_INLINE constexpr uint128_pair
+		pow10_for( double, int k ) noexcept {
+			return pow10_double[k - pow10_double_min];
+		}
+
+		[[nodiscard]] DAW_ATTRIB_INLINE constexpr std::uint64_t
+		pow10_for( float, int k ) noexcept {
+			return pow10_float[k - pow10_float_min];
+		}
+
+		/// The top 64 bits of g * cp, with the lowest bit set when any of the
+		/// discarded bits are
+		[[nodiscard]] DAW_ATTRIB_INLINE constexpr std::uint64_t
+		round_to_odd( uint128_pair g, std::uint64_t cp ) noexcept {
+			auto const x = mul_64x64( g.lo, cp );
+			auto const y = mul_64x64( g.hi, cp );
+			std::uint64_t const z = y.lo + x.hi;
+			std::uint64_t const top = y.hi + static_cast<std::uint64_t>( z < x.hi );
+			return top | static_cast<std::uint64_t>( z > 1U );
+		}
+
+		/// The top 32 bits of g * cp, with the lowest bit set when any of the
+		/// discarded bits are
+		[[nodiscard]] DAW_ATTRIB_INLINE constexpr std::uint32_t
+		round_to_odd( std::uint64_t g, std::uint32_t cp ) noexcept {
+			auto const p = mul_64x64( g, cp );
+			auto const top = static_cast<std::uint32_t>( p.hi );
+			auto const rest = static_cast<std::uint32_t>( p.lo >> 32U );
+			return top | static_cast<std::uint32_t>( rest > 1U );
+		}
+
+		/// The shortest decimal in the rounding interval of a finite, non-zero
+		/// value, picking the closest when there are several.  See
+		/// "The Schubfach way to render doubles", Raffaello Giulietti
+		template<typename Float>
+		[[nodiscard]] constexpr decimal_fp
+		to_decimal( typename float_traits<Float>::carrier_t ieee_significand,
+		            int ieee_exponent ) noexcept {
+			using traits = float_traits<Float>;
+			using carrier_t = typename traits::carrier_t;
+			constexpr carrier_t hidden_bit = carrier_t{ 1 }
+			                                 << traits::significand_bits;
+
+			carrier_t c = ieee_significand;
+			int q = 1 - traits::exponent_bias;
+			if( ieee_exponent != 0 ) {
+				c |= hidden_bit;
+				q = ieee_exponent - traits::exponent_bias;
+				// Small integers are exact
+				if( 0 <= -q and -q <= traits::significand_bits ) {
+					carrier_t const fraction = c & ( ( carrier_t{ 1 } << -q ) - 1U );
+					if( fraction == 0 ) {
+						return decimal_fp{ static_cast<std::uint64_t>( c >> -q ), 0 };
+					}
+				}
+			}
+
+			bool const is_even = c % 2U == 0;
+			bool const lower_closer = ieee_significand == 0 and ieee_exponent > 1;
+
+			carrier_t const cbl =
+			  4U * c - 2U + static_cast<carrier_t>( lower_closer );
+			carrier_t const cb = 4U * c;
+			carrier_t const cbr = 4U * c + 2U;
+
+			int const k = floor_log10_pow2( q, lower_closer );
+			int const h = q + floor_log2_pow10( -k ) + 1;
+			auto const g = pow10_for( Float{ }, -k );
+
+			carrier_t const vbl =
+			  round_to_odd( g, static_cast<carrier_t>( cbl << h ) );
+			carrier_t const vb = round_to_odd( g, static_cast<carrier_t>( cb << h ) );
+			carrier_t const vbr =
+			  round_to_odd( g, static_cast<carrier_t>( cbr << h ) );
+
+			// The interval is closed for even significands
+			carrier_t const lower = vbl + static_cast<carrier_t>( not is_even );
+			carrier_t const upper = vbr - static_cast<carrier_t>( not is_even );
+
+			carrier_t const s = vb / 4U;
+			if( s >= 10U ) {
+				carrier_t const sp = s / 10U;
+				bool const up_inside = lower <= 40U * sp;
+				bool const wp_inside = 40U * sp + 40U <= upper;
+				if( up_inside != wp_inside ) {
+					return decimal_fp{ static_cast<std::uint64_t>( sp + wp_inside ),
+					                   k + 1 };
+				}
+			}
+			bool const u_inside = lower <= 4U * s;
+			bool const w_inside = 4U * s + 4U <= upper;
+			if( u_inside != w_inside ) {
+				return decimal_fp{ static_cast<std::uint64_t>( s + w_inside ), k };
+			}
+			carrier_t const mid = 4U * s + 2U;
+			bool const round_up = vb > mid or ( vb == mid and ( s & 1U ) != 0 );
+			return decimal_fp{ static_cast<std::uint64_t>( s + round_up ), k };
+		}
+
+		DAW_ATTRIB_INLINE constexpr void
+		remove_trailing_zeros( decimal_fp &dec ) noexcept {
+			while( dec.significand % 100U == 0 ) {
+				dec.significand /= 100U;
+				dec.exponent += 2;
+			}
+			if( dec.significand % 10U == 0 ) {
+				dec.significand /= 10U;
+				++dec.exponent;
+			}
+		}
+
+		[[nodiscard]] inline std::to_chars_result
+		copy_text( char *first, char *last, char const *text,
+		           std::size_t size ) noexcept {
+			if( DAW_UNLIKELY( static_cast<std::size_t>( last - first ) < size ) ) {
+				return { last, std::errc::value_too_large };
+			}
+			std::memcpy( first, text, size );
+			return { first + size, std::errc{ } };
+		}
+
+		/// Write the exact value of significand * 2^exponent, which is an integer
+		/// of count digits that is less than 2^128.  %f prints integers exactly,
+		/// where the shortest round trip digits would end in zeros
+		DAW_ATTRIB_NOINLINE inline void
+		write_exact_integer( char *first, std::size_t count,
+		                     std::uint64_t significand, int exponent ) noexcept {
+			// Little endian 32bit limbs of significand << exponent
+			std::uint32_t limbs[4]{ };
+			auto const limb_shift = static_cast<std::size_t>( exponent / 32 );
+			auto const bit_shift = static_cast<unsigned>( exponent % 32 );
+			std::uint64_t carry = 0;
+			for( std::size_t n = 0; n + limb_shift < 4U; ++n ) {
+				std::uint64_t const part =
+				  n < 2U ? ( significand >> ( 32U * n ) ) & 0xFFFF'FFFFU : 0U;
+				std::uint64_t const shifted = ( part << bit_shift ) | carry;
+				limbs[n + limb_shift] = static_cast<std::uint32_t>( shifted );
+				carry = shifted >> 32U;
+			}
+			char *last = first + count;
+			while( last - first > 8 ) {
+				// Long division by 10^8, with the remainder as the next 8 digits
+				std::uint64_t rem = 0;
+				for( std::size_t n = 4; n-- > 0; ) {
+					std::uint64_t const cur = ( rem << 32U ) | limbs[n];
+					limbs[n] = static_cast<std::uint32_t>( cur / 100'000'000U );
+					rem = cur % 100'000'000U;
+				}
+				last -= 8;
+				write_eight_digits( last, static_cast<std::uint32_t>( rem ) );
+			}
+			write_digits( last, limbs[0] );
+		}
+
+		/// The value as significand * 2^exponent
+		struct binary_fp {
+			std::uint64_t significand;
+			int exponent;
+		};
+
+		/// Lay out significand * 10^exponent the way printf's %f or %e would
+		/// with just enough precision, preferring %f on a tie in length
+		[[nodiscard]] inline std::to_chars_result
+		format_decimal( char *first, char *last, decimal_fp dec,
+		                binary_fp bin ) noexcept {
+			remove_trailing_zeros( dec );
+			auto const digits = count_digits( dec.significand );
+			auto const ndigits = static_cast<int>( digits );
+			// Position of the decimal point relative to the first digit
+			int const point = ndigits + dec.exponent;
+			int const sci_exp = point - 1;
+			auto const abs_exp = static_cast<unsigned>( sci_exp < 0 ? -sci_exp
+			                                                         : sci_exp );
+
+			std::size_t const sci_size =
+			  digits + static_cast<std::size_t>( digits > 1 ) + 4U +
+			  static_cast<std::size_t>( abs_exp >= 100U );
+			std::size_t const fixed_size =
+			  dec.exponent >= 0
+			    ? digits + static_cast<std::size_t>( dec.exponent )
+			  : point > 0 ? digits + 1U
+			              : digits + 2U + static_cast<std::size_t>( -point );
+
+			auto const space = static_cast<std::size_t>( last - first );
+			if( fixed_size <= sci_size ) {
+				if( DAW_UNLIKELY( space < fixed_size ) ) {
+					return { last, std::errc::value_too_large };
+				}
+				if( dec.exponent > 0 and bin.exponent > 0 ) {
+					write_exact_integer( first, fixed_size, bin.significand,
+					                     bin.exponent );
+				} else if( dec.exponent >= 0 ) {
+					write_digits_n( first, dec.significand, digits );
+					std::memset( first + digits, '0',
+					             static_cast<std::size_t>( dec.exponent ) );
+				} else if( point > 0 ) {
+					// Write the digits one to the right and pull the whole part
+					// back over the gap left for the decimal point
+					write_digits_n( first + 1, dec.significand, digits );
+					std::memmove( first, first + 1, static_cast<std::size_t>( point ) );
+					first[point] = '.';
+				} else {
+					auto const zeros = static_cast<std::size_t>( -point );
+					first[0] = '0';
+					first[1] = '.';
+					std::memset( first + 2, '0', zeros );
+					write_digits_n( first + 2 + zeros, dec.significand, digits );
+				}
+				return { first + fixed_size, std::errc{ } };
+			}
+
+			if( DAW_UNLIKELY( space < sci_size ) ) {
+				return { last, std::errc::value_too_large };
+			}
+			char *ptr = first;
+			if( digits > 1 ) {
+				write_digits_n( ptr + 1, dec.significand, digits );
+				ptr[0] = ptr[1];
+				ptr[1] = '.';
+				ptr += digits + 1U;
+			} else {
+				*ptr++ = static_cast<char>( '0' + dec.significand );
+			}
+			*ptr++ = 'e';
+			*ptr++ = sci_exp < 0 ? '-' : '+';
+			if( abs_exp >= 100U ) {
+				*ptr++ = static_cast<char>( '0' + abs_exp / 100U );
+				copy_pair( ptr, abs_exp % 100U );
+			} else {
+				copy_pair( ptr, abs_exp );
+			}
+			return { ptr + 2, std::errc{ } };
+		}
+
+		template<typename Float>
+		[[nodiscard]] std::to_chars_result
+		float_to_chars( char *first, char *last, Float value ) noexcept {
+			using traits = float_traits<Float>;
+			using carrier_t = typename traits::carrier_t;
+			constexpr int exponent_mask = ( 1 << traits::exponent_bits ) - 1;
+			constexpr carrier_t significand_mask =
+			  ( carrier_t{ 1 } << traits::significand_bits ) - 1U;
+
+			auto const bits = DAW_BIT_CAST( carrier_t, value );
+			carrier_t const significand = bits & significand_mask;
+			auto const exponent = static_cast<int>(
+			  ( bits >> traits::significand_bits ) & exponent_mask );
+			bool const is_negative =
+			  ( bits >> ( sizeof( carrier_t ) * 8U - 1U ) ) != 0;
+
+			if( is_negative ) {
+				if( DAW_UNLIKELY( first == last ) ) {
+					return { last, std::errc::value_too_large };
+				}
+				*first++ = '-';
+			}
+			if( DAW_UNLIKELY( exponent == exponent_mask ) ) {
+				if( significand == 0 ) {
+					return copy_text( first, last, "inf", 3 );
+				}
+				return copy_text( first, last, "nan", 3 );
+			}
+			if( significand == 0 and exponent == 0 ) {
+				return copy_text( first, last, "0", 1 );
+			}
+			auto const bin = binary_fp{
+			  exponent != 0 ? significand | ( significand_mask + 1U ) : significand,
+			  ( exponent != 0 ? exponent : 1 ) - traits::exponent_bias };
+			return format_decimal(
+			  first, last, to_decimal<Float>( significand, exponent ), bin );
+		}
+
+		struct append_probe {
+			std::size_t operator( )( char *, std::size_t ) const;
+		};
+
+		DAW_MAKE_REQ_TRAIT( has_append_and_overwrite_v,
+		                    std::declval<T &>( ).append_and_overwrite(
+		                      std::size_t{ }, append_probe{ } ) );
+
+		DAW_MAKE_REQ_TRAIT( has_resize_and_overwrite_v,
+		                    std::declval<T &>( ).resize_and_overwrite(
+		                      std::size_t{ }, append_probe{ } ) );
+	} // namespace to_chars_impl
+
+	/// The most chars that to_chars will write for a T
+	template<typename T>
+	inline constexpr std::size_t max_chars_v =
+	  std::is_same_v<T, double>  ? 24U
+	  : std::is_same_v<T, float> ? 15U
+	                             : static_cast<std::size_t>(
+	                                 std::numeric_limits<T>::digits10 + 2 );
+
+	/// Write value to [first, last) in base 10.  On failure the result is
+	/// { last, std::errc::value_too_large } as with std::to_chars
+	template<typename Integer,
+	         std::enable_if_t<to_chars_impl::is_integer_v<Integer>,
+	                          std::nullptr_t> = nullptr>
+	[[nodiscard]] constexpr std::to_chars_result
+	to_chars( char *first, char *last, Integer value ) noexcept {
+		static_assert( sizeof( Integer ) <= 8, "Unsupported integer size" );
+		using unsigned_t = std::make_unsigned_t<Integer>;
+		auto magnitude = static_cast<unsigned_t>( value );
+		if constexpr( std::is_signed_v<Integer> ) {
+			if( value < 0 ) {
+				if( DAW_UNLIKELY( first == last ) ) {
+					return { last, std::errc::value_too_large };
+				}
+				*first++ = '-';
+				magnitude = static_cast<unsigned_t>( unsigned_t{ 0 } - magnitude );
+			}
+		}
+		auto const count =
+		  to_chars_impl::count_digits( static_cast<std::uint64_t>( magnitude ) );
+		if( DAW_UNLIKELY( static_cast<std::size_t>( last - first ) < count ) ) {
+			return { last, std::errc::value_too_large };
+		}
+		using work_t = std::conditional_t<sizeof( Integer ) <= 4, std::uint32_t,
+		                                  std::uint64_t>;
+		to_chars_impl::write_digits( first + count,
+		                             static_cast<work_t>( magnitude ) );
+		return { first + count, std::errc{ } };
+	}
+
+	/// Write the shortest text that reads back as value, the same as
+	/// std::to_chars( first, last, value ).  On failure the result is
+	/// { last, std::errc::value_too_large }
+	template<typename Float,
+	         std::enable_if_t<to_chars_impl::is_float_v<Float>,
+	                          std::nullptr_t> = nullptr>
+	[[nodiscard]] inline std::to_chars_result
+	to_chars( char *first, char *last, Float value ) noexcept {
+		return to_chars_impl::float_to_chars( first, last, value );
+	}
+
+	/// Write value to an output iterator, returning the iterator after the
+	/// last char written
+	template<typename OutputIterator, typename T>
+	constexpr OutputIterator write_chars( OutputIterator out, T value ) {
+		char buff[max_chars_v<T>]{ };
+		auto const result = daw::to_chars( buff, buff + max_chars_v<T>, value );
+		for( char const *ptr = buff; ptr != result.ptr; ++ptr ) {
+			*out = *ptr;
+			++out;
+		}
+		return out;
+	}
+
+	/// Append value to the end of a char container.  daw::vector, and
+	/// std::string when it has resize_and_overwrite, are written in place
+	template<typename Container, typename T>
+	constexpr void append_chars( Container &container, T value ) {
+		if constexpr( to_chars_impl::has_append_and_overwrite_v<Container> ) {
+			(void)container.append_and_overwrite(
+			  max_chars_v<T>, [&]( char *ptr, std::size_t size ) {
+				  return static_cast<std::size_t>(
+				    daw::to_chars( ptr, ptr + size, value ).ptr - ptr );
+			  } );
+		} else if constexpr( to_chars_impl::has_resize_and_overwrite_v<
+		                       Container> ) {
+			auto const old_size = container.size( );
+			container.resize_and_overwrite(
+			  old_size + max_chars_v<T>, [&]( char *ptr, std::size_t size ) {
+				  return static_cast<std::size_t>(
+				    daw::to_chars( ptr + old_size, ptr + size, value ).ptr - ptr );
+			  } );
+		} else {
+			char buff[max_chars_v<T>]{ };
+			auto const result = daw::to_chars( buff, buff + max_chars_v<T>, value );
+			container.insert( container.end( ), buff, result.ptr );
+		}
+	}
+} // namespace daw
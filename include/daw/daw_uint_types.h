@@ -10,17 +10,26 @@
 
 #include "ciso646.h"
 #include "daw_arith_traits.h"
+#include "daw_cpp_feature_check.h"
+#include "daw_is_constant_evaluated.h"
 #include "traits/daw_traits_conditional.h"
 
 #include <cassert>
 #include <climits>
+#include <cstddef>
 #include <cstdint>
 #include <limits>
 #include <type_traits>
 #include <utility>
 
+#if defined( DAW_HAS_MSVC ) and defined( _M_X64 )
+#include <intrin.h>
+#endif
+
 namespace daw {
 	struct InvalidUIntSize;
+	struct UInt256;
+	struct UInt128;
 	enum class UInt64 : std::uint64_t {};
 	enum class UInt32 : std::uint32_t {};
 	enum class UInt16 : std::uint16_t {};
@@ -57,9 +66,16 @@ namespace daw {
 	  conditional_t<
 	    ( Bits == 16 ),
 	    UInt16,
-	    conditional_t<( Bits == 32 ),
-	                  UInt32,
-	                  conditional_t<( Bits == 64 ), UInt64, InvalidUIntSize>>>>;
+	    conditional_t<
+	      ( Bits == 32 ),
+	      UInt32,
+	      conditional_t<
+	        ( Bits == 64 ),
+	        UInt64,
+	        conditional_t<
+	          ( Bits == 128 ),
+	          UInt128,
+	          conditional_t<( Bits == 256 ), UInt256, InvalidUIntSize>>>>>>;
 
 	constexpr UInt64 &operator<<=( UInt64 &b, std::uint64_t shift ) noexcept {
 		auto tmp = static_cast<std::uint64_t>( b );
@@ -3046,9 +3062,939 @@ namespace daw {
 		return static_cast<UInt16>( result );
 	}
 
+	namespace uint_types_details {
+		[[nodiscard]] constexpr unsigned clz64( std::uint64_t v ) noexcept {
+#if DAW_HAS_BUILTIN( __builtin_clzll )
+			if( v == 0 ) {
+				return 64U;
+			}
+			return static_cast<unsigned>( __builtin_clzll( v ) );
+#else
+			unsigned result = 0;
+			for( auto mask = std::uint64_t{ 1 } << 63U;
+			     mask != 0 and ( v & mask ) == 0;
+			     mask >>= 1U ) {
+				++result;
+			}
+			return result;
+#endif
+		}
+
+		/// a + b + carry.  carry must be 0 or 1 and is set to the carry out
+		[[nodiscard]] constexpr std::uint64_t
+		add_carry( std::uint64_t a,
+		           std::uint64_t b,
+		           std::uint64_t &carry ) noexcept {
+			auto const sum = a + b;
+			auto const result = sum + carry;
+			carry = static_cast<std::uint64_t>( sum < a ) |
+			        static_cast<std::uint64_t>( result < sum );
+			return result;
+		}
+
+		/// a - b - borrow.  borrow must be 0 or 1 and is set to the borrow out
+		[[nodiscard]] constexpr std::uint64_t
+		sub_borrow( std::uint64_t a,
+		            std::uint64_t b,
+		            std::uint64_t &borrow ) noexcept {
+			auto const diff = a - b;
+			auto const result = diff - borrow;
+			borrow = static_cast<std::uint64_t>( a < b ) |
+			         static_cast<std::uint64_t>( diff < borrow );
+			return result;
+		}
+
+		/// The full 128 bit product of a and b
+		constexpr void mul64( std::uint64_t a, std::uint64_t b, std::uint64_t &hi,
+		                      std::uint64_t &lo ) noexcept {
+#if defined( DAW_HAS_INT128 )
+			auto const p = static_cast<uint128_t>( a ) * b;
+			hi = static_cast<std::uint64_t>( p >> 64U );
+			lo = static_cast<std::uint64_t>( p );
+#else
+#if defined( DAW_HAS_MSVC ) and defined( _M_X64 ) and \
+  defined( DAW_IS_CONSTANT_EVALUATED )
+			if( not DAW_IS_CONSTANT_EVALUATED( ) ) {
+				lo = _umul128( a, b, &hi );
+				return;
+			}
+#endif
+			auto const a_lo = a & 0xFFFF'FFFFULL;
+			auto const a_hi = a >> 32U;
+			auto const b_lo = b & 0xFFFF'FFFFULL;
+			auto const b_hi = b >> 32U;
+			auto const ll = a_lo * b_lo;
+			auto const lh = a_lo * b_hi;
+			auto const hl = a_hi * b_lo;
+			auto const hh = a_hi * b_hi;
+			auto const mid = ( ll >> 32U ) + ( lh & 0xFFFF'FFFFULL ) + hl;
+			hi = hh + ( lh >> 32U ) + ( mid >> 32U );
+			lo = ( mid << 32U ) | ( ll & 0xFFFF'FFFFULL );
+#endif
+		}
+
+		/// The value of the limbs above an integer being widened
+		template<typename Integer>
+		[[nodiscard]] constexpr std::uint64_t sign_fill( Integer v ) noexcept {
+			if constexpr( std::is_signed_v<Integer> ) {
+				return v < 0 ? ~std::uint64_t{ } : std::uint64_t{ };
+			} else {
+				(void)v;
+				return 0;
+			}
+		}
+
+		template<typename UIntN>
+		struct udivmod_result {
+			UIntN quot;
+			UIntN rem;
+		};
+
+		/// Restoring division, one quotient bit per step starting at the highest
+		/// set bit of the dividend.  Used when there is no native division
+		template<typename UIntN>
+		[[nodiscard]] constexpr udivmod_result<UIntN>
+		long_divide( UIntN const &n, UIntN const &d ) {
+			auto result = udivmod_result<UIntN>{ };
+			if( n < d ) {
+				result.rem = n;
+				return result;
+			}
+			for( auto bit = static_cast<int>( bit_width( n ) ) - 1; bit >= 0;
+			     --bit ) {
+				result.rem <<= 1U;
+				if( test_bit( n, static_cast<unsigned>( bit ) ) ) {
+					set_bit( result.rem, 0U );
+				}
+				if( not( result.rem < d ) ) {
+					result.rem -= d;
+					set_bit( result.quot, static_cast<unsigned>( bit ) );
+				}
+			}
+			return result;
+		}
+	} // namespace uint_types_details
+
+	/// The high 64 bits of the 128 bit product of a and b
+	[[nodiscard]] constexpr std::uint64_t mul_hi( std::uint64_t a,
+	                                              std::uint64_t b ) noexcept {
+		std::uint64_t hi = 0;
+		std::uint64_t lo = 0;
+		uint_types_details::mul64( a, b, hi, lo );
+		return hi;
+	}
+
+	/// Unsigned 128 bit integer with the wrapping semantics of the builtin
+	/// unsigned types.  Arithmetic uses the compiler's unsigned __int128 when
+	/// DAW_HAS_INT128 is defined and two 64 bit limbs otherwise.  Like the
+	/// UIntN enums, it is only explicitly constructible from builtin integers
+	struct UInt128 {
+		std::uint64_t lo = 0;
+		std::uint64_t hi = 0;
+
+		constexpr UInt128( ) = default;
+
+		template<typename Integer,
+		         std::enable_if_t<std::is_integral_v<Integer>, std::nullptr_t> =
+		           nullptr>
+		explicit constexpr UInt128( Integer v ) noexcept
+		  : lo( static_cast<std::uint64_t>( v ) )
+		  , hi( uint_types_details::sign_fill( v ) ) {}
+
+		constexpr UInt128( std::uint64_t high, std::uint64_t low ) noexcept
+		  : lo( low )
+		  , hi( high ) {}
+
+#if defined( DAW_HAS_INT128 )
+		explicit constexpr UInt128( uint128_t v ) noexcept
+		  : lo( static_cast<std::uint64_t>( v ) )
+		  , hi( static_cast<std::uint64_t>( v >> 64U ) ) {}
+
+		explicit constexpr operator uint128_t( ) const noexcept {
+			return ( static_cast<uint128_t>( hi ) << 64U ) | lo;
+		}
+#endif
+
+		template<typename Integer,
+		         std::enable_if_t<std::is_integral_v<Integer>, std::nullptr_t> =
+		           nullptr>
+		explicit constexpr operator Integer( ) const noexcept {
+			return static_cast<Integer>( lo );
+		}
+
+		explicit constexpr operator bool( ) const noexcept {
+			return ( lo | hi ) != 0;
+		}
+
+		[[nodiscard]] friend constexpr bool
+		operator==( UInt128 const &lhs, UInt128 const &rhs ) noexcept {
+			return lhs.lo == rhs.lo and lhs.hi == rhs.hi;
+		}
+
+		[[nodiscard]] friend constexpr bool
+		operator!=( UInt128 const &lhs, UInt128 const &rhs ) noexcept {
+			return not( lhs == rhs );
+		}
+
+		[[nodiscard]] friend constexpr bool
+		operator<( UInt128 const &lhs, UInt128 const &rhs ) noexcept {
+			return lhs.hi < rhs.hi or ( lhs.hi == rhs.hi and lhs.lo < rhs.lo );
+		}
+
+		[[nodiscard]] friend constexpr bool
+		operator>( UInt128 const &lhs, UInt128 const &rhs ) noexcept {
+			return rhs < lhs;
+		}
+
+		[[nodiscard]] friend constexpr bool
+		operator<=( UInt128 const &lhs, UInt128 const &rhs ) noexcept {
+			return not( rhs < lhs );
+		}
+
+		[[nodiscard]] friend constexpr bool
+		operator>=( UInt128 const &lhs, UInt128 const &rhs ) noexcept {
+			return not( lhs < rhs );
+		}
+
+		[[nodiscard]] friend constexpr UInt128
+		operator~( UInt128 const &v ) noexcept {
+			return UInt128( ~v.hi, ~v.lo );
+		}
+
+		constexpr UInt128 &operator&=( UInt128 const &rhs ) noexcept {
+			lo &= rhs.lo;
+			hi &= rhs.hi;
+			return *this;
+		}
+
+		constexpr UInt128 &operator|=( UInt128 const &rhs ) noexcept {
+			lo |= rhs.lo;
+			hi |= rhs.hi;
+			return *this;
+		}
+
+		constexpr UInt128 &operator^=( UInt128 const &rhs ) noexcept {
+			lo ^= rhs.lo;
+			hi ^= rhs.hi;
+			return *this;
+		}
+
+		/// Shifts of 128 or more bits result in 0
+		constexpr UInt128 &operator<<=( unsigned shift ) noexcept {
+			if( shift >= 128U ) {
+				*this = UInt128( );
+			} else if( shift >= 64U ) {
+				hi = lo << ( shift - 64U );
+				lo = 0;
+			} else if( shift > 0U ) {
+				hi = ( hi << shift ) | ( lo >> ( 64U - shift ) );
+				lo <<= shift;
+			}
+			return *this;
+		}
+
+		/// Shifts of 128 or more bits result in 0
+		constexpr UInt128 &operator>>=( unsigned shift ) noexcept {
+			if( shift >= 128U ) {
+				*this = UInt128( );
+			} else if( shift >= 64U ) {
+				lo = hi >> ( shift - 64U );
+				hi = 0;
+			} else if( shift > 0U ) {
+				lo = ( lo >> shift ) | ( hi << ( 64U - shift ) );
+				hi >>= shift;
+			}
+			return *this;
+		}
+
+		constexpr UInt128 &operator+=( UInt128 const &rhs ) noexcept {
+#if defined( DAW_HAS_INT128 )
+			*this = UInt128( static_cast<uint128_t>( *this ) +
+			                 static_cast<uint128_t>( rhs ) );
+#else
+			std::uint64_t carry = 0;
+			lo = uint_types_details::add_carry( lo, rhs.lo, carry );
+			hi = uint_types_details::add_carry( hi, rhs.hi, carry );
+#endif
+			return *this;
+		}
+
+		constexpr UInt128 &operator-=( UInt128 const &rhs ) noexcept {
+#if defined( DAW_HAS_INT128 )
+			*this = UInt128( static_cast<uint128_t>( *this ) -
+			                 static_cast<uint128_t>( rhs ) );
+#else
+			std::uint64_t borrow = 0;
+			lo = uint_types_details::sub_borrow( lo, rhs.lo, borrow );
+			hi = uint_types_details::sub_borrow( hi, rhs.hi, borrow );
+#endif
+			return *this;
+		}
+
+		constexpr UInt128 &operator*=( UInt128 const &rhs ) noexcept {
+#if defined( DAW_HAS_INT128 )
+			*this = UInt128( static_cast<uint128_t>( *this ) *
+			                 static_cast<uint128_t>( rhs ) );
+#else
+			std::uint64_t p_hi = 0;
+			std::uint64_t p_lo = 0;
+			uint_types_details::mul64( lo, rhs.lo, p_hi, p_lo );
+			hi = p_hi + lo * rhs.hi + hi * rhs.lo;
+			lo = p_lo;
+#endif
+			return *this;
+		}
+
+		/// Precondition: rhs != 0
+		constexpr UInt128 &operator/=( UInt128 const &rhs ) noexcept {
+			*this = divmod( *this, rhs ).quot;
+			return *this;
+		}
+
+		/// Precondition: rhs != 0
+		constexpr UInt128 &operator%=( UInt128 const &rhs ) noexcept {
+			*this = divmod( *this, rhs ).rem;
+			return *this;
+		}
+
+		constexpr UInt128 &operator++( ) noexcept {
+			return *this += UInt128( 1U );
+		}
+
+		constexpr UInt128 operator++( int ) noexcept {
+			auto result = *this;
+			++*this;
+			return result;
+		}
+
+		constexpr UInt128 &operator--( ) noexcept {
+			return *this -= UInt128( 1U );
+		}
+
+		constexpr UInt128 operator--( int ) noexcept {
+			auto result = *this;
+			--*this;
+			return result;
+		}
+
+		[[nodiscard]] friend constexpr UInt128
+		operator&( UInt128 lhs, UInt128 const &rhs ) noexcept {
+			lhs &= rhs;
+			return lhs;
+		}
+
+		[[nodiscard]] friend constexpr UInt128
+		operator|( UInt128 lhs, UInt128 const &rhs ) noexcept {
+			lhs |= rhs;
+			return lhs;
+		}
+
+		[[nodiscard]] friend constexpr UInt128
+		operator^( UInt128 lhs, UInt128 const &rhs ) noexcept {
+			lhs ^= rhs;
+			return lhs;
+		}
+
+		[[nodiscard]] friend constexpr UInt128
+		operator+( UInt128 lhs, UInt128 const &rhs ) noexcept {
+			lhs += rhs;
+			return lhs;
+		}
+
+		[[nodiscard]] friend constexpr UInt128
+		operator-( UInt128 lhs, UInt128 const &rhs ) noexcept {
+			lhs -= rhs;
+			return lhs;
+		}
+
+		[[nodiscard]] friend constexpr UInt128
+		operator*( UInt128 lhs, UInt128 const &rhs ) noexcept {
+			lhs *= rhs;
+			return lhs;
+		}
+
+		[[nodiscard]] friend constexpr UInt128
+		operator/( UInt128 lhs, UInt128 const &rhs ) noexcept {
+			lhs /= rhs;
+			return lhs;
+		}
+
+		[[nodiscard]] friend constexpr UInt128
+		operator%( UInt128 lhs, UInt128 const &rhs ) noexcept {
+			lhs %= rhs;
+			return lhs;
+		}
+
+		[[nodiscard]] friend constexpr UInt128
+		operator<<( UInt128 lhs, unsigned shift ) noexcept {
+			lhs <<= shift;
+			return lhs;
+		}
+
+		[[nodiscard]] friend constexpr UInt128
+		operator>>( UInt128 lhs, unsigned shift ) noexcept {
+			lhs >>= shift;
+			return lhs;
+		}
+
+		[[nodiscard]] friend constexpr unsigned
+		bit_width( UInt128 const &v ) noexcept {
+			if( v.hi != 0 ) {
+				return 128U - uint_types_details::clz64( v.hi );
+			}
+			return 64U - uint_types_details::clz64( v.lo );
+		}
+
+		[[nodiscard]] friend constexpr bool
+		test_bit( UInt128 const &v, unsigned bit ) noexcept {
+			return ( ( bit < 64U ? v.lo >> bit : v.hi >> ( bit - 64U ) ) & 1U ) != 0;
+		}
+
+		friend constexpr void set_bit( UInt128 &v, unsigned bit ) noexcept {
+			if( bit < 64U ) {
+				v.lo |= std::uint64_t{ 1 } << bit;
+			} else {
+				v.hi |= std::uint64_t{ 1 } << ( bit - 64U );
+			}
+		}
+
+		/// Quotient and remainder in one division.  Precondition: d != 0
+		[[nodiscard]] friend constexpr uint_types_details::udivmod_result<UInt128>
+		divmod( UInt128 const &n, UInt128 const &d ) noexcept {
+#if defined( DAW_HAS_INT128 )
+			auto const n128 = static_cast<uint128_t>( n );
+			auto const d128 = static_cast<uint128_t>( d );
+			return { UInt128( n128 / d128 ), UInt128( n128 % d128 ) };
+#else
+			if( ( n.hi | d.hi ) == 0 ) {
+				return { UInt128( n.lo / d.lo ), UInt128( n.lo % d.lo ) };
+			}
+			return uint_types_details::long_divide( n, d );
+#endif
+		}
+	};
+
+	/// Unsigned 256 bit integer with wrapping semantics, stored as four 64 bit
+	/// limbs, least significant first.  Addition and subtraction propagate a
+	/// carry through the limbs, multiplication is the truncated schoolbook
+	/// product of the limbs
+	struct UInt256 {
+		std::uint64_t limbs[4] = { };
+
+		constexpr UInt256( ) = default;
+
+		template<typename Integer,
+		         std::enable_if_t<std::is_integral_v<Integer>, std::nullptr_t> =
+		           nullptr>
+		explicit constexpr UInt256( Integer v ) noexcept
+		  : limbs{ static_cast<std::uint64_t>( v ),
+		           uint_types_details::sign_fill( v ),
+		           uint_types_details::sign_fill( v ),
+		           uint_types_details::sign_fill( v ) } {}
+
+		explicit constexpr UInt256( UInt128 const &v ) noexcept
+		  : limbs{ v.lo, v.hi, 0, 0 } {}
+
+		constexpr UInt256( UInt128 const &high, UInt128 const &low ) noexcept
+		  : limbs{ low.lo, low.hi, high.lo, high.hi } {}
+
+		[[nodiscard]] constexpr UInt128 low( ) const noexcept {
+			return UInt128( limbs[1], limbs[0] );
+		}
+
+		[[nodiscard]] constexpr UInt128 high( ) const noexcept {
+			return UInt128( limbs[3], limbs[2] );
+		}
+
+		explicit constexpr operator UInt128( ) const noexcept {
+			return low( );
+		}
+
+		template<typename Integer,
+		         std::enable_if_t<std::is_integral_v<Integer>, std::nullptr_t> =
+		           nullptr>
+		explicit constexpr operator Integer( ) const noexcept {
+			return static_cast<Integer>( limbs[0] );
+		}
+
+		explicit constexpr operator bool( ) const noexcept {
+			return ( limbs[0] | limbs[1] | limbs[2] | limbs[3] ) != 0;
+		}
+
+		[[nodiscard]] friend constexpr bool
+		operator==( UInt256 const &lhs, UInt256 const &rhs ) noexcept {
+			return lhs.limbs[0] == rhs.limbs[0] and lhs.limbs[1] == rhs.limbs[1] and
+			       lhs.limbs[2] == rhs.limbs[2] and lhs.limbs[3] == rhs.limbs[3];
+		}
+
+		[[nodiscard]] friend constexpr bool
+		operator!=( UInt256 const &lhs, UInt256 const &rhs ) noexcept {
+			return not( lhs == rhs );
+		}
+
+		[[nodiscard]] friend constexpr bool
+		operator<( UInt256 const &lhs, UInt256 const &rhs ) noexcept {
+			for( std::size_t n = 4; n-- > 0; ) {
+				if( lhs.limbs[n] != rhs.limbs[n] ) {
+					return lhs.limbs[n] < rhs.limbs[n];
+				}
+			}
+			return false;
+		}
+
+		[[nodiscard]] friend constexpr bool
+		operator>( UInt256 const &lhs, UInt256 const &rhs ) noexcept {
+			return rhs < lhs;
+		}
+
+		[[nodiscard]] friend constexpr bool
+		operator<=( UInt256 const &lhs, UInt256 const &rhs ) noexcept {
+			return not( rhs < lhs );
+		}
+
+		[[nodiscard]] friend constexpr bool
+		operator>=( UInt256 const &lhs, UInt256 const &rhs ) noexcept {
+			return not( lhs < rhs );
+		}
+
+		[[nodiscard]] friend constexpr UInt256 operator~( UInt256 v ) noexcept {
+			for( auto &l : v.limbs ) {
+				l = ~l;
+			}
+			return v;
+		}
+
+		constexpr UInt256 &operator&=( UInt256 const &rhs ) noexcept {
+			for( std::size_t n = 0; n < 4; ++n ) {
+				limbs[n] &= rhs.limbs[n];
+			}
+			return *this;
+		}
+
+		constexpr UInt256 &operator|=( UInt256 const &rhs ) noexcept {
+			for( std::size_t n = 0; n < 4; ++n ) {
+				limbs[n] |= rhs.limbs[n];
+			}
+			return *this;
+		}
+
+		constexpr UInt256 &operator^=( UInt256 const &rhs ) noexcept {
+			for( std::size_t n = 0; n < 4; ++n ) {
+				limbs[n] ^= rhs.limbs[n];
+			}
+			return *this;
+		}
+
+		/// Shifts of 256 or more bits result in 0
+		constexpr UInt256 &operator<<=( unsigned shift ) noexcept {
+			auto const limb_shift = shift / 64U;
+			auto const bit_shift = shift % 64U;
+			for( std::size_t n = 4; n-- > 0; ) {
+				std::uint64_t v = 0;
+				if( n >= limb_shift ) {
+					v = limbs[n - limb_shift] << bit_shift;
+					if( bit_shift != 0 and n > limb_shift ) {
+						v |= limbs[n - limb_shift - 1] >> ( 64U - bit_shift );
+					}
+				}
+				limbs[n] = v;
+			}
+			return *this;
+		}
+
+		/// Shifts of 256 or more bits result in 0
+		constexpr UInt256 &operator>>=( unsigned shift ) noexcept {
+			auto const limb_shift = shift / 64U;
+			auto const bit_shift = shift % 64U;
+			for( std::size_t n = 0; n < 4; ++n ) {
+				std::uint64_t v = 0;
+				if( n + limb_shift < 4 ) {
+					v = limbs[n + limb_shift] >> bit_shift;
+					if( bit_shift != 0 and n + limb_shift + 1 < 4 ) {
+						v |= limbs[n + limb_shift + 1] << ( 64U - bit_shift );
+					}
+				}
+				limbs[n] = v;
+			}
+			return *this;
+		}
+
+		constexpr UInt256 &operator+=( UInt256 const &rhs ) noexcept {
+			std::uint64_t carry = 0;
+			for( std::size_t n = 0; n < 4; ++n ) {
+				limbs[n] =
+				  uint_types_details::add_carry( limbs[n], rhs.limbs[n], carry );
+			}
+			return *this;
+		}
+
+		constexpr UInt256 &operator-=( UInt256 const &rhs ) noexcept {
+			std::uint64_t borrow = 0;
+			for( std::size_t n = 0; n < 4; ++n ) {
+				limbs[n] =
+				  uint_types_details::sub_borrow( limbs[n], rhs.limbs[n], borrow );
+			}
+			return *this;
+		}
+
+		constexpr UInt256 &operator*=( UInt256 const &rhs ) noexcept {
+			std::uint64_t result[4] = { };
+			for( std::size_t i = 0; i < 4; ++i ) {
+				std::uint64_t carry = 0;
+				for( std::size_t j = 0; i + j < 4; ++j ) {
+					std::uint64_t p_hi = 0;
+					std::uint64_t p_lo = 0;
+					uint_types_details::mul64( limbs[i], rhs.limbs[j], p_hi, p_lo );
+					std::uint64_t c = 0;
+					p_lo = uint_types_details::add_carry( p_lo, carry, c );
+					p_hi += c;
+					c = 0;
+					result[i + j] =
+					  uint_types_details::add_carry( result[i + j], p_lo, c );
+					carry = p_hi + c;
+				}
+			}
+			for( std::size_t n = 0; n < 4; ++n ) {
+				limbs[n] = result[n];
+			}
+			return *this;
+		}
+
+		/// Precondition: rhs != 0
+		constexpr UInt256 &operator/=( UInt256 const &rhs ) noexcept {
+			*this = divmod( *this, rhs ).quot;
+			return *this;
+		}
+
+		/// Precondition: rhs != 0
+		constexpr UInt256 &operator%=( UInt256 const &rhs ) noexcept {
+			*this = divmod( *this, rhs ).rem;
+			return *this;
+		}
+
+		constexpr UInt256 &operator++( ) noexcept {
+			return *this += UInt256( 1U );
+		}
+
+		constexpr UInt256 operator++( int ) noexcept {
+			auto result = *this;
+			++*this;
+			return result;
+		}
+
+		constexpr UInt256 &operator--( ) noexcept {
+			return *this -= UInt256( 1U );
+		}
+
+		constexpr UInt256 operator--( int ) noexcept {
+			auto result = *this;
+			--*this;
+			return result;
+		}
+
+		[[nodiscard]] friend constexpr UInt256
+		operator&( UInt256 lhs, UInt256 const &rhs ) noexcept {
+			lhs &= rhs;
+			return lhs;
+		}
+
+		[[nodiscard]] friend constexpr UInt256
+		operator|( UInt256 lhs, UInt256 const &rhs ) noexcept {
+			lhs |= rhs;
+			return lhs;
+		}
+
+		[[nodiscard]] friend constexpr UInt256
+		operator^( UInt256 lhs, UInt256 const &rhs ) noexcept {
+			lhs ^= rhs;
+			return lhs;
+		}
+
+		[[nodiscard]] friend constexpr UInt256
+		operator+( UInt256 lhs, UInt256 const &rhs ) noexcept {
+			lhs += rhs;
+			return lhs;
+		}
+
+		[[nodiscard]] friend constexpr UInt256
+		operator-( UInt256 lhs, UInt256 const &rhs ) noexcept {
+			lhs -= rhs;
+			return lhs;
+		}
+
+		[[nodiscard]] friend constexpr UInt256
+		operator*( UInt256 lhs, UInt256 const &rhs ) noexcept {
+			lhs *= rhs;
+			return lhs;
+		}
+
+		[[nodiscard]] friend constexpr UInt256
+		operator/( UInt256 lhs, UInt256 const &rhs ) noexcept {
+			lhs /= rhs;
+			return lhs;
+		}
+
+		[[nodiscard]] friend constexpr UInt256
+		operator%( UInt256 lhs, UInt256 const &rhs ) noexcept {
+			lhs %= rhs;
+			return lhs;
+		}
+
+		[[nodiscard]] friend constexpr UInt256
+		operator<<( UInt256 lhs, unsigned shift ) noexcept {
+			lhs <<= shift;
+			return lhs;
+		}
+
+		[[nodiscard]] friend constexpr UInt256
+		operator>>( UInt256 lhs, unsigned shift ) noexcept {
+			lhs >>= shift;
+			return lhs;
+		}
+
+		[[nodiscard]] friend constexpr unsigned
+		bit_width( UInt256 const &v ) noexcept {
+			for( std::size_t n = 4; n-- > 0; ) {
+				if( v.limbs[n] != 0 ) {
+					return static_cast<unsigned>( 64U * ( n + 1U ) ) -
+					       uint_types_details::clz64( v.limbs[n] );
+				}
+			}
+			return 0U;
+		}
+
+		[[nodiscard]] friend constexpr bool
+		test_bit( UInt256 const &v, unsigned bit ) noexcept {
+			return ( ( v.limbs[bit / 64U] >> ( bit % 64U ) ) & 1U ) != 0;
+		}
+
+		friend constexpr void set_bit( UInt256 &v, unsigned bit ) noexcept {
+			v.limbs[bit / 64U] |= std::uint64_t{ 1 } << ( bit % 64U );
+		}
+
+		/// Quotient and remainder in one division.  Precondition: d != 0
+		[[nodiscard]] friend constexpr uint_types_details::udivmod_result<UInt256>
+		divmod( UInt256 const &n, UInt256 const &d ) noexcept {
+			return uint_types_details::long_divide( n, d );
+		}
+	};
+
+	/// The full 128 bit product of a and b
+	[[nodiscard]] constexpr UInt128 mul_wide( std::uint64_t a,
+	                                          std::uint64_t b ) noexcept {
+		auto result = UInt128( );
+		uint_types_details::mul64( a, b, result.hi, result.lo );
+		return result;
+	}
+
+	/// The full 256 bit product of a and b
+	[[nodiscard]] constexpr UInt256 mul_wide( UInt128 const &a,
+	                                          UInt128 const &b ) noexcept {
+		auto const ll = mul_wide( a.lo, b.lo );
+		auto const lh = mul_wide( a.lo, b.hi );
+		auto const hl = mul_wide( a.hi, b.lo );
+		auto const hh = mul_wide( a.hi, b.hi );
+		auto result = UInt256( hh, ll );
+		std::uint64_t carry = 0;
+		result.limbs[1] =
+		  uint_types_details::add_carry( result.limbs[1], lh.lo, carry );
+		result.limbs[2] =
+		  uint_types_details::add_carry( result.limbs[2], lh.hi, carry );
+		result.limbs[3] += carry;
+		carry = 0;
+		result.limbs[1] =
+		  uint_types_details::add_carry( result.limbs[1], hl.lo, carry );
+		result.limbs[2] =
+		  uint_types_details::add_carry( result.limbs[2], hl.hi, carry );
+		result.limbs[3] += carry;
+		return result;
+	}
+
+	/// The high 128 bits of the 256 bit product of a and b
+	[[nodiscard]] constexpr UInt128 mul_hi( UInt128 const &a,
+	                                        UInt128 const &b ) noexcept {
+		auto const ll = mul_wide( a.lo, b.lo );
+		auto const lh = mul_wide( a.lo, b.hi );
+		auto const hl = mul_wide( a.hi, b.lo );
+		auto const hh = mul_wide( a.hi, b.hi );
+		// Cannot overflow, each term is less than 2^64
+		auto const cross = UInt128( ll.hi ) + UInt128( lh.lo ) + UInt128( hl.lo );
+		return hh + UInt128( lh.hi ) + UInt128( hl.hi ) + UInt128( cross.hi );
+	}
+
+	/// Division of UInt128 values by a divisor fixed at construction.  The
+	/// reciprocal is computed once so each division is a mul_hi, a subtract and
+	/// shifts(Granlund and Montgomery, "Division by Invariant Integers using
+	/// Multiplication", figure 4.1).  Powers of two are a single shift
+	struct uint128_divider {
+	private:
+		UInt128 m_magic = UInt128( );
+		unsigned m_shift = 0;
+		bool m_is_pow2 = true;
+
+	public:
+		/// Precondition: divisor != 0
+		explicit constexpr uint128_divider( UInt128 const &divisor ) noexcept {
+			auto const width = bit_width( divisor );
+			if( ( divisor & ( divisor - UInt128( 1U ) ) ) == UInt128( ) ) {
+				m_shift = width - 1U;
+				return;
+			}
+			m_is_pow2 = false;
+			m_shift = width - 1U;
+			// floor( 2^128 * ( 2^width - divisor ) / divisor ) + 1
+			auto const numerator =
+			  ( ( UInt256( 1U ) << width ) - UInt256( divisor ) ) << 128U;
+			m_magic =
+			  ( numerator / UInt256( divisor ) ).low( ) + UInt128( 1U );
+		}
+
+		[[nodiscard]] constexpr UInt128 divide( UInt128 const &n ) const noexcept {
+			if( m_is_pow2 ) {
+				return n >> m_shift;
+			}
+			auto const q = mul_hi( m_magic, n );
+			return ( ( ( n - q ) >> 1U ) + q ) >> m_shift;
+		}
+
+		[[nodiscard]] friend constexpr UInt128
+		operator/( UInt128 const &n, uint128_divider const &d ) noexcept {
+			return d.divide( n );
+		}
+	};
 } // namespace daw
 
 namespace std {
+	template<>
+	struct numeric_limits<daw::UInt128> {
+		static constexpr bool is_specialized = true;
+		static constexpr bool is_signed = false;
+		static constexpr bool is_integer = true;
+		static constexpr bool is_exact = true;
+		static constexpr bool has_infinity = false;
+		static constexpr bool has_quiet_NaN = false;
+		static constexpr bool has_signaling_NaN = false;
+		static constexpr bool has_denorm = false;
+		static constexpr bool has_denorm_loss = false;
+		static constexpr std::float_round_style round_style =
+		  std::round_toward_zero;
+		static constexpr bool is_iec559 = false;
+		static constexpr bool is_bounded = true;
+		static constexpr bool is_modulo = true;
+		static constexpr int digits = 128;
+		static constexpr int digits10 = digits * 643 / 2136;
+		static constexpr int max_digits10 = 0;
+		static constexpr int radix = 2;
+		static constexpr int min_exponent = 0;
+		static constexpr int min_exponent10 = 0;
+		static constexpr int max_exponent = 0;
+		static constexpr int max_exponent10 = 0;
+		// Cannot reasonibly define
+		// static constexpr bool traps = true;
+		static constexpr bool tinyness_before = false;
+
+		static constexpr daw::UInt128( min )( ) noexcept {
+			return daw::UInt128( );
+		}
+
+		static constexpr daw::UInt128 lowest( ) noexcept {
+			return daw::UInt128( );
+		}
+
+		static constexpr daw::UInt128( max )( ) noexcept {
+			return ~daw::UInt128( );
+		}
+
+		static constexpr daw::UInt128 epsilon( ) noexcept {
+			return daw::UInt128( );
+		}
+
+		static constexpr daw::UInt128 round_error( ) noexcept {
+			return daw::UInt128( );
+		}
+
+		static constexpr daw::UInt128 infinity( ) noexcept {
+			return daw::UInt128( );
+		}
+
+		static constexpr daw::UInt128 quiet_NaN( ) noexcept {
+			return daw::UInt128( );
+		}
+
+		static constexpr daw::UInt128 signalling_NaN( ) noexcept {
+			return daw::UInt128( );
+		}
+
+		static constexpr daw::UInt128 denorm_min( ) noexcept {
+			return daw::UInt128( );
+		}
+	};
+
+	template<>
+	struct numeric_limits<daw::UInt256> {
+		static constexpr bool is_specialized = true;
+		static constexpr bool is_signed = false;
+		static constexpr bool is_integer = true;
+		static constexpr bool is_exact = true;
+		static constexpr bool has_infinity = false;
+		static constexpr bool has_quiet_NaN = false;
+		static constexpr bool has_signaling_NaN = false;
+		static constexpr bool has_denorm = false;
+		static constexpr bool has_denorm_loss = false;
+		static constexpr std::float_round_style round_style =
+		  std::round_toward_zero;
+		static constexpr bool is_iec559 = false;
+		static constexpr bool is_bounded = true;
+		static constexpr bool is_modulo = true;
+		static constexpr int digits = 256;
+		static constexpr int digits10 = digits * 643 / 2136;
+		static constexpr int max_digits10 = 0;
+		static constexpr int radix = 2;
+		static constexpr int min_exponent = 0;
+		static constexpr int min_exponent10 = 0;
+		static constexpr int max_exponent = 0;
+		static constexpr int max_exponent10 = 0;
+		// Cannot reasonibly define
+		// static constexpr bool traps = true;
+		static constexpr bool tinyness_before = false;
+
+		static constexpr daw::UInt256( min )( ) noexcept {
+			return daw::UInt256( );
+		}
+
+		static constexpr daw::UInt256 lowest( ) noexcept {
+			return daw::UInt256( );
+		}
+
+		static constexpr daw::UInt256( max )( ) noexcept {
+			return ~daw::UInt256( );
+		}
+
+		static constexpr daw::UInt256 epsilon( ) noexcept {
+			return daw::UInt256( );
+		}
+
+		static constexpr daw::UInt256 round_error( ) noexcept {
+			return daw::UInt256( );
+		}
+
+		static constexpr daw::UInt256 infinity( ) noexcept {
+			return daw::UInt256( );
+		}
+
+		static constexpr daw::UInt256 quiet_NaN( ) noexcept {
+			return daw::UInt256( );
+		}
+
+		static constexpr daw::UInt256 signalling_NaN( ) noexcept {
+			return daw::UInt256( );
+		}
+
+		static constexpr daw::UInt256 denorm_min( ) noexcept {
+			return daw::UInt256( );
+		}
+	};
+
 	template<>
 	struct numeric_limits<daw::UInt64> {
 		static constexpr bool is_specialized = true;
@@ -0,0 +1,416 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "ciso646.h"
+#include "daw_attributes.h"
+#include "daw_cxmath.h"
+#include "daw_likely.h"
+#include "daw_string_view.h"
+#include "impl/daw_simd_features.h"
+#include "impl/daw_utf8_simd.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/// UTF-8 validation, code point counting and transcoding to and from UTF-16
+/// and UTF-32.  Inputs are daw::string_view's, so any contiguous buffer works,
+/// including a daw::filesystem::memory_mapped_file_t.  Validation follows
+/// Unicode Table 3-7: overlong forms, surrogates, values past U+10FFFF and
+/// cut off sequences are all rejected
+namespace daw::utf8 {
+	inline constexpr std::size_t npos = daw::string_view::npos;
+
+	/// The result of a transcode.  When is_valid is false, read is the
+	/// position of the first code unit of the invalid sequence and the output
+	/// holds everything before it
+	struct transcode_result {
+		std::size_t read = 0;
+		std::size_t written = 0;
+		bool is_valid = true;
+	};
+} // namespace daw::utf8
+
+namespace daw::utf8_impl {
+	struct decode_result {
+		char32_t code_point;
+		/// 0 when the sequence is invalid
+		std::size_t length;
+	};
+
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr bool
+	is_continuation( unsigned char c ) noexcept {
+		return ( c & 0xC0U ) == 0x80U;
+	}
+
+	[[nodiscard]] DAW_ATTRIB_INLINE bool
+	is_ascii8( unsigned char const *p ) noexcept {
+		std::uint64_t word;
+		std::memcpy( &word, p, sizeof( word ) );
+		return ( word & 0x8080'8080'8080'8080ULL ) == 0;
+	}
+
+	[[nodiscard]] constexpr decode_result
+	decode( unsigned char const *p, std::size_t remaining ) noexcept {
+		char32_t const b0 = p[0];
+		if( b0 < 0x80U ) {
+			return { b0, 1 };
+		}
+		if( DAW_UNLIKELY( b0 < 0xC2U or b0 > 0xF4U ) ) {
+			return { 0, 0 };
+		}
+		if( b0 < 0xE0U ) {
+			if( remaining < 2 or not is_continuation( p[1] ) ) {
+				return { 0, 0 };
+			}
+			return { ( ( b0 & 0x1FU ) << 6U ) | ( p[1] & 0x3FU ), 2 };
+		}
+		// The range of the second byte depends on the lead, which rejects
+		// overlong forms, surrogates and values past U+10FFFF
+		unsigned lo = 0x80U;
+		unsigned hi = 0xBFU;
+		switch( b0 ) {
+		case 0xE0U:
+			lo = 0xA0U;
+			break;
+		case 0xEDU:
+			hi = 0x9FU;
+			break;
+		case 0xF0U:
+			lo = 0x90U;
+			break;
+		case 0xF4U:
+			hi = 0x8FU;
+			break;
+		default:
+			break;
+		}
+		if( remaining < 2 or p[1] < lo or p[1] > hi ) {
+			return { 0, 0 };
+		}
+		if( b0 < 0xF0U ) {
+			if( remaining < 3 or not is_continuation( p[2] ) ) {
+				return { 0, 0 };
+			}
+			return { ( ( b0 & 0x0FU ) << 12U ) |
+			           ( static_cast<char32_t>( p[1] & 0x3FU ) << 6U ) |
+			           ( p[2] & 0x3FU ),
+			         3 };
+		}
+		if( remaining < 4 or not is_continuation( p[2] ) or
+		    not is_continuation( p[3] ) ) {
+			return { 0, 0 };
+		}
+		return { ( ( b0 & 0x07U ) << 18U ) |
+		           ( static_cast<char32_t>( p[1] & 0x3FU ) << 12U ) |
+		           ( static_cast<char32_t>( p[2] & 0x3FU ) << 6U ) |
+		           ( p[3] & 0x3FU ),
+		         4 };
+	}
+
+	/// Write the UTF-8 form of a valid scalar value and return its length
+	DAW_ATTRIB_INLINE constexpr std::size_t encode( char32_t cp,
+	                                                char *out ) noexcept {
+		if( cp < 0x80U ) {
+			out[0] = static_cast<char>( cp );
+			return 1;
+		}
+		if( cp < 0x800U ) {
+			out[0] = static_cast<char>( 0xC0U | ( cp >> 6U ) );
+			out[1] = static_cast<char>( 0x80U | ( cp & 0x3FU ) );
+			return 2;
+		}
+		if( cp < 0x1'0000U ) {
+			out[0] = static_cast<char>( 0xE0U | ( cp >> 12U ) );
+			out[1] = static_cast<char>( 0x80U | ( ( cp >> 6U ) & 0x3FU ) );
+			out[2] = static_cast<char>( 0x80U | ( cp & 0x3FU ) );
+			return 3;
+		}
+		out[0] = static_cast<char>( 0xF0U | ( cp >> 18U ) );
+		out[1] = static_cast<char>( 0x80U | ( ( cp >> 12U ) & 0x3FU ) );
+		out[2] = static_cast<char>( 0x80U | ( ( cp >> 6U ) & 0x3FU ) );
+		out[3] = static_cast<char>( 0x80U | ( cp & 0x3FU ) );
+		return 4;
+	}
+
+	[[nodiscard]] constexpr bool is_scalar_value( char32_t cp ) noexcept {
+		return cp < 0xD800U or ( cp > 0xDFFFU and cp <= 0x10'FFFFU );
+	}
+
+	[[nodiscard]] inline std::size_t
+	find_invalid_scalar( unsigned char const *p, std::size_t size ) noexcept {
+		std::size_t pos = 0;
+		while( pos < size ) {
+			if( pos + 8 <= size and is_ascii8( p + pos ) ) {
+				pos += 8;
+				continue;
+			}
+			auto const r = decode( p + pos, size - pos );
+			if( r.length == 0 ) {
+				return pos;
+			}
+			pos += r.length;
+		}
+		return utf8::npos;
+	}
+
+	/// Decode whole sequences, and at least one, until pos reaches last.
+	/// Returns false on an invalid sequence and leaves pos at its start
+	template<typename Out>
+	DAW_ATTRIB_INLINE bool decode_until( unsigned char const *p,
+	                                     std::size_t size,
+	                                     std::size_t &pos,
+	                                     std::size_t last,
+	                                     Out &&out ) {
+		do {
+			auto const r = decode( p + pos, size - pos );
+			if( DAW_UNLIKELY( r.length == 0 ) ) {
+				return false;
+			}
+			out( r.code_point );
+			pos += r.length;
+		} while( pos < last );
+		return true;
+	}
+} // namespace daw::utf8_impl
+
+namespace daw::utf8 {
+	/// Is the whole of str valid UTF-8
+	[[nodiscard]] inline bool is_valid( daw::string_view str ) noexcept {
+		auto const *const p =
+		  reinterpret_cast<unsigned char const *>( str.data( ) );
+#if defined( DAW_HAS_AVX2 )
+		return utf8_impl::validate_simd<utf8_impl::simd256>( p, str.size( ) );
+#elif defined( DAW_HAS_SSSE3 )
+		return utf8_impl::validate_simd<utf8_impl::simd128>( p, str.size( ) );
+#else
+		return utf8_impl::find_invalid_scalar( p, str.size( ) ) == npos;
+#endif
+	}
+
+	/// The position of the first byte of the first invalid sequence in str, or
+	/// npos when it is all valid
+	[[nodiscard]] inline std::size_t
+	find_invalid( daw::string_view str ) noexcept {
+		if( DAW_LIKELY( is_valid( str ) ) ) {
+			return npos;
+		}
+		return utf8_impl::find_invalid_scalar(
+		  reinterpret_cast<unsigned char const *>( str.data( ) ), str.size( ) );
+	}
+
+	/// The number of code points in valid UTF-8; each byte that is not a
+	/// continuation byte starts one
+	[[nodiscard]] inline std::size_t
+	count_code_points( daw::string_view str ) noexcept {
+		auto const *const p =
+		  reinterpret_cast<unsigned char const *>( str.data( ) );
+		std::size_t const size = str.size( );
+		std::size_t result = 0;
+		std::size_t pos = 0;
+#if defined( DAW_HAS_SSE2 )
+		// Continuation bytes are -128 to -65 as signed chars
+		auto const min_lead = _mm_set1_epi8( -65 );
+		for( ; pos + 16 <= size; pos += 16 ) {
+			auto const v =
+			  _mm_loadu_si128( reinterpret_cast<__m128i const *>( p + pos ) );
+			result += static_cast<std::size_t>( daw::cxmath::popcount(
+			  static_cast<unsigned>( _mm_movemask_epi8(
+			    _mm_cmpgt_epi8( v, min_lead ) ) ) ) );
+		}
+#endif
+		for( ; pos < size; ++pos ) {
+			result +=
+			  static_cast<std::size_t>( not utf8_impl::is_continuation( p[pos] ) );
+		}
+		return result;
+	}
+
+	/// The number of UTF-16 code units needed for valid UTF-8.  It is an upper
+	/// bound of what to_utf16 writes for any input
+	[[nodiscard]] inline std::size_t
+	utf16_length( daw::string_view str ) noexcept {
+		auto const *const p =
+		  reinterpret_cast<unsigned char const *>( str.data( ) );
+		std::size_t result = count_code_points( str );
+		// Four byte sequences become surrogate pairs
+		for( std::size_t pos = 0; pos < str.size( ); ++pos ) {
+			result += static_cast<std::size_t>( p[pos] >= 0xF0U );
+		}
+		return result;
+	}
+
+	/// The number of UTF-8 code units needed for valid UTF-16
+	[[nodiscard]] constexpr std::size_t
+	length_from_utf16( daw::u16string_view str ) noexcept {
+		std::size_t result = 0;
+		for( char16_t c : str ) {
+			// A surrogate pair needs 4 bytes, 2 for each half
+			if( c < 0x80U ) {
+				result += 1;
+			} else if( c < 0x800U or ( c & 0xF800U ) == 0xD800U ) {
+				result += 2;
+			} else {
+				result += 3;
+			}
+		}
+		return result;
+	}
+
+	/// The number of UTF-8 code units needed for valid UTF-32
+	[[nodiscard]] constexpr std::size_t
+	length_from_utf32( daw::u32string_view str ) noexcept {
+		std::size_t result = 0;
+		for( char32_t c : str ) {
+			result += c < 0x80U ? 1 : c < 0x800U ? 2 : c < 0x1'0000U ? 3 : 4;
+		}
+		return result;
+	}
+
+	/// Decode str to out, which needs room for count_code_points( str ) values
+	/// (str.size( ) is always enough)
+	inline transcode_result to_utf32( daw::string_view str, char32_t *out ) {
+		auto const *const p =
+		  reinterpret_cast<unsigned char const *>( str.data( ) );
+		std::size_t const size = str.size( );
+		std::size_t pos = 0;
+		std::size_t written = 0;
+		auto const put = [&]( char32_t cp ) {
+			out[written++] = cp;
+		};
+		while( pos < size ) {
+#if defined( DAW_HAS_SSE2 )
+			if( pos + 16 <= size ) {
+				auto const v =
+				  _mm_loadu_si128( reinterpret_cast<__m128i const *>( p + pos ) );
+				if( _mm_movemask_epi8( v ) == 0 ) {
+					// Widen 16 ASCII bytes to 16 code points
+					auto const zero = _mm_setzero_si128( );
+					auto const lo = _mm_unpacklo_epi8( v, zero );
+					auto const hi = _mm_unpackhi_epi8( v, zero );
+					auto *const o = reinterpret_cast<__m128i *>( out + written );
+					_mm_storeu_si128( o, _mm_unpacklo_epi16( lo, zero ) );
+					_mm_storeu_si128( o + 1, _mm_unpackhi_epi16( lo, zero ) );
+					_mm_storeu_si128( o + 2, _mm_unpacklo_epi16( hi, zero ) );
+					_mm_storeu_si128( o + 3, _mm_unpackhi_epi16( hi, zero ) );
+					pos += 16;
+					written += 16;
+					continue;
+				}
+			}
+			std::size_t const last = pos + 16 < size ? pos + 16 : size;
+#else
+			std::size_t const last = size;
+#endif
+			if( not utf8_impl::decode_until( p, size, pos, last, put ) ) {
+				return { pos, written, false };
+			}
+		}
+		return { pos, written, true };
+	}
+
+	/// Transcode str to out, which needs room for utf16_length( str ) code
+	/// units (str.size( ) is always enough)
+	inline transcode_result to_utf16( daw::string_view str, char16_t *out ) {
+		auto const *const p =
+		  reinterpret_cast<unsigned char const *>( str.data( ) );
+		std::size_t const size = str.size( );
+		std::size_t pos = 0;
+		std::size_t written = 0;
+		auto const put = [&]( char32_t cp ) {
+			if( cp < 0x1'0000U ) {
+				out[written++] = static_cast<char16_t>( cp );
+			} else {
+				cp -= 0x1'0000U;
+				out[written++] = static_cast<char16_t>( 0xD800U | ( cp >> 10U ) );
+				out[written++] = static_cast<char16_t>( 0xDC00U | ( cp & 0x3FFU ) );
+			}
+		};
+		while( pos < size ) {
+#if defined( DAW_HAS_SSE2 )
+			if( pos + 16 <= size ) {
+				auto const v =
+				  _mm_loadu_si128( reinterpret_cast<__m128i const *>( p + pos ) );
+				if( _mm_movemask_epi8( v ) == 0 ) {
+					auto const zero = _mm_setzero_si128( );
+					auto *const o = reinterpret_cast<__m128i *>( out + written );
+					_mm_storeu_si128( o, _mm_unpacklo_epi8( v, zero ) );
+					_mm_storeu_si128( o + 1, _mm_unpackhi_epi8( v, zero ) );
+					pos += 16;
+					written += 16;
+					continue;
+				}
+			}
+			std::size_t const last = pos + 16 < size ? pos + 16 : size;
+#else
+			std::size_t const last = size;
+#endif
+			if( not utf8_impl::decode_until( p, size, pos, last, put ) ) {
+				return { pos, written, false };
+			}
+		}
+		return { pos, written, true };
+	}
+
+	/// Transcode UTF-16 to out, which needs room for length_from_utf16( str )
+	/// bytes.  Unpaired surrogates are invalid
+	inline transcode_result from_utf16( daw::u16string_view str, char *out ) {
+		char16_t const *const p = str.data( );
+		std::size_t const size = str.size( );
+		std::size_t pos = 0;
+		std::size_t written = 0;
+		while( pos < size ) {
+#if defined( DAW_HAS_SSE2 )
+			if( pos + 8 <= size ) {
+				auto const v =
+				  _mm_loadu_si128( reinterpret_cast<__m128i const *>( p + pos ) );
+				auto const non_ascii =
+				  _mm_and_si128( v, _mm_set1_epi16( static_cast<short>( 0xFF80 ) ) );
+				if( _mm_movemask_epi8( _mm_cmpeq_epi16(
+				      non_ascii, _mm_setzero_si128( ) ) ) == 0xFFFF ) {
+					// Narrow 8 ASCII code units to bytes
+					_mm_storel_epi64( reinterpret_cast<__m128i *>( out + written ),
+					                  _mm_packus_epi16( v, v ) );
+					pos += 8;
+					written += 8;
+					continue;
+				}
+			}
+#endif
+			char32_t cp = p[pos];
+			std::size_t length = 1;
+			if( ( cp & 0xF800U ) == 0xD800U ) {
+				if( cp > 0xDBFFU or pos + 1 == size or
+				    ( p[pos + 1] & 0xFC00U ) != 0xDC00U ) {
+					return { pos, written, false };
+				}
+				cp = 0x1'0000U + ( ( cp - 0xD800U ) << 10U ) + ( p[pos + 1] - 0xDC00U );
+				length = 2;
+			}
+			written += utf8_impl::encode( cp, out + written );
+			pos += length;
+		}
+		return { pos, written, true };
+	}
+
+	/// Transcode UTF-32 to out, which needs room for length_from_utf32( str )
+	/// bytes.  Surrogates and values past U+10FFFF are invalid
+	inline transcode_result from_utf32( daw::u32string_view str, char *out ) {
+		std::size_t written = 0;
+		for( std::size_t pos = 0; pos < str.size( ); ++pos ) {
+			char32_t const cp = str[pos];
+			if( DAW_UNLIKELY( not utf8_impl::is_scalar_value( cp ) ) ) {
+				return { pos, written, false };
+			}
+			written += utf8_impl::encode( cp, out + written );
+		}
+		return { str.size( ), written, true };
+	}
+} // namespace daw::utf8
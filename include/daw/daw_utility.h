@@ -16,12 +16,14 @@
 #include "daw_empty.h"
 #include "daw_exception.h"
 #include "daw_int_cmp.h"
+#include "daw_is_constant_evaluated.h"
 #include "daw_likely.h"
 #include "daw_move.h"
 #include "daw_remove_cvref.h"
 #include "daw_traits.h"
 #include "daw_typeof.h"
 #include "daw_unused.h"
+#include "impl/daw_ascii_case_simd.h"
 #include "impl/daw_make_trait.h"
 
 #include <cmath>
@@ -320,6 +322,12 @@ namespace daw {
 	template<typename CharType, typename Traits, typename Allocator>
 	[[nodiscard]] constexpr auto
 	AsciiUpper( std::basic_string<CharType, Traits, Allocator> str ) noexcept {
+		if constexpr( std::is_same_v<CharType, char> ) {
+			if( not DAW_IS_CONSTANT_EVALUATED_COMPAT( ) ) {
+				ascii_impl::convert_n<true>( str.data( ), str.size( ), str.data( ) );
+				return str;
+			}
+		}
 		daw::algorithm::map(
 		  str.cbegin( ), str.cend( ), str.begin( ), []( CharType c ) noexcept {
 			  return AsciiUpper( c );
@@ -330,6 +338,12 @@ namespace daw {
 	template<typename CharType, typename Traits, typename Allocator>
 	[[nodiscard]] constexpr auto
 	AsciiLower( std::basic_string<CharType, Traits, Allocator> str ) noexcept {
+		if constexpr( std::is_same_v<CharType, char> ) {
+			if( not DAW_IS_CONSTANT_EVALUATED_COMPAT( ) ) {
+				ascii_impl::convert_n<false>( str.data( ), str.size( ), str.data( ) );
+				return str;
+			}
+		}
 		daw::algorithm::map(
 		  str.cbegin( ), str.cend( ), str.begin( ), []( CharType c ) noexcept {
 			  return AsciiLower( c );
@@ -532,7 +546,6 @@ namespace daw {
 		auto chr_ptr = reinterpret_cast<char const *>( &val );
 		for( std::size_t n = 0; n < sizeof( T ); ++n ) {
 			it_out = hex( *chr_ptr, it_out );
-			++it_out;
 			++chr_ptr;
 		}
 		return it_out;
@@ -581,7 +594,7 @@ namespace daw {
 	                                  ForwardIterator2 const last_in,
 	                                  OutputIterator first_out ) noexcept {
 		for( ; first_in != last_in; ++first_in ) {
-			first_out = hex( *first_out, first_out );
+			first_out = hex( *first_in, first_out );
 		}
 		return first_out;
 	}
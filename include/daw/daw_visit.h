@@ -19,11 +19,15 @@
 #include "daw_unreachable.h"
 #include "impl/daw_make_trait.h"
 
+#include <array>
 #include <cstddef>
 #include <daw/stdinc/move_fwd_exch.h>
 #include <exception>
+#include <iterator>
 #include <type_traits>
+#include <utility>
 #include <variant>
+#include <vector>
 
 namespace daw {
 	using bad_variant_access = std::bad_variant_access;
@@ -96,6 +100,12 @@ namespace daw {
 		inline constexpr size_t get_var_size_v =
 		  get_var_size<daw::remove_cvref_t<Variant>>::value;
 
+		DAW_MAKE_REQ_TRAIT( has_index_v, std::declval<T const &>( ).index( ) );
+
+		template<typename T>
+		inline constexpr bool is_variant_like_v =
+		  has_index_v<daw::remove_cvref_t<T>>;
+
 		// A simple overload class that is constructed via aggregate.
 		template<typename... Fs>
 		struct overload_t : Fs... {
@@ -348,6 +358,142 @@ namespace daw {
 
 #undef DAW_VISIT_CASE
 
+		/// The alternative index of variant K within a flattened index.  The
+		/// flattened index is ( ( i0 * S1 + i1 ) * S2 + i2 )... so the last
+		/// variant has a stride of 1
+		template<std::size_t Flat, std::size_t K, typename... Variants>
+		constexpr std::size_t flat_component( ) noexcept {
+			constexpr std::size_t sizes[] = { get_var_size_v<Variants>... };
+			std::size_t stride = 1;
+			for( std::size_t n = K + 1; n < sizeof...( Variants ); ++n ) {
+				stride *= sizes[n];
+			}
+			return ( Flat / stride ) % sizes[K];
+		}
+
+		template<std::size_t Flat,
+		         typename R,
+		         typename... Variants,
+		         std::size_t... Ks,
+		         typename Visitor>
+		DAW_ATTRIB_FLATINLINE constexpr R
+		visit_flat_impl( std::index_sequence<Ks...>,
+		                 Visitor &&vis,
+		                 Variants &&...vars ) {
+			return DAW_FWD( vis )(
+			  get_nt<flat_component<Flat, Ks, Variants...>( )>(
+			    DAW_FWD( vars ) )... );
+		}
+
+		template<std::size_t Flat,
+		         typename R,
+		         typename Visitor,
+		         typename... Variants>
+		constexpr R visit_flat( Visitor &&vis, Variants &&...vars ) {
+			return visit_flat_impl<Flat, R, Variants...>(
+			  std::index_sequence_for<Variants...>{ },
+			  DAW_FWD( vis ),
+			  DAW_FWD( vars )... );
+		}
+
+		template<typename R,
+		         typename Visitor,
+		         typename... Variants,
+		         std::size_t... Flat>
+		constexpr auto make_visit_table( std::index_sequence<Flat...> ) {
+			using fn_t = R ( * )( Visitor &&, Variants &&... );
+			return std::array<fn_t, sizeof...( Flat )>{
+			  { &visit_flat<Flat, R, Visitor, Variants...>... } };
+		}
+
+		/// One entry per combination of alternatives, indexed by the flattened
+		/// index
+		template<typename R, typename Visitor, typename... Variants>
+		inline constexpr auto visit_table_v =
+		  make_visit_table<R, Visitor, Variants...>(
+		    std::make_index_sequence<( get_var_size_v<Variants> * ... )>{ } );
+
+#define DAW_VISIT_FLAT_CASE( Idx )                                        \
+	case N + Idx:                                                           \
+		if constexpr( N + Idx < Total ) {                                     \
+			return visit_flat<N + Idx, R>( DAW_FWD( vis ), DAW_FWD( vars )... ); \
+		} else {                                                              \
+			DAW_UNREACHABLE( );                                                 \
+		}
+
+		/// A switch over the flattened index, 16 cases at a time.  This lets the
+		/// visitor be inlined, unlike a call through the table
+		template<std::size_t N, typename R, typename Visitor, typename... Variants>
+		DAW_ATTRIB_FLATINLINE constexpr R
+		visit_flat_switch( std::size_t flat, Visitor &&vis, Variants &&...vars ) {
+			constexpr std::size_t Total = ( get_var_size_v<Variants> * ... );
+			switch( flat ) {
+				DAW_VISIT_FLAT_CASE( 0 )
+				DAW_VISIT_FLAT_CASE( 1 )
+				DAW_VISIT_FLAT_CASE( 2 )
+				DAW_VISIT_FLAT_CASE( 3 )
+				DAW_VISIT_FLAT_CASE( 4 )
+				DAW_VISIT_FLAT_CASE( 5 )
+				DAW_VISIT_FLAT_CASE( 6 )
+				DAW_VISIT_FLAT_CASE( 7 )
+				DAW_VISIT_FLAT_CASE( 8 )
+				DAW_VISIT_FLAT_CASE( 9 )
+				DAW_VISIT_FLAT_CASE( 10 )
+				DAW_VISIT_FLAT_CASE( 11 )
+				DAW_VISIT_FLAT_CASE( 12 )
+				DAW_VISIT_FLAT_CASE( 13 )
+				DAW_VISIT_FLAT_CASE( 14 )
+				DAW_VISIT_FLAT_CASE( 15 )
+			default:
+				if constexpr( Total - N > 16 ) {
+					return visit_flat_switch<N + 16, R>(
+					  flat, DAW_FWD( vis ), DAW_FWD( vars )... );
+				} else {
+					DAW_UNREACHABLE( );
+				}
+			}
+		}
+
+#undef DAW_VISIT_FLAT_CASE
+
+		/// Above this many combinations the table is used instead of the switch
+		inline constexpr std::size_t max_flat_switch_size = 64;
+
+		template<typename R, typename Visitor, typename... Variants>
+		DAW_ATTRIB_FLATINLINE constexpr R visit_n_nt( Visitor &&vis,
+		                                              Variants &&...vars ) {
+			if constexpr( sizeof...( Variants ) == 1 ) {
+				return visit_nt<0, R>( DAW_FWD( vars )..., DAW_FWD( vis ) );
+			} else {
+				std::size_t flat = 0;
+				( ( flat = flat * get_var_size_v<Variants> +
+				           static_cast<std::size_t>( get_index( vars ) ) ),
+				  ... );
+				if constexpr( ( get_var_size_v<Variants> * ... ) <=
+				              max_flat_switch_size ) {
+					return visit_flat_switch<0, R>(
+					  flat, DAW_FWD( vis ), DAW_FWD( vars )... );
+				} else {
+					return visit_table_v<R, Visitor, Variants...>[flat](
+					  DAW_FWD( vis ), DAW_FWD( vars )... );
+				}
+			}
+		}
+
+		template<std::size_t... Is, typename Variant, typename Visitor>
+		void visit_buckets( std::index_sequence<Is...>,
+		                    Variant *const *order,
+		                    std::size_t const *offsets,
+		                    Visitor &vis ) {
+			// One loop per alternative, each calling a single overload
+			( [&] {
+				for( std::size_t n = offsets[Is]; n < offsets[Is + 1]; ++n ) {
+					(void)vis( get_nt<Is>( *order[n] ) );
+				}
+			}( ),
+			  ... );
+		}
+
 		[[noreturn]] DAW_ATTRIB_NOINLINE inline void visit_error( ) {
 			DAW_THROW_OR_TERMINATE_NA( daw::bad_variant_access );
 		}
@@ -357,7 +503,10 @@ namespace daw {
 	// Singe visitation visit.  Expects that variant is valid and not empty
 	// The return type assumes that all the visitors have a result convertable
 	// to that of visitor( get_nt<0>( variant ) ) 's result
-	template<typename Variant, typename... Visitors>
+	template<typename Variant,
+	         typename... Visitors,
+	         std::enable_if_t<visit_details::is_variant_like_v<Variant>,
+	                          std::nullptr_t> = nullptr>
 	[[nodiscard]] constexpr decltype( auto ) visit_nt( Variant &&var,
 	                                                   Visitors &&...visitors ) {
 		using result_t = decltype( daw::visit_details::overload(
@@ -397,13 +546,93 @@ namespace daw {
 
 	// Singe visitation visit with user choosable result.  Expects that variant is
 	// valid and not empty
-	template<typename Result, typename Variant, typename... Visitors>
+	template<typename Result,
+	         typename Variant,
+	         typename... Visitors,
+	         std::enable_if_t<visit_details::is_variant_like_v<Variant>,
+	                          std::nullptr_t> = nullptr>
 	[[nodiscard]] constexpr Result visit_nt( Variant &&var,
 	                                         Visitors &&...visitors ) {
 		return daw::visit_details::visit_nt<0, Result>(
 		  DAW_FWD( var ), daw::visit_details::overload( DAW_FWD( visitors )... ) );
 	}
 
+	// Multiple visitation.  Expects that the variants are valid and not empty.
+	// The alternative indices are combined into one flattened index that is
+	// dispatched on once, instead of a nested dispatch per variant.  Up to 64
+	// combinations this is a generated switch, above that an entry in a
+	// constexpr table of functions.  The return type is that of
+	// visitor( get_nt<0>( vars )... )
+	template<typename Visitor,
+	         typename Variant,
+	         typename... Variants,
+	         std::enable_if_t<( not visit_details::is_variant_like_v<Visitor> and
+	                            visit_details::is_variant_like_v<Variant> and
+	                            ( visit_details::is_variant_like_v<Variants> and
+	                              ... ) ),
+	                          std::nullptr_t> = nullptr>
+	[[nodiscard]] constexpr decltype( auto )
+	visit_nt( Visitor &&vis, Variant &&var, Variants &&...vars ) {
+		using result_t = decltype( DAW_FWD( vis )(
+		  get_nt<0>( DAW_FWD( var ) ), get_nt<0>( DAW_FWD( vars ) )... ) );
+		return visit_details::visit_n_nt<result_t>(
+		  DAW_FWD( vis ), DAW_FWD( var ), DAW_FWD( vars )... );
+	}
+
+	// Multiple visitation with user choosable result.  Expects that the
+	// variants are valid and not empty
+	template<typename Result,
+	         typename Visitor,
+	         typename Variant,
+	         typename... Variants,
+	         std::enable_if_t<( not visit_details::is_variant_like_v<Visitor> and
+	                            visit_details::is_variant_like_v<Variant> and
+	                            ( visit_details::is_variant_like_v<Variants> and
+	                              ... ) ),
+	                          std::nullptr_t> = nullptr>
+	[[nodiscard]] constexpr Result visit_nt( Visitor &&vis,
+	                                         Variant &&var,
+	                                         Variants &&...vars ) {
+		return visit_details::visit_n_nt<Result>(
+		  DAW_FWD( vis ), DAW_FWD( var ), DAW_FWD( vars )... );
+	}
+
+	// Visit each element of a contiguous range of variants, grouped by
+	// alternative.  The elements are first bucketed by index( ), then each
+	// bucket is processed in its own loop that always calls the same overload,
+	// so the per element dispatch branch goes away.  Elements with the same
+	// alternative are visited in order, but the order across alternatives is
+	// not kept.  Expects that no element is valueless.  The buckets take one
+	// pointer per element of temporary storage
+	template<typename Range, typename... Visitors>
+	void visit_batch( Range &&rng, Visitors &&...visitors ) {
+		using variant_t = std::remove_reference_t<decltype( *std::data( rng ) )>;
+		constexpr std::size_t VSz = visit_details::get_var_size_v<variant_t>;
+
+		auto *const first = std::data( rng );
+		auto const size = static_cast<std::size_t>( std::size( rng ) );
+
+		// offsets[I] is the start of the bucket for alternative I
+		auto offsets = std::array<std::size_t, VSz + 1>{ };
+		for( std::size_t n = 0; n < size; ++n ) {
+			++offsets[static_cast<std::size_t>( first[n].index( ) ) + 1U];
+		}
+		for( std::size_t n = 1; n <= VSz; ++n ) {
+			offsets[n] += offsets[n - 1];
+		}
+		auto order = std::vector<variant_t *>( size );
+		auto next = offsets;
+		for( std::size_t n = 0; n < size; ++n ) {
+			order[next[static_cast<std::size_t>( first[n].index( ) )]++] = first + n;
+		}
+
+		auto vis = visit_details::overload( DAW_FWD( visitors )... );
+		visit_details::visit_buckets( std::make_index_sequence<VSz>{ },
+		                              order.data( ),
+		                              offsets.data( ),
+		                              vis );
+	}
+
 	template<typename Value, typename... Visitors>
 	inline constexpr bool is_visitable_v =
 	  ( std::is_invocable_v<Visitors, Value> or ... );
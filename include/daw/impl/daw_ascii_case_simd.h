@@ -0,0 +1,184 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw/ciso646.h"
+#include "daw/daw_attributes.h"
+#include "daw/daw_cxmath.h"
+#include "daw_simd_features.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/// ASCII case folding of whole blocks.  A byte is upper case when adding
+/// 0x80 - 'A' lands it in the 26 smallest signed values, so one add and one
+/// signed compare find the letters in a vector and the fold is an xor with
+/// 0x20.  Words of 8 bytes use the same idea with SWAR, which also covers
+/// targets without SSE2.  Bytes outside of ASCII are left alone
+namespace daw::ascii_impl {
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr char
+	to_lower( char c ) noexcept {
+		return ( 'A' <= c and c <= 'Z' ) ? static_cast<char>( c | 0x20 ) : c;
+	}
+
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr char
+	to_upper( char c ) noexcept {
+		return ( 'a' <= c and c <= 'z' ) ? static_cast<char>( c & ~0x20 ) : c;
+	}
+
+	inline constexpr std::uint64_t ones = 0x0101'0101'0101'0101ULL;
+	inline constexpr std::uint64_t high_bits = 0x8080'8080'8080'8080ULL;
+
+	/// 0x20 in each byte of word that is between First and Last
+	template<char First, char Last>
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr std::uint64_t
+	case_bits( std::uint64_t word ) noexcept {
+		std::uint64_t const low7 = word & ~high_bits;
+		std::uint64_t const ge_first =
+		  low7 + ones * static_cast<std::uint64_t>( 0x80 - First );
+		std::uint64_t const gt_last =
+		  low7 + ones * static_cast<std::uint64_t>( 0x7F - Last );
+		return ( ( ge_first ^ gt_last ) & ~word & high_bits ) >> 2U;
+	}
+
+	template<bool Upper>
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr std::uint64_t
+	convert_word( std::uint64_t word ) noexcept {
+		if constexpr( Upper ) {
+			return word ^ case_bits<'a', 'z'>( word );
+		} else {
+			return word ^ case_bits<'A', 'Z'>( word );
+		}
+	}
+
+	[[nodiscard]] DAW_ATTRIB_INLINE std::uint64_t
+	load_word( char const *ptr ) noexcept {
+		std::uint64_t result;
+		std::memcpy( &result, ptr, sizeof( result ) );
+		return result;
+	}
+
+#if defined( DAW_HAS_SSE2 )
+	/// Moves the first letter of the case being converted to -128
+	template<bool Upper>
+	inline constexpr char fold_offset =
+	  static_cast<char>( 0x80 - ( Upper ? 'a' : 'A' ) );
+	/// Shifted letters are less than this
+	inline constexpr char fold_limit = static_cast<char>( -128 + 26 );
+
+	template<bool Upper>
+	[[nodiscard]] DAW_ATTRIB_INLINE __m128i convert_128( __m128i v ) noexcept {
+		auto const shifted =
+		  _mm_add_epi8( v, _mm_set1_epi8( fold_offset<Upper> ) );
+		auto const is_letter =
+		  _mm_cmplt_epi8( shifted, _mm_set1_epi8( fold_limit ) );
+		return _mm_xor_si128( v,
+		                      _mm_and_si128( is_letter, _mm_set1_epi8( 0x20 ) ) );
+	}
+#endif
+#if defined( DAW_HAS_AVX2 )
+	template<bool Upper>
+	[[nodiscard]] DAW_ATTRIB_INLINE __m256i convert_256( __m256i v ) noexcept {
+		auto const shifted =
+		  _mm256_add_epi8( v, _mm256_set1_epi8( fold_offset<Upper> ) );
+		auto const is_letter =
+		  _mm256_cmpgt_epi8( _mm256_set1_epi8( fold_limit ), shifted );
+		return _mm256_xor_si256(
+		  v, _mm256_and_si256( is_letter, _mm256_set1_epi8( 0x20 ) ) );
+	}
+#endif
+
+	/// Case convert count bytes from src to dst.  src may equal dst
+	template<bool Upper>
+	void convert_n( char const *src, std::size_t count, char *dst ) noexcept {
+		std::size_t pos = 0;
+#if defined( DAW_HAS_AVX2 )
+		for( ; pos + 32U <= count; pos += 32U ) {
+			_mm256_storeu_si256(
+			  reinterpret_cast<__m256i *>( dst + pos ),
+			  convert_256<Upper>( _mm256_loadu_si256(
+			    reinterpret_cast<__m256i const *>( src + pos ) ) ) );
+		}
+#endif
+#if defined( DAW_HAS_SSE2 )
+		for( ; pos + 16U <= count; pos += 16U ) {
+			_mm_storeu_si128( reinterpret_cast<__m128i *>( dst + pos ),
+			                  convert_128<Upper>( _mm_loadu_si128(
+			                    reinterpret_cast<__m128i const *>( src + pos ) ) ) );
+		}
+#endif
+		for( ; pos + 8U <= count; pos += 8U ) {
+			auto const word = convert_word<Upper>( load_word( src + pos ) );
+			std::memcpy( dst + pos, &word, sizeof( word ) );
+		}
+		for( ; pos < count; ++pos ) {
+			dst[pos] = Upper ? to_upper( src[pos] ) : to_lower( src[pos] );
+		}
+	}
+
+	/// The index of the first byte where lhs and rhs differ ignoring ASCII
+	/// case, or count
+	[[nodiscard]] inline std::size_t
+	mismatch_n( char const *lhs, char const *rhs, std::size_t count ) noexcept {
+		std::size_t pos = 0;
+#if defined( DAW_HAS_SSE2 )
+		for( ; pos + 16U <= count; pos += 16U ) {
+			auto const l = convert_128<false>(
+			  _mm_loadu_si128( reinterpret_cast<__m128i const *>( lhs + pos ) ) );
+			auto const r = convert_128<false>(
+			  _mm_loadu_si128( reinterpret_cast<__m128i const *>( rhs + pos ) ) );
+			auto const equal = static_cast<unsigned>(
+			  _mm_movemask_epi8( _mm_cmpeq_epi8( l, r ) ) );
+			if( equal != 0xFFFFU ) {
+				return pos + daw::cxmath::count_trailing_zeros(
+				               static_cast<std::uint64_t>( ~equal & 0xFFFFU ) );
+			}
+		}
+#endif
+		for( ; pos + 8U <= count; pos += 8U ) {
+			if( convert_word<false>( load_word( lhs + pos ) ) !=
+			    convert_word<false>( load_word( rhs + pos ) ) ) {
+				break;
+			}
+		}
+		for( ; pos < count; ++pos ) {
+			if( to_lower( lhs[pos] ) != to_lower( rhs[pos] ) ) {
+				return pos;
+			}
+		}
+		return count;
+	}
+
+	/// The index of the first byte in [0, count) equal to a or b, or count
+	[[nodiscard]] inline std::size_t
+	find_either( char const *ptr, std::size_t count, char a, char b ) noexcept {
+		std::size_t pos = 0;
+#if defined( DAW_HAS_SSE2 )
+		auto const va = _mm_set1_epi8( a );
+		auto const vb = _mm_set1_epi8( b );
+		for( ; pos + 16U <= count; pos += 16U ) {
+			auto const v =
+			  _mm_loadu_si128( reinterpret_cast<__m128i const *>( ptr + pos ) );
+			auto const found = static_cast<unsigned>( _mm_movemask_epi8(
+			  _mm_or_si128( _mm_cmpeq_epi8( v, va ), _mm_cmpeq_epi8( v, vb ) ) ) );
+			if( found != 0 ) {
+				return pos + daw::cxmath::count_trailing_zeros(
+				               static_cast<std::uint64_t>( found ) );
+			}
+		}
+#endif
+		for( ; pos < count; ++pos ) {
+			if( ptr[pos] == a or ptr[pos] == b ) {
+				return pos;
+			}
+		}
+		return count;
+	}
+} // namespace daw::ascii_impl
@@ -0,0 +1,336 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "../daw_attributes.h"
+#include "../daw_cxmath.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/// Algorithms over the 64 bit words of a bitset, shared by static_bitset and
+/// dynamic_bitset.  Bit n is bit n % 64 of word n / 64 and bits past the size
+/// of the bitset are always zero, so whole words can be counted and scanned.
+namespace daw::bitset_impl {
+	using word_t = std::uint64_t;
+	inline constexpr std::size_t word_bits = 64;
+	inline constexpr std::size_t npos =
+	  ( std::numeric_limits<std::size_t>::max )( );
+
+	[[nodiscard]] constexpr std::size_t
+	words_needed( std::size_t bits ) noexcept {
+		return ( bits + word_bits - 1U ) / word_bits;
+	}
+
+	/// The mask of the valid bits in the last word of a bitset of size bits
+	[[nodiscard]] constexpr word_t tail_mask( std::size_t bits ) noexcept {
+		auto const rem = bits % word_bits;
+		if( rem == 0 ) {
+			return ~word_t{ 0 };
+		}
+		return ( word_t{ 1 } << rem ) - 1U;
+	}
+
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr std::size_t
+	popcount( word_t w ) noexcept {
+		return static_cast<std::size_t>( daw::cxmath::popcount( w ) );
+	}
+
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr std::size_t
+	countr_zero( word_t w ) noexcept {
+		return static_cast<std::size_t>( daw::cxmath::count_trailing_zeros( w ) );
+	}
+
+	[[nodiscard]] constexpr std::size_t popcount( word_t const *words,
+	                                              std::size_t count ) noexcept {
+		// Independent accumulators let the adds overlap
+		std::size_t c0 = 0, c1 = 0, c2 = 0, c3 = 0;
+		std::size_t n = 0;
+		for( ; n + 4U <= count; n += 4U ) {
+			c0 += popcount( words[n] );
+			c1 += popcount( words[n + 1U] );
+			c2 += popcount( words[n + 2U] );
+			c3 += popcount( words[n + 3U] );
+		}
+		for( ; n < count; ++n ) {
+			c0 += popcount( words[n] );
+		}
+		return c0 + c1 + c2 + c3;
+	}
+
+	/// The position of the first set bit at or after pos, or npos
+	[[nodiscard]] constexpr std::size_t find_next( word_t const *words,
+	                                               std::size_t count,
+	                                               std::size_t pos ) noexcept {
+		auto idx = pos / word_bits;
+		if( idx >= count ) {
+			return npos;
+		}
+		auto w = words[idx] & ( ~word_t{ 0 } << ( pos % word_bits ) );
+		while( w == 0 ) {
+			if( ++idx == count ) {
+				return npos;
+			}
+			w = words[idx];
+		}
+		return idx * word_bits + countr_zero( w );
+	}
+
+	/// Call f( pos ) for each set bit in ascending order
+	template<typename Func>
+	constexpr void for_each_set_bit( word_t const *words,
+	                                 std::size_t count,
+	                                 Func &&f ) {
+		for( std::size_t idx = 0; idx < count; ++idx ) {
+			auto w = words[idx];
+			while( w != 0 ) {
+				f( idx * word_bits + countr_zero( w ) );
+				// Clear the lowest set bit
+				w &= w - 1U;
+			}
+		}
+	}
+
+	/// The number of set bits in [0, pos)
+	[[nodiscard]] constexpr std::size_t
+	rank( word_t const *words, std::size_t pos ) noexcept {
+		auto const idx = pos / word_bits;
+		auto result = popcount( words, idx );
+		if( auto const rem = pos % word_bits; rem != 0 ) {
+			result += popcount( words[idx] & ( ( word_t{ 1 } << rem ) - 1U ) );
+		}
+		return result;
+	}
+
+	/// The position of the set bit with k set bits before it within w
+	[[nodiscard]] constexpr std::size_t select_in_word( word_t w,
+	                                                    std::size_t k ) noexcept {
+		// Narrow down by halves, then finish with at most 7 clears
+		std::size_t base = 0;
+		for( std::size_t width = 32; width >= 8; width /= 2 ) {
+			auto const low = popcount( w & ( ( word_t{ 1 } << width ) - 1U ) );
+			if( k >= low ) {
+				k -= low;
+				w >>= width;
+				base += width;
+			}
+		}
+		while( k-- > 0 ) {
+			w &= w - 1U;
+		}
+		return base + countr_zero( w );
+	}
+
+	/// The position of the set bit with k set bits before it, or npos
+	[[nodiscard]] constexpr std::size_t
+	select( word_t const *words, std::size_t count, std::size_t k ) noexcept {
+		for( std::size_t idx = 0; idx < count; ++idx ) {
+			auto const c = popcount( words[idx] );
+			if( k < c ) {
+				return idx * word_bits + select_in_word( words[idx], k );
+			}
+			k -= c;
+		}
+		return npos;
+	}
+
+	/// dst[n] = op( dst[n], src[n] ), returning the number of set bits in the
+	/// result.  The loop is written to vectorize; the count is only computed
+	/// when requested
+	template<bool Count, typename Op>
+	DAW_ATTRIB_INLINE constexpr std::size_t
+	apply_words( word_t *dst, word_t const *src, std::size_t count, Op op ) {
+		if constexpr( Count ) {
+			std::size_t result = 0;
+			for( std::size_t n = 0; n < count; ++n ) {
+				auto const w = op( dst[n], src[n] );
+				dst[n] = w;
+				result += popcount( w );
+			}
+			return result;
+		} else {
+			for( std::size_t n = 0; n < count; ++n ) {
+				dst[n] = op( dst[n], src[n] );
+			}
+			return 0;
+		}
+	}
+
+	/// The number of set bits in op( lhs[n], rhs[n] ) without storing it
+	template<typename Op>
+	[[nodiscard]] constexpr std::size_t count_words( word_t const *lhs,
+	                                                 word_t const *rhs,
+	                                                 std::size_t count,
+	                                                 Op op ) {
+		std::size_t c0 = 0, c1 = 0;
+		std::size_t n = 0;
+		for( ; n + 2U <= count; n += 2U ) {
+			c0 += popcount( op( lhs[n], rhs[n] ) );
+			c1 += popcount( op( lhs[n + 1U], rhs[n + 1U] ) );
+		}
+		if( n < count ) {
+			c0 += popcount( op( lhs[n], rhs[n] ) );
+		}
+		return c0 + c1;
+	}
+
+	struct and_op {
+		constexpr word_t operator( )( word_t l, word_t r ) const noexcept {
+			return l & r;
+		}
+	};
+
+	struct or_op {
+		constexpr word_t operator( )( word_t l, word_t r ) const noexcept {
+			return l | r;
+		}
+	};
+
+	struct xor_op {
+		constexpr word_t operator( )( word_t l, word_t r ) const noexcept {
+			return l ^ r;
+		}
+	};
+
+	struct and_not_op {
+		constexpr word_t operator( )( word_t l, word_t r ) const noexcept {
+			return l & ~r;
+		}
+	};
+
+	/// Shift the bits towards higher positions, filling with zero.  The caller
+	/// masks the tail
+	constexpr void shift_left( word_t *words,
+	                           std::size_t count,
+	                           std::size_t bits ) noexcept {
+		auto const word_shift = bits / word_bits;
+		auto const bit_shift = bits % word_bits;
+		if( word_shift >= count ) {
+			for( std::size_t n = 0; n < count; ++n ) {
+				words[n] = 0;
+			}
+			return;
+		}
+		for( std::size_t n = count; n-- > word_shift; ) {
+			auto w = words[n - word_shift] << bit_shift;
+			if( bit_shift != 0 and n > word_shift ) {
+				w |= words[n - word_shift - 1U] >> ( word_bits - bit_shift );
+			}
+			words[n] = w;
+		}
+		for( std::size_t n = 0; n < word_shift; ++n ) {
+			words[n] = 0;
+		}
+	}
+
+	/// Shift the bits towards lower positions, filling with zero
+	constexpr void shift_right( word_t *words,
+	                            std::size_t count,
+	                            std::size_t bits ) noexcept {
+		auto const word_shift = bits / word_bits;
+		auto const bit_shift = bits % word_bits;
+		if( word_shift >= count ) {
+			for( std::size_t n = 0; n < count; ++n ) {
+				words[n] = 0;
+			}
+			return;
+		}
+		auto const last = count - word_shift;
+		for( std::size_t n = 0; n < last; ++n ) {
+			auto w = words[n + word_shift] >> bit_shift;
+			if( bit_shift != 0 and n + word_shift + 1U < count ) {
+				w |= words[n + word_shift + 1U] << ( word_bits - bit_shift );
+			}
+			words[n] = w;
+		}
+		for( std::size_t n = last; n < count; ++n ) {
+			words[n] = 0;
+		}
+	}
+} // namespace daw::bitset_impl
+
+namespace daw {
+	/// Constant time rank and fast select over a bitset that is no longer
+	/// modified.  It stores the number of set bits before each 512 bit block,
+	/// about 12.5% extra space.  The index refers to the bitset's words, so
+	/// it must be rebuilt after the bitset changes or is destroyed.
+	class bitset_rank_index {
+		static constexpr std::size_t block_words = 8;
+
+		bitset_impl::word_t const *m_words = nullptr;
+		std::size_t m_word_count = 0;
+		std::size_t m_ones = 0;
+		// m_block_ranks[b] is the number of set bits before block b
+		std::vector<std::size_t> m_block_ranks{ };
+
+	public:
+		static constexpr std::size_t npos = bitset_impl::npos;
+
+		bitset_rank_index( ) = default;
+
+		/// Index a bitset, anything with word_data( ) and word_count( )
+		template<typename Bitset>
+		explicit bitset_rank_index( Bitset const &bs )
+		  : m_words( bs.word_data( ) )
+		  , m_word_count( bs.word_count( ) ) {
+			auto const blocks = ( m_word_count + block_words - 1U ) / block_words;
+			m_block_ranks.reserve( blocks );
+			std::size_t total = 0;
+			for( std::size_t b = 0; b < blocks; ++b ) {
+				m_block_ranks.push_back( total );
+				auto const first = b * block_words;
+				auto const len = ( std::min )( block_words, m_word_count - first );
+				total += bitset_impl::popcount( m_words + first, len );
+			}
+			m_ones = total;
+		}
+
+		/// The number of set bits
+		[[nodiscard]] std::size_t ones( ) const noexcept {
+			return m_ones;
+		}
+
+		/// The number of set bits in [0, pos)
+		[[nodiscard]] std::size_t rank( std::size_t pos ) const noexcept {
+			auto const word_idx = pos / bitset_impl::word_bits;
+			if( word_idx >= m_word_count ) {
+				return m_ones;
+			}
+			auto const block = word_idx / block_words;
+			auto const first = block * block_words;
+			auto const bits = pos - first * bitset_impl::word_bits;
+			return m_block_ranks[block] + bitset_impl::rank( m_words + first, bits );
+		}
+
+		/// The position of the set bit with k set bits before it, or npos
+		[[nodiscard]] std::size_t select( std::size_t k ) const noexcept {
+			if( k >= m_ones ) {
+				return npos;
+			}
+			// The last block starting with at most k set bits before it
+			std::size_t lo = 0;
+			std::size_t hi = m_block_ranks.size( );
+			while( hi - lo > 1U ) {
+				auto const mid = lo + ( hi - lo ) / 2U;
+				if( m_block_ranks[mid] <= k ) {
+					lo = mid;
+				} else {
+					hi = mid;
+				}
+			}
+			auto const first = lo * block_words;
+			auto const len = ( std::min )( block_words, m_word_count - first );
+			return first * bitset_impl::word_bits +
+			       bitset_impl::select( m_words + first, len, k - m_block_ranks[lo] );
+		}
+	};
+} // namespace daw
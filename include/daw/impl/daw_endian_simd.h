@@ -0,0 +1,130 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw/ciso646.h"
+#include "daw/daw_attributes.h"
+#include "daw_simd_features.h"
+
+#include <cstddef>
+#include <cstdint>
+
+/// Byte swapping of whole blocks with vector registers.  pshufb (SSSE3) and
+/// vpshufb (AVX2) reverse each element with one shuffle; plain SSE2 gets
+/// there with word shuffles and shifts.  Each function swaps as many whole
+/// vectors as fit and returns the number of bytes done, the caller finishes
+/// the tail with the scalar swap.  Loads and stores are unaligned so src and
+/// dst only need the alignment of their element type and src may equal dst
+namespace daw::endian_details {
+#if defined( DAW_HAS_AVX2 )
+	inline constexpr std::size_t simd_width = 32;
+#elif defined( DAW_HAS_SSE2 )
+	inline constexpr std::size_t simd_width = 16;
+#else
+	inline constexpr std::size_t simd_width = 0;
+#endif
+
+#if defined( DAW_HAS_SSE2 )
+#if defined( DAW_HAS_SSSE3 )
+	/// Byte n of the result comes from byte shuffle_index<Size>( n )
+	template<std::size_t Size>
+	constexpr char shuffle_index( std::size_t n ) noexcept {
+		return static_cast<char>( ( n / Size ) * Size + ( Size - 1 - n % Size ) );
+	}
+
+	template<std::size_t Size>
+	DAW_ATTRIB_INLINE __m128i shuffle_mask_128( ) noexcept {
+		return _mm_setr_epi8(
+		  shuffle_index<Size>( 0 ), shuffle_index<Size>( 1 ),
+		  shuffle_index<Size>( 2 ), shuffle_index<Size>( 3 ),
+		  shuffle_index<Size>( 4 ), shuffle_index<Size>( 5 ),
+		  shuffle_index<Size>( 6 ), shuffle_index<Size>( 7 ),
+		  shuffle_index<Size>( 8 ), shuffle_index<Size>( 9 ),
+		  shuffle_index<Size>( 10 ), shuffle_index<Size>( 11 ),
+		  shuffle_index<Size>( 12 ), shuffle_index<Size>( 13 ),
+		  shuffle_index<Size>( 14 ), shuffle_index<Size>( 15 ) );
+	}
+#endif
+
+	template<std::size_t Size>
+	DAW_ATTRIB_INLINE __m128i swap_128( __m128i value ) noexcept {
+#if defined( DAW_HAS_SSSE3 )
+		return _mm_shuffle_epi8( value, shuffle_mask_128<Size>( ) );
+#else
+		if constexpr( Size == 4 ) {
+			// Swap the 16bit halves, then the bytes within them
+			value = _mm_shufflehi_epi16( _mm_shufflelo_epi16( value, 0xB1 ), 0xB1 );
+		} else if constexpr( Size == 8 ) {
+			value = _mm_shufflehi_epi16( _mm_shufflelo_epi16( value, 0x1B ), 0x1B );
+		}
+		return _mm_or_si128( _mm_slli_epi16( value, 8 ),
+		                     _mm_srli_epi16( value, 8 ) );
+#endif
+	}
+
+	template<std::size_t Size>
+	DAW_ATTRIB_INLINE void swap_block_128( unsigned char const *src,
+	                                       unsigned char *dst ) noexcept {
+		_mm_storeu_si128(
+		  reinterpret_cast<__m128i *>( dst ),
+		  swap_128<Size>(
+		    _mm_loadu_si128( reinterpret_cast<__m128i const *>( src ) ) ) );
+	}
+#endif
+
+#if defined( DAW_HAS_AVX2 )
+	template<std::size_t Size>
+	DAW_ATTRIB_INLINE void swap_block_256( unsigned char const *src,
+	                                       unsigned char *dst,
+	                                       __m256i mask ) noexcept {
+		_mm256_storeu_si256(
+		  reinterpret_cast<__m256i *>( dst ),
+		  _mm256_shuffle_epi8(
+		    _mm256_loadu_si256( reinterpret_cast<__m256i const *>( src ) ),
+		    mask ) );
+	}
+#endif
+
+	template<std::size_t Size>
+	inline std::size_t swap_bytes_simd( unsigned char const *src,
+	                                    unsigned char *dst,
+	                                    std::size_t bytes ) noexcept {
+		std::size_t pos = 0;
+#if defined( DAW_HAS_AVX2 )
+		// vpshufb shuffles within each 128bit lane, so the mask is repeated
+		auto const mask = _mm256_broadcastsi128_si256( shuffle_mask_128<Size>( ) );
+		for( ; pos + 4 * 32 <= bytes; pos += 4 * 32 ) {
+			swap_block_256<Size>( src + pos, dst + pos, mask );
+			swap_block_256<Size>( src + pos + 32, dst + pos + 32, mask );
+			swap_block_256<Size>( src + pos + 64, dst + pos + 64, mask );
+			swap_block_256<Size>( src + pos + 96, dst + pos + 96, mask );
+		}
+		for( ; pos + 32 <= bytes; pos += 32 ) {
+			swap_block_256<Size>( src + pos, dst + pos, mask );
+		}
+#elif defined( DAW_HAS_SSE2 )
+		for( ; pos + 4 * 16 <= bytes; pos += 4 * 16 ) {
+			swap_block_128<Size>( src + pos, dst + pos );
+			swap_block_128<Size>( src + pos + 16, dst + pos + 16 );
+			swap_block_128<Size>( src + pos + 32, dst + pos + 32 );
+			swap_block_128<Size>( src + pos + 48, dst + pos + 48 );
+		}
+#endif
+#if defined( DAW_HAS_SSE2 )
+		for( ; pos + 16 <= bytes; pos += 16 ) {
+			swap_block_128<Size>( src + pos, dst + pos );
+		}
+#else
+		(void)src;
+		(void)dst;
+		(void)bytes;
+#endif
+		return pos;
+	}
+} // namespace daw::endian_details
@@ -0,0 +1,441 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw/ciso646.h"
+#include "daw/daw_attributes.h"
+#include "daw_simd_features.h"
+
+#include <cstddef>
+#include <cstdint>
+
+/// Vector kernels for hex and base64.  Each function handles as many whole
+/// blocks as it can without reading or writing past the buffers and returns
+/// the number of input bytes done; the caller finishes with the scalar code.
+/// Decoders stop before the first block holding an invalid character so the
+/// scalar code can report its exact position.
+/// Hex uses SSE2 compares and adds.  Base64 follows Muła and Lemire, "Faster
+/// Base64 Encoding and Decoding using AVX2 Instructions": a pshufb/multiply
+/// to move the 6 bit groups into bytes when encoding and maddubs/madd to
+/// merge them when decoding, so it needs SSSE3.  Character classes are range
+/// checks rather than lookup tables, which lets one kernel serve both the
+/// standard and URL safe alphabets
+namespace daw::encoding_impl {
+#if defined( DAW_HAS_SSE2 )
+	/// All ones in the bytes of c that are in [Low, High]
+	template<char Low, char High>
+	[[nodiscard]] DAW_ATTRIB_INLINE __m128i in_range_128( __m128i c ) noexcept {
+		return _mm_cmplt_epi8(
+		  _mm_add_epi8( c, _mm_set1_epi8( static_cast<char>( 0x80 - Low ) ) ),
+		  _mm_set1_epi8( static_cast<char>( -128 + ( High - Low + 1 ) ) ) );
+	}
+
+	/// Nibbles, 0-15, to hex digits
+	template<bool Upper>
+	[[nodiscard]] DAW_ATTRIB_INLINE __m128i
+	hex_digits_128( __m128i nibbles ) noexcept {
+		auto const is_alpha = _mm_cmpgt_epi8( nibbles, _mm_set1_epi8( 9 ) );
+		auto const alpha_offset =
+		  _mm_set1_epi8( static_cast<char>( ( Upper ? 'A' : 'a' ) - '0' - 10 ) );
+		return _mm_add_epi8( _mm_add_epi8( nibbles, _mm_set1_epi8( '0' ) ),
+		                     _mm_and_si128( is_alpha, alpha_offset ) );
+	}
+
+	template<bool Upper>
+	[[nodiscard]] inline std::size_t
+	hex_encode_simd( unsigned char const *src, std::size_t count,
+	                 char *dst ) noexcept {
+		auto const low_nibble = _mm_set1_epi8( 0x0F );
+		std::size_t pos = 0;
+		for( ; pos + 16U <= count; pos += 16U ) {
+			auto const v =
+			  _mm_loadu_si128( reinterpret_cast<__m128i const *>( src + pos ) );
+			auto const hi = hex_digits_128<Upper>(
+			  _mm_and_si128( _mm_srli_epi16( v, 4 ), low_nibble ) );
+			auto const lo = hex_digits_128<Upper>( _mm_and_si128( v, low_nibble ) );
+			auto *const out = reinterpret_cast<__m128i *>( dst + 2U * pos );
+			_mm_storeu_si128( out, _mm_unpacklo_epi8( hi, lo ) );
+			_mm_storeu_si128( out + 1, _mm_unpackhi_epi8( hi, lo ) );
+		}
+		return pos;
+	}
+
+	/// Hex digits to their values, with valid set to all ones for the bytes
+	/// that are hex digits
+	[[nodiscard]] DAW_ATTRIB_INLINE __m128i hex_values_128( __m128i c,
+	                                                        __m128i &valid ) {
+		auto const digit = _mm_sub_epi8( c, _mm_set1_epi8( '0' ) );
+		auto const is_digit =
+		  _mm_cmpeq_epi8( _mm_min_epu8( digit, _mm_set1_epi8( 9 ) ), digit );
+		auto const alpha = _mm_sub_epi8( _mm_or_si128( c, _mm_set1_epi8( 0x20 ) ),
+		                                 _mm_set1_epi8( 'a' ) );
+		auto const is_alpha =
+		  _mm_cmpeq_epi8( _mm_min_epu8( alpha, _mm_set1_epi8( 5 ) ), alpha );
+		valid = _mm_or_si128( is_digit, is_alpha );
+		return _mm_or_si128(
+		  _mm_and_si128( is_digit, digit ),
+		  _mm_and_si128( is_alpha, _mm_add_epi8( alpha, _mm_set1_epi8( 10 ) ) ) );
+	}
+
+	/// Pairs of nibble values to bytes in the low half of each 16 bit lane
+	[[nodiscard]] DAW_ATTRIB_INLINE __m128i hex_pairs_128( __m128i v ) noexcept {
+		return _mm_or_si128(
+		  _mm_slli_epi16( _mm_and_si128( v, _mm_set1_epi16( 0xFF ) ), 4 ),
+		  _mm_srli_epi16( v, 8 ) );
+	}
+
+	/// count is the number of hex digits
+	[[nodiscard]] inline std::size_t hex_decode_simd( char const *src,
+	                                                  std::size_t count,
+	                                                  unsigned char *dst ) {
+		std::size_t pos = 0;
+		for( ; pos + 32U <= count; pos += 32U ) {
+			__m128i valid0;
+			__m128i valid1;
+			auto const v0 = hex_values_128(
+			  _mm_loadu_si128( reinterpret_cast<__m128i const *>( src + pos ) ),
+			  valid0 );
+			auto const v1 = hex_values_128(
+			  _mm_loadu_si128( reinterpret_cast<__m128i const *>( src + pos + 16 ) ),
+			  valid1 );
+			if( _mm_movemask_epi8( _mm_and_si128( valid0, valid1 ) ) != 0xFFFF ) {
+				break;
+			}
+			_mm_storeu_si128(
+			  reinterpret_cast<__m128i *>( dst + pos / 2U ),
+			  _mm_packus_epi16( hex_pairs_128( v0 ), hex_pairs_128( v1 ) ) );
+		}
+		return pos;
+	}
+#endif
+
+#if defined( DAW_HAS_SSSE3 )
+	/// Spread 12 bytes into 16 bytes of 6 bit indices
+	[[nodiscard]] DAW_ATTRIB_INLINE __m128i
+	base64_split_128( __m128i in ) noexcept {
+		in = _mm_shuffle_epi8(
+		  in, _mm_set_epi8( 10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1 ) );
+		auto const t0 = _mm_and_si128( in, _mm_set1_epi32( 0x0FC0'FC00 ) );
+		auto const t1 = _mm_mulhi_epu16( t0, _mm_set1_epi32( 0x0400'0040 ) );
+		auto const t2 = _mm_and_si128( in, _mm_set1_epi32( 0x003F'03F0 ) );
+		auto const t3 = _mm_mullo_epi16( t2, _mm_set1_epi32( 0x0100'0010 ) );
+		return _mm_or_si128( t1, t3 );
+	}
+
+	/// The offset added to an index to get its character, looked up by a
+	/// small class number
+	template<bool Url>
+	[[nodiscard]] DAW_ATTRIB_INLINE __m128i base64_offsets_128( ) noexcept {
+		constexpr char c62 = Url ? '-' : '+';
+		constexpr char c63 = Url ? '_' : '/';
+		constexpr char digit = static_cast<char>( '0' - 52 );
+		return _mm_setr_epi8( static_cast<char>( 'a' - 26 ), digit, digit, digit,
+		                      digit, digit, digit, digit, digit, digit, digit,
+		                      static_cast<char>( c62 - 62 ),
+		                      static_cast<char>( c63 - 63 ), 'A', 0, 0 );
+	}
+
+	/// Indices 0-25 map to class 13, 26-51 to 0, 52-61 to 1-10, 62 to 11 and
+	/// 63 to 12
+	[[nodiscard]] DAW_ATTRIB_INLINE __m128i
+	base64_classes_128( __m128i indices ) noexcept {
+		auto const result = _mm_subs_epu8( indices, _mm_set1_epi8( 51 ) );
+		auto const less = _mm_cmpgt_epi8( _mm_set1_epi8( 26 ), indices );
+		return _mm_or_si128( result, _mm_and_si128( less, _mm_set1_epi8( 13 ) ) );
+	}
+
+	template<bool Url>
+	[[nodiscard]] DAW_ATTRIB_INLINE __m128i
+	base64_chars_128( __m128i indices ) noexcept {
+		return _mm_add_epi8( indices,
+		                     _mm_shuffle_epi8( base64_offsets_128<Url>( ),
+		                                       base64_classes_128( indices ) ) );
+	}
+
+	/// Character values, with valid set to all ones for the bytes in the
+	/// alphabet
+	template<bool Url>
+	[[nodiscard]] DAW_ATTRIB_INLINE __m128i base64_values_128( __m128i c,
+	                                                           __m128i &valid ) {
+		constexpr char c62 = Url ? '-' : '+';
+		constexpr char c63 = Url ? '_' : '/';
+		auto const upper = in_range_128<'A', 'Z'>( c );
+		auto const lower = in_range_128<'a', 'z'>( c );
+		auto const digit = in_range_128<'0', '9'>( c );
+		auto const is62 = _mm_cmpeq_epi8( c, _mm_set1_epi8( c62 ) );
+		auto const is63 = _mm_cmpeq_epi8( c, _mm_set1_epi8( c63 ) );
+		valid = _mm_or_si128( _mm_or_si128( upper, lower ),
+		                      _mm_or_si128( digit, _mm_or_si128( is62, is63 ) ) );
+		auto const shift = _mm_or_si128(
+		  _mm_or_si128(
+		    _mm_and_si128( upper, _mm_set1_epi8( static_cast<char>( -'A' ) ) ),
+		    _mm_and_si128( lower,
+		                   _mm_set1_epi8( static_cast<char>( 26 - 'a' ) ) ) ),
+		  _mm_or_si128(
+		    _mm_and_si128( digit, _mm_set1_epi8( static_cast<char>( 52 - '0' ) ) ),
+		    _mm_or_si128(
+		      _mm_and_si128( is62, _mm_set1_epi8( static_cast<char>( 62 - c62 ) ) ),
+		      _mm_and_si128( is63,
+		                     _mm_set1_epi8( static_cast<char>( 63 - c63 ) ) ) ) ) );
+		return _mm_add_epi8( c, shift );
+	}
+
+	/// Merge each group of four 6 bit values into 3 bytes, in the low 12 bytes
+	[[nodiscard]] DAW_ATTRIB_INLINE __m128i
+	base64_merge_128( __m128i values ) noexcept {
+		auto const ab_cd =
+		  _mm_maddubs_epi16( values, _mm_set1_epi32( 0x0140'0140 ) );
+		auto const abcd = _mm_madd_epi16( ab_cd, _mm_set1_epi32( 0x0001'1000 ) );
+		return _mm_shuffle_epi8( abcd, _mm_setr_epi8( 2, 1, 0, 6, 5, 4, 10, 9,
+		                                              8, 14, 13, 12, -1, -1, -1,
+		                                              -1 ) );
+	}
+#endif
+
+#if defined( DAW_HAS_AVX2 )
+	[[nodiscard]] DAW_ATTRIB_INLINE __m256i both_lanes( __m128i v ) noexcept {
+		return _mm256_inserti128_si256( _mm256_castsi128_si256( v ), v, 1 );
+	}
+
+	template<char Low, char High>
+	[[nodiscard]] DAW_ATTRIB_INLINE __m256i in_range_256( __m256i c ) noexcept {
+		return _mm256_cmpgt_epi8(
+		  _mm256_set1_epi8( static_cast<char>( -128 + ( High - Low + 1 ) ) ),
+		  _mm256_add_epi8( c,
+		                   _mm256_set1_epi8( static_cast<char>( 0x80 - Low ) ) ) );
+	}
+
+	template<bool Upper>
+	[[nodiscard]] DAW_ATTRIB_INLINE __m256i
+	hex_digits_256( __m256i nibbles ) noexcept {
+		auto const is_alpha = _mm256_cmpgt_epi8( nibbles, _mm256_set1_epi8( 9 ) );
+		auto const alpha_offset = _mm256_set1_epi8(
+		  static_cast<char>( ( Upper ? 'A' : 'a' ) - '0' - 10 ) );
+		return _mm256_add_epi8(
+		  _mm256_add_epi8( nibbles, _mm256_set1_epi8( '0' ) ),
+		  _mm256_and_si256( is_alpha, alpha_offset ) );
+	}
+
+	template<bool Upper>
+	[[nodiscard]] inline std::size_t
+	hex_encode_avx2( unsigned char const *src, std::size_t count,
+	                 char *dst ) noexcept {
+		auto const low_nibble = _mm256_set1_epi8( 0x0F );
+		std::size_t pos = 0;
+		for( ; pos + 32U <= count; pos += 32U ) {
+			auto const v =
+			  _mm256_loadu_si256( reinterpret_cast<__m256i const *>( src + pos ) );
+			auto const hi = hex_digits_256<Upper>(
+			  _mm256_and_si256( _mm256_srli_epi16( v, 4 ), low_nibble ) );
+			auto const lo =
+			  hex_digits_256<Upper>( _mm256_and_si256( v, low_nibble ) );
+			// The unpacks work within each 128 bit lane
+			auto const a = _mm256_unpacklo_epi8( hi, lo );
+			auto const b = _mm256_unpackhi_epi8( hi, lo );
+			auto *const out = reinterpret_cast<__m256i *>( dst + 2U * pos );
+			_mm256_storeu_si256( out, _mm256_permute2x128_si256( a, b, 0x20 ) );
+			_mm256_storeu_si256( out + 1, _mm256_permute2x128_si256( a, b, 0x31 ) );
+		}
+		return pos;
+	}
+
+	[[nodiscard]] DAW_ATTRIB_INLINE __m256i hex_values_256( __m256i c,
+	                                                        __m256i &valid ) {
+		auto const digit = _mm256_sub_epi8( c, _mm256_set1_epi8( '0' ) );
+		auto const is_digit = _mm256_cmpeq_epi8(
+		  _mm256_min_epu8( digit, _mm256_set1_epi8( 9 ) ), digit );
+		auto const alpha = _mm256_sub_epi8(
+		  _mm256_or_si256( c, _mm256_set1_epi8( 0x20 ) ), _mm256_set1_epi8( 'a' ) );
+		auto const is_alpha = _mm256_cmpeq_epi8(
+		  _mm256_min_epu8( alpha, _mm256_set1_epi8( 5 ) ), alpha );
+		valid = _mm256_or_si256( is_digit, is_alpha );
+		return _mm256_or_si256(
+		  _mm256_and_si256( is_digit, digit ),
+		  _mm256_and_si256( is_alpha,
+		                    _mm256_add_epi8( alpha, _mm256_set1_epi8( 10 ) ) ) );
+	}
+
+	[[nodiscard]] DAW_ATTRIB_INLINE __m256i hex_pairs_256( __m256i v ) noexcept {
+		return _mm256_or_si256(
+		  _mm256_slli_epi16( _mm256_and_si256( v, _mm256_set1_epi16( 0xFF ) ), 4 ),
+		  _mm256_srli_epi16( v, 8 ) );
+	}
+
+	[[nodiscard]] inline std::size_t hex_decode_avx2( char const *src,
+	                                                  std::size_t count,
+	                                                  unsigned char *dst ) {
+		std::size_t pos = 0;
+		for( ; pos + 64U <= count; pos += 64U ) {
+			__m256i valid0;
+			__m256i valid1;
+			auto const v0 = hex_values_256(
+			  _mm256_loadu_si256( reinterpret_cast<__m256i const *>( src + pos ) ),
+			  valid0 );
+			auto const v1 = hex_values_256(
+			  _mm256_loadu_si256(
+			    reinterpret_cast<__m256i const *>( src + pos + 32 ) ),
+			  valid1 );
+			if( _mm256_movemask_epi8( _mm256_and_si256( valid0, valid1 ) ) != -1 ) {
+				break;
+			}
+			// packus works within lanes, put the 64 bit quarters back in order
+			auto const packed =
+			  _mm256_packus_epi16( hex_pairs_256( v0 ), hex_pairs_256( v1 ) );
+			_mm256_storeu_si256( reinterpret_cast<__m256i *>( dst + pos / 2U ),
+			                     _mm256_permute4x64_epi64( packed, 0xD8 ) );
+		}
+		return pos;
+	}
+
+	[[nodiscard]] DAW_ATTRIB_INLINE __m256i
+	base64_split_256( __m256i in ) noexcept {
+		in = _mm256_shuffle_epi8(
+		  in, both_lanes( _mm_set_epi8( 10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1,
+		                                2, 0, 1 ) ) );
+		auto const t0 = _mm256_and_si256( in, _mm256_set1_epi32( 0x0FC0'FC00 ) );
+		auto const t1 = _mm256_mulhi_epu16( t0, _mm256_set1_epi32( 0x0400'0040 ) );
+		auto const t2 = _mm256_and_si256( in, _mm256_set1_epi32( 0x003F'03F0 ) );
+		auto const t3 = _mm256_mullo_epi16( t2, _mm256_set1_epi32( 0x0100'0010 ) );
+		return _mm256_or_si256( t1, t3 );
+	}
+
+	template<bool Url>
+	[[nodiscard]] DAW_ATTRIB_INLINE __m256i
+	base64_chars_256( __m256i indices ) noexcept {
+		auto classes = _mm256_subs_epu8( indices, _mm256_set1_epi8( 51 ) );
+		auto const less = _mm256_cmpgt_epi8( _mm256_set1_epi8( 26 ), indices );
+		classes = _mm256_or_si256(
+		  classes, _mm256_and_si256( less, _mm256_set1_epi8( 13 ) ) );
+		return _mm256_add_epi8(
+		  indices, _mm256_shuffle_epi8( both_lanes( base64_offsets_128<Url>( ) ),
+		                                classes ) );
+	}
+
+	template<bool Url>
+	[[nodiscard]] DAW_ATTRIB_INLINE __m256i base64_values_256( __m256i c,
+	                                                           __m256i &valid ) {
+		constexpr char c62 = Url ? '-' : '+';
+		constexpr char c63 = Url ? '_' : '/';
+		auto const upper = in_range_256<'A', 'Z'>( c );
+		auto const lower = in_range_256<'a', 'z'>( c );
+		auto const digit = in_range_256<'0', '9'>( c );
+		auto const is62 = _mm256_cmpeq_epi8( c, _mm256_set1_epi8( c62 ) );
+		auto const is63 = _mm256_cmpeq_epi8( c, _mm256_set1_epi8( c63 ) );
+		valid = _mm256_or_si256(
+		  _mm256_or_si256( upper, lower ),
+		  _mm256_or_si256( digit, _mm256_or_si256( is62, is63 ) ) );
+		auto const shift = _mm256_or_si256(
+		  _mm256_or_si256(
+		    _mm256_and_si256( upper,
+		                      _mm256_set1_epi8( static_cast<char>( -'A' ) ) ),
+		    _mm256_and_si256( lower,
+		                      _mm256_set1_epi8( static_cast<char>( 26 - 'a' ) ) ) ),
+		  _mm256_or_si256(
+		    _mm256_and_si256( digit,
+		                      _mm256_set1_epi8( static_cast<char>( 52 - '0' ) ) ),
+		    _mm256_or_si256(
+		      _mm256_and_si256( is62,
+		                        _mm256_set1_epi8( static_cast<char>( 62 - c62 ) ) ),
+		      _mm256_and_si256(
+		        is63, _mm256_set1_epi8( static_cast<char>( 63 - c63 ) ) ) ) ) );
+		return _mm256_add_epi8( c, shift );
+	}
+
+	/// Merge groups of four 6 bit values into 24 bytes at the start
+	[[nodiscard]] DAW_ATTRIB_INLINE __m256i
+	base64_merge_256( __m256i values ) noexcept {
+		auto const ab_cd =
+		  _mm256_maddubs_epi16( values, _mm256_set1_epi32( 0x0140'0140 ) );
+		auto const abcd =
+		  _mm256_madd_epi16( ab_cd, _mm256_set1_epi32( 0x0001'1000 ) );
+		auto const packed = _mm256_shuffle_epi8(
+		  abcd, both_lanes( _mm_setr_epi8( 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12,
+		                                   -1, -1, -1, -1 ) ) );
+		return _mm256_permutevar8x32_epi32(
+		  packed, _mm256_setr_epi32( 0, 1, 2, 4, 5, 6, 3, 7 ) );
+	}
+#endif
+
+	/// Returns the number of input bytes encoded, a multiple of 3
+	template<bool Url>
+	[[nodiscard]] inline std::size_t
+	base64_encode_simd( unsigned char const *src, std::size_t count,
+	                    char *dst ) noexcept {
+		std::size_t pos = 0;
+		std::size_t out = 0;
+#if defined( DAW_HAS_AVX2 )
+		// Each lane loads 16 bytes and uses 12
+		for( ; pos + 28U <= count; pos += 24U, out += 32U ) {
+			auto const lo =
+			  _mm_loadu_si128( reinterpret_cast<__m128i const *>( src + pos ) );
+			auto const hi =
+			  _mm_loadu_si128( reinterpret_cast<__m128i const *>( src + pos + 12 ) );
+			auto const in =
+			  _mm256_inserti128_si256( _mm256_castsi128_si256( lo ), hi, 1 );
+			_mm256_storeu_si256( reinterpret_cast<__m256i *>( dst + out ),
+			                     base64_chars_256<Url>( base64_split_256( in ) ) );
+		}
+#endif
+#if defined( DAW_HAS_SSSE3 )
+		for( ; pos + 16U <= count; pos += 12U, out += 16U ) {
+			auto const in =
+			  _mm_loadu_si128( reinterpret_cast<__m128i const *>( src + pos ) );
+			_mm_storeu_si128( reinterpret_cast<__m128i *>( dst + out ),
+			                  base64_chars_128<Url>( base64_split_128( in ) ) );
+		}
+#endif
+		(void)src;
+		(void)count;
+		(void)dst;
+		(void)out;
+		return pos;
+	}
+
+	/// count is the number of characters before any padding.  Returns the
+	/// number of characters decoded, a multiple of 4.  Stores write past the
+	/// decoded bytes, so blocks stop while there is room for the whole store
+	template<bool Url>
+	[[nodiscard]] inline std::size_t base64_decode_simd( char const *src,
+	                                                     std::size_t count,
+	                                                     unsigned char *dst ) {
+		std::size_t pos = 0;
+		std::size_t out = 0;
+#if defined( DAW_HAS_AVX2 )
+		for( ; pos + 44U <= count; pos += 32U, out += 24U ) {
+			__m256i valid;
+			auto const values = base64_values_256<Url>(
+			  _mm256_loadu_si256( reinterpret_cast<__m256i const *>( src + pos ) ),
+			  valid );
+			if( _mm256_movemask_epi8( valid ) != -1 ) {
+				return pos;
+			}
+			_mm256_storeu_si256( reinterpret_cast<__m256i *>( dst + out ),
+			                     base64_merge_256( values ) );
+		}
+#endif
+#if defined( DAW_HAS_SSSE3 )
+		for( ; pos + 24U <= count; pos += 16U, out += 12U ) {
+			__m128i valid;
+			auto const values = base64_values_128<Url>(
+			  _mm_loadu_si128( reinterpret_cast<__m128i const *>( src + pos ) ),
+			  valid );
+			if( _mm_movemask_epi8( valid ) != 0xFFFF ) {
+				return pos;
+			}
+			_mm_storeu_si128( reinterpret_cast<__m128i *>( dst + out ),
+			                  base64_merge_128( values ) );
+		}
+#endif
+		(void)src;
+		(void)count;
+		(void)dst;
+		(void)out;
+		return pos;
+	}
+} // namespace daw::encoding_impl
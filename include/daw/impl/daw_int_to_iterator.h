@@ -11,7 +11,10 @@
 #include "daw/ciso646.h"
 #include "daw/deprecated/daw_bounded_string.h"
 #include "daw/daw_exception.h"
+#include "daw/daw_string_view.h"
+#include "daw/daw_to_chars.h"
 #include "daw/daw_traits.h"
+#include "daw/daw_utility.h"
 
 #include <limits>
 
@@ -21,15 +24,15 @@ namespace daw {
 		constexpr Result num_digits( T value ) noexcept {
 			static_assert( std::is_integral_v<Result>,
 			               "Result must be an integer type" );
-			if( value == 0 ) {
-				return static_cast<Result>( 1 );
-			}
-			Result result = 0;
-			while( value != 0 ) {
-				value /= 10;
-				++result;
+			using unsigned_t = std::make_unsigned_t<daw::remove_cvref_t<T>>;
+			auto magnitude = static_cast<unsigned_t>( value );
+			if constexpr( std::is_signed_v<daw::remove_cvref_t<T>> ) {
+				if( value < 0 ) {
+					magnitude = static_cast<unsigned_t>( unsigned_t{ 0 } - magnitude );
+				}
 			}
-			return result;
+			return static_cast<Result>( daw::to_chars_impl::count_digits(
+			  static_cast<std::uint64_t>( magnitude ) ) );
 		}
 
 		template<
@@ -182,38 +185,18 @@ namespace daw {
 		         typename Traits = daw::impl::char_traits<CharT>,
 		         std::enable_if_t<
 		           daw::all_true_v<
-		             not std::is_integral_v<daw::remove_cvref_t<Integer>>,
+		             std::is_integral_v<daw::remove_cvref_t<Integer>>,
 		             not std::is_same_v<bool, daw::remove_cvref_t<Integer>>,
-		             not std::is_floating_point_v<daw::remove_cvref_t<Integer>>,
 		             not daw::traits::is_character_v<Integer>>,
 		           std::nullptr_t> = nullptr>
 		constexpr OutputIterator
 		to_os_string( OutputIterator it, Integer value, daw::tag_t<int> ) {
-
-			if( value < 0 ) {
-				if( value == ( std::numeric_limits<Integer>::min )( ) ) {
-					constexpr auto m = min_strings::get(
-					  CharT{ }, std::integral_constant<size_t, sizeof( Integer )>{ } );
-					return daw::algorithm::copy( m.begin( ), m.end( ), it );
-				}
-				*it = static_cast<CharT>( '-' );
+			constexpr auto buff_size = daw::max_chars_v<daw::remove_cvref_t<Integer>>;
+			char buff[buff_size]{ };
+			auto const result = daw::to_chars( buff, buff + buff_size, value );
+			for( char const *ptr = buff; ptr != result.ptr; ++ptr ) {
+				*it = static_cast<CharT>( *ptr );
 				++it;
-				value = -value;
-			}
-			for( auto p10 = pow10<Integer>( whole_log10<uint16_t>( value ) );
-			     p10 >= 1;
-			     p10 /= static_cast<Integer>( 10 ) ) {
-
-				auto const tmp = value / p10;
-
-				daw::exception::dbg_precondition_check(
-				  tmp >= 0 && tmp < 10,
-				  "There should only ever be a single digit positive number" );
-
-				*it = Traits::get_char_digit( tmp );
-				++it;
-
-				value -= tmp * p10;
 			}
 			return it;
 		}
@@ -0,0 +1,196 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw/ciso646.h"
+#include "daw/daw_attributes.h"
+#include "daw/daw_cxmath.h"
+#include "daw/daw_likely.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+/// Integer parsing that converts 8 digits at a time with SWAR (SIMD within a
+/// register) arithmetic on a 64bit word.  Shorter tails use overlapping loads
+/// and only runs longer than 19 digits go a digit at a time.  Everything is
+/// constexpr; the byte wise loads compile to single unaligned loads
+namespace daw::parse_digits_impl {
+	inline constexpr std::uint64_t ascii_zeros = 0x3030'3030'3030'3030ULL;
+	inline constexpr std::uint64_t high_nibbles = 0xF0F0'F0F0'F0F0'F0F0ULL;
+
+	/// Any 19 digit number fits in a uint64_t
+	inline constexpr std::size_t max_safe_digits = 19;
+
+	inline constexpr std::uint64_t pow10_table[9] = {
+	  1ULL,       10ULL,        100ULL,        1'000ULL,      10'000ULL,
+	  100'000ULL, 1'000'000ULL, 10'000'000ULL, 100'000'000ULL };
+
+	[[nodiscard]] constexpr bool is_digit( char c ) noexcept {
+		return static_cast<unsigned char>( static_cast<unsigned char>( c ) -
+		                                   static_cast<unsigned char>( '0' ) ) <
+		       10U;
+	}
+
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr std::uint64_t
+	load_byte( char const *ptr, std::size_t n ) noexcept {
+		return static_cast<std::uint64_t>( static_cast<unsigned char>( ptr[n] ) )
+		       << ( 8U * n );
+	}
+
+	/// Load 8 chars so that the first char is in the low byte.  Written out so
+	/// that it is recognized as a single load
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr std::uint64_t
+	load_eight( char const *ptr ) noexcept {
+		return load_byte( ptr, 0 ) | load_byte( ptr, 1 ) | load_byte( ptr, 2 ) |
+		       load_byte( ptr, 3 ) | load_byte( ptr, 4 ) | load_byte( ptr, 5 ) |
+		       load_byte( ptr, 6 ) | load_byte( ptr, 7 );
+	}
+
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr std::uint64_t
+	load_four( char const *ptr ) noexcept {
+		return load_byte( ptr, 0 ) | load_byte( ptr, 1 ) | load_byte( ptr, 2 ) |
+		       load_byte( ptr, 3 );
+	}
+
+	/// Load count( 1-7 ) chars without reading past them, using overlapping
+	/// loads instead of a loop.  The missing high bytes are 0, which is not a
+	/// digit
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr std::uint64_t
+	load_partial( char const *ptr, std::size_t count ) noexcept {
+		if( count >= 4U ) {
+			return load_four( ptr ) | ( load_four( ptr + count - 4U )
+			                            << ( 8U * ( count - 4U ) ) );
+		}
+		return load_byte( ptr, 0 ) | load_byte( ptr, count / 2U ) |
+		       load_byte( ptr, count - 1U );
+	}
+
+	/// A mask with bits set in the high nibble of every byte that is not an
+	/// ascii digit.  Bytes after the first non-digit can be wrong because of
+	/// carries, but the lowest set byte is always the first non-digit
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr std::uint64_t
+	non_digit_mask( std::uint64_t chunk ) noexcept {
+		auto const high = ( chunk & high_nibbles ) ^ ascii_zeros;
+		auto const low =
+		  ( ( chunk + 0x0606'0606'0606'0606ULL ) & high_nibbles ) ^ ascii_zeros;
+		return high | low;
+	}
+
+	/// The number of leading digits in the chunk
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr std::size_t
+	digit_count( std::uint64_t chunk ) noexcept {
+		auto const mask = non_digit_mask( chunk );
+		if( mask == 0 ) {
+			return 8U;
+		}
+		return static_cast<std::size_t>(
+		         daw::cxmath::count_trailing_zeros( mask ) ) /
+		       8U;
+	}
+
+	/// Convert the first count( 1-8 ) digits in chunk
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr std::uint64_t
+	convert_digits( std::uint64_t chunk, std::size_t count ) noexcept {
+		// Borrows only propagate to later characters, which are shifted out
+		auto v = ( chunk - ascii_zeros ) << ( 8U * ( 8U - count ) );
+		v = ( v * 10U ) + ( v >> 8U );
+		return ( ( ( v & 0x0000'00FF'0000'00FFULL ) *
+		           ( 100ULL + ( 1'000'000ULL << 32U ) ) ) +
+		         ( ( ( v >> 16U ) & 0x0000'00FF'0000'00FFULL ) *
+		           ( 1ULL + ( 10'000ULL << 32U ) ) ) ) >>
+		       32U;
+	}
+
+	struct digits_result {
+		char const *last;
+		std::uint64_t value;
+		bool overflow;
+	};
+
+	/// Digit at a time with overflow checks, for runs longer than
+	/// max_safe_digits
+	[[nodiscard]] DAW_ATTRIB_NOINLINE constexpr digits_result
+	parse_long_digits( char const *first, char const *last ) noexcept {
+		// Leading zeros do not count towards the overflow limit
+		while( first != last and *first == '0' ) {
+			++first;
+		}
+		char const *const significant = first;
+		std::uint64_t value = 0;
+		bool overflow = false;
+		while( first != last and is_digit( *first ) ) {
+			auto const digit = static_cast<std::uint64_t>( *first - '0' );
+			if( static_cast<std::size_t>( first - significant ) >=
+			    max_safe_digits ) {
+				// A 20th digit only fits if the result is at most uint64_t's max
+				overflow =
+				  overflow or
+				  static_cast<std::size_t>( first - significant ) > max_safe_digits or
+				  value > ( std::numeric_limits<std::uint64_t>::max( ) - digit ) / 10U;
+			}
+			value = value * 10U + digit;
+			++first;
+		}
+		return digits_result{ first, value, overflow };
+	}
+
+	/// Parse the run of digits at the start of [first, last).  last in the
+	/// result points to the first char that is not a digit.  When the value
+	/// does not fit in a uint64_t, overflow is set and the digits are still
+	/// consumed
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr digits_result
+	parse_digits( char const *first, char const *last ) noexcept {
+		char const *const start = first;
+		std::uint64_t value = 0;
+		while( first != last ) {
+			auto const remaining = static_cast<std::size_t>( last - first );
+			auto const chunk = remaining >= 8U ? load_eight( first )
+			                                   : load_partial( first, remaining );
+			auto const count = digit_count( chunk );
+			if( DAW_UNLIKELY( static_cast<std::size_t>( first - start ) + count >
+			                  max_safe_digits ) ) {
+				return parse_long_digits( start, last );
+			}
+			if( count == 0 ) {
+				break;
+			}
+			value = value * pow10_table[count] + convert_digits( chunk, count );
+			first += count;
+			if( count < 8U ) {
+				break;
+			}
+		}
+		return digits_result{ first, value, false };
+	}
+
+	/// Convert a parsed magnitude to Result, or return false if it does not
+	/// fit.  Branch free, as the sign is often unpredictable
+	template<typename Result>
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr bool
+	to_integer( std::uint64_t magnitude,
+	            bool is_negative,
+	            Result &result ) noexcept {
+		static_assert( std::is_integral_v<Result> and sizeof( Result ) <= 8 );
+		using unsigned_t = std::make_unsigned_t<Result>;
+		constexpr auto max_value =
+		  static_cast<std::uint64_t>( std::numeric_limits<Result>::max( ) );
+		// The magnitude of min( ) is one more than max( ) for signed types, and
+		// only -0 is allowed for unsigned
+		std::uint64_t const limit =
+		  std::is_signed_v<Result>
+		    ? max_value + static_cast<std::uint64_t>( is_negative )
+		    : ( is_negative ? 0U : max_value );
+		auto const bits = static_cast<unsigned_t>( magnitude );
+		result = static_cast<Result>(
+		  is_negative ? static_cast<unsigned_t>( unsigned_t{ 0 } - bits ) : bits );
+		return magnitude <= limit;
+	}
+} // namespace daw::parse_digits_impl
@@ -0,0 +1,33 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw/ciso646.h"
+
+/// The x86 vector extensions enabled for this translation unit.  Code paths
+/// are chosen at compile time, so -mssse3/-mavx2 (or /arch:AVX2) select the
+/// wider kernels and a plain x86-64 build gets SSE2
+#if defined( __AVX2__ )
+#define DAW_HAS_AVX2
+#endif
+#if defined( __SSSE3__ ) or defined( __AVX__ )
+#define DAW_HAS_SSSE3
+#endif
+#if defined( __SSE2__ ) or defined( _M_X64 ) or                             \
+  ( defined( _M_IX86_FP ) and _M_IX86_FP >= 2 )
+#define DAW_HAS_SSE2
+#endif
+
+#if defined( __PCLMUL__ )
+#define DAW_HAS_PCLMUL
+#endif
+
+#if defined( DAW_HAS_SSE2 )
+#include <immintrin.h>
+#endif
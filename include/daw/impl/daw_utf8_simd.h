@@ -0,0 +1,340 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw/ciso646.h"
+#include "daw/daw_attributes.h"
+#include "daw_simd_features.h"
+
+#include <cstddef>
+#include <cstring>
+
+/// UTF-8 validation with vector table lookups, after Keiser and Lemire,
+/// "Validating UTF-8 In Less Than One Instruction Per Byte".  Each byte is
+/// classified by three 16 entry tables indexed by the high and low nibble of
+/// the previous byte and the high nibble of the current one.  A bit that
+/// survives the AND of the three is a two byte error.  The lengths of three
+/// and four byte sequences are checked separately by looking 2 and 3 bytes
+/// back.  All ASCII blocks skip the lookups.
+namespace daw::utf8_impl {
+	namespace error_bits {
+		/// 11______ 0_______ or 11______ 11______
+		inline constexpr unsigned char too_short = 1U << 0U;
+		/// 0_______ 10______
+		inline constexpr unsigned char too_long = 1U << 1U;
+		/// 11100000 100_____
+		inline constexpr unsigned char overlong_3 = 1U << 2U;
+		/// 11110100 1001____ and larger leads followed by 1001____ or 101_____
+		inline constexpr unsigned char too_large = 1U << 3U;
+		/// 11101101 101_____
+		inline constexpr unsigned char surrogate = 1U << 4U;
+		/// 1100000_ 10______
+		inline constexpr unsigned char overlong_2 = 1U << 5U;
+		/// 11110101 1000____ and larger leads followed by 1000____
+		inline constexpr unsigned char too_large_1000 = 1U << 6U;
+		/// 11110000 1000____
+		inline constexpr unsigned char overlong_4 = 1U << 6U;
+		/// 10______ 10______
+		inline constexpr unsigned char two_conts = 1U << 7U;
+		/// Errors decided by the high nibble of the first byte alone
+		inline constexpr unsigned char carry = too_short | too_long | two_conts;
+	} // namespace error_bits
+
+	/// Indexed by the high nibble of the first byte
+	inline constexpr unsigned char byte_1_high[16] = {
+	  // 0_______ ASCII
+	  error_bits::too_long, error_bits::too_long, error_bits::too_long,
+	  error_bits::too_long, error_bits::too_long, error_bits::too_long,
+	  error_bits::too_long, error_bits::too_long,
+	  // 10______ continuation
+	  error_bits::two_conts, error_bits::two_conts, error_bits::two_conts,
+	  error_bits::two_conts,
+	  // 1100____ two byte lead
+	  error_bits::too_short | error_bits::overlong_2,
+	  // 1101____ two byte lead
+	  error_bits::too_short,
+	  // 1110____ three byte lead
+	  error_bits::too_short | error_bits::overlong_3 | error_bits::surrogate,
+	  // 1111____ four byte lead
+	  error_bits::too_short | error_bits::too_large |
+	    error_bits::too_large_1000 | error_bits::overlong_4 };
+
+	/// Indexed by the low nibble of the first byte
+	inline constexpr unsigned char byte_1_low[16] = {
+	  // ____0000
+	  error_bits::carry | error_bits::overlong_3 | error_bits::overlong_2 |
+	    error_bits::overlong_4,
+	  // ____0001
+	  error_bits::carry | error_bits::overlong_2,
+	  // ____001_
+	  error_bits::carry, error_bits::carry,
+	  // ____0100
+	  error_bits::carry | error_bits::too_large,
+	  // ____0101 to ____1100
+	  error_bits::carry | error_bits::too_large | error_bits::too_large_1000,
+	  error_bits::carry | error_bits::too_large | error_bits::too_large_1000,
+	  error_bits::carry | error_bits::too_large | error_bits::too_large_1000,
+	  error_bits::carry | error_bits::too_large | error_bits::too_large_1000,
+	  error_bits::carry | error_bits::too_large | error_bits::too_large_1000,
+	  error_bits::carry | error_bits::too_large | error_bits::too_large_1000,
+	  error_bits::carry | error_bits::too_large | error_bits::too_large_1000,
+	  error_bits::carry | error_bits::too_large | error_bits::too_large_1000,
+	  // ____1101
+	  error_bits::carry | error_bits::too_large | error_bits::too_large_1000 |
+	    error_bits::surrogate,
+	  // ____111_
+	  error_bits::carry | error_bits::too_large | error_bits::too_large_1000,
+	  error_bits::carry | error_bits::too_large | error_bits::too_large_1000 };
+
+	/// Indexed by the high nibble of the second byte
+	inline constexpr unsigned char byte_2_high[16] = {
+	  // 0_______ ASCII
+	  error_bits::too_short, error_bits::too_short, error_bits::too_short,
+	  error_bits::too_short, error_bits::too_short, error_bits::too_short,
+	  error_bits::too_short, error_bits::too_short,
+	  // 1000____
+	  error_bits::too_long | error_bits::overlong_2 | error_bits::two_conts |
+	    error_bits::overlong_3 | error_bits::too_large_1000 |
+	    error_bits::overlong_4,
+	  // 1001____
+	  error_bits::too_long | error_bits::overlong_2 | error_bits::two_conts |
+	    error_bits::overlong_3 | error_bits::too_large,
+	  // 101_____
+	  error_bits::too_long | error_bits::overlong_2 | error_bits::two_conts |
+	    error_bits::surrogate | error_bits::too_large,
+	  error_bits::too_long | error_bits::overlong_2 | error_bits::two_conts |
+	    error_bits::surrogate | error_bits::too_large,
+	  // 11______ lead
+	  error_bits::too_short, error_bits::too_short, error_bits::too_short,
+	  error_bits::too_short };
+
+	/// A block ending with a lead byte above these needs more bytes
+	inline constexpr unsigned char incomplete_max[32] = {
+	  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1 };
+
+#if defined( DAW_HAS_SSSE3 )
+	struct simd128 {
+		using reg = __m128i;
+		static constexpr std::size_t width = 16;
+
+		DAW_ATTRIB_INLINE static reg load( unsigned char const *p ) noexcept {
+			return _mm_loadu_si128( reinterpret_cast<__m128i const *>( p ) );
+		}
+
+		DAW_ATTRIB_INLINE static reg zero( ) noexcept {
+			return _mm_setzero_si128( );
+		}
+
+		DAW_ATTRIB_INLINE static reg table( unsigned char const *t ) noexcept {
+			return load( t );
+		}
+
+		DAW_ATTRIB_INLINE static reg incomplete( ) noexcept {
+			return load( incomplete_max + 16 );
+		}
+
+		DAW_ATTRIB_INLINE static reg lookup( reg t, reg index ) noexcept {
+			return _mm_shuffle_epi8( t, index );
+		}
+
+		DAW_ATTRIB_INLINE static reg high_nibble( reg v ) noexcept {
+			return _mm_and_si128( _mm_srli_epi16( v, 4 ), _mm_set1_epi8( 0x0F ) );
+		}
+
+		DAW_ATTRIB_INLINE static reg low_nibble( reg v ) noexcept {
+			return _mm_and_si128( v, _mm_set1_epi8( 0x0F ) );
+		}
+
+		DAW_ATTRIB_INLINE static reg and_( reg a, reg b ) noexcept {
+			return _mm_and_si128( a, b );
+		}
+
+		DAW_ATTRIB_INLINE static reg or_( reg a, reg b ) noexcept {
+			return _mm_or_si128( a, b );
+		}
+
+		DAW_ATTRIB_INLINE static reg xor_( reg a, reg b ) noexcept {
+			return _mm_xor_si128( a, b );
+		}
+
+		DAW_ATTRIB_INLINE static reg subs( reg a, unsigned char b ) noexcept {
+			return _mm_subs_epu8( a, _mm_set1_epi8( static_cast<char>( b ) ) );
+		}
+
+		DAW_ATTRIB_INLINE static reg subs( reg a, reg b ) noexcept {
+			return _mm_subs_epu8( a, b );
+		}
+
+		DAW_ATTRIB_INLINE static reg high_bits( reg v ) noexcept {
+			return _mm_and_si128( v, _mm_set1_epi8( static_cast<char>( 0x80 ) ) );
+		}
+
+		/// The bytes of current shifted back by N, with the end of previous
+		/// shifted in
+		template<int N>
+		DAW_ATTRIB_INLINE static reg prev( reg current, reg previous ) noexcept {
+			return _mm_alignr_epi8( current, previous, 16 - N );
+		}
+
+		DAW_ATTRIB_INLINE static bool is_ascii( reg v ) noexcept {
+			return _mm_movemask_epi8( v ) == 0;
+		}
+
+		DAW_ATTRIB_INLINE static bool any( reg v ) noexcept {
+			return _mm_movemask_epi8( _mm_cmpeq_epi8( v, zero( ) ) ) != 0xFFFF;
+		}
+	};
+#endif
+
+#if defined( DAW_HAS_AVX2 )
+	struct simd256 {
+		using reg = __m256i;
+		static constexpr std::size_t width = 32;
+
+		DAW_ATTRIB_INLINE static reg load( unsigned char const *p ) noexcept {
+			return _mm256_loadu_si256( reinterpret_cast<__m256i const *>( p ) );
+		}
+
+		DAW_ATTRIB_INLINE static reg zero( ) noexcept {
+			return _mm256_setzero_si256( );
+		}
+
+		/// vpshufb looks up within each 128bit lane, so both get the table
+		DAW_ATTRIB_INLINE static reg table( unsigned char const *t ) noexcept {
+			return _mm256_broadcastsi128_si256(
+			  _mm_loadu_si128( reinterpret_cast<__m128i const *>( t ) ) );
+		}
+
+		DAW_ATTRIB_INLINE static reg incomplete( ) noexcept {
+			return load( incomplete_max );
+		}
+
+		DAW_ATTRIB_INLINE static reg lookup( reg t, reg index ) noexcept {
+			return _mm256_shuffle_epi8( t, index );
+		}
+
+		DAW_ATTRIB_INLINE static reg high_nibble( reg v ) noexcept {
+			return _mm256_and_si256( _mm256_srli_epi16( v, 4 ),
+			                         _mm256_set1_epi8( 0x0F ) );
+		}
+
+		DAW_ATTRIB_INLINE static reg low_nibble( reg v ) noexcept {
+			return _mm256_and_si256( v, _mm256_set1_epi8( 0x0F ) );
+		}
+
+		DAW_ATTRIB_INLINE static reg and_( reg a, reg b ) noexcept {
+			return _mm256_and_si256( a, b );
+		}
+
+		DAW_ATTRIB_INLINE static reg or_( reg a, reg b ) noexcept {
+			return _mm256_or_si256( a, b );
+		}
+
+		DAW_ATTRIB_INLINE static reg xor_( reg a, reg b ) noexcept {
+			return _mm256_xor_si256( a, b );
+		}
+
+		DAW_ATTRIB_INLINE static reg subs( reg a, unsigned char b ) noexcept {
+			return _mm256_subs_epu8( a, _mm256_set1_epi8( static_cast<char>( b ) ) );
+		}
+
+		DAW_ATTRIB_INLINE static reg subs( reg a, reg b ) noexcept {
+			return _mm256_subs_epu8( a, b );
+		}
+
+		DAW_ATTRIB_INLINE static reg high_bits( reg v ) noexcept {
+			return _mm256_and_si256( v,
+			                         _mm256_set1_epi8( static_cast<char>( 0x80 ) ) );
+		}
+
+		template<int N>
+		DAW_ATTRIB_INLINE static reg prev( reg current, reg previous ) noexcept {
+			return _mm256_alignr_epi8(
+			  current, _mm256_permute2x128_si256( previous, current, 0x21 ),
+			  16 - N );
+		}
+
+		DAW_ATTRIB_INLINE static bool is_ascii( reg v ) noexcept {
+			return _mm256_movemask_epi8( v ) == 0;
+		}
+
+		DAW_ATTRIB_INLINE static bool any( reg v ) noexcept {
+			return not _mm256_testz_si256( v, v );
+		}
+	};
+#endif
+
+#if defined( DAW_HAS_SSSE3 )
+	template<typename Simd>
+	struct utf8_checker {
+		using reg = typename Simd::reg;
+
+		reg const table_1_high = Simd::table( byte_1_high );
+		reg const table_1_low = Simd::table( byte_1_low );
+		reg const table_2_high = Simd::table( byte_2_high );
+		reg error = Simd::zero( );
+		reg prev_input = Simd::zero( );
+		reg prev_incomplete = Simd::zero( );
+
+		DAW_ATTRIB_INLINE void check( reg input ) noexcept {
+			if( Simd::is_ascii( input ) ) {
+				// A sequence cut off by the end of the last block is an error
+				error = Simd::or_( error, prev_incomplete );
+			} else {
+				auto const prev1 = Simd::template prev<1>( input, prev_input );
+				auto const special_cases = Simd::and_(
+				  Simd::and_(
+				    Simd::lookup( table_1_high, Simd::high_nibble( prev1 ) ),
+				    Simd::lookup( table_1_low, Simd::low_nibble( prev1 ) ) ),
+				  Simd::lookup( table_2_high, Simd::high_nibble( input ) ) );
+				// Bytes 2 and 3 back from a third or fourth continuation byte are
+				// three and four byte leads
+				auto const prev2 = Simd::template prev<2>( input, prev_input );
+				auto const prev3 = Simd::template prev<3>( input, prev_input );
+				auto const must_be_continuation =
+				  Simd::high_bits( Simd::or_( Simd::subs( prev2, 0xE0 - 0x80 ),
+				                              Simd::subs( prev3, 0xF0 - 0x80 ) ) );
+				error = Simd::or_( error,
+				                   Simd::xor_( must_be_continuation, special_cases ) );
+				prev_incomplete = Simd::subs( input, Simd::incomplete( ) );
+			}
+			prev_input = input;
+		}
+	};
+
+	/// Validate in blocks of Simd::width, checking for an error every 64
+	/// blocks so invalid input is rejected early
+	template<typename Simd>
+	[[nodiscard]] inline bool validate_simd( unsigned char const *first,
+	                                         std::size_t size ) noexcept {
+		constexpr std::size_t width = Simd::width;
+		auto checker = utf8_checker<Simd>{ };
+		std::size_t pos = 0;
+		while( pos + width <= size ) {
+			auto const chunk_last = size - pos > 64 * width ? pos + 64 * width : size;
+			for( ; pos + width <= chunk_last; pos += width ) {
+				checker.check( Simd::load( first + pos ) );
+			}
+			if( Simd::any( checker.error ) ) {
+				return false;
+			}
+		}
+		if( pos < size ) {
+			// Zeros are ASCII, so padding leaves a cut off sequence as an error
+			unsigned char tail[width]{ };
+			std::memcpy( tail, first + pos, size - pos );
+			checker.check( Simd::load( tail ) );
+		}
+		checker.error = Simd::or_( checker.error, checker.prev_incomplete );
+		return not Simd::any( checker.error );
+	}
+#endif
+} // namespace daw::utf8_impl
@@ -0,0 +1,176 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw/ciso646.h"
+#include "daw/daw_attributes.h"
+#include "daw/daw_exception.h"
+#include "daw/integers/daw_signed.h"
+#include "daw/integers/impl/daw_signed_span_simd.h"
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+/// Arithmetic over contiguous ranges of signed_integer, e.g. std::vector,
+/// std::array or daw::span.  These are the batch forms of add_saturated,
+/// add_wrapped and add_checked on a single value.  The checked forms call
+/// on_signed_integer_overflow( ) at most once per call, after all of the
+/// elements are written
+namespace daw::integers {
+	namespace sint_span_impl {
+		template<typename>
+		inline constexpr std::size_t signed_integer_bits_v = 0;
+
+		template<std::size_t Bits>
+		inline constexpr std::size_t signed_integer_bits_v<signed_integer<Bits>> =
+		  Bits;
+
+		template<typename Range>
+		using range_value_t =
+		  std::remove_cv_t<std::remove_reference_t<decltype( *std::data(
+		    std::declval<Range &>( ) ) )>>;
+
+		template<typename Range>
+		inline constexpr std::size_t range_bits_v =
+		  signed_integer_bits_v<range_value_t<Range>>;
+
+		template<typename Range>
+		using underlying_t = typename range_value_t<Range>::value_type;
+
+		template<typename Range>
+		[[nodiscard]] DAW_ATTRIB_INLINE auto *values_of( Range &&r ) noexcept {
+			using value_t = underlying_t<Range>;
+			static_assert( sizeof( range_value_t<Range> ) == sizeof( value_t ) );
+			if constexpr( std::is_const_v<
+			                std::remove_pointer_t<decltype( std::data( r ) )>> ) {
+				return reinterpret_cast<value_t const *>( std::data( r ) );
+			} else {
+				return reinterpret_cast<value_t *>( std::data( r ) );
+			}
+		}
+
+		template<bool Sub, overflow_mode Mode, typename Lhs, typename Rhs,
+		         typename Out>
+		bool transform( Lhs const &lhs, Rhs const &rhs, Out &&out ) {
+			static_assert( range_bits_v<Lhs> != 0 and
+			                 range_bits_v<Lhs> == range_bits_v<Rhs> and
+			                 range_bits_v<Lhs> == range_bits_v<Out>,
+			               "Ranges must be of the same signed_integer type" );
+			auto const count = std::size( lhs );
+			daw::exception::precondition_check<std::out_of_range>(
+			  std::size( rhs ) == count and std::size( out ) >= count,
+			  "Ranges must be the same size" );
+			return transform_n<Sub, Mode>( values_of( lhs ), values_of( rhs ),
+			                               values_of( out ), count );
+		}
+	} // namespace sint_span_impl
+
+	/// The sum of a range and whether it fits in the element type
+	template<std::size_t Bits>
+	struct checked_sum_result {
+		/// The sum, wrapped to Bits when it does not fit
+		signed_integer<Bits> value;
+		bool overflowed = false;
+	};
+
+	/// out[i] = lhs[i] + rhs[i], clamped to the range of the element type
+	template<typename Lhs, typename Rhs, typename Out>
+	void add_saturated( Lhs const &lhs, Rhs const &rhs, Out &&out ) {
+		(void)sint_span_impl::transform<false,
+		                                sint_span_impl::overflow_mode::saturated>(
+		  lhs, rhs, out );
+	}
+
+	/// out[i] = lhs[i] - rhs[i], clamped to the range of the element type
+	template<typename Lhs, typename Rhs, typename Out>
+	void sub_saturated( Lhs const &lhs, Rhs const &rhs, Out &&out ) {
+		(void)sint_span_impl::transform<true,
+		                                sint_span_impl::overflow_mode::saturated>(
+		  lhs, rhs, out );
+	}
+
+	/// out[i] = lhs[i] + rhs[i] with two's complement wrapping
+	template<typename Lhs, typename Rhs, typename Out>
+	void add_wrapped( Lhs const &lhs, Rhs const &rhs, Out &&out ) {
+		(void)sint_span_impl::transform<false,
+		                                sint_span_impl::overflow_mode::wrapped>(
+		  lhs, rhs, out );
+	}
+
+	/// out[i] = lhs[i] - rhs[i] with two's complement wrapping
+	template<typename Lhs, typename Rhs, typename Out>
+	void sub_wrapped( Lhs const &lhs, Rhs const &rhs, Out &&out ) {
+		(void)sint_span_impl::transform<true,
+		                                sint_span_impl::overflow_mode::wrapped>(
+		  lhs, rhs, out );
+	}
+
+	/// out[i] = lhs[i] + rhs[i] with wrapping.  When any element overflowed,
+	/// on_signed_integer_overflow( ) is called once.  Returns whether any
+	/// element overflowed, for when the handler does not throw
+	template<typename Lhs, typename Rhs, typename Out>
+	bool add_checked( Lhs const &lhs, Rhs const &rhs, Out &&out ) {
+		bool const overflowed =
+		  sint_span_impl::transform<false, sint_span_impl::overflow_mode::checked>(
+		    lhs, rhs, out );
+		if( DAW_UNLIKELY( overflowed ) ) {
+			DAW_UNLIKELY_BRANCH
+			on_signed_integer_overflow( );
+		}
+		return overflowed;
+	}
+
+	/// out[i] = lhs[i] - rhs[i] with wrapping.  When any element overflowed,
+	/// on_signed_integer_overflow( ) is called once.  Returns whether any
+	/// element overflowed, for when the handler does not throw
+	template<typename Lhs, typename Rhs, typename Out>
+	bool sub_checked( Lhs const &lhs, Rhs const &rhs, Out &&out ) {
+		bool const overflowed =
+		  sint_span_impl::transform<true, sint_span_impl::overflow_mode::checked>(
+		    lhs, rhs, out );
+		if( DAW_UNLIKELY( overflowed ) ) {
+			DAW_UNLIKELY_BRANCH
+			on_signed_integer_overflow( );
+		}
+		return overflowed;
+	}
+
+	/// The sum of the elements of values.  The total is exact, so it only
+	/// overflows when the final sum does not fit, no matter the order or the
+	/// values along the way
+	template<typename Range>
+	[[nodiscard]] checked_sum_result<sint_span_impl::range_bits_v<Range>>
+	checked_sum( Range const &values ) {
+		constexpr auto bits = sint_span_impl::range_bits_v<Range>;
+		static_assert( bits != 0, "Range must be of signed_integer" );
+		using value_t = sint_span_impl::underlying_t<Range>;
+		auto const sum = sint_span_impl::sum_n( sint_span_impl::values_of( values ),
+		                                        std::size( values ) );
+		bool const overflowed =
+		  sum.carries != 0 or not daw::in_range<value_t>( sum.value );
+		return { signed_integer<bits>( static_cast<value_t>( sum.value ) ),
+		         overflowed };
+	}
+
+	/// The sum of the elements of values.  When it does not fit,
+	/// on_signed_integer_overflow( ) is called and the wrapped sum returned
+	template<typename Range>
+	[[nodiscard]] signed_integer<sint_span_impl::range_bits_v<Range>>
+	sum_checked( Range const &values ) {
+		auto const result = checked_sum( values );
+		if( DAW_UNLIKELY( result.overflowed ) ) {
+			DAW_UNLIKELY_BRANCH
+			on_signed_integer_overflow( );
+		}
+		return result.value;
+	}
+} // namespace daw::integers
@@ -0,0 +1,524 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw/ciso646.h"
+#include "daw/daw_attributes.h"
+#include "daw/impl/daw_simd_features.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+/// Element wise arithmetic and sums over arrays of signed integers.  An
+/// add or subtract overflowed when the sign of the result differs from the
+/// operands it should agree with, so the overflow of a whole vector is a few
+/// xors and ands.  Checked kernels or these bits together and test them once
+/// at the end, so no element takes a branch.  Sums are widened so that they
+/// are exact no matter how many elements there are
+namespace daw::integers::sint_span_impl {
+	enum class overflow_mode { wrapped, saturated, checked };
+
+	/// Sign bit of the result is set when lhs op rhs overflowed into r
+	template<bool Sub, typename T>
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr T overflow_bits( T lhs, T rhs,
+	                                                           T r ) noexcept {
+		if constexpr( Sub ) {
+			return static_cast<T>( ( lhs ^ rhs ) & ( lhs ^ r ) );
+		} else {
+			return static_cast<T>( ( lhs ^ r ) & ( rhs ^ r ) );
+		}
+	}
+
+	template<bool Sub, typename T>
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr T wrapped_op( T lhs,
+	                                                        T rhs ) noexcept {
+		using unsigned_t = std::make_unsigned_t<T>;
+		auto const l = static_cast<unsigned_t>( lhs );
+		auto const r = static_cast<unsigned_t>( rhs );
+		return static_cast<T>( static_cast<unsigned_t>( Sub ? l - r : l + r ) );
+	}
+
+	/// The value an overflow from lhs saturates to, max when lhs is not
+	/// negative and min otherwise
+	template<typename T>
+	[[nodiscard]] DAW_ATTRIB_INLINE constexpr T
+	saturated_value( T lhs ) noexcept {
+		return static_cast<T>( ( lhs >> ( sizeof( T ) * 8U - 1U ) ) ^
+		                       std::numeric_limits<T>::max( ) );
+	}
+
+	/// A 128 bit sum, value + carries * 2^64
+	struct wide_sum {
+		std::int64_t value = 0;
+		std::int64_t carries = 0;
+	};
+
+	DAW_ATTRIB_INLINE constexpr void accumulate( wide_sum &sum,
+	                                             std::int64_t v ) noexcept {
+		auto const r = wrapped_op<false>( sum.value, v );
+		auto const overflowed = overflow_bits<false>( sum.value, v, r ) < 0;
+		sum.carries += static_cast<std::int64_t>( overflowed ) * ( v < 0 ? -1 : 1 );
+		sum.value = r;
+	}
+
+#if defined( DAW_HAS_SSE2 )
+	template<typename T>
+	struct simd128 {
+		using reg = __m128i;
+		static constexpr std::size_t width = sizeof( reg ) / sizeof( T );
+
+		[[nodiscard]] DAW_ATTRIB_INLINE static reg load( T const *ptr ) noexcept {
+			return _mm_loadu_si128( reinterpret_cast<reg const *>( ptr ) );
+		}
+
+		DAW_ATTRIB_INLINE static void store( T *ptr, reg v ) noexcept {
+			_mm_storeu_si128( reinterpret_cast<reg *>( ptr ), v );
+		}
+
+		DAW_ATTRIB_INLINE static void store_lanes( std::int64_t *ptr,
+		                                           reg v ) noexcept {
+			_mm_storeu_si128( reinterpret_cast<reg *>( ptr ), v );
+		}
+
+		[[nodiscard]] DAW_ATTRIB_INLINE static reg zero( ) noexcept {
+			return _mm_setzero_si128( );
+		}
+
+		[[nodiscard]] DAW_ATTRIB_INLINE static reg set1( T v ) noexcept {
+			if constexpr( sizeof( T ) == 1 ) {
+				return _mm_set1_epi8( static_cast<char>( v ) );
+			} else if constexpr( sizeof( T ) == 2 ) {
+				return _mm_set1_epi16( static_cast<short>( v ) );
+			} else if constexpr( sizeof( T ) == 4 ) {
+				return _mm_set1_epi32( static_cast<int>( v ) );
+			} else {
+				return _mm_set1_epi64x( static_cast<long long>( v ) );
+			}
+		}
+
+		[[nodiscard]] DAW_ATTRIB_INLINE static reg and_( reg a, reg b ) noexcept {
+			return _mm_and_si128( a, b );
+		}
+
+		[[nodiscard]] DAW_ATTRIB_INLINE static reg or_( reg a, reg b ) noexcept {
+			return _mm_or_si128( a, b );
+		}
+
+		[[nodiscard]] DAW_ATTRIB_INLINE static reg xor_( reg a, reg b ) noexcept {
+			return _mm_xor_si128( a, b );
+		}
+
+		/// ~mask & v
+		[[nodiscard]] DAW_ATTRIB_INLINE static reg andnot( reg mask,
+		                                                   reg v ) noexcept {
+			return _mm_andnot_si128( mask, v );
+		}
+
+		[[nodiscard]] DAW_ATTRIB_INLINE static reg add( reg a, reg b ) noexcept {
+			if constexpr( sizeof( T ) == 1 ) {
+				return _mm_add_epi8( a, b );
+			} else if constexpr( sizeof( T ) == 2 ) {
+				return _mm_add_epi16( a, b );
+			} else if constexpr( sizeof( T ) == 4 ) {
+				return _mm_add_epi32( a, b );
+			} else {
+				return _mm_add_epi64( a, b );
+			}
+		}
+
+		[[nodiscard]] DAW_ATTRIB_INLINE static reg sub( reg a, reg b ) noexcept {
+			if constexpr( sizeof( T ) == 1 ) {
+				return _mm_sub_epi8( a, b );
+			} else if constexpr( sizeof( T ) == 2 ) {
+				return _mm_sub_epi16( a, b );
+			} else if constexpr( sizeof( T ) == 4 ) {
+				return _mm_sub_epi32( a, b );
+			} else {
+				return _mm_sub_epi64( a, b );
+			}
+		}
+
+		/// All ones in the lanes that are negative
+		[[nodiscard]] DAW_ATTRIB_INLINE static reg sign_mask( reg v ) noexcept {
+			if constexpr( sizeof( T ) == 1 ) {
+				return _mm_cmplt_epi8( v, zero( ) );
+			} else if constexpr( sizeof( T ) == 2 ) {
+				return _mm_srai_epi16( v, 15 );
+			} else if constexpr( sizeof( T ) == 4 ) {
+				return _mm_srai_epi32( v, 31 );
+			} else {
+				return _mm_shuffle_epi32( _mm_srai_epi32( v, 31 ),
+				                          _MM_SHUFFLE( 3, 3, 1, 1 ) );
+			}
+		}
+
+		[[nodiscard]] DAW_ATTRIB_INLINE static bool any_negative( reg v ) noexcept {
+			return _mm_movemask_epi8( sign_mask( v ) ) != 0;
+		}
+
+		[[nodiscard]] DAW_ATTRIB_INLINE static reg adds( reg a, reg b ) noexcept {
+			if constexpr( sizeof( T ) == 1 ) {
+				return _mm_adds_epi8( a, b );
+			} else if constexpr( sizeof( T ) == 2 ) {
+				return _mm_adds_epi16( a, b );
+			} else {
+				auto const r = add( a, b );
+				return saturate( a, r, and_( xor_( a, r ), xor_( b, r ) ) );
+			}
+		}
+
+		[[nodiscard]] DAW_ATTRIB_INLINE static reg subs( reg a, reg b ) noexcept {
+			if constexpr( sizeof( T ) == 1 ) {
+				return _mm_subs_epi8( a, b );
+			} else if constexpr( sizeof( T ) == 2 ) {
+				return _mm_subs_epi16( a, b );
+			} else {
+				auto const r = sub( a, b );
+				return saturate( a, r, and_( xor_( a, b ), xor_( a, r ) ) );
+			}
+		}
+
+		/// r where the sign of overflow is clear, otherwise the limit a
+		/// saturates to
+		[[nodiscard]] DAW_ATTRIB_INLINE static reg
+		saturate( reg a, reg r, reg overflow ) noexcept {
+			auto const mask = sign_mask( overflow );
+			auto const limit =
+			  xor_( sign_mask( a ), set1( std::numeric_limits<T>::max( ) ) );
+			return or_( and_( mask, limit ), andnot( mask, r ) );
+		}
+
+		/// The bytes biased to unsigned and summed into two 64 bit lanes
+		[[nodiscard]] DAW_ATTRIB_INLINE static reg sum_bytes( reg v ) noexcept {
+			return _mm_sad_epu8( _mm_xor_si128( v, _mm_set1_epi8( -128 ) ),
+			                     zero( ) );
+		}
+
+		/// Adjacent 16 bit lanes summed into 32 bit lanes
+		[[nodiscard]] DAW_ATTRIB_INLINE static reg sum_pairs( reg v ) noexcept {
+			return _mm_madd_epi16( v, _mm_set1_epi16( 1 ) );
+		}
+
+		/// Sign extend the 32 bit lanes of v and add them to the 64 bit lanes
+		/// of acc
+		[[nodiscard]] DAW_ATTRIB_INLINE static reg add_widened( reg acc,
+		                                                        reg v ) noexcept {
+			auto const sign = _mm_srai_epi32( v, 31 );
+			acc = _mm_add_epi64( acc, _mm_unpacklo_epi32( v, sign ) );
+			return _mm_add_epi64( acc, _mm_unpackhi_epi32( v, sign ) );
+		}
+
+		[[nodiscard]] DAW_ATTRIB_INLINE static reg add64( reg a, reg b ) noexcept {
+			return _mm_add_epi64( a, b );
+		}
+
+		[[nodiscard]] DAW_ATTRIB_INLINE static reg add32( reg a, reg b ) noexcept {
+			return _mm_add_epi32( a, b );
+		}
+	};
+#endif
+#if defined( DAW_HAS_AVX2 )
+	template<typename T>
+	struct simd256 {
+		using reg = __m256i;
+		static constexpr std::size_t width = sizeof( reg ) / sizeof( T );
+
+		[[nodiscard]] DAW_ATTRIB_INLINE static reg load( T const *ptr ) noexcept {
+			return _mm256_loadu_si256( reinterpret_cast<reg const *>( ptr ) );
+		}
+
+		DAW_ATTRIB_INLINE static void store( T *ptr, reg v ) noexcept {
+			_mm256_storeu_si256( reinterpret_cast<reg *>( ptr ), v );
+		}
+
+		DAW_ATTRIB_INLINE static void store_lanes( std::int64_t *ptr,
+		                                           reg v ) noexcept {
+			_mm256_storeu_si256( reinterpret_cast<reg *>( ptr ), v );
+		}
+
+		[[nodiscard]] DAW_ATTRIB_INLINE static reg zero( ) noexcept {
+			return _mm256_setzero_si256( );
+		}
+
+		[[nodiscard]] DAW_ATTRIB_INLINE static reg set1( T v ) noexcept {
+			if constexpr( sizeof( T ) == 1 ) {
+				return _mm256_set1_epi8( static_cast<char>( v ) );
+			} else if constexpr( sizeof( T ) == 2 ) {
+				return _mm256_set1_epi16( static_cast<short>( v ) );
+			} else if constexpr( sizeof( T ) == 4 ) {
+				return _mm256_set1_epi32( static_cast<int>( v ) );
+			} else {
+				return _mm256_set1_epi64x( static_cast<long long>( v ) );
+			}
+		}
+
+		[[nodiscard]] DAW_ATTRIB_INLINE static reg and_( reg a, reg b ) noexcept {
+			return _mm256_and_si256( a, b );
+		}
+
+		[[nodiscard]] DAW_ATTRIB_INLINE static reg or_( reg a, reg b ) noexcept {
+			return _mm256_or_si256( a, b );
+		}
+
+		[[nodiscard]] DAW_ATTRIB_INLINE static reg xor_( reg a, reg b ) noexcept {
+			return _mm256_xor_si256( a, b );
+		}
+
+		/// ~mask & v
+		[[nodiscard]] DAW_ATTRIB_INLINE static reg andnot( reg mask,
+		                                                   reg v ) noexcept {
+			return _mm256_andnot_si256( mask, v );
+		}
+
+		[[nodiscard]] DAW_ATTRIB_INLINE static reg add( reg a, reg b ) noexcept {
+			if constexpr( sizeof( T ) == 1 ) {
+				return _mm256_add_epi8( a, b );
+			} else if constexpr( sizeof( T ) == 2 ) {
+				return _mm256_add_epi16( a, b );
+			} else if constexpr( sizeof( T ) == 4 ) {
+				return _mm256_add_epi32( a, b );
+			} else {
+				return _mm256_add_epi64( a, b );
+			}
+		}
+
+		[[nodiscard]] DAW_ATTRIB_INLINE static reg sub( reg a, reg b ) noexcept {
+			if constexpr( sizeof( T ) == 1 ) {
+				return _mm256_sub_epi8( a, b );
+			} else if constexpr( sizeof( T ) == 2 ) {
+				return _mm256_sub_epi16( a, b );
+			} else if constexpr( sizeof( T ) == 4 ) {
+				return _mm256_sub_epi32( a, b );
+			} else {
+				return _mm256_sub_epi64( a, b );
+			}
+		}
+
+		/// All ones in the lanes that are negative
+		[[nodiscard]] DAW_ATTRIB_INLINE static reg sign_mask( reg v ) noexcept {
+			if constexpr( sizeof( T ) == 1 ) {
+				return _mm256_cmpgt_epi8( zero( ), v );
+			} else if constexpr( sizeof( T ) == 2 ) {
+				return _mm256_srai_epi16( v, 15 );
+			} else if constexpr( sizeof( T ) == 4 ) {
+				return _mm256_srai_epi32( v, 31 );
+			} else {
+				return _mm256_cmpgt_epi64( zero( ), v );
+			}
+		}
+
+		[[nodiscard]] DAW_ATTRIB_INLINE static bool any_negative( reg v ) noexcept {
+			return _mm256_movemask_epi8( sign_mask( v ) ) != 0;
+		}
+
+		[[nodiscard]] DAW_ATTRIB_INLINE static reg adds( reg a, reg b ) noexcept {
+			if constexpr( sizeof( T ) == 1 ) {
+				return _mm256_adds_epi8( a, b );
+			} else if constexpr( sizeof( T ) == 2 ) {
+				return _mm256_adds_epi16( a, b );
+			} else {
+				auto const r = add( a, b );
+				return saturate( a, r, and_( xor_( a, r ), xor_( b, r ) ) );
+			}
+		}
+
+		[[nodiscard]] DAW_ATTRIB_INLINE static reg subs( reg a, reg b ) noexcept {
+			if constexpr( sizeof( T ) == 1 ) {
+				return _mm256_subs_epi8( a, b );
+			} else if constexpr( sizeof( T ) == 2 ) {
+				return _mm256_subs_epi16( a, b );
+			} else {
+				auto const r = sub( a, b );
+				return saturate( a, r, and_( xor_( a, b ), xor_( a, r ) ) );
+			}
+		}
+
+		/// r where the sign of overflow is clear, otherwise the limit a
+		/// saturates to
+		[[nodiscard]] DAW_ATTRIB_INLINE static reg
+		saturate( reg a, reg r, reg overflow ) noexcept {
+			auto const mask = sign_mask( overflow );
+			auto const limit =
+			  xor_( sign_mask( a ), set1( std::numeric_limits<T>::max( ) ) );
+			return _mm256_blendv_epi8( r, limit, mask );
+		}
+
+		/// The bytes biased to unsigned and summed into four 64 bit lanes
+		[[nodiscard]] DAW_ATTRIB_INLINE static reg sum_bytes( reg v ) noexcept {
+			return _mm256_sad_epu8(
+			  _mm256_xor_si256( v, _mm256_set1_epi8( -128 ) ), zero( ) );
+		}
+
+		/// Adjacent 16 bit lanes summed into 32 bit lanes
+		[[nodiscard]] DAW_ATTRIB_INLINE static reg sum_pairs( reg v ) noexcept {
+			return _mm256_madd_epi16( v, _mm256_set1_epi16( 1 ) );
+		}
+
+		/// Sign extend the 32 bit lanes of v and add them to the 64 bit lanes
+		/// of acc
+		[[nodiscard]] DAW_ATTRIB_INLINE static reg add_widened( reg acc,
+		                                                        reg v ) noexcept {
+			acc = _mm256_add_epi64(
+			  acc, _mm256_cvtepi32_epi64( _mm256_castsi256_si128( v ) ) );
+			return _mm256_add_epi64(
+			  acc, _mm256_cvtepi32_epi64( _mm256_extracti128_si256( v, 1 ) ) );
+		}
+
+		[[nodiscard]] DAW_ATTRIB_INLINE static reg add64( reg a, reg b ) noexcept {
+			return _mm256_add_epi64( a, b );
+		}
+
+		[[nodiscard]] DAW_ATTRIB_INLINE static reg add32( reg a, reg b ) noexcept {
+			return _mm256_add_epi32( a, b );
+		}
+	};
+
+	template<typename T>
+	using simd = simd256<T>;
+#define DAW_SIGNED_SPAN_HAS_SIMD
+#elif defined( DAW_HAS_SSE2 )
+	template<typename T>
+	using simd = simd128<T>;
+#define DAW_SIGNED_SPAN_HAS_SIMD
+#endif
+
+#if defined( DAW_SIGNED_SPAN_HAS_SIMD )
+	template<bool Sub, overflow_mode Mode, typename V>
+	[[nodiscard]] DAW_ATTRIB_INLINE typename V::reg
+	vector_op( typename V::reg a, typename V::reg b,
+	           typename V::reg &overflow ) noexcept {
+		if constexpr( Mode == overflow_mode::saturated ) {
+			return Sub ? V::subs( a, b ) : V::adds( a, b );
+		} else {
+			auto const r = Sub ? V::sub( a, b ) : V::add( a, b );
+			if constexpr( Mode == overflow_mode::checked ) {
+				overflow = V::or_(
+				  overflow, Sub ? V::and_( V::xor_( a, b ), V::xor_( a, r ) )
+				                : V::and_( V::xor_( a, r ), V::xor_( b, r ) ) );
+			}
+			return r;
+		}
+	}
+#endif
+
+	/// out[i] = lhs[i] op rhs[i] for i in [0, count).  Returns whether any
+	/// of them overflowed when Mode is checked, and false otherwise
+	template<bool Sub, overflow_mode Mode, typename T>
+	bool transform_n( T const *lhs, T const *rhs, T *out,
+	                  std::size_t count ) noexcept {
+		std::size_t pos = 0;
+		bool overflowed = false;
+#if defined( DAW_SIGNED_SPAN_HAS_SIMD )
+		using V = simd<T>;
+		auto overflow = V::zero( );
+		for( ; pos + V::width <= count; pos += V::width ) {
+			V::store( out + pos,
+			          vector_op<Sub, Mode, V>( V::load( lhs + pos ),
+			                                   V::load( rhs + pos ), overflow ) );
+		}
+		overflowed = V::any_negative( overflow );
+#endif
+		for( ; pos < count; ++pos ) {
+			auto const r = wrapped_op<Sub>( lhs[pos], rhs[pos] );
+			bool const o = overflow_bits<Sub>( lhs[pos], rhs[pos], r ) < 0;
+			if constexpr( Mode == overflow_mode::saturated ) {
+				out[pos] = o ? saturated_value( lhs[pos] ) : r;
+			} else {
+				out[pos] = r;
+				overflowed |= o;
+			}
+		}
+		return Mode == overflow_mode::checked and overflowed;
+	}
+
+	/// Elements per chunk of a sum.  For element types of at most 32 bits the
+	/// total of a chunk, at most 2^30 * 2^31, fits in each 64 bit lane
+	inline constexpr std::size_t sum_chunk_size = std::size_t{ 1 } << 30U;
+
+	/// Exact sum of at most sum_chunk_size elements
+	template<typename T>
+	[[nodiscard]] wide_sum sum_chunk( T const *ptr, std::size_t count ) noexcept {
+		std::size_t pos = 0;
+		auto result = wide_sum{ };
+#if defined( DAW_SIGNED_SPAN_HAS_SIMD )
+		using V = simd<T>;
+		std::int64_t lanes[sizeof( typename V::reg ) / 8U]{ };
+		auto const add_lanes = [&]( typename V::reg v ) {
+			V::store_lanes( lanes, v );
+			for( auto lane : lanes ) {
+				accumulate( result, lane );
+			}
+		};
+		auto acc = V::zero( );
+		if constexpr( sizeof( T ) == 1 ) {
+			for( ; pos + V::width <= count; pos += V::width ) {
+				acc = V::add64( acc, V::sum_bytes( V::load( ptr + pos ) ) );
+			}
+			add_lanes( acc );
+			// Undo the bias of 128 added to each byte
+			accumulate( result, -128 * static_cast<std::int64_t>( pos ) );
+		} else if constexpr( sizeof( T ) == 2 ) {
+			while( pos + V::width <= count ) {
+				// Pair sums are at most 2^16 in magnitude, so 2^14 of them fit in
+				// the 32 bit lanes before being widened
+				auto pairs = V::zero( );
+				auto const block_end =
+				  pos + std::min( count - pos, V::width << 14U ) / V::width * V::width;
+				for( ; pos < block_end; pos += V::width ) {
+					pairs = V::add32( pairs, V::sum_pairs( V::load( ptr + pos ) ) );
+				}
+				acc = V::add_widened( acc, pairs );
+			}
+			add_lanes( acc );
+		} else if constexpr( sizeof( T ) == 4 ) {
+			for( ; pos + V::width <= count; pos += V::width ) {
+				acc = V::add_widened( acc, V::load( ptr + pos ) );
+			}
+			add_lanes( acc );
+		} else {
+			// Count the wraps of each lane, +1 past max and -1 past min
+			auto carries = V::zero( );
+			auto const one = V::set1( 1 );
+			for( ; pos + V::width <= count; pos += V::width ) {
+				auto const v = V::load( ptr + pos );
+				auto const r = V::add( acc, v );
+				auto const wrapped = V::sign_mask(
+				  V::and_( V::xor_( acc, r ), V::xor_( v, r ) ) );
+				auto const step = V::or_( V::sign_mask( v ), one );
+				carries = V::add( carries, V::and_( wrapped, step ) );
+				acc = r;
+			}
+			add_lanes( acc );
+			V::store_lanes( lanes, carries );
+			for( auto lane : lanes ) {
+				result.carries += lane;
+			}
+		}
+#endif
+		for( ; pos < count; ++pos ) {
+			accumulate( result, static_cast<std::int64_t>( ptr[pos] ) );
+		}
+		return result;
+	}
+
+	template<typename T>
+	[[nodiscard]] wide_sum sum_n( T const *ptr, std::size_t count ) noexcept {
+		auto result = wide_sum{ };
+		for( std::size_t pos = 0; pos < count; pos += sum_chunk_size ) {
+			auto const chunk =
+			  sum_chunk( ptr + pos, std::min( count - pos, sum_chunk_size ) );
+			accumulate( result, chunk.value );
+			result.carries += chunk.carries;
+		}
+		return result;
+	}
+} // namespace daw::integers::sint_span_impl
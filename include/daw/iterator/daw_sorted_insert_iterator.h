@@ -9,11 +9,15 @@
 #pragma once
 
 #include "daw/ciso646.h"
+#include "daw/daw_check_exceptions.h"
 #include "daw/daw_move.h"
 #include "daw_function_iterator.h"
 
+#include <algorithm>
+#include <cstddef>
 #include <deque>
 #include <functional>
+#include <iterator>
 #include <list>
 #include <vector>
 
@@ -85,4 +89,112 @@ namespace daw {
 		  si_impl::sorted_iterator_list_callable<Compare, Args...>{
 		    &c, std::move( compare ) } );
 	}
+
+	///
+	/// Keeps a container sorted while values are added, but instead of an
+	/// insert per value they are collected in a side buffer.  flush( ), or
+	/// destruction, sorts the buffer and merges it into the container in one
+	/// linear pass.  Values that arrive in order and do not sort before the
+	/// container's last element are appended directly, so sorted input runs
+	/// never touch the buffer.  Equal values keep their arrival order.  The
+	/// container must not be modified elsewhere until flushed.
+	/// Errors from the flush in the destructor are discarded, call flush( )
+	/// before destruction to see them.
+	/// Container must be a sequence container with push_back and insert(
+	/// pos, first, last ), e.g. vector, deque, or list
+	///
+	template<typename Container, typename Compare = std::less<>>
+	class buffered_sorted_inserter {
+		using value_type = typename Container::value_type;
+
+		Container *m_container;
+		Compare m_compare;
+		std::vector<value_type> m_buffer{ };
+		bool m_buffer_sorted = true;
+
+		/// Is the value in order after the last element of the container
+		[[nodiscard]] bool can_append( value_type const &value ) const {
+			return m_container->empty( ) or
+			       not m_compare( value, m_container->back( ) );
+		}
+
+	public:
+		explicit buffered_sorted_inserter( Container &c,
+		                                   Compare compare = Compare{ } )
+		  : m_container( &c )
+		  , m_compare( std::move( compare ) ) {}
+
+		buffered_sorted_inserter( buffered_sorted_inserter const & ) = delete;
+		buffered_sorted_inserter &
+		operator=( buffered_sorted_inserter const & ) = delete;
+
+		/// Flushes, discarding any exception.  The buffered values may then be
+		/// lost
+		~buffered_sorted_inserter( ) {
+#if defined( DAW_USE_EXCEPTIONS )
+			try {
+				flush( );
+			} catch( ... ) {}
+#else
+			flush( );
+#endif
+		}
+
+		template<typename T>
+		void push( T &&value ) {
+			if( m_buffer.empty( ) ) {
+				if( can_append( value ) ) {
+					m_container->push_back( DAW_FWD( value ) );
+					return;
+				}
+			} else if( m_buffer_sorted and m_compare( value, m_buffer.back( ) ) ) {
+				m_buffer_sorted = false;
+			}
+			m_buffer.emplace_back( DAW_FWD( value ) );
+		}
+
+		/// Merge the buffered values into the container.  Exceptions from the
+		/// comparison, or from moving values, propagate
+		void flush( ) {
+			if( m_buffer.empty( ) ) {
+				return;
+			}
+			if( not m_buffer_sorted ) {
+				std::stable_sort( m_buffer.begin( ), m_buffer.end( ), m_compare );
+			}
+			bool const needs_merge = not can_append( m_buffer.front( ) );
+			auto const old_size = static_cast<std::ptrdiff_t>( m_container->size( ) );
+			m_container->insert( m_container->end( ),
+			                     std::make_move_iterator( m_buffer.begin( ) ),
+			                     std::make_move_iterator( m_buffer.end( ) ) );
+			if( needs_merge ) {
+				std::inplace_merge( m_container->begin( ),
+				                    std::next( m_container->begin( ), old_size ),
+				                    m_container->end( ),
+				                    m_compare );
+			}
+			m_buffer.clear( );
+			m_buffer_sorted = true;
+		}
+
+		/// The number of values waiting to be merged
+		[[nodiscard]] std::size_t pending( ) const noexcept {
+			return m_buffer.size( );
+		}
+
+		/// An output iterator that adds to this inserter.  It must not outlive it
+		[[nodiscard]] auto iterator( ) noexcept {
+			return daw::make_function_iterator( [this]( auto &&value ) {
+				push( DAW_FWD( value ) );
+			} );
+		}
+	};
+
+	template<typename Container>
+	buffered_sorted_inserter( Container & )
+	  -> buffered_sorted_inserter<Container>;
+
+	template<typename Container, typename Compare>
+	buffered_sorted_inserter( Container &, Compare )
+	  -> buffered_sorted_inserter<Container, Compare>;
 } // namespace daw
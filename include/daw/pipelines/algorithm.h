@@ -8,13 +8,20 @@
 
 #pragma once
 
+#include "daw/daw_ensure.h"
 #include "daw/daw_iterator_traits.h"
 #include "daw/daw_move.h"
+#include "daw/daw_remove_cvref.h"
 #include "range.h"
 
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <functional>
 #include <iterator>
 #include <type_traits>
+#include <vector>
 
 namespace daw::pipelines {
 	template<typename R>
@@ -92,10 +99,247 @@ namespace daw::pipelines {
 		MinMax_t( ) -> MinMax_t<std::less<>>;
 		template<typename Compare>
 		MinMax_t( Compare ) -> MinMax_t<Compare>;
+
+		template<typename Compare>
+		struct NthElement_t {
+			std::size_t m_nth = 0;
+			DAW_NO_UNIQUE_ADDRESS Compare m_compare{ };
+
+			[[nodiscard]] constexpr decltype( auto )
+			operator( )( Sortable auto &&r ) const {
+				auto first = std::begin( r );
+				auto last = std::end( r );
+				auto const sz =
+				  static_cast<std::size_t>( std::distance( first, last ) );
+				if( m_nth < sz ) {
+					auto const nth =
+					  std::next( first, static_cast<std::ptrdiff_t>( m_nth ) );
+					std::nth_element( first, nth, last, m_compare );
+				}
+				return DAW_FWD( r );
+			}
+		};
+		template<typename Compare>
+		NthElement_t( std::size_t, Compare ) -> NthElement_t<Compare>;
+
+		template<typename Compare>
+		struct PartialSort_t {
+			std::size_t m_count = 0;
+			DAW_NO_UNIQUE_ADDRESS Compare m_compare{ };
+
+			[[nodiscard]] constexpr decltype( auto )
+			operator( )( Sortable auto &&r ) const {
+				auto first = std::begin( r );
+				auto last = std::end( r );
+				auto const sz =
+				  static_cast<std::size_t>( std::distance( first, last ) );
+				auto const middle = std::next(
+				  first, static_cast<std::ptrdiff_t>( ( std::min )( m_count, sz ) ) );
+				std::partial_sort( first, middle, last, m_compare );
+				return DAW_FWD( r );
+			}
+		};
+		template<typename Compare>
+		PartialSort_t( std::size_t, Compare ) -> PartialSort_t<Compare>;
+
+		/// Keeps the best k values seen so far in a heap ordered so that the
+		/// worst of them is at the front.  Once full, that front element is the
+		/// threshold a new value must beat to be admitted.
+		template<typename T, typename Compare>
+		class top_k_heap {
+			std::vector<T> m_heap{ };
+			std::size_t m_k = 0;
+			DAW_NO_UNIQUE_ADDRESS Compare m_compare{ };
+
+		public:
+			explicit constexpr top_k_heap( std::size_t k, Compare const &compare )
+			  : m_k( k )
+			  , m_compare( compare ) {
+				m_heap.reserve( k );
+			}
+
+			[[nodiscard]] constexpr bool full( ) const {
+				return m_heap.size( ) == m_k;
+			}
+
+			[[nodiscard]] constexpr T const &threshold( ) const {
+				return m_heap.front( );
+			}
+
+			constexpr void push( T const &v ) {
+				if( not full( ) ) {
+					m_heap.push_back( v );
+					std::push_heap( m_heap.begin( ), m_heap.end( ), m_compare );
+				} else if( m_compare( v, m_heap.front( ) ) ) {
+					std::pop_heap( m_heap.begin( ), m_heap.end( ), m_compare );
+					m_heap.back( ) = v;
+					std::push_heap( m_heap.begin( ), m_heap.end( ), m_compare );
+				}
+			}
+
+			[[nodiscard]] constexpr std::vector<T> release( ) {
+				std::sort_heap( m_heap.begin( ), m_heap.end( ), m_compare );
+				return std::move( m_heap );
+			}
+		};
+
+		template<typename Compare>
+		struct TopK_t {
+			/// Number of arithmetic values buffered before testing them against
+			/// the heap threshold.  The test over a block has no data dependent
+			/// branches and can be vectorized, so blocks without a candidate are
+			/// rejected without touching the heap
+			static constexpr std::size_t block_size = 64;
+
+			std::size_t m_k = 0;
+			DAW_NO_UNIQUE_ADDRESS Compare m_compare{ };
+
+			template<Range R>
+			[[nodiscard]] constexpr auto operator( )( R &&r ) const {
+				using value_t = range_value_t<R>;
+				auto heap = top_k_heap<value_t, Compare>( m_k, m_compare );
+				if( m_k == 0 ) {
+					return heap.release( );
+				}
+				auto first = std::begin( r );
+				auto const last = std::end( r );
+				if constexpr( std::is_arithmetic_v<value_t> ) {
+					while( first != last and not heap.full( ) ) {
+						heap.push( *first );
+						++first;
+					}
+					auto block = std::array<value_t, block_size>{ };
+					while( first != last ) {
+						std::size_t sz = 0;
+						while( sz < block_size and first != last ) {
+							block[sz++] = *first;
+							++first;
+						}
+						auto const thresh = heap.threshold( );
+						bool has_candidate = false;
+						for( std::size_t n = 0; n < sz; ++n ) {
+							has_candidate |= m_compare( block[n], thresh );
+						}
+						if( has_candidate ) {
+							for( std::size_t n = 0; n < sz; ++n ) {
+								heap.push( block[n] );
+							}
+						}
+					}
+				} else {
+					for( ; first != last; ++first ) {
+						heap.push( *first );
+					}
+				}
+				return heap.release( );
+			}
+		};
+		template<typename Compare>
+		TopK_t( std::size_t, Compare ) -> TopK_t<Compare>;
+
+		/// Nearest rank quantile index, so the result is always an element of
+		/// the range
+		[[nodiscard]] constexpr std::size_t quantile_rank( double q,
+		                                                   std::size_t sz ) {
+			daw_ensure( 0.0 <= q and q <= 1.0 );
+			auto const rank =
+			  static_cast<std::size_t>( std::ceil( q * static_cast<double>( sz ) ) );
+			return rank == 0 ? 0 : ( std::min )( rank - 1, sz - 1 );
+		}
+
+		template<std::size_t N, typename Compare>
+		struct Quantiles_t {
+			std::array<double, N> m_quantiles{ };
+			DAW_NO_UNIQUE_ADDRESS Compare m_compare{ };
+
+			template<Range R>
+			[[nodiscard]] constexpr auto operator( )( R &&r ) const {
+				using value_t = range_value_t<R>;
+				auto values = std::vector<value_t>( std::begin( r ), std::end( r ) );
+				daw_ensure( not values.empty( ) );
+				auto order = std::array<std::size_t, N>{ };
+				for( std::size_t n = 0; n < N; ++n ) {
+					order[n] = n;
+				}
+				std::sort( order.begin( ), order.end( ), [&]( auto lhs, auto rhs ) {
+					return m_quantiles[lhs] < m_quantiles[rhs];
+				} );
+				auto result = std::array<value_t, N>{ };
+				// Each selection only needs to look past the previous one as the
+				// quantiles are visited in increasing order
+				auto first = values.begin( );
+				for( auto idx : order ) {
+					auto const nth = std::next(
+					  values.begin( ),
+					  static_cast<std::ptrdiff_t>(
+					    quantile_rank( m_quantiles[idx], values.size( ) ) ) );
+					std::nth_element( first, nth, values.end( ), m_compare );
+					first = nth;
+					result[idx] = *nth;
+				}
+				return result;
+			}
+		};
+
+		template<typename Compare>
+		struct Median_t {
+			DAW_NO_UNIQUE_ADDRESS Compare m_compare{ };
+
+			[[nodiscard]] DAW_CPP23_STATIC_CALL_OP constexpr auto
+			operator( )( auto &&compare ) DAW_CPP23_STATIC_CALL_OP_CONST {
+				return Median_t<daw::remove_cvref_t<decltype( compare )>>{
+				  DAW_FWD( compare ) };
+			}
+
+			template<Range R>
+			[[nodiscard]] constexpr auto operator( )( R &&r ) const {
+				return Quantiles_t<1, Compare>{ { 0.5 }, m_compare }( DAW_FWD( r ) )[0];
+			}
+		};
+		Median_t( ) -> Median_t<std::less<>>;
 	} // namespace pimpl
 
 	inline constexpr auto Sort = pimpl::Sort_t{ };
 	inline constexpr auto Max = pimpl::Max_t{ };
 	inline constexpr auto Min = pimpl::Min_t{ };
 	inline constexpr auto MinMax = pimpl::MinMax_t{ };
+
+	/// Reorder a random access range so that the nth element is the one that
+	/// would be there if sorted, as std::nth_element
+	template<typename Compare = std::less<>>
+	[[nodiscard]] constexpr auto NthElement( std::size_t nth,
+	                                         Compare &&compare = Compare{ } ) {
+		return pimpl::NthElement_t{ nth, DAW_FWD( compare ) };
+	}
+
+	/// Sort the first count elements of a random access range, as
+	/// std::partial_sort
+	template<typename Compare = std::less<>>
+	[[nodiscard]] constexpr auto PartialSort( std::size_t count,
+	                                          Compare &&compare = Compare{ } ) {
+		return pimpl::PartialSort_t{ count, DAW_FWD( compare ) };
+	}
+
+	/// Select the first k values of any input range, as if it was sorted by
+	/// compare, into a std::vector ordered by compare.  The default ordering
+	/// gives the k largest values.  Only k values are ever stored, so this
+	/// works on streaming sources without materializing them
+	template<typename Compare = std::greater<>>
+	[[nodiscard]] constexpr auto TopK( std::size_t k,
+	                                   Compare &&compare = Compare{ } ) {
+		return pimpl::TopK_t{ k, DAW_FWD( compare ) };
+	}
+
+	/// Nearest rank quantiles of a range, e.g. Quantiles( 0.5, 0.9, 0.99 ).
+	/// The result is a std::array of range values in the order the quantiles
+	/// were specified.  The range must not be empty
+	template<typename... Qs>
+	requires( std::is_convertible_v<Qs, double> and ... ) //
+	  [[nodiscard]] constexpr auto Quantiles( Qs... qs ) {
+		return pimpl::Quantiles_t<sizeof...( Qs ), std::less<>>{
+		  { static_cast<double>( qs )... } };
+	}
+
+	/// The lower median of a non-empty range
+	inline constexpr auto Median = pimpl::Median_t{ };
 } // namespace daw::pipelines
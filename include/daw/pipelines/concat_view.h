@@ -14,6 +14,7 @@
 #include "daw/daw_visit.h"
 #include "pipeline_traits.h"
 #include "range.h"
+#include "size_hint.h"
 
 #include <tuple>
 #include <type_traits>
@@ -41,9 +42,21 @@ namespace daw::pipelines {
 		using range_variant_t =
 		  std::variant<std::pair<iterator_t<Ranges>, iterator_t<Ranges>>...>;
 
+		// Declared first so that it is computed before the ranges are moved from
+		size_hint_t m_size_hint = size_hint_t{ };
 		std::array<range_variant_t, sizeof...( Ranges )> m_ranges;
 		std::size_t m_index = 0;
 
+		[[nodiscard]] static constexpr size_hint_t
+		concat_size_hint( Ranges const &...ranges ) {
+			size_hint_t const hints[] = { range_size_hint( ranges )... };
+			auto result = size_hint_t::exact( 0 );
+			for( auto const &h : hints ) {
+				result = size_hint_sum( result, h );
+			}
+			return result;
+		}
+
 		template<std::size_t... Is>
 		static constexpr std::array<range_variant_t, sizeof...( Ranges )>
 		get_iter_pair( std::index_sequence<Is...>,
@@ -58,10 +71,16 @@ namespace daw::pipelines {
 		explicit concat_view( ) = default;
 
 		explicit constexpr concat_view( Ranges... ranges )
-		  : m_ranges(
+		  : m_size_hint( concat_size_hint( ranges... ) )
+		  , m_ranges(
 		      get_iter_pair( std::make_index_sequence<sizeof...( Ranges )>{ },
 		                     std::tuple{ std::move( ranges )... } ) ) {}
 
+		/// The sum of the size hints of the concatenated ranges
+		[[nodiscard]] constexpr size_hint_t size_hint( ) const {
+			return m_size_hint;
+		}
+
 		concat_view begin( ) const {
 			return *this;
 		}
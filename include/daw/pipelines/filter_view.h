@@ -16,6 +16,7 @@
 #include "daw/daw_remove_cvref.h"
 #include "daw/daw_typeof.h"
 #include "range.h"
+#include "size_hint.h"
 
 #include <concepts>
 #include <cstddef>
@@ -37,6 +38,7 @@ namespace daw::pipelines {
 		Iterator m_first = Iterator{ };
 		Iterator m_last = Iterator{ };
 		DAW_NO_UNIQUE_ADDRESS Filter m_func = Filter( );
+		size_hint_t m_size_hint = size_hint_t{ };
 
 	public:
 		explicit filter_view( ) = default;
@@ -52,6 +54,23 @@ namespace daw::pipelines {
 			}
 		}
 
+		/// @param hint size hint of the unfiltered range
+		template<typename F>
+		requires std::constructible_from<Filter, F> //
+		  explicit constexpr filter_view( Iterator first,
+		                                  Iterator last,
+		                                  F &&fn,
+		                                  size_hint_t hint )
+		  : filter_view( first, last, DAW_FWD( fn ) ) {
+			m_size_hint = hint.as_upper_bound( );
+		}
+
+		/// Any number of elements may be filtered out, so this is at most the
+		/// size of the unfiltered range
+		[[nodiscard]] constexpr size_hint_t size_hint( ) const {
+			return m_size_hint;
+		}
+
 		[[nodiscard]] DAW_ATTRIB_INLINE constexpr filter_view begin( ) const {
 			return *this;
 		}
@@ -123,7 +142,7 @@ namespace daw::pipelines {
 				                      bool>,
 				  "Filter requires an invokable function that returns a bool" );
 				return filter_view<iterator_t<R>, Fn>(
-				  std::begin( r ), std::end( r ), fn );
+				  std::begin( r ), std::end( r ), fn, range_size_hint( r ) );
 			}
 
 			template<typename Value>
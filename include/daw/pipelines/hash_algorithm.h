@@ -0,0 +1,356 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw/daw_attributes.h"
+#include "daw/daw_cpp_feature_check.h"
+#include "daw/daw_iterator_traits.h"
+#include "daw/daw_move.h"
+#include "daw/daw_remove_cvref.h"
+#include "range.h"
+#include "size_hint.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace daw::pipelines::pimpl {
+	/// std::hash for whatever key type the stage ends up with
+	struct DefaultHash {
+		template<typename T>
+		[[nodiscard]] DAW_CPP23_STATIC_CALL_OP constexpr std::size_t
+		operator( )( T const &v ) DAW_CPP23_STATIC_CALL_OP_CONST {
+			return std::hash<T>{ }( v );
+		}
+	};
+
+	/// Upper limit on the number of keys a table is pre-sized for from the
+	/// element count.  Past this, a low cardinality input would pay for a
+	/// mostly empty table; the table grows on demand instead
+	inline constexpr std::size_t max_presize_keys = std::size_t{ 1 } << 20U;
+
+	/// Open addressing, linear probing index from Key to the position it was
+	/// first inserted at.  Keys are stored densely in insertion order so that
+	/// results built from them are deterministic.  The slots store the full
+	/// hash to avoid calling the equality comparison on most probe misses
+	template<typename Key,
+	         typename Hash = DefaultHash,
+	         typename KeyEqual = std::equal_to<>>
+	class hash_index {
+		static constexpr std::size_t empty_slot = static_cast<std::size_t>( -1 );
+
+		struct slot_t {
+			std::size_t hash = 0;
+			std::size_t index = empty_slot;
+		};
+
+		std::vector<slot_t> m_slots{ };
+		std::vector<Key> m_keys{ };
+		std::size_t m_mask = 0;
+		DAW_NO_UNIQUE_ADDRESS Hash m_hash{ };
+		DAW_NO_UNIQUE_ADDRESS KeyEqual m_key_equal{ };
+
+		/// std::hash is the identity for integers on common implementations;
+		/// mix it so that the low bits used by the mask are well distributed
+		[[nodiscard]] constexpr std::size_t hash_of( Key const &key ) const {
+			auto const h = static_cast<std::uint64_t>( m_hash( key ) );
+			auto const m = h * 0x9E37'79B9'7F4A'7C15ULL;
+			return static_cast<std::size_t>( m ^ ( m >> 32U ) );
+		}
+
+		constexpr void rehash( std::size_t slot_count ) {
+			m_slots.assign( slot_count, slot_t{ } );
+			m_mask = slot_count - 1;
+			for( std::size_t n = 0; n < m_keys.size( ); ++n ) {
+				auto const h = hash_of( m_keys[n] );
+				auto pos = h & m_mask;
+				while( m_slots[pos].index != empty_slot ) {
+					pos = ( pos + 1 ) & m_mask;
+				}
+				m_slots[pos] = slot_t{ h, n };
+			}
+		}
+
+		/// Keep the load factor at or below 1/2
+		[[nodiscard]] static constexpr std::size_t
+		slots_for( std::size_t key_count ) {
+			return std::bit_ceil( ( std::max )( key_count * 2, std::size_t{ 16 } ) );
+		}
+
+	public:
+		static constexpr std::size_t npos = empty_slot;
+
+		explicit hash_index( ) = default;
+
+		/// @param expected_keys pre-size for this many keys, up to
+		/// max_presize_keys
+		explicit constexpr hash_index( std::size_t expected_keys,
+		                               Hash const &hash = Hash{ },
+		                               KeyEqual const &key_equal = KeyEqual{ } )
+		  : m_hash( hash )
+		  , m_key_equal( key_equal ) {
+			reserve( ( std::min )( expected_keys, max_presize_keys ) );
+		}
+
+		constexpr void reserve( std::size_t key_count ) {
+			m_keys.reserve( key_count );
+			auto const slot_count = slots_for( key_count );
+			if( slot_count > m_slots.size( ) ) {
+				rehash( slot_count );
+			}
+		}
+
+		/// @return the dense index of key and whether it was newly inserted
+		template<typename K>
+		constexpr std::pair<std::size_t, bool> try_emplace( K &&key ) {
+			if( ( m_keys.size( ) + 1 ) * 2 > m_slots.size( ) ) {
+				rehash( slots_for( m_keys.size( ) + 1 ) );
+			}
+			auto const h = hash_of( key );
+			auto pos = h & m_mask;
+			while( true ) {
+				auto const &slot = m_slots[pos];
+				if( slot.index == empty_slot ) {
+					auto const idx = m_keys.size( );
+					m_keys.emplace_back( DAW_FWD( key ) );
+					m_slots[pos] = slot_t{ h, idx };
+					return { idx, true };
+				}
+				if( slot.hash == h and m_key_equal( m_keys[slot.index], key ) ) {
+					return { slot.index, false };
+				}
+				pos = ( pos + 1 ) & m_mask;
+			}
+		}
+
+		/// @return the dense index of key or npos
+		[[nodiscard]] constexpr std::size_t find( Key const &key ) const {
+			if( m_slots.empty( ) ) {
+				return npos;
+			}
+			auto const h = hash_of( key );
+			auto pos = h & m_mask;
+			while( true ) {
+				auto const &slot = m_slots[pos];
+				if( slot.index == empty_slot ) {
+					return npos;
+				}
+				if( slot.hash == h and m_key_equal( m_keys[slot.index], key ) ) {
+					return slot.index;
+				}
+				pos = ( pos + 1 ) & m_mask;
+			}
+		}
+
+		[[nodiscard]] constexpr std::size_t size( ) const {
+			return m_keys.size( );
+		}
+
+		[[nodiscard]] constexpr std::vector<Key> &keys( ) {
+			return m_keys;
+		}
+
+		[[nodiscard]] constexpr std::vector<Key> const &keys( ) const {
+			return m_keys;
+		}
+	};
+
+	template<typename Hash>
+	struct Distinct_t {
+		DAW_NO_UNIQUE_ADDRESS Hash m_hash{ };
+
+		template<Range R>
+		[[nodiscard]] constexpr auto operator( )( R &&r ) const {
+			using value_t = range_value_t<R>;
+			auto index =
+			  hash_index<value_t, Hash>( range_size_hint( r ).value, m_hash );
+			for( auto &&v : r ) {
+				(void)index.try_emplace( DAW_FWD( v ) );
+			}
+			return std::move( index.keys( ) );
+		}
+	};
+	template<typename Hash>
+	Distinct_t( Hash ) -> Distinct_t<Hash>;
+
+	template<typename KeyFn, typename T, typename Op, typename Hash>
+	struct GroupBy_t {
+		DAW_NO_UNIQUE_ADDRESS mutable KeyFn m_key_fn;
+		T m_init;
+		DAW_NO_UNIQUE_ADDRESS mutable Op m_op;
+		DAW_NO_UNIQUE_ADDRESS Hash m_hash{ };
+
+		template<Range R>
+		[[nodiscard]] constexpr auto operator( )( R &&r ) const {
+			static_assert( std::is_invocable_v<KeyFn, range_reference_t<R>>,
+			               "GroupBy requires the key function to be callable with "
+			               "the range_reference_t" );
+			using key_t = daw::remove_cvref_t<
+			  std::invoke_result_t<KeyFn, range_reference_t<R>>>;
+			static_assert( std::is_invocable_v<Op, T, range_reference_t<R>>,
+			               "GroupBy requires the aggregator to be callable with the "
+			               "accumulated value and the range_reference_t" );
+
+			auto const hint = range_size_hint( r ).value;
+			auto index = hash_index<key_t, Hash>( hint, m_hash );
+			auto accs = std::vector<T>( );
+			accs.reserve( ( std::min )( hint, max_presize_keys ) );
+			for( auto &&v : r ) {
+				auto const [idx, inserted] =
+				  index.try_emplace( std::invoke( m_key_fn, v ) );
+				if( inserted ) {
+					accs.push_back( m_init );
+				}
+				accs[idx] = std::invoke( m_op, std::move( accs[idx] ), v );
+			}
+			auto &keys = index.keys( );
+			auto result = std::vector<std::pair<key_t, T>>( );
+			result.reserve( keys.size( ) );
+			for( std::size_t n = 0; n < keys.size( ); ++n ) {
+				result.emplace_back( std::move( keys[n] ), std::move( accs[n] ) );
+			}
+			return result;
+		}
+	};
+	template<typename KeyFn, typename T, typename Op, typename Hash>
+	GroupBy_t( KeyFn, T, Op, Hash ) -> GroupBy_t<KeyFn, T, Op, Hash>;
+
+	struct GroupAppend_t {
+		template<typename Vec, typename Value>
+		[[nodiscard]] DAW_CPP23_STATIC_CALL_OP constexpr Vec
+		operator( )( Vec &&vec, Value &&v ) DAW_CPP23_STATIC_CALL_OP_CONST {
+			vec.push_back( DAW_FWD( v ) );
+			return DAW_FWD( vec );
+		}
+	};
+
+	template<typename Other, typename LeftKey, typename RightKey, typename Hash>
+	struct HashJoin_t {
+		Other m_other;
+		DAW_NO_UNIQUE_ADDRESS mutable LeftKey m_left_key;
+		DAW_NO_UNIQUE_ADDRESS mutable RightKey m_right_key;
+		DAW_NO_UNIQUE_ADDRESS Hash m_hash{ };
+
+		template<Range R>
+		[[nodiscard]] constexpr auto operator( )( R &&r ) const {
+			using right_t = range_value_t<Other const &>;
+			using left_t = range_value_t<R>;
+			using key_t = daw::remove_cvref_t<
+			  std::invoke_result_t<RightKey, range_reference_t<Other const &>>>;
+			static_assert(
+			  std::is_invocable_v<LeftKey, range_reference_t<R>>,
+			  "HashJoin requires the left key function to be callable with the "
+			  "range_reference_t" );
+
+			// Build side.  Rows sharing a key are chained through next, in
+			// insertion order, starting at the key's dense index in heads
+			constexpr auto end_of_chain = static_cast<std::size_t>( -1 );
+			auto const hint = range_size_hint( m_other ).value;
+			auto index = hash_index<key_t, Hash>( hint, m_hash );
+			auto rows = std::vector<right_t>( );
+			auto next = std::vector<std::size_t>( );
+			auto heads = std::vector<std::size_t>( );
+			auto tails = std::vector<std::size_t>( );
+			rows.reserve( hint );
+			next.reserve( hint );
+			for( auto &&v : m_other ) {
+				auto const row = rows.size( );
+				auto const [idx, inserted] =
+				  index.try_emplace( std::invoke( m_right_key, v ) );
+				rows.push_back( v );
+				next.push_back( end_of_chain );
+				if( inserted ) {
+					heads.push_back( row );
+					tails.push_back( row );
+				} else {
+					next[tails[idx]] = row;
+					tails[idx] = row;
+				}
+			}
+
+			// Probe side
+			auto result = std::vector<std::pair<left_t, right_t>>( );
+			result.reserve( range_size_hint( r ).value );
+			for( auto &&v : r ) {
+				auto const idx = index.find( std::invoke( m_left_key, v ) );
+				if( idx == index.npos ) {
+					continue;
+				}
+				for( auto row = heads[idx]; row != end_of_chain; row = next[row] ) {
+					result.emplace_back( v, rows[row] );
+				}
+			}
+			return result;
+		}
+	};
+} // namespace daw::pipelines::pimpl
+
+namespace daw::pipelines {
+	/// Remove all duplicate values, not just adjacent ones, keeping the first
+	/// occurrence of each.  The result is a std::vector in input order
+	template<typename Hash = pimpl::DefaultHash>
+	[[nodiscard]] constexpr auto Distinct( Hash &&hash = Hash{ } ) {
+		return pimpl::Distinct_t{ DAW_FWD( hash ) };
+	}
+
+	/// Aggregate the values of a range by the key returned from key_fn.  Each
+	/// group starts as init and values are folded into it with
+	/// op( std::move( acc ), value ), as std::accumulate.  The result is a
+	/// std::vector<std::pair<Key, T>> in order of first occurrence of each key
+	template<typename KeyFn,
+	         typename T,
+	         typename Op,
+	         typename Hash = pimpl::DefaultHash>
+	[[nodiscard]] constexpr auto
+	GroupBy( KeyFn &&key_fn, T &&init, Op &&op, Hash &&hash = Hash{ } ) {
+		return pimpl::GroupBy_t{
+		  DAW_FWD( key_fn ), DAW_FWD( init ), DAW_FWD( op ), DAW_FWD( hash ) };
+	}
+
+	/// Group the values of a range by the key returned from key_fn.  The
+	/// result is a std::vector<std::pair<Key, std::vector<Value>>> in order of
+	/// first occurrence of each key
+	template<typename KeyFn>
+	[[nodiscard]] constexpr auto GroupBy( KeyFn &&key_fn ) {
+		return [key_fn = DAW_FWD( key_fn )]<Range R>( R &&r ) {
+			return pimpl::GroupBy_t{ key_fn,
+			                         std::vector<range_value_t<R>>( ),
+			                         pimpl::GroupAppend_t{ },
+			                         pimpl::DefaultHash{ } }( DAW_FWD( r ) );
+		};
+	}
+
+	/// Inner equi-join of the current range with other.  A hash table is built
+	/// over other and probed with each value of the current range.  The result
+	/// is a std::vector<std::pair<LeftValue, RightValue>> in the order of the
+	/// current range and, for equal keys, the order of other.  An lvalue other
+	/// is referenced and must outlive the stage, an rvalue is moved into it
+	template<Range Other,
+	         typename LeftKey,
+	         typename RightKey,
+	         typename Hash = pimpl::DefaultHash>
+	[[nodiscard]] constexpr auto HashJoin( Other &&other,
+	                                       LeftKey &&left_key,
+	                                       RightKey &&right_key,
+	                                       Hash &&hash = Hash{ } ) {
+		return pimpl::HashJoin_t<Other,
+		                         daw::remove_cvref_t<LeftKey>,
+		                         daw::remove_cvref_t<RightKey>,
+		                         daw::remove_cvref_t<Hash>>{ DAW_FWD( other ),
+		                                                     DAW_FWD( left_key ),
+		                                                     DAW_FWD( right_key ),
+		                                                     DAW_FWD( hash ) };
+	}
+} // namespace daw::pipelines
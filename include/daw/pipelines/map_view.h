@@ -13,6 +13,7 @@
 #include "daw/daw_typeof.h"
 #include "daw/iterator/daw_arrow_proxy.h"
 #include "pipeline_traits.h"
+#include "size_hint.h"
 
 #include <cstddef>
 #include <functional>
@@ -176,6 +177,7 @@ namespace daw::pipelines {
 
 		iterator m_first = iterator{ };
 		iterator m_last = iterator{ };
+		size_hint_t m_size_hint = size_hint_t{ };
 
 		explicit map_view( ) = default;
 
@@ -184,7 +186,25 @@ namespace daw::pipelines {
 
 		explicit constexpr map_view( Iterator first, Iterator last, Fn const &fn )
 		  : m_first( first, fn )
-		  , m_last( last, fn ) {}
+		  , m_last( last, fn ) {
+			if constexpr( RandomIterator<Iterator> ) {
+				m_size_hint = size_hint_t::exact(
+				  static_cast<std::size_t>( std::distance( first, last ) ) );
+			}
+		}
+
+		explicit constexpr map_view( Iterator first,
+		                             Iterator last,
+		                             Fn const &fn,
+		                             size_hint_t hint )
+		  : m_first( first, fn )
+		  , m_last( last, fn )
+		  , m_size_hint( hint ) {}
+
+		/// Mapping is one to one, so this is the hint of the source range
+		[[nodiscard]] constexpr size_hint_t size_hint( ) const {
+			return m_size_hint;
+		}
 
 		[[nodiscard]] DAW_ATTRIB_INLINE constexpr iterator begin( ) const {
 			return m_first;
@@ -198,6 +218,8 @@ namespace daw::pipelines {
 	map_view( I, F ) -> map_view<I, F>;
 	template<typename I, typename F>
 	map_view( I, I, F ) -> map_view<I, F>;
+	template<typename I, typename F>
+	map_view( I, I, F, size_hint_t ) -> map_view<I, F>;
 
 	namespace pimpl {
 		template<typename Fn>
@@ -212,7 +234,8 @@ namespace daw::pipelines {
 					               "with invoke and the range_reference_t" );
 					static_assert( traits::NoVoidResults<Fn, range_reference_t<R>>,
 					               "Map requires the result to not be void" );
-					return map_view( std::begin( r ), std::end( r ), m_func );
+					return map_view(
+					  std::begin( r ), std::end( r ), m_func, range_size_hint( r ) );
 				} else {
 					static_assert( std::is_invocable_v<Fn, R>,
 					               "Map requires the function to be able to be called "
@@ -236,9 +259,13 @@ namespace daw::pipelines {
 				               "MapApply requires the function to be able to be called "
 				               "with apply and the range_reference_t" );
 				auto func = m_func;
-				return map_view( std::begin( r ), std::end( r ), [=]( auto &&tp ) {
-					return std::apply( func, tp );
-				} );
+				return map_view(
+				  std::begin( r ),
+				  std::end( r ),
+				  [=]( auto &&tp ) {
+					  return std::apply( func, tp );
+				  },
+				  range_size_hint( r ) );
 			}
 		};
 		template<typename Fn>
@@ -261,9 +288,12 @@ namespace daw::pipelines {
 					               "Clamp requires a lo/hi values convertible to the "
 					               "range value type" );
 					return map_view(
-					  std::begin( r ), std::end( r ), [=]( value_type const &v ) {
+					  std::begin( r ),
+					  std::end( r ),
+					  [=]( value_type const &v ) {
 						  return std::clamp( v, l, h, c );
-					  } );
+					  },
+					  range_size_hint( r ) );
 				} else {
 					static_assert(
 					  std::convertible_to<T, daw::remove_cvref_t<R>>,
@@ -8,25 +8,147 @@
 
 #pragma once
 
+#include "daw/daw_attributes.h"
+#include "daw/daw_concepts.h"
 #include "daw/daw_cpp_feature_check.h"
 #include "daw/daw_cxmath.h"
 #include "daw/daw_iterator_traits.h"
 #include "daw/daw_move.h"
+#include "daw/daw_remove_cvref.h"
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
 #include <iterator>
+#include <type_traits>
+#include <utility>
 
 namespace daw::pipelines {
 	namespace pimpl {
+		/// Number of independent accumulators used by the contiguous fast paths.
+		/// Each lane is its own dependency chain, so the loop is not bound by
+		/// the latency of a single add and can be vectorized
+		inline constexpr std::size_t reduce_lanes = 8;
+
+		template<typename R>
+		concept ArithmeticContiguousRange =
+		  ContiguousContainer<R> and
+		  std::is_arithmetic_v<daw::remove_cvref_t<decltype( *std::data(
+		    std::declval<R &>( ) ) )>>;
+
+		/// Reduce the indices [0, size) with Lanes independent states.  step( s,
+		/// i ) folds index i into the lane state s and combine( l, r ) folds
+		/// lane r into lane l.  The lanes are combined as a tree at the end.
+		template<std::size_t Lanes = reduce_lanes,
+		         typename State,
+		         typename Step,
+		         typename Combine>
+		[[nodiscard]] DAW_ATTRIB_INLINE constexpr State
+		lane_reduce( std::size_t size,
+		             State const &init,
+		             Step &&step,
+		             Combine &&combine ) {
+			static_assert( Lanes > 0 and ( Lanes & ( Lanes - 1 ) ) == 0,
+			               "Lanes must be a power of two" );
+			auto lanes = std::array<State, Lanes>{ };
+			lanes.fill( init );
+			auto const block_end = size - ( size % Lanes );
+			std::size_t n = 0;
+			for( ; n < block_end; n += Lanes ) {
+				for( std::size_t l = 0; l < Lanes; ++l ) {
+					step( lanes[l], n + l );
+				}
+			}
+			for( std::size_t l = 0; n < size; ++n, ++l ) {
+				step( lanes[l], n );
+			}
+			for( std::size_t width = Lanes / 2; width > 0; width /= 2 ) {
+				for( std::size_t l = 0; l < width; ++l ) {
+					combine( lanes[l], lanes[l + width] );
+				}
+			}
+			return lanes[0];
+		}
+
+		template<typename T>
+		[[nodiscard]] constexpr T lane_sum( T const *ptr, std::size_t size ) {
+			return lane_reduce(
+			  size,
+			  T{ },
+			  [ptr]( T &s, std::size_t i ) {
+				  s += ptr[i];
+			  },
+			  []( T &l, T const &r ) {
+				  l += r;
+			  } );
+		}
+
+		/// Pairwise summation has an error bound of O( log( n ) * epsilon )
+		/// instead of the O( n * epsilon ) of a single accumulator.  The leaves
+		/// are summed with lane_sum so the recursion overhead is amortized
+		template<typename T>
+		[[nodiscard]] constexpr T pairwise_sum( T const *ptr, std::size_t size ) {
+			constexpr std::size_t leaf_size = 128;
+			if( size <= leaf_size ) {
+				return lane_sum( ptr, size );
+			}
+			auto const half = ( size / 2 ) - ( ( size / 2 ) % reduce_lanes );
+			return pairwise_sum( ptr, half ) +
+			       pairwise_sum( ptr + half, size - half );
+		}
+
 		struct sum_t {
 			[[nodiscard]] DAW_CPP23_STATIC_CALL_OP constexpr auto
 			operator( )( Range auto &&r ) DAW_CPP23_STATIC_CALL_OP_CONST {
 				using value_type = daw::iter_value_t<decltype( std::begin( r ) )>;
-				auto sum = value_type{ };
-				for( auto const &v : r ) {
-					sum = sum + v;
+				if constexpr( ArithmeticContiguousRange<decltype( r )> ) {
+					return lane_sum<value_type>( std::data( r ), std::size( r ) );
+				} else {
+					auto sum = value_type{ };
+					for( auto const &v : r ) {
+						sum = sum + v;
+					}
+					return sum;
+				}
+			}
+		};
+
+		struct SumPairwise_t {
+			template<Range R>
+			[[nodiscard]] DAW_CPP23_STATIC_CALL_OP constexpr auto
+			operator( )( R &&r ) DAW_CPP23_STATIC_CALL_OP_CONST {
+				using value_type = range_value_t<R>;
+				if constexpr( ArithmeticContiguousRange<R> ) {
+					return pairwise_sum<value_type>( std::data( r ), std::size( r ) );
+				} else {
+					// Stream through fixed blocks, merging block sums on a binary
+					// counter stack so that only O( log( n ) ) partials are kept
+					constexpr std::size_t block_size = 128;
+					auto block = std::array<value_type, block_size>{ };
+					auto partials = std::array<value_type, 64>{ };
+					std::size_t partial_count = 0;
+					std::size_t block_count = 0;
+					auto first = std::begin( r );
+					auto const last = std::end( r );
+					while( first != last ) {
+						std::size_t sz = 0;
+						while( sz < block_size and first != last ) {
+							block[sz++] = *first;
+							++first;
+						}
+						auto sum = lane_sum<value_type>( block.data( ), sz );
+						++block_count;
+						for( auto c = block_count; ( c & 1U ) == 0; c >>= 1U ) {
+							sum = partials[--partial_count] + sum;
+						}
+						partials[partial_count++] = sum;
+					}
+					auto result = value_type{ };
+					while( partial_count > 0 ) {
+						result = partials[--partial_count] + result;
+					}
+					return result;
 				}
-				return sum;
 			}
 		};
 
@@ -69,6 +191,44 @@ namespace daw::pipelines {
 			}
 		} IdentityFn;
 
+		template<typename T>
+		struct neumaier_state {
+			T sum = T{ };
+			T c = T{ };
+
+			/// The compensation is chosen with a select instead of a branch so
+			/// that independent lanes can be vectorized
+			DAW_ATTRIB_INLINE constexpr void add( T input ) {
+				auto const t = sum + input;
+				auto const big_sum =
+				  daw::cxmath::abs( sum ) >= daw::cxmath::abs( input );
+				auto const big = big_sum ? sum : input;
+				auto const small = big_sum ? input : sum;
+				c += ( big - t ) + small;
+				sum = t;
+			}
+
+			[[nodiscard]] constexpr T value( ) const {
+				return sum + c;
+			}
+		};
+
+		template<typename T>
+		[[nodiscard]] constexpr T lane_neumaier_sum( T const *ptr,
+		                                             std::size_t size ) {
+			return lane_reduce<4>(
+			         size,
+			         neumaier_state<T>{ },
+			         [ptr]( neumaier_state<T> &s, std::size_t i ) {
+				         s.add( ptr[i] );
+			         },
+			         []( neumaier_state<T> &l, neumaier_state<T> const &r ) {
+				         l.add( r.sum );
+				         l.c += r.c;
+			         } )
+			  .value( );
+		}
+
 		template<typename Projection = IdentityFn_t>
 		struct SumKahanBabushkaNeumaier_t {
 			DAW_NO_UNIQUE_ADDRESS Projection m_projection = Projection{ };
@@ -87,25 +247,30 @@ namespace daw::pipelines {
 				static_assert( std::is_floating_point_v<fp_t>,
 				               "Use of Kahan Babushka Neumaier summation requires the "
 				               "range value type to be a floating point type" );
-				auto sum = fp_t{ 0.0 };
-				auto c = fp_t{ 0.0 };
-				for( auto &&cur_v : r ) {
-					fp_t input = [&] {
-						if constexpr( std::is_same_v<Projection, IdentityFn_t> ) {
-							return cur_v;
+				if constexpr( std::is_same_v<Projection, IdentityFn_t> and
+				              ArithmeticContiguousRange<R> ) {
+					return lane_neumaier_sum<fp_t>( std::data( r ), std::size( r ) );
+				} else {
+					auto sum = fp_t{ 0.0 };
+					auto c = fp_t{ 0.0 };
+					for( auto &&cur_v : r ) {
+						fp_t input = [&] {
+							if constexpr( std::is_same_v<Projection, IdentityFn_t> ) {
+								return cur_v;
+							} else {
+								return std::invoke( cur_v, m_projection );
+							}
+						}( );
+						auto t = sum + input;
+						if( daw::cxmath::abs( sum ) >= daw::cxmath::abs( input ) ) {
+							c += ( sum - t ) + input;
 						} else {
-							return std::invoke( cur_v, m_projection );
+							c += ( input - t ) + sum;
 						}
-					}( );
-					auto t = sum + input;
-					if( daw::cxmath::abs( sum ) >= daw::cxmath::abs( input ) ) {
-						c += ( sum - t ) + input;
-					} else {
-						c += ( input - t ) + sum;
+						sum = t;
 					}
-					sum = t;
+					return sum + c;
 				}
-				return sum + c;
 			}
 		};
 		SumKahanBabushkaNeumaier_t( ) -> SumKahanBabushkaNeumaier_t<>;
@@ -113,6 +278,159 @@ namespace daw::pipelines {
 		template<typename Projection>
 		SumKahanBabushkaNeumaier_t( Projection )
 		  -> SumKahanBabushkaNeumaier_t<Projection>;
+
+		template<typename Other>
+		struct Dot_t {
+			Other m_other;
+
+			template<Range R>
+			[[nodiscard]] constexpr auto operator( )( R &&r ) const {
+				using value_type = std::common_type_t<range_value_t<R>,
+				                                      range_value_t<Other const &>>;
+				if constexpr( ArithmeticContiguousRange<R> and
+				              ArithmeticContiguousRange<Other const &> ) {
+					auto const *lhs = std::data( r );
+					auto const *rhs = std::data( m_other );
+					auto const sz =
+					  ( std::min )( static_cast<std::size_t>( std::size( r ) ),
+					                static_cast<std::size_t>( std::size( m_other ) ) );
+					return lane_reduce(
+					  sz,
+					  value_type{ },
+					  [=]( value_type &s, std::size_t i ) {
+						  s += static_cast<value_type>( lhs[i] ) *
+						       static_cast<value_type>( rhs[i] );
+					  },
+					  []( value_type &l, value_type const &rs ) {
+						  l += rs;
+					  } );
+				} else {
+					auto result = value_type{ };
+					auto first0 = std::begin( r );
+					auto const last0 = std::end( r );
+					auto first1 = std::begin( m_other );
+					auto const last1 = std::end( m_other );
+					for( ; first0 != last0 and first1 != last1; ++first0, ++first1 ) {
+						result += static_cast<value_type>( *first0 ) *
+						          static_cast<value_type>( *first1 );
+					}
+					return result;
+				}
+			}
+		};
+
+		struct MinMaxValues_t {
+			template<Range R>
+			[[nodiscard]] DAW_CPP23_STATIC_CALL_OP constexpr auto
+			operator( )( R &&r ) DAW_CPP23_STATIC_CALL_OP_CONST {
+				using value_type = range_value_t<R>;
+				using result_t = std::pair<value_type, value_type>;
+				if constexpr( ArithmeticContiguousRange<R> ) {
+					auto const *ptr = std::data( r );
+					auto const sz = static_cast<std::size_t>( std::size( r ) );
+					if( sz == 0 ) {
+						return result_t{ };
+					}
+					return lane_reduce(
+					  sz,
+					  result_t{ ptr[0], ptr[0] },
+					  [ptr]( result_t &s, std::size_t i ) {
+						  s.first = ptr[i] < s.first ? ptr[i] : s.first;
+						  s.second = s.second < ptr[i] ? ptr[i] : s.second;
+					  },
+					  []( result_t &l, result_t const &rs ) {
+						  l.first = rs.first < l.first ? rs.first : l.first;
+						  l.second = l.second < rs.second ? rs.second : l.second;
+					  } );
+				} else {
+					auto first = std::begin( r );
+					auto const last = std::end( r );
+					if( first == last ) {
+						return result_t{ };
+					}
+					auto result = result_t{ *first, *first };
+					for( ++first; first != last; ++first ) {
+						value_type const &v = *first;
+						if( v < result.first ) {
+							result.first = v;
+						}
+						if( result.second < v ) {
+							result.second = v;
+						}
+					}
+					return result;
+				}
+			}
+		};
+	} // namespace pimpl
+
+	/// The running moments of a sequence, as accumulated by Welford's method.
+	/// Two sets of moments can be merged with Chan's parallel formula
+	struct moments_t {
+		double count = 0.0;
+		double mean = 0.0;
+		double m2 = 0.0;
+
+		DAW_ATTRIB_INLINE constexpr void add( double x ) {
+			count += 1.0;
+			auto const delta = x - mean;
+			mean += delta / count;
+			m2 += delta * ( x - mean );
+		}
+
+		constexpr void merge( moments_t const &other ) {
+			if( other.count == 0.0 ) {
+				return;
+			}
+			if( count == 0.0 ) {
+				*this = other;
+				return;
+			}
+			auto const total = count + other.count;
+			auto const delta = other.mean - mean;
+			mean += delta * ( other.count / total );
+			m2 += other.m2 + delta * delta * ( count * other.count / total );
+			count = total;
+		}
+
+		/// Population variance
+		[[nodiscard]] constexpr double variance( ) const {
+			return count > 0.0 ? m2 / count : 0.0;
+		}
+
+		/// Unbiased sample variance
+		[[nodiscard]] constexpr double sample_variance( ) const {
+			return count > 1.0 ? m2 / ( count - 1.0 ) : 0.0;
+		}
+	};
+
+	namespace pimpl {
+		struct Moments_t {
+			template<Range R>
+			[[nodiscard]] DAW_CPP23_STATIC_CALL_OP constexpr moments_t
+			operator( )( R &&r ) DAW_CPP23_STATIC_CALL_OP_CONST {
+				static_assert( std::is_arithmetic_v<range_value_t<R>>,
+				               "Moments require an arithmetic range value type" );
+				if constexpr( ArithmeticContiguousRange<R> ) {
+					auto const *ptr = std::data( r );
+					return lane_reduce<4>(
+					  static_cast<std::size_t>( std::size( r ) ),
+					  moments_t{ },
+					  [ptr]( moments_t &s, std::size_t i ) {
+						  s.add( static_cast<double>( ptr[i] ) );
+					  },
+					  []( moments_t &l, moments_t const &rs ) {
+						  l.merge( rs );
+					  } );
+				} else {
+					auto result = moments_t{ };
+					for( auto const &v : r ) {
+						result.add( static_cast<double>( v ) );
+					}
+					return result;
+				}
+			}
+		};
 	} // namespace pimpl
 
 	inline constexpr auto Count = pimpl::count_t{ };
@@ -120,6 +438,34 @@ namespace daw::pipelines {
 	inline constexpr auto SumKahanBabushkaNeumaier =
 	  pimpl::SumKahanBabushkaNeumaier_t{ };
 
+	/// Sum with pairwise summation, error grows with log( n ) rather than n
+	inline constexpr auto SumPairwise = pimpl::SumPairwise_t{ };
+
+	/// The smallest and largest values of a range as a std::pair.  An empty
+	/// range results in a value initialized pair
+	inline constexpr auto MinMaxValues = pimpl::MinMaxValues_t{ };
+
+	/// The count, mean and variance of a range in a single pass
+	inline constexpr auto Moments = pimpl::Moments_t{ };
+
+	/// The arithmetic mean of a range
+	inline constexpr auto Mean = []( Range auto &&r ) {
+		return pimpl::Moments_t{ }( DAW_FWD( r ) ).mean;
+	};
+
+	/// The population variance of a range
+	inline constexpr auto Variance = []( Range auto &&r ) {
+		return pimpl::Moments_t{ }( DAW_FWD( r ) ).variance( );
+	};
+
+	/// The sum of the products of the current range and other, stopping at the
+	/// end of the shorter one.  An lvalue other is referenced and must outlive
+	/// the stage
+	template<Range Other>
+	[[nodiscard]] constexpr auto Dot( Other &&other ) {
+		return pimpl::Dot_t<Other>{ DAW_FWD( other ) };
+	}
+
 	[[nodiscard]] constexpr auto CountIf( auto &&fn ) {
 		return pimpl::CountIf_t{ DAW_FWD( fn ) };
 	};
@@ -8,6 +8,9 @@
 
 #pragma once
 
+#include "daw/daw_iterator_traits.h"
+#include "size_hint.h"
+
 #include <iterator>
 
 namespace daw::pipelines {
@@ -15,6 +18,19 @@ namespace daw::pipelines {
 	struct range_t {
 		First first;
 		Last last;
+		/// Set by views that know their size but whose iterators cannot compute
+		/// it, e.g. Take over a forward range
+		size_hint_t hint = size_hint_t{ };
+
+		[[nodiscard]] constexpr size_hint_t size_hint( ) const {
+			if constexpr( std::same_as<First, Last> and RandomIterator<First> ) {
+				if( not hint.is_known( ) ) {
+					return size_hint_t::exact(
+					  static_cast<std::size_t>( std::distance( first, last ) ) );
+				}
+			}
+			return hint;
+		}
 
 		[[nodiscard]] constexpr First begin( ) const {
 			return first;
@@ -26,4 +42,6 @@ namespace daw::pipelines {
 	};
 	template<typename I, typename L>
 	range_t( I, L ) -> range_t<I, L>;
+	template<typename I, typename L>
+	range_t( I, L, size_hint_t ) -> range_t<I, L>;
 } // namespace daw::pipelines
@@ -0,0 +1,109 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#pragma once
+
+#include "daw/daw_iterator_traits.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+
+namespace daw::pipelines {
+	enum class size_hint_kind { unknown, upper_bound, exact };
+
+	/// How many elements a range will produce, if it can be known without
+	/// iterating it.  Views that cannot compute their size in constant time
+	/// carry the hint of the range they were built from, e.g. a filter_view
+	/// has an upper bound of the size of its input.
+	struct size_hint_t {
+		std::size_t value = 0;
+		size_hint_kind kind = size_hint_kind::unknown;
+
+		[[nodiscard]] static constexpr size_hint_t exact( std::size_t n ) {
+			return size_hint_t{ n, size_hint_kind::exact };
+		}
+
+		[[nodiscard]] static constexpr size_hint_t upper_bound( std::size_t n ) {
+			return size_hint_t{ n, size_hint_kind::upper_bound };
+		}
+
+		[[nodiscard]] constexpr bool is_known( ) const {
+			return kind != size_hint_kind::unknown;
+		}
+
+		[[nodiscard]] constexpr bool is_exact( ) const {
+			return kind == size_hint_kind::exact;
+		}
+
+		/// The hint with exactness removed, for views that may produce fewer
+		/// elements than their input
+		[[nodiscard]] constexpr size_hint_t as_upper_bound( ) const {
+			if( kind == size_hint_kind::exact ) {
+				return upper_bound( value );
+			}
+			return *this;
+		}
+
+		/// At most n elements of this
+		[[nodiscard]] constexpr size_hint_t take( std::size_t n ) const {
+			if( not is_known( ) ) {
+				return upper_bound( n );
+			}
+			return size_hint_t{ ( std::min )( value, n ), kind };
+		}
+
+		/// This after skipping up to n elements
+		[[nodiscard]] constexpr size_hint_t skip( std::size_t n ) const {
+			return size_hint_t{ value > n ? value - n : 0, kind };
+		}
+
+		/// The hint of ranges iterated in lock step.  An unknown member makes the
+		/// result unknown, as its size may be anything
+		[[nodiscard]] friend constexpr size_hint_t
+		size_hint_min( size_hint_t const &lhs, size_hint_t const &rhs ) {
+			if( not lhs.is_known( ) or not rhs.is_known( ) ) {
+				return size_hint_t{ };
+			}
+			auto const kind = lhs.is_exact( ) and rhs.is_exact( )
+			                    ? size_hint_kind::exact
+			                    : size_hint_kind::upper_bound;
+			return size_hint_t{ ( std::min )( lhs.value, rhs.value ), kind };
+		}
+
+		/// The hint of ranges iterated one after the other
+		[[nodiscard]] friend constexpr size_hint_t
+		size_hint_sum( size_hint_t const &lhs, size_hint_t const &rhs ) {
+			if( not lhs.is_known( ) or not rhs.is_known( ) ) {
+				return size_hint_t{ };
+			}
+			auto const kind = lhs.is_exact( ) and rhs.is_exact( )
+			                    ? size_hint_kind::exact
+			                    : size_hint_kind::upper_bound;
+			return size_hint_t{ lhs.value + rhs.value, kind };
+		}
+	};
+
+	/// The size hint of r.  In order of preference this is r.size_hint( ), an
+	/// exact r.size( ), or the distance between random access iterators
+	template<typename R>
+	[[nodiscard]] constexpr size_hint_t range_size_hint( R const &r ) {
+		if constexpr( requires {
+			              { r.size_hint( ) } -> std::convertible_to<size_hint_t>;
+		              } ) {
+			return r.size_hint( );
+		} else if constexpr( requires { std::size( r ); } ) {
+			return size_hint_t::exact( static_cast<std::size_t>( std::size( r ) ) );
+		} else if constexpr( RandomIterator<iterator_t<R const &>> ) {
+			return size_hint_t::exact( static_cast<std::size_t>(
+			  std::distance( std::begin( r ), std::end( r ) ) ) );
+		} else {
+			return size_hint_t{ };
+		}
+	}
+} // namespace daw::pipelines
@@ -10,6 +10,7 @@
 
 #include "daw/daw_iterator_traits.h"
 #include "range.h"
+#include "size_hint.h"
 #include "sized_iterator.h"
 
 #include <algorithm>
@@ -31,16 +32,21 @@ namespace daw::pipelines::pimpl {
 				auto const skip =
 				  std::min( { static_cast<std::ptrdiff_t>( how_many ), range_size } );
 				first = std::next( first, skip );
+				return range_t{ first,
+				                last,
+				                size_hint_t::exact(
+				                  static_cast<std::size_t>( range_size - skip ) ) };
 			} else {
 				// Input
+				auto const hint = range_size_hint( r ).skip( how_many );
 				for( auto n = how_many; n > 0; --n ) {
 					if( first == last ) {
 						break;
 					}
 					++first;
 				}
+				return range_t{ first, last, hint };
 			}
-			return range_t{ first, last };
 		}
 	};
 } // namespace daw::pipelines::pimpl
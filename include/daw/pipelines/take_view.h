@@ -12,6 +12,7 @@
 #include "daw/daw_iterator_traits.h"
 #include "daw/daw_typeof.h"
 #include "range.h"
+#include "size_hint.h"
 #include "sized_iterator.h"
 #include "skip.h"
 
@@ -36,10 +37,13 @@ namespace daw::pipelines::pimpl {
 				  std::min( { range_size, static_cast<std::ptrdiff_t>( how_many ) } );
 				return range_t{ sized_iterator<iter_t>{
 				                  first, static_cast<std::size_t>( take_size ) },
-				                sized_iterator<iter_t>{ last, 0 } };
+				                sized_iterator<iter_t>{ last, 0 },
+				                size_hint_t::exact(
+				                  static_cast<std::size_t>( take_size ) ) };
 			} else {
 				return range_t{ sized_iterator<iter_t>{ first, how_many },
-				                sized_iterator<iter_t>{ last, 0 } };
+				                sized_iterator<iter_t>{ last, 0 },
+				                range_size_hint( r ).take( how_many ) };
 			}
 		}
 	};
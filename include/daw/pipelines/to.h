@@ -10,7 +10,10 @@
 
 #include "daw/daw_move.h"
 #include "range.h"
+#include "size_hint.h"
 
+#include <algorithm>
+#include <cstddef>
 #include <iterator>
 #include <type_traits>
 
@@ -22,6 +25,109 @@ namespace daw::pipelines::pimpl {
 	// used for other purposes
 	struct UseTypeDefault {};
 
+	template<typename Container>
+	concept AppendableContainer = requires( Container &c ) {
+		typename Container::value_type;
+		c.push_back( std::declval<typename Container::value_type>( ) );
+	};
+
+	template<typename Container>
+	concept ReservableContainer = requires( Container &c, std::size_t n ) {
+		c.reserve( n );
+		{ c.capacity( ) } -> std::convertible_to<std::size_t>;
+	};
+
+	template<typename Container>
+	struct append_overwrite_probe {
+		std::size_t operator( )( typename Container::pointer, std::size_t ) const;
+	};
+
+	/// Containers like daw::vector that can append into uninitialized storage
+	template<typename Container>
+	concept AppendAndOverwriteContainer =
+	  requires( Container &c, std::size_t n ) {
+		  c.append_and_overwrite( n, append_overwrite_probe<Container>{ } );
+	  };
+
+	/// Grow c so that n more elements fit.  Growth is at least geometric so
+	/// that repeated appends stay amortized constant time
+	template<ReservableContainer Container>
+	constexpr void reserve_for_append( Container &c, std::size_t n ) {
+		auto const needed = static_cast<std::size_t>( c.size( ) ) + n;
+		if constexpr( requires { c.max_size( ); } ) {
+			if( needed > static_cast<std::size_t>( c.max_size( ) ) ) {
+				return;
+			}
+		}
+		auto const cap = static_cast<std::size_t>( c.capacity( ) );
+		if( cap < needed ) {
+			c.reserve( ( std::max )( needed, cap * 2 ) );
+		}
+	}
+
+	/// Append the values of r to the end of c, using the size hint of r to
+	/// allocate once up front.  An upper bound hint may over allocate, but
+	/// never reallocates part way through.
+	/// @return The number of elements appended
+	template<AppendableContainer Container, Range R>
+	constexpr std::size_t append_range_to( Container &c, R &&r ) {
+		using value_t = typename Container::value_type;
+		auto const hint = range_size_hint( r );
+		auto const old_size = static_cast<std::size_t>( c.size( ) );
+		auto first = std::begin( r );
+		auto const last = std::end( r );
+		if constexpr( ReservableContainer<Container> ) {
+			if( hint.is_known( ) ) {
+				reserve_for_append( c, hint.value );
+				if constexpr( AppendAndOverwriteContainer<Container> and
+				              std::is_trivially_copyable_v<value_t> and
+				              std::is_trivially_default_constructible_v<value_t> ) {
+					if( c.capacity( ) >= c.size( ) + hint.value ) {
+						c.append_and_overwrite( hint.value,
+						                        [&]( auto p, std::size_t n ) {
+							                        std::size_t count = 0;
+							                        while( count < n and first != last ) {
+								                        p[count] =
+								                          static_cast<value_t>( *first );
+								                        ++count;
+								                        ++first;
+							                        }
+							                        return count;
+						                        } );
+					}
+				}
+			}
+		}
+		// Anything not covered by the hint
+		for( ; first != last; ++first ) {
+			c.push_back( static_cast<value_t>( *first ) );
+		}
+		return static_cast<std::size_t>( c.size( ) ) - old_size;
+	}
+
+	template<typename Container>
+	struct ToContainer {
+		template<Range R>
+		[[nodiscard]] DAW_ATTRIB_NOINLINE DAW_CPP23_STATIC_CALL_OP constexpr auto
+		operator( )( R &&r ) DAW_CPP23_STATIC_CALL_OP_CONST {
+			if constexpr( AppendableContainer<Container> and
+			              ReservableContainer<Container> and
+			              std::is_default_constructible_v<Container> ) {
+				auto result = Container( );
+				(void)append_range_to( result, DAW_FWD( r ) );
+				return result;
+			} else {
+				return Container( std::begin( DAW_FWD( r ) ),
+				                  std::end( DAW_FWD( r ) ) );
+			}
+		}
+
+		[[nodiscard]] DAW_ATTRIB_INLINE DAW_CPP23_STATIC_CALL_OP constexpr auto
+		operator( )( auto &&value ) DAW_CPP23_STATIC_CALL_OP_CONST {
+			return ToContainer<Container>( )( maybe_view{ value } );
+		}
+	};
+
 	template<template<typename...> typename Container>
 	struct ToTemplateTemplateContainer {
 		template<Range R>
@@ -31,7 +137,10 @@ namespace daw::pipelines::pimpl {
 			  requires( iterator_t<R> it ) { Container( it, it ); },
 			  "To requires the container to be constructible from an iterator "
 			  "pair" );
-			return Container( std::begin( DAW_FWD( r ) ), std::end( DAW_FWD( r ) ) );
+			using container_t =
+			  decltype( Container( std::declval<iterator_t<R>>( ),
+			                       std::declval<iterator_t<R>>( ) ) );
+			return ToContainer<container_t>{ }( DAW_FWD( r ) );
 		}
 
 		[[nodiscard]] DAW_ATTRIB_INLINE DAW_CPP23_STATIC_CALL_OP constexpr auto
@@ -40,17 +149,17 @@ namespace daw::pipelines::pimpl {
 		}
 	};
 
-	template<typename Container>
-	struct ToContainer {
+	template<AppendableContainer Container>
+	struct Into_t {
+		Container *m_container;
+
 		template<Range R>
-		[[nodiscard]] DAW_ATTRIB_NOINLINE DAW_CPP23_STATIC_CALL_OP constexpr auto
-		operator( )( R &&r ) DAW_CPP23_STATIC_CALL_OP_CONST {
-			return Container( std::begin( DAW_FWD( r ) ), std::end( DAW_FWD( r ) ) );
+		constexpr std::size_t operator( )( R &&r ) const {
+			return append_range_to( *m_container, DAW_FWD( r ) );
 		}
 
-		[[nodiscard]] DAW_ATTRIB_INLINE DAW_CPP23_STATIC_CALL_OP constexpr auto
-		operator( )( auto &&value ) DAW_CPP23_STATIC_CALL_OP_CONST {
-			return ToContainer<Container>( )( maybe_view{ value } );
+		constexpr std::size_t operator( )( auto &&value ) const {
+			return append_range_to( *m_container, maybe_view{ value } );
 		}
 	};
 
@@ -111,6 +220,14 @@ namespace daw::pipelines {
 		return pimpl::ToContainer<Container>{ };
 	}
 
+	/// Append a Range or single value to the end of an existing container,
+	/// reusing its capacity.  The container must outlive the stage.  The
+	/// result is the number of elements appended
+	template<pimpl::AppendableContainer Container>
+	[[nodiscard]] constexpr auto Into( Container &c ) {
+		return pimpl::Into_t<Container>{ &c };
+	}
+
 	/// Construct a std::array from a Range
 	/// TODO: add single value method
 	template<typename Array, auto Default = pimpl::UseTypeDefault{ }>
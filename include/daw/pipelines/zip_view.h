@@ -11,6 +11,7 @@
 #include "daw/daw_iterator_traits.h"
 #include "daw/daw_traits.h"
 #include "range.h"
+#include "size_hint.h"
 
 #include <cstddef>
 #include <tuple>
@@ -231,13 +232,33 @@ namespace daw::pipelines {
 
 		iterator m_first = iterator{ };
 		iterator m_last = iterator{ };
+		size_hint_t m_size_hint = size_hint_t{ };
 
+	private:
+		template<Range... Rs>
+		[[nodiscard]] static constexpr size_hint_t
+		zip_size_hint( Rs const &...rs ) {
+			size_hint_t const hints[] = { range_size_hint( rs )... };
+			auto result = hints[0];
+			for( auto const &h : hints ) {
+				result = size_hint_min( result, h );
+			}
+			return result;
+		}
+
+	public:
 		explicit zip_view( ) = default;
 
 		template<Range... Rs>
 		explicit constexpr zip_view( Rs &&...rs )
 		  : m_first( ( std::begin( DAW_FWD( rs ) ) )... )
-		  , m_last( ( std::end( DAW_FWD( rs ) ) )... ) {}
+		  , m_last( ( std::end( DAW_FWD( rs ) ) )... )
+		  , m_size_hint( zip_size_hint( rs... ) ) {}
+
+		/// Iteration stops at the end of the shortest range
+		[[nodiscard]] constexpr size_hint_t size_hint( ) const {
+			return m_size_hint;
+		}
 
 		[[nodiscard]] constexpr iterator begin( ) const {
 			return m_first;
@@ -0,0 +1,296 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include "daw/daw_arena_allocator.h"
+
+#include "daw/daw_benchmark.h"
+#include "daw/daw_do_not_optimize.h"
+#include "daw/daw_ensure.h"
+#include "daw/daw_ordered_map.h"
+#include "daw/daw_random.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace {
+	bool is_aligned( void const *ptr, std::size_t align ) {
+		return reinterpret_cast<std::uintptr_t>( ptr ) % align == 0;
+	}
+
+	void test_arena( ) {
+		auto arena = daw::memory::monotonic_arena( 256 );
+		auto *c = arena.allocate( 1, 1 );
+		auto *d = arena.allocate( sizeof( double ), alignof( double ) );
+		daw_ensure( c != nullptr and is_aligned( d, alignof( double ) ) );
+		auto *big = arena.allocate( 64, 64 );
+		daw_ensure( is_aligned( big, 64 ) );
+
+		// Larger than a block
+		auto *huge = static_cast<char *>( arena.allocate( 10'000, 1 ) );
+		huge[9'999] = 'a';
+
+		auto const marker = arena.mark( );
+		auto *after_mark = arena.allocate( 100, 8 );
+		(void)arena.allocate( 5'000, 8 );
+		arena.rewind( marker );
+		daw_ensure( arena.allocate( 100, 8 ) == after_mark );
+
+		auto const capacity = arena.capacity( );
+		for( int n = 0; n < 10; ++n ) {
+			arena.reset( );
+			daw_ensure( arena.allocate( 1, 1 ) == c );
+			(void)arena.allocate( 10'000, 1 );
+			(void)arena.allocate( 5'000, 8 );
+		}
+		// Blocks are reused after reset
+		daw_ensure( arena.capacity( ) == capacity );
+		arena.release( );
+		daw_ensure( arena.capacity( ) == 0 );
+	}
+
+	void test_pool( ) {
+		auto pool = daw::memory::pool_resource( );
+		auto *a = pool.allocate( 24, 8 );
+		auto *b = pool.allocate( 24, 8 );
+		daw_ensure( a != b );
+		pool.deallocate( a, 24, 8 );
+		// Same size class reuses the freed chunk
+		daw_ensure( pool.allocate( 32, 8 ) == a );
+		auto *large = pool.allocate( 1'000, 8 );
+		daw_ensure( large != nullptr );
+		pool.deallocate( large, 1'000, 8 );
+		pool.deallocate( b, 24, 8 );
+		pool.reset( );
+		daw_ensure( pool.allocate( 8, 8 ) != nullptr );
+
+		// Alignment larger than the size is honoured, for new and reused chunks
+		for( int n = 0; n < 4; ++n ) {
+			auto *p = pool.allocate( 8, 16 );
+			daw_ensure( reinterpret_cast<std::uintptr_t>( p ) % 16U == 0 );
+			(void)pool.allocate( 8, 8 );
+			pool.deallocate( p, 8, 16 );
+			daw_ensure( pool.allocate( 8, 16 ) == p );
+		}
+	}
+
+	void test_containers( ) {
+		auto arena = daw::memory::monotonic_arena( );
+		{
+			auto v = std::vector<int, daw::memory::arena_allocator<int>>( arena );
+			for( int n = 0; n < 1'000; ++n ) {
+				v.push_back( n );
+			}
+			daw_ensure( v.size( ) == 1'000 and v[999] == 999 );
+
+			using string_t =
+			  std::basic_string<char,
+			                    std::char_traits<char>,
+			                    daw::memory::arena_allocator<char>>;
+			auto s = string_t( "a string long enough to not fit in the sbo",
+			                   arena );
+			s += s;
+			daw_ensure( s.size( ) == 84 );
+
+			using pair_t = std::pair<int, int>;
+			auto m = daw::ordered_map<int,
+			                          int,
+			                          std::less<int>,
+			                          daw::memory::arena_allocator<pair_t>>(
+			  std::less<int>{ }, arena );
+			m[5] = 1;
+			m[2] = 3;
+			daw_ensure( m.size( ) == 2 and m[2] == 3 );
+		}
+		arena.reset( );
+
+		auto pool = daw::memory::pool_resource( );
+		{
+			auto l = std::list<int, daw::memory::pool_allocator<int>>( pool );
+			for( int n = 0; n < 100; ++n ) {
+				l.push_back( n );
+			}
+			l.remove_if( []( int n ) {
+				return n % 2 == 0;
+			} );
+			daw_ensure( l.size( ) == 50 and l.front( ) == 1 );
+
+			using alloc_t =
+			  daw::memory::pool_allocator<std::pair<int const, std::string>>;
+			auto m =
+			  std::unordered_map<int,
+			                     std::string,
+			                     std::hash<int>,
+			                     std::equal_to<int>,
+			                     alloc_t>( 16, std::hash<int>{ },
+			                               std::equal_to<int>{ }, alloc_t( pool ) );
+			for( int n = 0; n < 1'000; ++n ) {
+				m[n] = std::to_string( n );
+			}
+			for( int n = 0; n < 1'000; n += 2 ) {
+				m.erase( n );
+			}
+			daw_ensure( m.size( ) == 500 and m[999] == "999" );
+		}
+		auto const a = daw::memory::pool_allocator<int>( pool );
+		auto const b = daw::memory::pool_allocator<double>( a );
+		daw_ensure( a == b and b.resource( ) == &pool );
+	}
+
+	/// The same shape as graph_t's storage: nodes in a hash map, each with hash
+	/// sets of incoming and outgoing edges
+	template<typename Alloc>
+	struct graph_storage {
+		using edges_t =
+		  std::unordered_set<std::size_t,
+		                     std::hash<std::size_t>,
+		                     std::equal_to<std::size_t>,
+		                     typename std::allocator_traits<
+		                       Alloc>::template rebind_alloc<std::size_t>>;
+		struct node_t {
+			edges_t incoming;
+			edges_t outgoing;
+		};
+		using node_alloc_t = typename std::allocator_traits<
+		  Alloc>::template rebind_alloc<std::pair<std::size_t const, node_t>>;
+
+		Alloc alloc;
+		std::unordered_map<std::size_t,
+		                   node_t,
+		                   std::hash<std::size_t>,
+		                   std::equal_to<std::size_t>,
+		                   node_alloc_t>
+		  nodes;
+
+		explicit graph_storage( Alloc a )
+		  : alloc( a )
+		  , nodes( 16, std::hash<std::size_t>{ }, std::equal_to<std::size_t>{ },
+		           node_alloc_t( a ) ) {}
+
+		void add_node( std::size_t id ) {
+			nodes.emplace( id, node_t{ edges_t( alloc ), edges_t( alloc ) } );
+		}
+
+		void add_edge( std::size_t from, std::size_t to ) {
+			nodes.find( from )->second.outgoing.insert( to );
+			nodes.find( to )->second.incoming.insert( from );
+		}
+
+		std::size_t edge_count( ) const {
+			std::size_t result = 0;
+			for( auto const &node : nodes ) {
+				result += node.second.outgoing.size( );
+			}
+			return result;
+		}
+	};
+
+	template<typename Alloc>
+	std::size_t build_graph( Alloc alloc,
+	                         std::vector<std::size_t> const &edges ) {
+		auto g = graph_storage<Alloc>( alloc );
+		constexpr std::size_t node_count = 10'000;
+		for( std::size_t n = 0; n < node_count; ++n ) {
+			g.add_node( n );
+		}
+		for( std::size_t n = 0; n + 1 < edges.size( ); n += 2 ) {
+			g.add_edge( edges[n] % node_count, edges[n + 1] % node_count );
+		}
+		auto const result = g.edge_count( );
+		daw::do_not_optimize( result );
+		return result;
+	}
+
+	template<typename Alloc>
+	std::size_t churn_map( Alloc alloc, std::vector<std::size_t> const &keys ) {
+		auto m = std::unordered_map<std::size_t,
+		                            std::size_t,
+		                            std::hash<std::size_t>,
+		                            std::equal_to<std::size_t>,
+		                            Alloc>( 16, std::hash<std::size_t>{ },
+		                                    std::equal_to<std::size_t>{ }, alloc );
+		// Keep a sliding window of live keys
+		constexpr std::size_t window = 1'000;
+		for( std::size_t n = 0; n < keys.size( ); ++n ) {
+			m[keys[n]] = n;
+			if( n >= window ) {
+				m.erase( keys[n - window] );
+			}
+		}
+		auto const result = m.size( );
+		daw::do_not_optimize( result );
+		return result;
+	}
+
+	void bench( ) {
+		auto const edges = daw::make_random_data<std::size_t>( 100'000 );
+		using node_t = std::pair<std::size_t const, std::size_t>;
+		auto pool = daw::memory::pool_resource( 1U << 16U );
+		auto arena = daw::memory::monotonic_arena( 1U << 16U );
+
+		auto const g0 = daw::bench_n_test<5>(
+		  "graph build: std::allocator",
+		  []( auto const &e ) {
+			  return build_graph( std::allocator<node_t>( ), e );
+		  },
+		  edges );
+		auto const g1 = daw::bench_n_test<5>(
+		  "graph build: monotonic_arena",
+		  [&]( auto const &e ) {
+			  auto const result =
+			    build_graph( daw::memory::arena_allocator<node_t>( arena ), e );
+			  arena.reset( );
+			  return result;
+		  },
+		  edges );
+		auto const g2 = daw::bench_n_test<5>(
+		  "graph build: pool_resource",
+		  [&]( auto const &e ) {
+			  auto const result =
+			    build_graph( daw::memory::pool_allocator<node_t>( pool ), e );
+			  pool.reset( );
+			  return result;
+		  },
+		  edges );
+		daw_ensure( g0.get( ) == g1.get( ) and g0.get( ) == g2.get( ) );
+
+		auto const keys = daw::make_random_data<std::size_t>( 200'000, 0, 5'000 );
+		auto const m0 = daw::bench_n_test<5>(
+		  "hash map churn: std::allocator",
+		  []( auto const &k ) {
+			  return churn_map( std::allocator<node_t>( ), k );
+		  },
+		  keys );
+		auto const m1 = daw::bench_n_test<5>(
+		  "hash map churn: pool_resource",
+		  [&]( auto const &k ) {
+			  auto const result =
+			    churn_map( daw::memory::pool_allocator<node_t>( pool ), k );
+			  pool.reset( );
+			  return result;
+		  },
+		  keys );
+		daw_ensure( m0.get( ) == m1.get( ) );
+	}
+} // namespace
+
+int main( ) {
+	test_arena( );
+	test_pool( );
+	test_containers( );
+	bench( );
+	std::cout << "Done\n";
+}
@@ -0,0 +1,215 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include "daw/daw_ascii_case.h"
+
+#include "daw/daw_benchmark.h"
+#include "daw/daw_do_not_optimize.h"
+#include "daw/daw_ensure.h"
+#include "daw/daw_utility.h"
+
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+	char reference_lower( char c ) {
+		return ( c >= 'A' and c <= 'Z' ) ? static_cast<char>( c - 'A' + 'a' ) : c;
+	}
+
+	std::string reference_lower( std::string str ) {
+		for( auto &c : str ) {
+			c = reference_lower( c );
+		}
+		return str;
+	}
+
+	std::string reference_upper( std::string str ) {
+		for( auto &c : str ) {
+			if( c >= 'a' and c <= 'z' ) {
+				c = static_cast<char>( c - 'a' + 'A' );
+			}
+		}
+		return str;
+	}
+
+	int sign( int value ) {
+		return ( value > 0 ) - ( value < 0 );
+	}
+
+	/// Mostly letters, with some of every other byte value
+	std::string random_string( std::mt19937_64 &rng, std::size_t size ) {
+		auto result = std::string( );
+		for( std::size_t n = 0; n < size; ++n ) {
+			auto const r = rng( ) % 4U;
+			if( r == 0 ) {
+				result += static_cast<char>( rng( ) );
+			} else {
+				result += static_cast<char>( ( r == 1 ? 'A' : 'a' ) + rng( ) % 3U );
+			}
+		}
+		return result;
+	}
+
+	void test_chars( ) {
+		for( int n = 0; n < 256; ++n ) {
+			auto const c = static_cast<char>( n );
+			daw_ensure( daw::ascii::to_lower( c ) == reference_lower( c ) );
+			daw_ensure( daw::ascii::to_upper( c ) ==
+			            reference_upper( std::string( 1, c ) )[0] );
+		}
+		// Every byte value in every lane of the vector and word paths
+		auto all = std::string( );
+		for( int n = 0; n < 256 * 3; ++n ) {
+			all += static_cast<char>( n * 7 );
+		}
+		for( std::size_t offset = 0; offset < 40; ++offset ) {
+			auto const str = all.substr( offset );
+			daw_ensure( daw::ascii::to_lower_copy( str ) == reference_lower( str ) );
+			daw_ensure( daw::ascii::to_upper_copy( str ) == reference_upper( str ) );
+			auto in_place = str;
+			daw::ascii::to_lower( in_place );
+			daw_ensure( in_place == reference_lower( str ) );
+			daw_ensure( daw::AsciiUpper( str ) == reference_upper( str ) );
+			daw_ensure( daw::AsciiLower( str ) == reference_lower( str ) );
+		}
+	}
+
+	void test_random( ) {
+		auto rng = std::mt19937_64( 1234 );
+		for( int n = 0; n < 20'000; ++n ) {
+			auto const a = random_string( rng, rng( ) % 70U );
+			auto b = rng( ) % 2U == 0 ? random_string( rng, rng( ) % 70U ) : a;
+			if( not b.empty( ) and rng( ) % 2U == 0 ) {
+				// Same letters, different case
+				b = reference_upper( b );
+			}
+			auto const la = reference_lower( a );
+			auto const lb = reference_lower( b );
+			daw_ensure( daw::ascii::iequal( a, b ) == ( la == lb ) );
+			daw_ensure( sign( daw::ascii::icompare( a, b ) ) ==
+			            sign( la.compare( lb ) ) );
+			daw_ensure( daw::ascii::istarts_with( a, b ) ==
+			            ( la.rfind( lb, 0 ) == 0 ) );
+			daw_ensure( daw::ascii::iends_with( a, b ) ==
+			            ( la.size( ) >= lb.size( ) and
+			              la.compare( la.size( ) - lb.size( ), lb.size( ), lb ) ==
+			                0 ) );
+			daw_ensure( daw::ascii::ifnv1a_hash( a ) == daw::fnv1a_hash( la ) );
+
+			auto const needle = b.substr( 0, rng( ) % 4U );
+			auto const pos = static_cast<std::size_t>( rng( ) % 8U );
+			auto const expected = la.find( reference_lower( needle ), pos );
+			daw_ensure( daw::ascii::ifind( a, needle, pos ) ==
+			            ( expected == std::string::npos ? daw::ascii::npos
+			                                            : expected ) );
+		}
+	}
+
+	void test_containers( ) {
+		auto headers =
+		  std::unordered_map<std::string, int, daw::ascii::ihash,
+		                     daw::ascii::iequal_to>{ { "Content-Type", 1 },
+		                                             { "Content-Length", 2 } };
+		daw_ensure( headers.count( "content-type" ) == 1 );
+		daw_ensure( headers.at( "CONTENT-LENGTH" ) == 2 );
+		daw_ensure( headers.count( "content-encoding" ) == 0 );
+		daw_ensure( daw::ascii::iless{ }( "apple", "Banana" ) );
+	}
+
+	void benchmarks( ) {
+		auto rng = std::mt19937_64( 1 );
+		auto const text = random_string( rng, 16U * 1024U * 1024U );
+		auto out = std::string( text.size( ), '\0' );
+		std::cout << "Lower casing " << text.size( ) << " bytes\n";
+		(void)daw::bench_n_test_mbs<10>(
+		  "character at a time",
+		  text.size( ),
+		  [&]( std::string const &str ) {
+			  for( std::size_t n = 0; n < str.size( ); ++n ) {
+				  out[n] = reference_lower( str[n] );
+			  }
+			  daw::do_not_optimize( out );
+			  return out.size( );
+		  },
+		  text );
+		(void)daw::bench_n_test_mbs<10>(
+		  "daw::ascii::to_lower",
+		  text.size( ),
+		  [&]( std::string const &str ) {
+			  (void)daw::ascii::to_lower( str, out.data( ) );
+			  daw::do_not_optimize( out );
+			  return out.size( );
+		  },
+		  text );
+
+		// Header names as a proxy sees them
+		constexpr char const *names[] = {
+		  "Host",          "User-Agent",      "Accept",
+		  "Accept-Encoding", "Accept-Language", "Content-Type",
+		  "Content-Length", "Connection",      "Cache-Control",
+		  "X-Forwarded-For", "Authorization",  "If-None-Match" };
+		auto headers = std::vector<std::string>( );
+		std::size_t header_bytes = 0;
+		for( std::size_t n = 0; n < 100'000; ++n ) {
+			headers.emplace_back( names[rng( ) % std::size( names )] );
+			header_bytes += headers.back( ).size( );
+		}
+		std::cout << "Hashing " << headers.size( ) << " header names\n";
+		auto const lowered = daw::bench_n_test_mbs<10>(
+		  "lower case copy then daw::fnv1a_hash",
+		  header_bytes,
+		  []( std::vector<std::string> const &hs ) {
+			  std::size_t result = 0;
+			  for( auto const &h : hs ) {
+				  auto const copy = reference_lower( h );
+				  result += static_cast<std::size_t>( daw::fnv1a_hash( copy ) );
+			  }
+			  daw::do_not_optimize( result );
+			  return result;
+		  },
+		  headers );
+		auto const folded = daw::bench_n_test_mbs<10>(
+		  "daw::ascii::ifnv1a_hash",
+		  header_bytes,
+		  []( std::vector<std::string> const &hs ) {
+			  std::size_t result = 0;
+			  for( auto const &h : hs ) {
+				  result += static_cast<std::size_t>( daw::ascii::ifnv1a_hash( h ) );
+			  }
+			  daw::do_not_optimize( result );
+			  return result;
+		  },
+		  headers );
+		daw_ensure( lowered.get( ) == folded.get( ) );
+		(void)daw::bench_n_test_mbs<10>(
+		  "daw::ascii::iequal against \"content-length\"",
+		  header_bytes,
+		  []( std::vector<std::string> const &hs ) {
+			  std::size_t result = 0;
+			  for( auto const &h : hs ) {
+				  result += daw::ascii::iequal( h, "content-length" ) ? 1U : 0U;
+			  }
+			  daw::do_not_optimize( result );
+			  return result;
+		  },
+		  headers );
+	}
+} // namespace
+
+int main( ) {
+	test_chars( );
+	test_random( );
+	test_containers( );
+	benchmarks( );
+	std::cout << "Done\n";
+}
@@ -0,0 +1,258 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include "daw/daw_async_log.h"
+
+#include "daw/daw_ensure.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+	/// A temporary file that can be read back after logging to it
+	struct temp_file {
+		FILE *f = std::tmpfile( );
+
+		temp_file( ) {
+			daw_ensure( f != nullptr );
+		}
+
+		temp_file( temp_file const & ) = delete;
+		temp_file &operator=( temp_file const & ) = delete;
+
+		~temp_file( ) {
+			std::fclose( f );
+		}
+
+		[[nodiscard]] std::vector<std::string> lines( ) const {
+			std::fflush( f );
+			std::rewind( f );
+			auto result = std::vector<std::string>( );
+			auto current = std::string( );
+			int c = 0;
+			while( ( c = std::fgetc( f ) ) != EOF ) {
+				if( c == '\n' ) {
+					result.push_back( std::move( current ) );
+					current.clear( );
+				} else {
+					current += static_cast<char>( c );
+				}
+			}
+			daw_ensure( current.empty( ) );
+			return result;
+		}
+	};
+
+	/// Each thread logs numbered lines, alternating between deferred
+	/// formatting, caller formatting and pre-formatted messages
+	void log_lines( daw::async_logger &log, int thread_id, int count ) {
+		auto const tag = std::string( "t" ) + std::to_string( thread_id );
+		for( int n = 0; n < count; ++n ) {
+			switch( n % 3 ) {
+			case 0:
+				log.println( "{} {}", thread_id, n );
+				break;
+			case 1:
+				log.println( "{} {}", tag.substr( 1 ), n );
+				break;
+			default:
+				log.write( std::to_string( thread_id ) + ' ' + std::to_string( n ) +
+				           '\n' );
+				break;
+			}
+		}
+	}
+
+	/// Check that every thread's lines are present and in order.  When lines
+	/// may be dropped, only the order is checked
+	void check_lines( std::vector<std::string> const &lines,
+	                  int thread_count,
+	                  int count,
+	                  bool allow_missing ) {
+		auto next = std::vector<int>( static_cast<std::size_t>( thread_count ), 0 );
+		for( auto const &line : lines ) {
+			auto const space = line.find( ' ' );
+			daw_ensure( space != std::string::npos );
+			auto const thread_id = std::stoi( line.substr( 0, space ) );
+			auto const n = std::stoi( line.substr( space + 1 ) );
+			auto &expected = next[static_cast<std::size_t>( thread_id )];
+			if( allow_missing ) {
+				daw_ensure( n >= expected );
+			} else {
+				daw_ensure( n == expected );
+			}
+			expected = n + 1;
+		}
+		if( not allow_missing ) {
+			daw_ensure( lines.size( ) ==
+			            static_cast<std::size_t>( thread_count * count ) );
+		}
+	}
+
+	void run_threads( daw::async_logger &log, int thread_count, int count ) {
+		auto threads = std::vector<std::thread>( );
+		for( int t = 0; t < thread_count; ++t ) {
+			threads.emplace_back( [&log, t, count] {
+				log_lines( log, t, count );
+			} );
+		}
+		for( auto &th : threads ) {
+			th.join( );
+		}
+	}
+
+	void test_policy( daw::log_overflow_policy policy ) {
+		constexpr int thread_count = 4;
+		constexpr int count = 20'000;
+		auto tf = temp_file( );
+		std::size_t dropped = 0;
+		{
+			auto options = daw::async_logger_options{ };
+			// The smallest ring, so that the producers overflow it
+			options.ring_size = 1;
+			options.overflow = policy;
+			auto log = daw::async_logger( tf.f, options );
+			run_threads( log, thread_count, count );
+			dropped = log.dropped( );
+		}
+		auto const lines = tf.lines( );
+		auto const is_drop = policy == daw::log_overflow_policy::drop;
+		check_lines( lines, thread_count, count, is_drop );
+		daw_ensure( lines.size( ) + dropped ==
+		            static_cast<std::size_t>( thread_count * count ) );
+		if( not is_drop ) {
+			daw_ensure( dropped == 0 );
+		}
+	}
+
+	void test_flush( ) {
+		auto tf = temp_file( );
+		auto log = daw::async_logger( tf.f );
+		log.println( "{}", 42 );
+		log.print( "{}-", "a" );
+		log.println( "{}", 1.5 );
+		log.flush( );
+		auto const lines = tf.lines( );
+		daw_ensure( lines == std::vector<std::string>{ "42", "a-1.5" } );
+	}
+
+	void test_large_message( ) {
+		auto tf = temp_file( );
+		auto const big = std::string( 100'000, 'x' );
+		{
+			auto log = daw::async_logger( tf.f );
+			log.println( "{}", big );
+			log.println( "{}", 1 );
+		}
+		auto const lines = tf.lines( );
+		daw_ensure( lines == std::vector<std::string>{ big, "1" } );
+	}
+
+	void test_wrapping_message( daw::log_overflow_policy policy ) {
+		// A record of 0.6 of the ring that has to wrap from the middle of it
+		// needs more than the ring for itself and the padding
+		constexpr std::size_t ring_size = 4096;
+		auto tf = temp_file( );
+		auto const half = std::string( ring_size / 2, 'a' );
+		auto const big = std::string( ring_size * 6 / 10, 'b' );
+		std::size_t dropped = 0;
+		{
+			auto options = daw::async_logger_options{ };
+			options.ring_size = ring_size;
+			options.overflow = policy;
+			auto log = daw::async_logger( tf.f, options );
+			log.println( "{}", half );
+			log.flush( );
+			log.println( "{}", big );
+			dropped = log.dropped( );
+		}
+		daw_ensure( dropped == 0 );
+		auto const lines = tf.lines( );
+		daw_ensure( lines == std::vector<std::string>{ half, big } );
+	}
+
+	void test_thread_exit( ) {
+		// Rings of exited threads are drained before they are released
+		auto tf = temp_file( );
+		{
+			auto log = daw::async_logger( tf.f );
+			for( int n = 0; n < 10; ++n ) {
+				run_threads( log, 2, 100 );
+			}
+			log.flush( );
+			daw_ensure( tf.lines( ).size( ) == 2000 );
+		}
+	}
+
+	void bench_producers( ) {
+		constexpr int count = 20'000;
+		std::cout << "async_logger: producers, total msgs/s, p50 ns, p99 ns\n";
+		for( int thread_count = 1; thread_count <= 32; thread_count *= 2 ) {
+			auto tf = temp_file( );
+			auto latencies = std::vector<std::vector<std::chrono::nanoseconds>>(
+			  static_cast<std::size_t>( thread_count ) );
+			auto const start = std::chrono::steady_clock::now( );
+			{
+				auto log = daw::async_logger( tf.f );
+				auto threads = std::vector<std::thread>( );
+				for( int t = 0; t < thread_count; ++t ) {
+					threads.emplace_back( [&, t] {
+						auto &lat = latencies[static_cast<std::size_t>( t )];
+						lat.reserve( count );
+						for( int n = 0; n < count; ++n ) {
+							auto const t0 = std::chrono::steady_clock::now( );
+							log.println( "thread {} message {} value {}", t, n, n * 0.5 );
+							lat.push_back( std::chrono::steady_clock::now( ) - t0 );
+						}
+					} );
+				}
+				for( auto &th : threads ) {
+					th.join( );
+				}
+			}
+			auto const elapsed = std::chrono::duration<double>(
+			  std::chrono::steady_clock::now( ) - start );
+			auto all = std::vector<std::chrono::nanoseconds>( );
+			for( auto const &lat : latencies ) {
+				all.insert( all.end( ), lat.begin( ), lat.end( ) );
+			}
+			auto const p50 =
+			  all.begin( ) + static_cast<std::ptrdiff_t>( all.size( ) / 2 );
+			std::nth_element( all.begin( ), p50, all.end( ) );
+			auto const p50_ns = p50->count( );
+			auto const p99 =
+			  all.begin( ) + static_cast<std::ptrdiff_t>( all.size( ) * 99 / 100 );
+			std::nth_element( all.begin( ), p99, all.end( ) );
+			std::cout << thread_count << ", "
+			          << static_cast<double>( all.size( ) ) / elapsed.count( ) << ", "
+			          << p50_ns << ", " << p99->count( ) << '\n';
+			daw_ensure( tf.lines( ).size( ) == all.size( ) );
+		}
+	}
+} // namespace
+
+int main( ) {
+	test_flush( );
+	test_large_message( );
+	test_thread_exit( );
+	test_policy( daw::log_overflow_policy::block );
+	test_policy( daw::log_overflow_policy::grow );
+	test_policy( daw::log_overflow_policy::drop );
+	test_wrapping_message( daw::log_overflow_policy::block );
+	test_wrapping_message( daw::log_overflow_policy::grow );
+	test_wrapping_message( daw::log_overflow_policy::drop );
+	bench_producers( );
+	std::cout << "Done\n";
+}
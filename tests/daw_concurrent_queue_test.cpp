@@ -0,0 +1,343 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include "daw/daw_concurrent_queue.h"
+
+#include "daw/daw_benchmark.h"
+#include "daw/daw_ensure.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+	struct counted {
+		static inline int live = 0;
+		int value = 0;
+
+		counted( int v ) noexcept
+		  : value( v ) {
+			++live;
+		}
+		counted( counted const &other ) noexcept
+		  : value( other.value ) {
+			++live;
+		}
+		counted &operator=( counted const & ) = default;
+		~counted( ) {
+			--live;
+		}
+	};
+
+	/// Copying throws once copies_left reaches 0
+	struct throwing_copy {
+		static inline int live = 0;
+		static inline int copies_left = -1;
+		int value = 0;
+
+		throwing_copy( int v ) noexcept
+		  : value( v ) {
+			++live;
+		}
+		throwing_copy( throwing_copy const &other )
+		  : value( other.value ) {
+			if( copies_left == 0 ) {
+				throw std::runtime_error( "copy" );
+			}
+			--copies_left;
+			++live;
+		}
+		throwing_copy( throwing_copy &&other ) noexcept
+		  : value( other.value ) {
+			++live;
+		}
+		throwing_copy &operator=( throwing_copy const & ) = default;
+		throwing_copy &operator=( throwing_copy && ) = default;
+		~throwing_copy( ) {
+			--live;
+		}
+	};
+
+	template<template<typename> class Queue>
+	void test_single_thread( ) {
+		auto q = Queue<int>( 5 );
+		daw_ensure( q.capacity( ) == 8 and q.empty( ) );
+		for( int n = 0; n < 8; ++n ) {
+			daw_ensure( q.try_push( n ) );
+		}
+		daw_ensure( not q.try_push( 8 ) and q.size( ) == 8 );
+		int value = -1;
+		daw_ensure( q.try_pop( value ) and value == 0 );
+		daw_ensure( q.try_pop( ) == 1 );
+
+		// Wrap around the end
+		auto const more = std::array<int, 4>{ 8, 9, 10, 11 };
+		daw_ensure( q.try_push_n( more.begin( ), more.size( ) ) == 2 );
+		auto out = std::vector<int>( );
+		daw_ensure( q.try_pop_n( std::back_inserter( out ), 3 ) == 3 );
+		daw_ensure( ( out == std::vector<int>{ 2, 3, 4 } ) );
+		daw_ensure( q.try_push_n( more.begin( ) + 2, 2 ) == 2 );
+		out.clear( );
+		daw_ensure( q.try_pop_n( std::back_inserter( out ), 100 ) == 7 );
+		daw_ensure( ( out == std::vector<int>{ 5, 6, 7, 8, 9, 10, 11 } ) );
+		daw_ensure( not q.try_pop( ) and q.empty( ) );
+
+		q.push( 42 );
+		daw_ensure( q.pop( ) == 42 );
+	}
+
+	template<template<typename> class Queue>
+	void test_lifetimes( ) {
+		{
+			auto q = Queue<counted>( 4 );
+			daw_ensure( q.try_emplace( 1 ) and q.try_emplace( 2 ) );
+			daw_ensure( q.try_emplace( 3 ) );
+			auto out = counted( 0 );
+			daw_ensure( q.try_pop( out ) and out.value == 1 );
+			daw_ensure( counted::live == 3 );
+		}
+		// The destructor destroys what is left
+		daw_ensure( counted::live == 0 );
+
+		auto q = Queue<std::string>( 2 );
+		q.push( std::string( "a string that is too long for the sbo" ) );
+		daw_ensure( q.pop( ).size( ) == 37 );
+	}
+
+	/// A copy that throws part way through try_push_n leaks nothing and
+	/// leaves no claimed slot unpublished.  The spsc_queue publishes none of
+	/// the batch, the mpmc_queue the elements before the throw
+	template<template<typename> class Queue>
+	void test_throwing_push_n( std::size_t published ) {
+		{
+			auto const values =
+			  std::vector<throwing_copy>{ { 0 }, { 1 }, { 2 }, { 3 } };
+			auto q = Queue<throwing_copy>( 8 );
+			throwing_copy::copies_left = 2;
+			bool threw = false;
+			try {
+				(void)q.try_push_n( values.begin( ), values.size( ) );
+			} catch( std::runtime_error const & ) { threw = true; }
+			throwing_copy::copies_left = -1;
+			daw_ensure( threw );
+			daw_ensure( throwing_copy::live ==
+			            4 + static_cast<int>( q.size( ) ) );
+			auto out = std::vector<throwing_copy>( );
+			auto const popped = q.try_pop_n( std::back_inserter( out ), 8 );
+			daw_ensure( popped == published );
+			for( std::size_t n = 0; n < out.size( ); ++n ) {
+				daw_ensure( out[n].value == static_cast<int>( n ) );
+			}
+			// The queue still works
+			q.push( values[3] );
+			daw_ensure( q.pop( ).value == 3 and q.empty( ) );
+			daw_ensure( q.try_push_n( values.begin( ), values.size( ) ) == 4 );
+		}
+		daw_ensure( throwing_copy::live == 0 );
+	}
+
+	/// Every value from every producer arrives once, and in order for each
+	/// producer.  Producers alternate between blocking and batch pushes
+	template<template<typename> class Queue>
+	void test_threads( std::size_t producers, std::size_t consumers ) {
+		constexpr std::uint64_t per_producer = 20'000;
+		auto q = Queue<std::uint64_t>( 1024 );
+		auto threads = std::vector<std::thread>( );
+		for( std::size_t p = 0; p < producers; ++p ) {
+			threads.emplace_back( [&q, p] {
+				auto batch = std::array<std::uint64_t, 8>{ };
+				std::uint64_t n = 0;
+				while( n < per_producer ) {
+					if( n % 16U == 0 and n + batch.size( ) <= per_producer ) {
+						for( std::size_t b = 0; b < batch.size( ); ++b ) {
+							batch[b] = ( p << 32U ) | ( n + b );
+						}
+						n += q.try_push_n( batch.begin( ), batch.size( ) );
+					} else {
+						q.push( ( p << 32U ) | n );
+						++n;
+					}
+				}
+			} );
+		}
+		auto const total = per_producer * producers;
+		auto received = std::atomic<std::uint64_t>( 0 );
+		auto results = std::vector<std::vector<std::uint64_t>>( consumers );
+		for( std::size_t c = 0; c < consumers; ++c ) {
+			threads.emplace_back( [&, c] {
+				auto &result = results[c];
+				auto batch = std::array<std::uint64_t, 8>{ };
+				while( received.load( ) < total ) {
+					auto const count = q.try_pop_n( batch.begin( ), batch.size( ) );
+					if( count == 0 ) {
+						std::this_thread::yield( );
+						continue;
+					}
+					result.insert( result.end( ), batch.begin( ),
+					               std::next( batch.begin( ),
+					                          static_cast<std::ptrdiff_t>( count ) ) );
+					received += count;
+				}
+			} );
+		}
+		for( auto &t : threads ) {
+			t.join( );
+		}
+		daw_ensure( received.load( ) == total and q.empty( ) );
+		auto seen = std::vector<std::uint64_t>( producers, 0 );
+		for( auto const &result : results ) {
+			auto last = std::vector<std::uint64_t>( producers, 0 );
+			auto first = std::vector<bool>( producers, true );
+			for( auto v : result ) {
+				auto const p = v >> 32U;
+				auto const n = v & 0xFFFF'FFFFU;
+				daw_ensure( first[p] or n > last[p] );
+				first[p] = false;
+				last[p] = n;
+				++seen[p];
+			}
+		}
+		for( auto count : seen ) {
+			daw_ensure( count == per_producer );
+		}
+	}
+
+	/// Move count values from producers to consumers, with each thread
+	/// handling an equal share
+	template<typename Queue>
+	std::uint64_t transfer( Queue &q, std::size_t pairs, std::uint64_t count,
+	                        std::size_t batch ) {
+		auto threads = std::vector<std::thread>( );
+		auto sums = std::vector<std::uint64_t>( pairs * 8U );
+		auto const share = count / pairs;
+		for( std::size_t t = 0; t < pairs; ++t ) {
+			threads.emplace_back( [&q, share, batch] {
+				auto values = std::vector<std::uint64_t>( batch );
+				for( std::uint64_t n = 0; n < share; ) {
+					for( std::size_t b = 0; b < batch; ++b ) {
+						values[b] = n + b;
+					}
+					auto const pushed = q.try_push_n(
+					  values.begin( ), std::min<std::uint64_t>( batch, share - n ) );
+					if( pushed == 0 ) {
+						std::this_thread::yield( );
+					}
+					n += pushed;
+				}
+			} );
+			threads.emplace_back( [&q, &sums, t, share, batch] {
+				auto values = std::vector<std::uint64_t>( batch );
+				std::uint64_t sum = 0;
+				for( std::uint64_t n = 0; n < share; ) {
+					auto const popped = q.try_pop_n(
+					  values.begin( ), std::min<std::uint64_t>( batch, share - n ) );
+					if( popped == 0 ) {
+						std::this_thread::yield( );
+					}
+					for( std::size_t b = 0; b < popped; ++b ) {
+						sum += values[b];
+					}
+					n += popped;
+				}
+				// Spread out to avoid false sharing between consumers
+				sums[t * 8U] = sum;
+			} );
+		}
+		for( auto &t : threads ) {
+			t.join( );
+		}
+		std::uint64_t result = 0;
+		for( auto s : sums ) {
+			result += s;
+		}
+		return result;
+	}
+
+	void bench_throughput( ) {
+		constexpr std::uint64_t count = 2'000'000;
+		auto const max_pairs =
+		  std::max( 2U, std::thread::hardware_concurrency( ) / 2U );
+		auto const bytes = count * sizeof( std::uint64_t );
+		auto const checked_transfer = []( auto &q, std::size_t pairs,
+		                                  std::size_t batch ) {
+			auto const share = count / pairs;
+			auto const sum = transfer( q, pairs, count, batch );
+			daw_ensure( sum == pairs * ( share * ( share - 1U ) / 2U ) );
+			return sum;
+		};
+		for( std::size_t batch : { std::size_t{ 1 }, std::size_t{ 32 } } ) {
+			auto const b = std::to_string( batch );
+			auto spsc = daw::spsc_queue<std::uint64_t>( 4096 );
+			(void)daw::bench_n_test_mbs<3>(
+			  "spsc_queue: 1 producer, 1 consumer, batch " + b, bytes, [&] {
+				  return checked_transfer( spsc, 1, batch );
+			  } );
+			for( std::size_t pairs = 1; pairs <= max_pairs; pairs *= 2U ) {
+				auto mpmc = daw::mpmc_queue<std::uint64_t>( 4096 );
+				auto const p = std::to_string( pairs );
+				(void)daw::bench_n_test_mbs<3>(
+				  "mpmc_queue: " + p + " producers, " + p + " consumers, batch " + b,
+				  bytes, [&] {
+					  return checked_transfer( mpmc, pairs, batch );
+				  } );
+			}
+		}
+	}
+
+	/// Round trips between two threads through a pair of queues using the
+	/// blocking push/pop
+	template<template<typename> class Queue>
+	void bench_latency( std::string const &title ) {
+		constexpr int round_trips = 20'000;
+		auto ping = Queue<int>( 16 );
+		auto pong = Queue<int>( 16 );
+		auto echo = std::thread( [&] {
+			for( int n = 0; n < round_trips; ++n ) {
+				pong.push( ping.pop( ) );
+			}
+		} );
+		auto const start = std::chrono::steady_clock::now( );
+		for( int n = 0; n < round_trips; ++n ) {
+			ping.push( n );
+			daw_ensure( pong.pop( ) == n );
+		}
+		auto const elapsed = std::chrono::steady_clock::now( ) - start;
+		echo.join( );
+		std::cout << title << " round trip: "
+		          << std::chrono::duration_cast<std::chrono::nanoseconds>( elapsed )
+		                 .count( ) /
+		               round_trips
+		          << "ns\n";
+	}
+} // namespace
+
+int main( ) {
+	test_single_thread<daw::spsc_queue>( );
+	test_single_thread<daw::mpmc_queue>( );
+	test_lifetimes<daw::spsc_queue>( );
+	test_lifetimes<daw::mpmc_queue>( );
+	test_throwing_push_n<daw::spsc_queue>( 0 );
+	test_throwing_push_n<daw::mpmc_queue>( 2 );
+	test_threads<daw::spsc_queue>( 1, 1 );
+	test_threads<daw::mpmc_queue>( 1, 1 );
+	test_threads<daw::mpmc_queue>( 4, 4 );
+	test_threads<daw::mpmc_queue>( 3, 1 );
+	bench_throughput( );
+	bench_latency<daw::spsc_queue>( "spsc_queue" );
+	bench_latency<daw::mpmc_queue>( "mpmc_queue" );
+	std::cout << "Done\n";
+}
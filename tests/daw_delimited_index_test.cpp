@@ -0,0 +1,237 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include "daw/daw_delimited_index.h"
+
+#include "daw/daw_benchmark.h"
+#include "daw/daw_do_not_optimize.h"
+#include "daw/daw_ensure.h"
+
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+	using fields_t = std::vector<std::vector<std::string>>;
+
+	/// A character at a time RFC 4180 splitter.  Fields keep their quotes
+	fields_t reference_split( std::string const &data ) {
+		auto result = fields_t( );
+		auto record = std::vector<std::string>( );
+		auto field = std::string( );
+		bool in_quote = false;
+		for( char c : data ) {
+			if( c == '"' ) {
+				in_quote = not in_quote;
+			}
+			if( in_quote or ( c != ',' and c != '\n' ) ) {
+				field += c;
+				continue;
+			}
+			if( c == '\n' and not field.empty( ) and field.back( ) == '\r' ) {
+				field.pop_back( );
+			}
+			record.push_back( std::move( field ) );
+			field.clear( );
+			if( c == '\n' ) {
+				result.push_back( std::move( record ) );
+				record.clear( );
+			}
+		}
+		if( not data.empty( ) and data.back( ) != '\n' ) {
+			if( not field.empty( ) and field.back( ) == '\r' ) {
+				field.pop_back( );
+			}
+			record.push_back( std::move( field ) );
+			result.push_back( std::move( record ) );
+		}
+		return result;
+	}
+
+	fields_t index_split( std::string const &data ) {
+		auto result = fields_t( );
+		for( auto const &rec : daw::parser::delimited_index( data ) ) {
+			auto &fields = result.emplace_back( );
+			for( std::size_t n = 0; n < rec.size( ); ++n ) {
+				fields.emplace_back( rec[n].data( ), rec[n].size( ) );
+			}
+		}
+		return result;
+	}
+
+	std::string random_field( std::mt19937_64 &rng ) {
+		auto result = std::string( );
+		auto const length = rng( ) % 12U;
+		bool const quoted = rng( ) % 3U == 0;
+		if( quoted ) {
+			result += '"';
+		}
+		for( std::size_t n = 0; n < length; ++n ) {
+			auto const r = rng( ) % 20U;
+			if( quoted and r == 0 ) {
+				result += "\"\"";
+			} else if( quoted and r == 1 ) {
+				result += ',';
+			} else if( quoted and r == 2 ) {
+				result += '\n';
+			} else {
+				result += static_cast<char>( 'a' + r );
+			}
+		}
+		if( quoted ) {
+			result += '"';
+		}
+		return result;
+	}
+
+	std::string random_csv( std::mt19937_64 &rng, std::size_t records ) {
+		auto result = std::string( );
+		for( std::size_t r = 0; r < records; ++r ) {
+			auto const fields = 1U + rng( ) % 6U;
+			for( std::size_t f = 0; f < fields; ++f ) {
+				if( f > 0 ) {
+					result += ',';
+				}
+				result += random_field( rng );
+			}
+			result += rng( ) % 4U == 0 ? "\r\n" : "\n";
+		}
+		return result;
+	}
+
+	void test_random( ) {
+		auto rng = std::mt19937_64( 1234 );
+		for( int n = 0; n < 3'000; ++n ) {
+			auto csv = random_csv( rng, rng( ) % 20U );
+			if( rng( ) % 2U == 0 and not csv.empty( ) ) {
+				// No line ending after the last record
+				csv.pop_back( );
+			}
+			daw_ensure( index_split( csv ) == reference_split( csv ) );
+		}
+	}
+
+	void test_parse( ) {
+		auto const csv = std::string(
+		  "id,price,name\r\n"
+		  "1,2.5,\"widget, large\"\r\n"
+		  "42,-7.25,\"say \"\"hi\"\"\"\r\n"
+		  "3,0,plain" );
+		auto const index = daw::parser::delimited_index( csv );
+		auto it = index.begin( );
+		daw_ensure( ( *it ).line( ) == "id,price,name" );
+		++it;
+		auto const [id, price, name] =
+		  ( *it ).parse<int, double, daw::string_view>( );
+		daw_ensure( id == 1 and price == 2.5 and name == "widget, large" );
+		++it;
+		daw_ensure( std::get<0>( ( *it ).parse<int, double>( ) ) == 42 );
+		daw_ensure( daw::parser::unquote_field( ( *it )[2] ) ==
+		            "say \"\"hi\"\"" );
+		++it;
+		auto const last =
+		  ( *it )
+		    .parse<unsigned, int, daw::parser::converters::unquoted_string>( );
+		daw_ensure( std::get<2>( last ) == "plain" );
+		daw_ensure( ++it == index.end( ) );
+
+		// Other delimiters, and a quote that is never closed
+		auto const tsv = daw::parser::delimited_index( "a\tb\n", '\t' );
+		daw_ensure( ( *tsv.begin( ) ).size( ) == 2 );
+		bool threw = false;
+		try {
+			(void)daw::parser::delimited_index( "a,\"b\nc" );
+		} catch( daw::parser::invalid_input_exception const & ) { threw = true; }
+		daw_ensure( threw );
+	}
+
+	void benchmarks( ) {
+		auto rng = std::mt19937_64( 1 );
+		auto csv = std::string( );
+		while( csv.size( ) < 16U * 1024U * 1024U ) {
+			csv += std::to_string( rng( ) % 1'000'000U );
+			csv += ',';
+			csv += std::to_string( static_cast<double>( rng( ) % 100'000U ) / 100.0 );
+			csv += ",\"";
+			csv += random_field( rng );
+			csv += "\",";
+			csv += random_field( rng );
+			csv += '\n';
+		}
+		std::cout << "Indexing " << csv.size( ) << " bytes of CSV\n";
+		auto const field_bytes = [&] {
+			std::size_t result = 0;
+			for( auto const &rec : reference_split( csv ) ) {
+				for( auto const &field : rec ) {
+					result += field.size( );
+				}
+			}
+			return result;
+		}( );
+		// The find based loop does not understand quotes, so it sees more
+		(void)daw::bench_n_test_mbs<5>(
+		  "string_view::find per field, no quote handling",
+		  csv.size( ),
+		  []( daw::string_view str ) {
+			  std::size_t result = 0;
+			  while( not str.empty( ) ) {
+				  auto line = str.pop_front_until( '\n' );
+				  while( not line.empty( ) ) {
+					  result += line.pop_front_until( ',' ).size( );
+				  }
+			  }
+			  daw::do_not_optimize( result );
+			  return result;
+		  },
+		  daw::string_view( csv ) );
+		(void)daw::bench_n_test_mbs<5>(
+		  "delimited_index build",
+		  csv.size( ),
+		  []( daw::string_view str ) {
+			  auto const index = daw::parser::delimited_index( str );
+			  daw::do_not_optimize( index );
+			  return index.structurals( ).size( );
+		  },
+		  daw::string_view( csv ) );
+		auto reused = daw::parser::delimited_index( csv );
+		(void)daw::bench_n_test_mbs<5>(
+		  "delimited_index::assign, reusing storage",
+		  csv.size( ),
+		  [&]( daw::string_view str ) {
+			  reused.assign( str );
+			  daw::do_not_optimize( reused );
+			  return reused.structurals( ).size( );
+		  },
+		  daw::string_view( csv ) );
+		auto const count = daw::bench_n_test_mbs<5>(
+		  "delimited_index build and visit every field",
+		  csv.size( ),
+		  []( daw::string_view str ) {
+			  std::size_t result = 0;
+			  for( auto const &rec : daw::parser::delimited_index( str ) ) {
+				  for( std::size_t n = 0; n < rec.size( ); ++n ) {
+					  result += rec[n].size( );
+				  }
+			  }
+			  daw::do_not_optimize( result );
+			  return result;
+		  },
+		  daw::string_view( csv ) );
+		daw_ensure( count.get( ) == field_bytes );
+	}
+} // namespace
+
+int main( ) {
+	test_random( );
+	test_parse( );
+	benchmarks( );
+	std::cout << "Done\n";
+}
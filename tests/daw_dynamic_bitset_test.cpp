@@ -0,0 +1,212 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include "daw/daw_dynamic_bitset.h"
+
+#include "daw/daw_benchmark.h"
+#include "daw/daw_do_not_optimize.h"
+#include "daw/daw_ensure.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+	/// A random bitset paired with the same bits as a vector<bool> to check
+	/// against
+	struct reference_bits {
+		daw::dynamic_bitset bits;
+		std::vector<bool> expected;
+
+		reference_bits( std::size_t size, std::mt19937_64 &rng, unsigned density )
+		  : bits( size )
+		  , expected( size ) {
+			for( std::size_t n = 0; n < size; ++n ) {
+				if( rng( ) % 100U < density ) {
+					bits.set_bit( n );
+					expected[n] = true;
+				}
+			}
+		}
+	};
+
+	void test_basic( ) {
+		auto b = daw::dynamic_bitset( 130 );
+		daw_ensure( b.size( ) == 130 and b.word_count( ) == 3 );
+		daw_ensure( b.none( ) and b.find_first( ) == daw::dynamic_bitset::npos );
+		b.set_bit( 129 );
+		b.set_bit( 0 );
+		daw_ensure( b.find_first( ) == 0 and b.find_next( 1 ) == 129 );
+		daw_ensure( not b.test_and_set( 64 ) and b.test_and_set( 64 ) );
+		b.flip_bit( 0 );
+		daw_ensure( b.one_count( ) == 2 and b.zero_count( ) == 128 );
+		b.flip( );
+		daw_ensure( b.one_count( ) == 128 and not b.get_bit( 129 ) );
+		b.set_all( );
+		daw_ensure( b.all( ) and b.one_count( ) == 130 );
+
+		auto c = daw::dynamic_bitset( 3, true );
+		c.push_back( false );
+		c.push_back( true );
+		daw_ensure( c.to_string( ) == "10111" );
+		c.resize( 70, true );
+		daw_ensure( c.one_count( ) == 69 and not c.get_bit( 3 ) );
+		c.resize( 4 );
+		daw_ensure( c.to_string( ) == "0111" );
+
+		auto d = daw::dynamic_bitset( 200 );
+		d.set_bit( 5 );
+		d <<= 150;
+		daw_ensure( d.find_first( ) == 155 );
+		d >>= 100;
+		daw_ensure( d.find_first( ) == 55 and d.one_count( ) == 1 );
+		d <<= 200;
+		daw_ensure( d.none( ) );
+	}
+
+	void test_scan_rank_select( std::mt19937_64 &rng ) {
+		for( unsigned density : { 0U, 1U, 50U, 99U, 100U } ) {
+			auto const r = reference_bits( 5'000, rng, density );
+			auto const index = daw::bitset_rank_index( r.bits );
+			auto positions = std::vector<std::size_t>( );
+			r.bits.for_each_set_bit( [&]( std::size_t pos ) {
+				positions.push_back( pos );
+			} );
+			auto from_find = std::vector<std::size_t>( );
+			for( auto pos = r.bits.find_first( ); pos != daw::dynamic_bitset::npos;
+			     pos = r.bits.find_next( pos + 1 ) ) {
+				from_find.push_back( pos );
+			}
+			daw_ensure( positions == from_find );
+			daw_ensure( positions.size( ) == r.bits.one_count( ) );
+			daw_ensure( index.ones( ) == positions.size( ) );
+
+			std::size_t count = 0;
+			for( std::size_t n = 0; n < r.expected.size( ); ++n ) {
+				daw_ensure( r.bits.get_bit( n ) == r.expected[n] );
+				daw_ensure( r.bits.rank( n ) == count );
+				daw_ensure( index.rank( n ) == count );
+				if( r.expected[n] ) {
+					daw_ensure( positions[count] == n );
+					daw_ensure( r.bits.select( count ) == n );
+					daw_ensure( index.select( count ) == n );
+					++count;
+				}
+			}
+			daw_ensure( r.bits.select( count ) == daw::dynamic_bitset::npos );
+			daw_ensure( index.select( count ) == daw::bitset_rank_index::npos );
+		}
+	}
+
+	void test_bulk_ops( std::mt19937_64 &rng ) {
+		auto const a = reference_bits( 1'000, rng, 30 );
+		auto const b = reference_bits( 1'000, rng, 60 );
+		auto and_bits = a.bits;
+		auto const and_count = and_bits.and_assign_count( b.bits );
+		auto or_bits = a.bits;
+		auto const or_count = or_bits.or_assign_count( b.bits );
+		auto and_not_bits = a.bits;
+		and_not_bits.and_not( b.bits );
+		auto const xor_bits = a.bits ^ b.bits;
+		daw_ensure( and_bits == ( a.bits & b.bits ) );
+		daw_ensure( or_bits == ( a.bits | b.bits ) );
+		daw_ensure( a.bits.count_and( b.bits ) == and_count );
+		daw_ensure( and_bits.one_count( ) == and_count );
+		daw_ensure( or_bits.one_count( ) == or_count );
+		for( std::size_t n = 0; n < 1'000; ++n ) {
+			auto const x = a.expected[n];
+			auto const y = b.expected[n];
+			daw_ensure( and_bits.get_bit( n ) == ( x and y ) );
+			daw_ensure( or_bits.get_bit( n ) == ( x or y ) );
+			daw_ensure( xor_bits.get_bit( n ) == ( x != y ) );
+			daw_ensure( and_not_bits.get_bit( n ) == ( x and not y ) );
+		}
+		daw_ensure( ( ~a.bits ).one_count( ) == 1'000 - a.bits.one_count( ) );
+	}
+
+	void bench_bulk_ops( std::mt19937_64 &rng ) {
+		// A filter mask over 16M rows
+		constexpr std::size_t size = 1U << 24U;
+		auto const a = reference_bits( size, rng, 50 );
+		auto const b = reference_bits( size, rng, 50 );
+		auto const bools_a = a.expected;
+		auto const bools_b = b.expected;
+		std::cout << "dynamic_bitset: " << size << " bits\n";
+
+		auto const bool_result = daw::bench_n_test<5>(
+		  "vector<bool>: and + count",
+		  []( auto lhs, auto const &rhs ) {
+			  std::size_t count = 0;
+			  for( std::size_t n = 0; n < lhs.size( ); ++n ) {
+				  lhs[n] = lhs[n] and rhs[n];
+				  count += lhs[n] ? 1U : 0U;
+			  }
+			  daw::do_not_optimize( lhs, count );
+			  return count;
+		  },
+		  bools_a,
+		  bools_b );
+		auto const result = daw::bench_n_test<5>(
+		  "dynamic_bitset: and + count",
+		  []( auto lhs, auto const &rhs ) {
+			  auto const count = lhs.and_assign_count( rhs );
+			  daw::do_not_optimize( lhs, count );
+			  return count;
+		  },
+		  a.bits,
+		  b.bits );
+		auto const count_result = daw::bench_n_test<5>(
+		  "dynamic_bitset: count_and",
+		  []( auto const &lhs, auto const &rhs ) {
+			  auto const count = lhs.count_and( rhs );
+			  daw::do_not_optimize( count );
+			  return count;
+		  },
+		  a.bits,
+		  b.bits );
+		daw_ensure( bool_result.get( ) == result.get( ) );
+		daw_ensure( count_result.get( ) == result.get( ) );
+
+		auto const bool_scan = daw::bench_n_test<5>(
+		  "vector<bool>: visit set bits",
+		  []( auto const &bits ) {
+			  std::size_t sum = 0;
+			  for( std::size_t n = 0; n < bits.size( ); ++n ) {
+				  if( bits[n] ) {
+					  sum += n;
+				  }
+			  }
+			  daw::do_not_optimize( sum );
+			  return sum;
+		  },
+		  bools_a );
+		auto const scan = daw::bench_n_test<5>(
+		  "dynamic_bitset: for_each_set_bit",
+		  []( auto const &bits ) {
+			  std::size_t sum = 0;
+			  bits.for_each_set_bit( [&]( std::size_t pos ) {
+				  sum += pos;
+			  } );
+			  daw::do_not_optimize( sum );
+			  return sum;
+		  },
+		  a.bits );
+		daw_ensure( bool_scan.get( ) == scan.get( ) );
+	}
+} // namespace
+
+int main( ) {
+	auto rng = std::mt19937_64( 0x1234'5678U );
+	test_basic( );
+	test_scan_rank_select( rng );
+	test_bulk_ops( rng );
+	bench_bulk_ops( rng );
+	std::cout << "Done\n";
+}
@@ -9,8 +9,16 @@
 #include "daw/daw_endian.h"
 
 #include "daw/daw_benchmark.h"
+#include "daw/daw_do_not_optimize.h"
+#include "daw/daw_ensure.h"
+#include "daw/daw_span.h"
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
 
 constexpr bool to_host_order_001( ) {
 	if( daw::endian::native == daw::endian::little ) {
@@ -23,4 +31,119 @@ constexpr bool to_host_order_001( ) {
 }
 static_assert( to_host_order_001( ) );
 
-int main( ) {}
+namespace {
+	template<typename T>
+	T reference_swap( T value ) {
+		T result = 0;
+		for( std::size_t n = 0; n < sizeof( T ); ++n ) {
+			result = static_cast<T>( ( result << 8U ) | ( value & 0xFFU ) );
+			value = static_cast<T>( value >> 8U );
+		}
+		return result;
+	}
+
+	/// Every length up to a few vectors and every misalignment of src and dst
+	template<typename T>
+	void test_copy_swap_bytes( ) {
+		auto src_buff = std::vector<T>( 300 );
+		auto dst_buff = std::vector<T>( 300 );
+		for( std::size_t n = 0; n < src_buff.size( ); ++n ) {
+			src_buff[n] = static_cast<T>( 0x0102'0304'0506'0708ULL * ( n + 1 ) );
+		}
+		for( std::size_t src_off = 0; src_off < 4; ++src_off ) {
+			for( std::size_t dst_off = 0; dst_off < 4; ++dst_off ) {
+				for( std::size_t count = 0; count < 290; ++count ) {
+					std::fill( dst_buff.begin( ), dst_buff.end( ), T{ 0 } );
+					T const *src = src_buff.data( ) + src_off;
+					T *dst = dst_buff.data( ) + dst_off;
+					daw_ensure( daw::copy_swap_bytes( src, count, dst ) == dst + count );
+					for( std::size_t n = 0; n < count; ++n ) {
+						daw_ensure( dst[n] == reference_swap( src[n] ) );
+					}
+					// Nothing past the end is written
+					daw_ensure( dst_off + count == dst_buff.size( ) or
+					            dst[count] == T{ 0 } );
+				}
+			}
+		}
+		// In place, swapping twice is the identity
+		auto values = src_buff;
+		daw::swap_bytes( values.data( ) + 1, values.size( ) - 1 );
+		daw_ensure( values[0] == src_buff[0] );
+		daw_ensure( values[1] == reference_swap( src_buff[1] ) );
+		daw::swap_bytes( values.data( ) + 1, values.size( ) - 1 );
+		daw_ensure( values == src_buff );
+	}
+
+	void test_ranges( ) {
+		auto values = std::vector<std::uint32_t>{ 0x0102'0304U, 0xA0B0'C0D0U };
+		daw::convert_endian<daw::endian::native>( values );
+		daw_ensure( values[0] == 0x0102'0304U );
+		daw::convert_endian<daw::endian::big, daw::endian::little>(
+		  daw::span<std::uint32_t>( values.data( ), values.size( ) ) );
+		daw_ensure( values[0] == 0x0403'0201U and values[1] == 0xD0C0'B0A0U );
+
+		auto out = std::array<std::uint32_t, 3>{ };
+		daw::copy_swap_bytes( values, out );
+		daw_ensure( out[0] == 0x0102'0304U and out[2] == 0 );
+		bool threw = false;
+		try {
+			auto small = std::array<std::uint32_t, 1>{ };
+			daw::copy_swap_bytes( values, small );
+		} catch( std::out_of_range const & ) { threw = true; }
+		daw_ensure( threw );
+	}
+
+	template<typename T>
+	void bench( std::string const &title ) {
+		constexpr std::size_t count = ( 16U * 1024U * 1024U ) / sizeof( T );
+		auto src = std::vector<T>( count );
+		for( std::size_t n = 0; n < count; ++n ) {
+			src[n] = static_cast<T>( n * 0x9E37'79B9'7F4A'7C15ULL );
+		}
+		auto dst = std::vector<T>( count );
+		auto const bytes = count * sizeof( T );
+		std::cout << "Swapping 16MB of " << title << '\n';
+		(void)daw::bench_n_test_mbs<20>(
+		  "scalar loop",
+		  bytes,
+		  [&]( auto const &s ) {
+			  for( std::size_t n = 0; n < s.size( ); ++n ) {
+				  dst[n] = daw::to_big_endian( s[n] );
+			  }
+			  daw::do_not_optimize( dst );
+		  },
+		  src );
+		(void)daw::bench_n_test_mbs<20>(
+		  "daw::copy_swap_bytes",
+		  bytes,
+		  [&]( auto const &s ) {
+			  daw::copy_swap_bytes( s, dst );
+			  daw::do_not_optimize( dst );
+		  },
+		  src );
+		(void)daw::bench_n_test_mbs<20>(
+		  "daw::swap_bytes in place",
+		  bytes,
+		  [&]( auto const & ) {
+			  daw::swap_bytes( dst.data( ), dst.size( ) );
+			  daw::do_not_optimize( dst );
+		  },
+		  src );
+	}
+} // namespace
+
+int main( ) {
+	test_copy_swap_bytes<std::uint8_t>( );
+	test_copy_swap_bytes<std::uint16_t>( );
+	test_copy_swap_bytes<std::int16_t>( );
+	test_copy_swap_bytes<std::uint32_t>( );
+	test_copy_swap_bytes<std::int32_t>( );
+	test_copy_swap_bytes<std::uint64_t>( );
+	test_copy_swap_bytes<std::int64_t>( );
+	test_ranges( );
+	bench<std::uint16_t>( "uint16_t" );
+	bench<std::uint32_t>( "uint32_t" );
+	bench<std::uint64_t>( "uint64_t" );
+	std::cout << "Done\n";
+}
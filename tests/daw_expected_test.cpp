@@ -9,14 +9,19 @@
 #include "daw/daw_expected.h"
 
 #include "daw/daw_benchmark.h"
+#include "daw/daw_do_not_optimize.h"
 #include "daw/daw_traits.h"
 
 #include <cstddef>
 #include <exception>
 #include <iostream>
+#include <memory>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 daw::expected_t<int> divide( int v ) {
 	try {
@@ -231,6 +236,216 @@ void daw_expected_test_move_construction_002( ) {
 	} );
 }
 
+enum class parse_errc { empty, invalid_digit, overflow };
+
+static_assert( std::is_trivially_copyable_v<daw::expected<int, parse_errc>> );
+static_assert( std::is_trivially_copyable_v<daw::expected<void, parse_errc>> );
+static_assert( sizeof( daw::expected<int, parse_errc> ) == 2 * sizeof( int ) );
+static_assert(
+  not std::is_trivially_copyable_v<daw::expected<std::string, parse_errc>> );
+static_assert(
+  not std::is_copy_constructible_v<daw::expected<std::unique_ptr<int>, int>> );
+static_assert(
+  std::is_move_constructible_v<daw::expected<std::unique_ptr<int>, int>> );
+
+constexpr daw::expected<int, parse_errc> parse_digits( std::string_view sv ) {
+	if( sv.empty( ) ) {
+		return daw::unexpected( parse_errc::empty );
+	}
+	int result = 0;
+	for( char c : sv ) {
+		if( c < '0' or c > '9' ) {
+			return daw::unexpected( parse_errc::invalid_digit );
+		}
+		if( result > 100'000'000 ) {
+			return daw::unexpected( parse_errc::overflow );
+		}
+		result = result * 10 + ( c - '0' );
+	}
+	return result;
+}
+
+static_assert( parse_digits( "1234" ).value( ) == 1234 );
+static_assert( parse_digits( "12a4" ).error( ) == parse_errc::invalid_digit );
+static_assert( parse_digits( "21" )
+                 .and_then( []( int x ) -> daw::expected<int, parse_errc> {
+	                 return x * 2;
+                 } )
+                 .transform( []( int x ) {
+	                 return x + 0.5;
+                 } )
+                 .value( ) == 42.5 );
+static_assert( parse_digits( "" )
+                 .or_else( []( parse_errc ) -> daw::expected<int, parse_errc> {
+	                 return 0;
+                 } )
+                 .value( ) == 0 );
+
+void daw_expected_typed_error_001( ) {
+	auto a = daw::expected<std::string, std::string>( "value" );
+	daw::expecting( a.has_value( ) );
+	daw::expecting( *a == "value" );
+	daw::expecting( a->size( ) == 5U );
+
+	auto b = daw::expected<std::string, std::string>(
+	  daw::unexpected( std::string( "error" ) ) );
+	daw::expecting( not b.has_value( ) );
+	daw::expecting( b.error( ) == "error" );
+	daw::expecting( b.value_or( "other" ) == "other" );
+	daw::expecting( b == daw::unexpected( std::string( "error" ) ) );
+	daw::expecting_exception<daw::bad_expected_access<std::string>>( [&] {
+		(void)b.value( );
+	} );
+
+	// Assignment across the states
+	auto c = a;
+	daw::expecting( c == a );
+	c = b;
+	daw::expecting( c == b );
+	c = std::move( a );
+	daw::expecting( c.has_value( ) and *c == "value" );
+
+	auto const len = b.transform_error( []( std::string const &e ) {
+		return e.size( );
+	} );
+	daw::expecting( len.error( ) == 5U );
+	auto const recovered =
+	  b.or_else( []( std::string const &e ) -> daw::expected<std::string, int> {
+		  return e + "!";
+	  } );
+	daw::expecting( recovered.value( ) == "error!" );
+
+	auto d =
+	  daw::expected<std::unique_ptr<int>, int>( std::make_unique<int>( 5 ) );
+	auto e = std::move( d ).transform( []( std::unique_ptr<int> p ) {
+		return *p + 1;
+	} );
+	daw::expecting( e.value( ) == 6 );
+}
+
+void daw_expected_typed_error_002( ) {
+	auto ok = daw::expected<void, parse_errc>( );
+	daw::expecting( ok.has_value( ) );
+	ok.value( );
+	auto bad = daw::expected<void, parse_errc>( daw::unexpect,
+	                                            parse_errc::overflow );
+	daw::expecting( not bad.has_value( ) );
+	daw::expecting( bad.error( ) == parse_errc::overflow );
+	auto const v = ok.transform( [] {
+		return 3;
+	} );
+	daw::expecting( v.value( ) == 3 );
+	auto const w = bad.and_then( []( ) -> daw::expected<void, parse_errc> {
+		return { };
+	} );
+	daw::expecting( w.error( ) == parse_errc::overflow );
+	auto const x = parse_digits( "12" ).transform( []( int ) {} );
+	daw::expecting( x.has_value( ) );
+}
+
+void daw_expected_typed_error_003( ) {
+	// Trivially destructible but not trivially copyable
+	using pair_t = std::pair<int, int>;
+	static_assert( not std::is_trivially_copyable_v<pair_t> );
+	auto a = daw::expected<pair_t, int>( std::in_place, 1, 2 );
+	auto b = a;
+	daw::expecting( b.has_value( ) and *b == pair_t( 1, 2 ) );
+	auto c = std::move( b );
+	daw::expecting( c.has_value( ) and *c == pair_t( 1, 2 ) );
+	auto const e = daw::expected<pair_t, int>( daw::unexpect, 5 );
+	auto f = e;
+	daw::expecting( f.error( ) == 5 );
+	f = a;
+	daw::expecting( f == a );
+
+	// Conversions from expected<U, G>
+	daw::expected<long, long> g = daw::expected<int, int>( 3 );
+	daw::expecting( g.value( ) == 3L );
+	auto const h = daw::expected<char const *, int>( daw::unexpect, 4 );
+	auto const i = daw::expected<std::string, long>( h );
+	daw::expecting( i.error( ) == 4L );
+	auto j =
+	  daw::expected<std::string, int>( daw::expected<char const *, int>( "j" ) );
+	daw::expecting( *j == "j" );
+	static_assert( std::is_convertible_v<daw::expected<int, int>,
+	                                     daw::expected<long, long>> );
+	// std::vector's size constructor is explicit
+	using sizes_t = daw::expected<std::vector<int>, int>;
+	static_assert(
+	  std::is_constructible_v<sizes_t, daw::expected<std::size_t, int>> );
+	static_assert(
+	  not std::is_convertible_v<daw::expected<std::size_t, int>, sizes_t> );
+	daw::expected<void, long> k = daw::expected<void, int>( daw::unexpect, 6 );
+	daw::expecting( k.error( ) == 6L );
+
+	// emplace replaces a value or an error
+	j.emplace( 3U, 'x' );
+	daw::expecting( *j == "xxx" );
+	auto l = daw::expected<std::string, std::string>( daw::unexpect, "l" );
+	daw::expecting( l.emplace( "value" ) == "value" and l.has_value( ) );
+	k.emplace( );
+	daw::expecting( k.has_value( ) );
+
+	// swap in each combination of states
+	auto m = daw::expected<std::string, std::string>( daw::unexpect, "error" );
+	swap( l, m );
+	daw::expecting( l.error( ) == "error" and *m == "value" );
+	l.swap( m );
+	daw::expecting( *l == "value" and m.error( ) == "error" );
+	auto n = daw::expected<std::string, std::string>( "other" );
+	swap( l, n );
+	daw::expecting( *l == "other" and *n == "value" );
+	auto o = daw::expected<void, long>( daw::unexpect, 7L );
+	swap( k, o );
+	daw::expecting( k.error( ) == 7L and o.has_value( ) );
+	static_assert( noexcept( l.swap( m ) ) );
+}
+
+void daw_expected_bench_errors( ) {
+	// 90% of the inputs are errors, like a parser probing alternatives
+	auto inputs = std::vector<std::string>( );
+	for( int n = 0; n < 10'000; ++n ) {
+		inputs.push_back( n % 10 == 0 ? std::to_string( n )
+		                              : "x" + std::to_string( n ) );
+	}
+	auto const result_exception = daw::bench_n_test<20>(
+	  "expected_t<int> with exception_ptr errors: 10k parses, 90% errors",
+	  []( auto const &v ) {
+		  int sum = 0;
+		  for( auto const &str : v ) {
+			  auto r = parse_digits( str );
+			  using result_t = daw::expected_t<int>;
+			  auto e = r.has_value( )
+			             ? result_t( *r )
+			             : result_t( result_t::exception_tag{ },
+			                         std::invalid_argument( "bad digit" ) );
+			  daw::do_not_optimize( e );
+			  if( e.has_value( ) ) {
+				  sum += e.get( );
+			  }
+		  }
+		  daw::do_not_optimize( sum );
+		  return sum;
+	  },
+	  inputs );
+	auto const result_typed = daw::bench_n_test<20>(
+	  "expected<int, parse_errc>: 10k parses, 90% errors",
+	  []( auto const &v ) {
+		  int sum = 0;
+		  for( auto const &str : v ) {
+			  auto e = parse_digits( str );
+			  daw::do_not_optimize( e );
+			  if( e.has_value( ) ) {
+				  sum += *e;
+			  }
+		  }
+		  daw::do_not_optimize( sum );
+		  return sum;
+	  },
+	  inputs );
+	daw::expecting( result_exception.get( ) == result_typed.get( ) );
+}
+
 int main( ) {
 	daw_expected_test_01( );
 	daw_expected_test_02( );
@@ -240,4 +455,8 @@ int main( ) {
 	daw_expected_test_move_construction_001( );
 	daw_expected_test_move_assignment_002( );
 	daw_expected_test_move_construction_002( );
+	daw_expected_typed_error_001( );
+	daw_expected_typed_error_002( );
+	daw_expected_typed_error_003( );
+	daw_expected_bench_errors( );
 }
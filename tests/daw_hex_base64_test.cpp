@@ -0,0 +1,239 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include "daw/daw_hex_base64.h"
+
+#include "daw/daw_benchmark.h"
+#include "daw/daw_do_not_optimize.h"
+#include "daw/daw_ensure.h"
+#include "daw/daw_span.h"
+#include "daw/daw_utility.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+	using daw::encoding::base64_alphabet;
+	using daw::encoding::hex_case;
+
+	/// A bit at a time encoder to check against
+	std::string reference_base64( std::vector<unsigned char> const &data,
+	                              base64_alphabet alphabet ) {
+		std::string const chars =
+		  alphabet == base64_alphabet::url
+		    ? "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_"
+		    : "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+		auto result = std::string( );
+		std::size_t bits = 0;
+		unsigned group = 0;
+		for( auto b : data ) {
+			for( int n = 7; n >= 0; --n ) {
+				group = ( group << 1U ) | ( ( b >> n ) & 1U );
+				if( ++bits % 6U == 0 ) {
+					result += chars[group];
+					group = 0;
+				}
+			}
+		}
+		if( bits % 6U != 0 ) {
+			result += chars[group << ( 6U - bits % 6U )];
+		}
+		if( alphabet == base64_alphabet::standard ) {
+			while( result.size( ) % 4U != 0 ) {
+				result += '=';
+			}
+		}
+		return result;
+	}
+
+	std::vector<unsigned char> random_bytes( std::mt19937_64 &rng,
+	                                         std::size_t size ) {
+		auto result = std::vector<unsigned char>( size );
+		for( auto &b : result ) {
+			b = static_cast<unsigned char>( rng( ) );
+		}
+		return result;
+	}
+
+	std::vector<unsigned char> base64_bytes( std::string const &str,
+	                                         daw::encoding::decode_result &r,
+	                                         base64_alphabet alphabet ) {
+		auto result = std::vector<unsigned char>(
+		  daw::encoding::base64_decoded_size( str.size( ) ) );
+		r = daw::encoding::base64_decode( str, result, alphabet );
+		result.resize( r.written );
+		return result;
+	}
+
+	void test_known( ) {
+		constexpr char const *vectors[][2] = {
+		  { "", "" },          { "f", "Zg==" },         { "fo", "Zm8=" },
+		  { "foo", "Zm9v" },   { "foob", "Zm9vYg==" },  { "fooba", "Zm9vYmE=" },
+		  { "foobar", "Zm9vYmFy" } };
+		for( auto const &v : vectors ) {
+			auto const text = std::string( v[0] );
+			daw_ensure( daw::encoding::to_base64_string( text ) == v[1] );
+			auto url = std::string( v[1] );
+			while( not url.empty( ) and url.back( ) == '=' ) {
+				url.pop_back( );
+			}
+			daw_ensure( daw::encoding::to_base64_string( text,
+			                                             base64_alphabet::url ) ==
+			            url );
+			for( auto const &encoded : { std::string( v[1] ), url } ) {
+				auto r = daw::encoding::decode_result( );
+				auto const decoded = base64_bytes( encoded, r, base64_alphabet::url );
+				daw_ensure( r.is_valid and r.read == encoded.size( ) );
+				daw_ensure( std::string( decoded.begin( ), decoded.end( ) ) == text );
+			}
+		}
+		daw_ensure( daw::encoding::to_hex_string( std::string( "\x01\xAB\xff" ) ) ==
+		            "01abff" );
+		daw_ensure( daw::encoding::to_hex_string( std::string( "\x01\xAB\xff" ),
+		                                          hex_case::upper ) == "01ABFF" );
+	}
+
+	void test_round_trip( ) {
+		auto rng = std::mt19937_64( 1234 );
+		for( std::size_t size = 0; size < 300; ++size ) {
+			auto const data = random_bytes( rng, size );
+			for( auto alphabet :
+			     { base64_alphabet::standard, base64_alphabet::url } ) {
+				auto const encoded = daw::encoding::to_base64_string( data, alphabet );
+				daw_ensure( encoded == reference_base64( data, alphabet ) );
+				daw_ensure( encoded.size( ) ==
+				            daw::encoding::base64_encoded_size( size, alphabet ) );
+				auto r = daw::encoding::decode_result( );
+				daw_ensure( base64_bytes( encoded, r, alphabet ) == data );
+				daw_ensure( r.is_valid );
+			}
+			auto const hex = daw::encoding::to_hex_string( data, hex_case::upper );
+			auto decoded = std::vector<unsigned char>( size );
+			auto const r = daw::encoding::hex_decode( hex, decoded );
+			daw_ensure( r.is_valid and r.written == size and decoded == data );
+			// Decoding into a daw::span
+			auto out = std::vector<std::byte>( size );
+			(void)daw::encoding::hex_decode(
+			  daw::encoding::to_hex_string( data ),
+			  daw::span<std::byte>( out.data( ), out.size( ) ) );
+			daw_ensure( size == 0 or
+			            out.back( ) == static_cast<std::byte>( data.back( ) ) );
+		}
+	}
+
+	void test_invalid( ) {
+		auto rng = std::mt19937_64( 42 );
+		for( int n = 0; n < 2'000; ++n ) {
+			auto const data = random_bytes( rng, 1U + rng( ) % 200U );
+
+			auto b64 = daw::encoding::to_base64_string( data );
+			auto const b64_pos = rng( ) % std::min( b64.find( '=' ), b64.size( ) );
+			b64[b64_pos] = "!*.\n #\x80"[rng( ) % 7U];
+			auto r = daw::encoding::decode_result( );
+			(void)base64_bytes( b64, r, base64_alphabet::standard );
+			daw_ensure( not r.is_valid and r.read == b64_pos );
+			daw_ensure( r.written <= b64_pos / 4U * 3U );
+
+			auto hex = daw::encoding::to_hex_string( data );
+			auto const hex_pos = rng( ) % hex.size( );
+			hex[hex_pos] = "gG!x \x80"[rng( ) % 6U];
+			auto out = std::vector<unsigned char>( data.size( ) );
+			auto const hr = daw::encoding::hex_decode( hex, out );
+			daw_ensure( not hr.is_valid and hr.read == hex_pos );
+			daw_ensure( hr.written == hex_pos / 2U );
+		}
+		auto r = daw::encoding::decode_result( );
+		// Leftover bits that are not zero, a lone character and bad padding
+		for( auto const *bad : { "Zh==", "Zm9=", "Z", "Zm9vY", "Zm9v=", "Zg=" } ) {
+			(void)base64_bytes( bad, r, base64_alphabet::standard );
+			daw_ensure( not r.is_valid );
+		}
+		// Each alphabet rejects the other's characters
+		(void)base64_bytes( "ab+/", r, base64_alphabet::url );
+		daw_ensure( not r.is_valid and r.read == 2 );
+		(void)base64_bytes( "ab-_", r, base64_alphabet::standard );
+		daw_ensure( not r.is_valid and r.read == 2 );
+		auto out = std::vector<unsigned char>( 4 );
+		auto const odd = daw::encoding::hex_decode( std::string( "abc" ), out );
+		daw_ensure( not odd.is_valid and odd.read == 2 and odd.written == 1 );
+	}
+
+	void benchmarks( ) {
+		auto rng = std::mt19937_64( 1 );
+		auto const data = random_bytes( rng, 16U * 1024U * 1024U );
+		std::cout << "Encoding " << data.size( ) << " bytes\n";
+		auto hex = std::string( daw::encoding::hex_encoded_size( data.size( ) ),
+		                        '\0' );
+		auto b64 = std::string(
+		  daw::encoding::base64_encoded_size( data.size( ) ), '\0' );
+		auto bytes = std::vector<unsigned char>( data.size( ) );
+		(void)daw::bench_n_test_mbs<10>(
+		  "daw::hex, byte at a time",
+		  data.size( ),
+		  [&]( std::vector<unsigned char> const &d ) {
+			  char *out = hex.data( );
+			  for( auto b : d ) {
+				  out = daw::hex_lc( static_cast<char>( b ), out );
+			  }
+			  daw::do_not_optimize( hex );
+			  return hex.size( );
+		  },
+		  data );
+		(void)daw::bench_n_test_mbs<10>(
+		  "daw::encoding::hex_encode",
+		  data.size( ),
+		  [&]( std::vector<unsigned char> const &d ) {
+			  auto const result = daw::encoding::hex_encode( d, hex );
+			  daw::do_not_optimize( hex );
+			  return result;
+		  },
+		  data );
+		(void)daw::bench_n_test_mbs<10>(
+		  "daw::encoding::hex_decode",
+		  hex.size( ),
+		  [&]( std::string const &h ) {
+			  auto const result = daw::encoding::hex_decode( h, bytes );
+			  daw::do_not_optimize( bytes );
+			  return result.written;
+		  },
+		  hex );
+		daw_ensure( bytes == data );
+		(void)daw::bench_n_test_mbs<10>(
+		  "daw::encoding::base64_encode",
+		  data.size( ),
+		  [&]( std::vector<unsigned char> const &d ) {
+			  auto const result = daw::encoding::base64_encode( d, b64 );
+			  daw::do_not_optimize( b64 );
+			  return result;
+		  },
+		  data );
+		(void)daw::bench_n_test_mbs<10>(
+		  "daw::encoding::base64_decode",
+		  b64.size( ),
+		  [&]( std::string const &s ) {
+			  auto const result = daw::encoding::base64_decode( s, bytes );
+			  daw::do_not_optimize( bytes );
+			  return result.written;
+		  },
+		  b64 );
+		daw_ensure( bytes == data );
+	}
+} // namespace
+
+int main( ) {
+	test_known( );
+	test_round_trip( );
+	test_invalid( );
+	benchmarks( );
+	std::cout << "Done\n";
+}
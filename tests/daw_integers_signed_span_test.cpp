@@ -0,0 +1,237 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include <daw/integers/daw_signed_span.h>
+
+#include <daw/daw_benchmark.h>
+#include <daw/daw_do_not_optimize.h>
+#include <daw/daw_ensure.h>
+#include <daw/daw_span.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace daw::integers::literals;
+
+namespace {
+	/// Mostly values near the limits, so that about half of the adds overflow
+	template<typename SignedInteger>
+	std::vector<SignedInteger> random_values( std::mt19937_64 &rng,
+	                                          std::size_t size ) {
+		using value_t = typename SignedInteger::value_type;
+		constexpr auto max = std::numeric_limits<value_t>::max( );
+		constexpr auto min = std::numeric_limits<value_t>::min( );
+		auto result = std::vector<SignedInteger>( );
+		for( std::size_t n = 0; n < size; ++n ) {
+			auto const offset = static_cast<value_t>( rng( ) % 4U );
+			switch( rng( ) % 4U ) {
+			case 0:
+				result.emplace_back( static_cast<value_t>( max - offset ) );
+				break;
+			case 1:
+				result.emplace_back( static_cast<value_t>( min + offset ) );
+				break;
+			default:
+				result.emplace_back( static_cast<value_t>( rng( ) ) );
+			}
+		}
+		return result;
+	}
+
+	/// Exact sum of small values, or of any value when 128 bit integers are
+	/// available
+	template<typename SignedInteger>
+	bool reference_sum( std::vector<SignedInteger> const &values,
+	                    bool &overflowed ) {
+		using value_t = typename SignedInteger::value_type;
+#if defined( __SIZEOF_INT128__ )
+		__extension__ using wide_t = __int128;
+#else
+		using wide_t = std::int64_t;
+		if constexpr( sizeof( value_t ) == 8 ) {
+			return false;
+		}
+#endif
+		wide_t sum = 0;
+		for( auto v : values ) {
+			sum += v.value( );
+		}
+		overflowed = sum < std::numeric_limits<value_t>::min( ) or
+		             sum > std::numeric_limits<value_t>::max( );
+		return true;
+	}
+
+	template<typename SignedInteger>
+	void test_type( ) {
+		auto rng = std::mt19937_64( 1234 );
+		std::size_t handler_calls = 0;
+		auto const handler = [&]( daw::integers::SignedIntegerErrorType ) {
+			++handler_calls;
+		};
+		daw::integers::register_signed_overflow_handler( handler );
+		for( std::size_t size = 0; size < 150; ++size ) {
+			auto const a = random_values<SignedInteger>( rng, size );
+			auto const b = random_values<SignedInteger>( rng, size );
+			auto out = std::vector<SignedInteger>( size );
+			auto wrapped = std::vector<SignedInteger>( size );
+
+			daw::integers::add_saturated( a, b, out );
+			daw::integers::add_wrapped( a, b, wrapped );
+			bool add_overflowed = false;
+			for( std::size_t n = 0; n < size; ++n ) {
+				daw_ensure( out[n] == a[n].add_saturated( b[n] ) );
+				daw_ensure( wrapped[n] == a[n].add_wrapped( b[n] ) );
+				// A saturated result differs from the wrapped one only on overflow
+				add_overflowed |= out[n] != wrapped[n];
+			}
+			handler_calls = 0;
+			daw_ensure( daw::integers::add_checked( a, b, out ) == add_overflowed );
+			daw_ensure( out == wrapped );
+			daw_ensure( handler_calls == ( add_overflowed ? 1U : 0U ) );
+
+			daw::integers::sub_saturated( a, b, out );
+			daw::integers::sub_wrapped( a, b, wrapped );
+			bool sub_overflowed = false;
+			for( std::size_t n = 0; n < size; ++n ) {
+				daw_ensure( out[n] == a[n].sub_saturated( b[n] ) );
+				daw_ensure( wrapped[n] == a[n].sub_wrapped( b[n] ) );
+				sub_overflowed |= out[n] != wrapped[n];
+			}
+			handler_calls = 0;
+			daw_ensure( daw::integers::sub_checked( a, b, out ) == sub_overflowed );
+			daw_ensure( out == wrapped );
+			daw_ensure( handler_calls == ( sub_overflowed ? 1U : 0U ) );
+
+			auto const sum = daw::integers::checked_sum( a );
+			auto wrapped_sum = SignedInteger( );
+			for( auto v : a ) {
+				wrapped_sum = wrapped_sum.add_wrapped( v );
+			}
+			daw_ensure( sum.value == wrapped_sum );
+			bool expected = false;
+			if( reference_sum( a, expected ) ) {
+				daw_ensure( sum.overflowed == expected );
+			}
+			// Small values never overflow
+			auto small = std::vector<SignedInteger>( size );
+			for( auto &v : small ) {
+				v = SignedInteger( static_cast<int>( rng( ) % 7U ) - 3 );
+			}
+			daw_ensure( not daw::integers::checked_sum( small ).overflowed );
+		}
+		daw::integers::register_signed_overflow_handler( );
+	}
+
+	void test_sums( ) {
+		// Overflow along the way that cancels out is not an overflow
+		auto values = std::vector<daw::i64>( 100, daw::i64::max( ) );
+		values.resize( 200, daw::i64::min( ) );
+		auto sum = daw::integers::checked_sum( values );
+		daw_ensure( not sum.overflowed and sum.value == -100_i64 );
+		values.push_back( daw::i64::min( ) );
+		sum = daw::integers::checked_sum( values );
+		daw_ensure( sum.overflowed and
+		            sum.value == daw::i64::max( ).sub_wrapped( 99_i64 ) );
+
+		auto bytes = std::vector<daw::i8>( 1000, daw::i8::min( ) );
+		daw_ensure( daw::integers::checked_sum( bytes ).overflowed );
+		daw_ensure( daw::integers::checked_sum(
+		              daw::span<daw::i8 const>( bytes.data( ), 1 ) )
+		              .value == daw::i8::min( ) );
+
+		bool threw = false;
+		try {
+			(void)daw::integers::sum_checked( bytes );
+		} catch( daw::integers::signed_integer_overflow_exception const & ) {
+			threw = true;
+		}
+		daw_ensure( threw );
+
+		// Sizes must match
+		auto const a = std::vector<daw::i32>( 4 );
+		auto out = std::vector<daw::i32>( 3 );
+		threw = false;
+		try {
+			daw::integers::add_saturated( a, a, out );
+		} catch( std::out_of_range const & ) { threw = true; }
+		daw_ensure( threw );
+	}
+
+	void benchmarks( ) {
+		auto rng = std::mt19937_64( 1 );
+		constexpr std::size_t count = 4U * 1024U * 1024U;
+		auto values = std::vector<daw::i64>( );
+		for( std::size_t n = 0; n < count; ++n ) {
+			values.emplace_back( static_cast<std::int64_t>( rng( ) % 2'000'000U ) -
+			                     1'000'000 );
+		}
+		auto const bytes = count * sizeof( daw::i64 );
+		std::cout << "Summing " << count << " i64 values\n";
+		auto const per_element = daw::bench_n_test_mbs<10>(
+		  "add_checked each element",
+		  bytes,
+		  []( std::vector<daw::i64> const &vs ) {
+			  auto result = 0_i64;
+			  for( auto v : vs ) {
+				  result = result.add_checked( v );
+			  }
+			  daw::do_not_optimize( result );
+			  return result;
+		  },
+		  values );
+		auto const batch = daw::bench_n_test_mbs<10>(
+		  "daw::integers::checked_sum",
+		  bytes,
+		  []( std::vector<daw::i64> const &vs ) {
+			  auto const result = daw::integers::checked_sum( vs );
+			  daw::do_not_optimize( result );
+			  return result.value;
+		  },
+		  values );
+		daw_ensure( per_element.get( ) == batch.get( ) );
+
+		auto const a = random_values<daw::i32>( rng, count );
+		auto const b = random_values<daw::i32>( rng, count );
+		auto out = std::vector<daw::i32>( count );
+		std::cout << "Saturated add of " << count << " i32 values\n";
+		(void)daw::bench_n_test_mbs<10>(
+		  "add_saturated each element",
+		  count * sizeof( daw::i32 ),
+		  [&]( std::vector<daw::i32> const &lhs ) {
+			  for( std::size_t n = 0; n < lhs.size( ); ++n ) {
+				  out[n] = lhs[n].add_saturated( b[n] );
+			  }
+			  daw::do_not_optimize( out );
+			  return out.size( );
+		  },
+		  a );
+		(void)daw::bench_n_test_mbs<10>(
+		  "daw::integers::add_saturated",
+		  count * sizeof( daw::i32 ),
+		  [&]( std::vector<daw::i32> const &lhs ) {
+			  daw::integers::add_saturated( lhs, b, out );
+			  daw::do_not_optimize( out );
+			  return out.size( );
+		  },
+		  a );
+	}
+} // namespace
+
+int main( ) {
+	test_type<daw::i8>( );
+	test_type<daw::i16>( );
+	test_type<daw::i32>( );
+	test_type<daw::i64>( );
+	test_sums( );
+	benchmarks( );
+	std::cout << "Done\n";
+}
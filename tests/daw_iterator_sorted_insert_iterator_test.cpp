@@ -9,6 +9,7 @@
 #include "daw/iterator/daw_sorted_insert_iterator.h"
 
 #include "daw/daw_benchmark.h"
+#include "daw/daw_ensure.h"
 #include "daw/daw_random.h"
 #include "daw/iterator/daw_function_iterator.h"
 
@@ -20,6 +21,8 @@
 #include <iterator>
 #include <limits>
 #include <list>
+#include <stdexcept>
+#include <utility>
 #include <vector>
 
 using test_data_t = size_t;
@@ -68,7 +71,136 @@ void test_006( std::vector<test_data_t> const &data ) {
 	daw::do_not_optimize( new_data );
 }
 
+template<typename Container>
+void test_buffered_001( std::vector<test_data_t> const &data ) {
+	auto expected = std::vector<test_data_t>( begin( data ), end( data ) );
+	std::sort( begin( expected ), end( expected ) );
+	// Start with part of the data in the container so the flush has to merge
+	auto const half = data.size( ) / 2;
+	auto result = Container( );
+	{
+		auto pre = std::vector<test_data_t>( begin( data ), begin( data ) + half );
+		std::sort( begin( pre ), end( pre ) );
+		result.insert( end( result ), begin( pre ), end( pre ) );
+		auto inserter = daw::buffered_sorted_inserter( result );
+		std::copy( begin( data ) + half, end( data ), inserter.iterator( ) );
+	}
+	daw_ensure( std::equal(
+	  begin( result ), end( result ), begin( expected ), end( expected ) ) );
+}
+
+void test_buffered_002( ) {
+	// Sorted runs are appended without buffering
+	auto result = std::vector<int>( );
+	auto inserter = daw::buffered_sorted_inserter( result, std::greater<>{ } );
+	for( int n = 100; n > 0; --n ) {
+		inserter.push( n );
+	}
+	daw_ensure( inserter.pending( ) == 0 and result.size( ) == 100 );
+	inserter.push( 50 );
+	inserter.push( 200 );
+	inserter.push( 150 );
+	daw_ensure( inserter.pending( ) == 3 );
+	inserter.flush( );
+	daw_ensure( inserter.pending( ) == 0 and result.size( ) == 103 );
+	daw_ensure(
+	  std::is_sorted( begin( result ), end( result ), std::greater<>{ } ) );
+	daw_ensure( result.front( ) == 200 );
+}
+
+void test_buffered_003( ) {
+	// Equal keys keep their arrival order
+	using record = std::pair<int, int>;
+	auto const by_key = []( record const &lhs, record const &rhs ) {
+		return lhs.first < rhs.first;
+	};
+	auto result = std::vector<record>{ { 1, 0 }, { 2, 1 }, { 3, 2 } };
+	{
+		auto inserter = daw::buffered_sorted_inserter( result, by_key );
+		inserter.push( record{ 2, 3 } );
+		inserter.push( record{ 1, 4 } );
+		inserter.push( record{ 2, 5 } );
+	}
+	auto const expected = std::vector<record>{
+	  { 1, 0 }, { 1, 4 }, { 2, 1 }, { 2, 3 }, { 2, 5 }, { 3, 2 } };
+	daw_ensure( result == expected );
+}
+
+void test_buffered_004( ) {
+	// An exception from the flush in the destructor does not escape it, an
+	// explicit flush reports it
+	bool should_throw = false;
+	auto const compare = [&]( int lhs, int rhs ) {
+		if( should_throw ) {
+			throw std::runtime_error( "compare" );
+		}
+		return lhs < rhs;
+	};
+	auto result = std::vector<int>{ 5 };
+	bool threw = false;
+	{
+		auto inserter = daw::buffered_sorted_inserter( result, compare );
+		inserter.push( 1 );
+		inserter.push( 0 );
+		should_throw = true;
+		try {
+			inserter.flush( );
+		} catch( std::runtime_error const & ) { threw = true; }
+	}
+	daw_ensure( threw );
+}
+
+void bench_buffered( ) {
+	// Mostly in order timestamps with some late arrivals
+	constexpr std::size_t sz = 50'000;
+	auto const timestamps = [] {
+		auto result = daw::make_random_data<test_data_t>( sz, 0, 100 );
+		for( std::size_t n = 0; n < sz; ++n ) {
+			result[n] = n * 10U + ( result[n] < 5U ? 0U : 100U );
+		}
+		return result;
+	}( );
+	auto const random_data = daw::make_random_data<test_data_t>( sz );
+	for( auto const *data : { &timestamps, &random_data } ) {
+		std::cout << ( data == &timestamps ? "Mostly sorted" : "Random" ) << ": "
+		          << sz << " values\n";
+		auto const r0 = daw::bench_n_test<5>(
+		  "vector<size_t> Insert sorted iterator",
+		  []( std::vector<test_data_t> const &d ) {
+			  auto result = std::vector<test_data_t>( );
+			  std::copy(
+			    begin( d ), end( d ), daw::make_sorted_insert_iterator( result ) );
+			  daw::do_not_optimize( result );
+			  return result;
+		  },
+		  *data );
+		auto const r1 = daw::bench_n_test<5>(
+		  "vector<size_t> buffered_sorted_inserter",
+		  []( std::vector<test_data_t> const &d ) {
+			  auto result = std::vector<test_data_t>( );
+			  {
+				  auto inserter = daw::buffered_sorted_inserter( result );
+				  std::copy( begin( d ), end( d ), inserter.iterator( ) );
+			  }
+			  daw::do_not_optimize( result );
+			  return result;
+		  },
+		  *data );
+		daw_ensure( r0.get( ) == r1.get( ) );
+	}
+}
+
 int main( ) {
+	{
+		auto const data = daw::make_random_data<test_data_t>( 1'000, 0, 500 );
+		test_buffered_001<std::vector<test_data_t>>( data );
+		test_buffered_001<std::deque<test_data_t>>( data );
+		test_buffered_001<std::list<test_data_t>>( data );
+		test_buffered_002( );
+		test_buffered_003( );
+		test_buffered_004( );
+		bench_buffered( );
+	}
 	for( size_t sz = 10ULL; sz < 1'000ULL; sz *= 10 ) {
 		std::vector<test_data_t> test_data( sz, 0ULL );
 		daw::random_fill<test_data_t>( begin( test_data ),
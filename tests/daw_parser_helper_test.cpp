@@ -9,13 +9,27 @@
 #include "daw/daw_parser_helper.h"
 
 #include "daw/daw_benchmark.h"
+#include "daw/daw_do_not_optimize.h"
+#include "daw/daw_ensure.h"
 #include "daw/daw_parser_addons.h"
 #include "daw/daw_string_view.h"
 #include "daw/daw_utility.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <iostream>
+#include <limits>
+#include <random>
+#include <stdexcept>
 #include <string>
+#include <vector>
+
+static_assert( [] {
+	daw::string_view const str = "-1234567890123";
+	std::int64_t i = 0;
+	daw::parser::parse_int( std::data( str ), daw::data_end( str ), i );
+	return i == -1234567890123LL;
+}( ) );
 
 void daw_parser_helper001( ) {
 	static std::string uint_test = "43453";
@@ -92,7 +106,147 @@ void daw_parser_helper002( ) {
 	          << "', without '" << sws << "'\n";
 }
 
+template<typename Int>
+Int parse_int_sv( daw::string_view str ) {
+	Int result = 0;
+	daw::parser::parse_int( std::data( str ), daw::data_end( str ), result );
+	return result;
+}
+
+template<typename Int>
+bool parse_int_throws( daw::string_view str ) {
+	try {
+		(void)parse_int_sv<Int>( str );
+	} catch( std::out_of_range const & ) {
+		return true;
+	} catch( daw::parser::ParserException const & ) {
+		return true;
+	}
+	return false;
+}
+
+void daw_parser_helper003( ) {
+	// Every digit length and a few leading zeros, against to_string
+	auto rng = std::mt19937_64( 42 );
+	for( int len = 1; len <= 19; ++len ) {
+		for( int n = 0; n < 200; ++n ) {
+			auto value = rng( ) % 10'000'000'000'000'000'000ULL;
+			auto str =
+			  std::to_string( value ).substr( 0, static_cast<std::size_t>( len ) );
+			auto const expected = std::stoull( str );
+			daw_ensure( parse_int_sv<std::uint64_t>( str ) == expected );
+			daw_ensure( parse_int_sv<std::uint64_t>( "000" + str ) == expected );
+		}
+	}
+	using u64_limits = std::numeric_limits<std::uint64_t>;
+	using i64_limits = std::numeric_limits<std::int64_t>;
+	daw_ensure( parse_int_sv<std::uint64_t>( "18446744073709551615" ) ==
+	            u64_limits::max( ) );
+	daw_ensure( parse_int_throws<std::uint64_t>( "18446744073709551616" ) );
+	daw_ensure( parse_int_throws<std::uint64_t>( "99999999999999999999" ) );
+	daw_ensure( parse_int_throws<std::uint64_t>( "100000000000000000000" ) );
+	daw_ensure( parse_int_sv<std::int64_t>( "-9223372036854775808" ) ==
+	            i64_limits::min( ) );
+	daw_ensure( parse_int_throws<std::int64_t>( "9223372036854775808" ) );
+	daw_ensure( parse_int_sv<std::int8_t>( "-128" ) == -128 );
+	daw_ensure( parse_int_sv<std::int8_t>( "127" ) == 127 );
+	daw_ensure( parse_int_throws<std::int8_t>( "128" ) );
+	daw_ensure( parse_int_throws<std::uint16_t>( "65536" ) );
+	daw_ensure( parse_int_sv<std::uint32_t>( "0" ) == 0 );
+	daw_ensure( parse_int_throws<std::uint32_t>( "12a4" ) );
+	daw_ensure( parse_int_throws<std::uint32_t>( "1234567/" ) );
+	daw_ensure( parse_int_throws<std::uint64_t>( "123456789:123" ) );
+}
+
+/// The digit at a time loop the parsers used before the SWAR path
+template<typename Result>
+constexpr Result parse_int_scalar( char const *first, char const *last ) {
+	bool is_neg = false;
+	if( *first == '-' ) {
+		is_neg = true;
+		++first;
+	}
+	Result result = 0;
+	for( ; first != last; ++first ) {
+		daw::exception::precondition_check<daw::parser::ParserException>(
+		  daw::parser::is_number( *first ) );
+		result = result * 10 + static_cast<Result>( *first - '0' );
+	}
+	return is_neg ? -result : result;
+}
+
+/// Each field's width is lengths[pick( n )]
+template<typename Pick>
+void daw_parser_helper_bench( std::string const &title,
+                              std::vector<int> const &lengths,
+                              Pick pick ) {
+	auto rng = std::mt19937_64( 1234 );
+	// The fields are views into one buffer, as when reading a file
+	auto buffer = std::string( );
+	auto bounds = std::vector<std::size_t>( { 0 } );
+	for( std::size_t n = 0; n < 1'000'000; ++n ) {
+		auto const len = lengths[pick( n, rng ) % lengths.size( )];
+		if( rng( ) % 4U == 0 ) {
+			buffer += '-';
+		}
+		buffer += static_cast<char>( '1' + rng( ) % 9U );
+		for( int d = 1; d < len; ++d ) {
+			buffer += static_cast<char>( '0' + rng( ) % 10U );
+		}
+		bounds.push_back( buffer.size( ) );
+	}
+	auto fields = std::vector<daw::string_view>( );
+	for( std::size_t n = 1; n < bounds.size( ); ++n ) {
+		fields.emplace_back( buffer.data( ) + bounds[n - 1],
+		                     bounds[n] - bounds[n - 1] );
+	}
+	std::cout << "Parsing " << fields.size( ) << ' ' << title << '\n';
+	auto const r0 = daw::bench_n_test_mbs<10>(
+	  "scalar parse_int",
+	  buffer.size( ),
+	  []( auto const &strs ) {
+		  std::uint64_t sum = 0;
+		  for( auto const &str : strs ) {
+			  sum += static_cast<std::uint64_t>( parse_int_scalar<std::int64_t>(
+			    std::data( str ), daw::data_end( str ) ) );
+		  }
+		  daw::do_not_optimize( sum );
+		  return sum;
+	  },
+	  fields );
+	auto const r1 = daw::bench_n_test_mbs<10>(
+	  "daw::parser::parse_int",
+	  buffer.size( ),
+	  []( auto const &strs ) {
+		  std::uint64_t sum = 0;
+		  for( auto const &str : strs ) {
+			  std::int64_t i = 0;
+			  daw::parser::parse_int( std::data( str ), daw::data_end( str ), i );
+			  sum += static_cast<std::uint64_t>( i );
+		  }
+		  daw::do_not_optimize( sum );
+		  return sum;
+	  },
+	  fields );
+	daw_ensure( r0.get( ) == r1.get( ) );
+}
+
 int main( ) {
 	daw_parser_helper001( );
 	daw_parser_helper002( );
+	daw_parser_helper003( );
+	// Mostly short ids and counters with some longer timestamps, in random
+	// order.  This is the worst case for branch prediction
+	daw_parser_helper_bench(
+	  "random width integers",
+	  { 1, 2, 2, 3, 3, 4, 4, 5, 6, 7, 8, 10, 13, 16, 18 },
+	  []( std::size_t, auto &rng ) {
+		  return rng( );
+	  } );
+	// Rows of id, timestamp, count, price and a long id, as in a table
+	daw_parser_helper_bench( "integer columns",
+	                         { 7, 13, 2, 5, 18 },
+	                         []( std::size_t n, auto & ) {
+		                         return n;
+	                         } );
 }
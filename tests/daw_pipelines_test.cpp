@@ -8,6 +8,7 @@
 
 #include <daw/daw_pipelines.h>
 
+#include <daw/daw_benchmark.h>
 #include <daw/daw_constant.h>
 #include <daw/daw_do_not_optimize.h>
 #include <daw/daw_ensure.h>
@@ -15,6 +16,7 @@
 #include <daw/daw_random.h>
 
 #include <array>
+#include <cmath>
 #include <iterator>
 #include <map>
 #include <string>
@@ -372,6 +374,293 @@ namespace tests {
 		  daw::fmt_range{ p } );
 		(void)p;
 	}
+
+	DAW_ATTRIB_NOINLINE void test018( ) {
+		daw::println(
+		  "\ntest018: TopK, NthElement, PartialSort, Median, Quantiles" );
+		constexpr auto a = std::array{ 5, 3, 9, 1, 7, 2, 8, 6, 4, 10 };
+		auto const top3 = pipeline( a, TopK( 3 ) );
+		daw_ensure( top3 == std::vector{ 10, 9, 8 } );
+		auto const bottom3 = pipeline( a, TopK( 3, std::less<>{ } ) );
+		daw_ensure( bottom3 == std::vector{ 1, 2, 3 } );
+		daw_ensure( pipeline( a, TopK( 0 ) ).empty( ) );
+		daw_ensure( pipeline( a, TopK( 20 ) ).size( ) == a.size( ) );
+		// Streaming source through a non-arithmetic value type
+		auto const words = pipeline( iota_view( 0, 100 ),
+		                             Map( []( int i ) {
+			                             return std::to_string( i );
+		                             } ),
+		                             TopK( 2 ) );
+		daw_ensure( words == std::vector<std::string>{ "99", "98" } );
+		daw::println( "\tTopK( 3 ): {}", daw::fmt_range( top3 ) );
+
+		auto v = std::vector<int>( a.begin( ), a.end( ) );
+		auto const nth = pipeline( v, NthElement( 4 ) );
+		daw_ensure( nth[4] == 5 );
+		auto const ps = pipeline( v, PartialSort( 4 ) );
+		daw_ensure( ps[0] == 1 and ps[1] == 2 and ps[2] == 3 and ps[3] == 4 );
+		daw::println( "\tPartialSort( 4 ): {}", daw::fmt_range( ps ) );
+
+		daw_ensure( pipeline( a, Median ) == 5 );
+		daw_ensure( pipeline( std::array{ 3, 1, 2 }, Median ) == 2 );
+		auto const qs =
+		  pipeline( iota_view( 1, 101 ), Quantiles( 0.99, 0.5, 0.9 ) );
+		daw_ensure( qs[0] == 99 and qs[1] == 50 and qs[2] == 90 );
+		daw::println( "\tQuantiles( 0.99, 0.5, 0.9 ) of 1..100: {}",
+		              daw::fmt_range( qs ) );
+
+		auto const data = daw::make_random_data<int>( 1'000'000 );
+		auto const expected = [&] {
+			auto tmp = data;
+			std::sort( tmp.begin( ), tmp.end( ) );
+			tmp.resize( 50 );
+			return tmp;
+		}( );
+		daw::bench_n_test<10>(
+		  "TopK( 50 ) of 1M ints",
+		  [&]( auto const &d ) {
+			  auto r = pipeline( d, TopK( 50, std::less<>{ } ) );
+			  daw_ensure( r == expected );
+			  return r.size( );
+		  },
+		  data );
+		daw::bench_n_test<10>(
+		  "Sort, Take( 50 ) of 1M ints",
+		  []( std::vector<int> d ) {
+			  return pipeline( d, Sort, Take( 50 ), Count );
+		  },
+		  data );
+	}
+
+	DAW_ATTRIB_NOINLINE void test019( ) {
+		daw::println( "\ntest019: Distinct, GroupBy, HashJoin" );
+		constexpr auto a = std::array{ 3, 1, 3, 2, 1, 5, 2, 3 };
+		auto const d = pipeline( a, Distinct( ) );
+		daw_ensure( d == std::vector{ 3, 1, 2, 5 } );
+		daw::println( "\tDistinct: {}", daw::fmt_range( d ) );
+
+		auto const sums = pipeline( iota_view( 0, 100 ),
+		                            GroupBy(
+		                              []( int i ) {
+			                              return i % 3;
+		                              },
+		                              0LL,
+		                              []( long long acc, int i ) {
+			                              return acc + i;
+		                              } ) );
+		daw_ensure( sums.size( ) == 3 );
+		daw_ensure( sums[0].first == 0 and sums[0].second == 1683 );
+		daw_ensure( sums[1].first == 1 and sums[1].second == 1617 );
+		daw_ensure( sums[2].first == 2 and sums[2].second == 1650 );
+
+		auto const words = std::vector<std::string>{
+		  "apple", "avocado", "banana", "blueberry", "cherry", "apricot" };
+		auto const groups = pipeline( words, GroupBy( []( std::string const &w ) {
+			                              return w.front( );
+		                              } ) );
+		daw_ensure( groups.size( ) == 3 );
+		daw_ensure( groups[0].first == 'a' and groups[0].second.size( ) == 3 );
+		daw_ensure( groups[0].second[2] == "apricot" );
+
+		struct price_t {
+			int id;
+			int price;
+		};
+		auto const prices_by_id =
+		  std::vector<price_t>{ { 1, 100 }, { 2, 200 }, { 1, 110 }, { 4, 400 } };
+		auto const joined = pipeline(
+		  std::array{ 1, 2, 3 },
+		  HashJoin( prices_by_id,
+		            []( int id ) {
+			            return id;
+		            },
+		            &price_t::id ) );
+		daw_ensure( joined.size( ) == 3 );
+		daw_ensure( joined[0].first == 1 and joined[0].second.price == 100 );
+		daw_ensure( joined[1].first == 1 and joined[1].second.price == 110 );
+		daw_ensure( joined[2].first == 2 and joined[2].second.price == 200 );
+
+		auto const data = daw::make_random_data<int>( 1'000'000, 0, 100'000 );
+		auto const expected_count = [&] {
+			auto tmp = data;
+			std::sort( tmp.begin( ), tmp.end( ) );
+			return static_cast<std::size_t>(
+			  std::unique( tmp.begin( ), tmp.end( ) ) - tmp.begin( ) );
+		}( );
+		daw::bench_n_test<10>(
+		  "Distinct of 1M ints",
+		  [&]( auto const &v ) {
+			  auto const r = pipeline( v, Distinct( ) );
+			  daw_ensure( r.size( ) == expected_count );
+			  return r.size( );
+		  },
+		  data );
+		daw::bench_n_test<10>(
+		  "Sort, Unique of 1M ints",
+		  []( std::vector<int> v ) {
+			  std::sort( v.begin( ), v.end( ) );
+			  return Count( Unique( v ) );
+		  },
+		  data );
+	}
+
+	DAW_ATTRIB_NOINLINE void test020( ) {
+		daw::println( "\ntest020: multi-lane Sum, SumPairwise, Dot, MinMaxValues, "
+		              "Moments" );
+		auto const ints = pipeline( iota_view( 1, 1001 ), To<std::vector> );
+		daw_ensure( Sum( ints ) == 500500 );
+		daw_ensure( SumPairwise( ints ) == 500500 );
+		daw_ensure( SumPairwise( iota_view( 1, 1001 ) ) == 500500 );
+		daw_ensure( Dot( ints )( ints ) == 333833500 );
+		daw_ensure( pipeline( iota_view( 1, 4 ), Dot( std::array{ 4, 5, 6 } ) ) ==
+		            32 );
+		auto const mm = MinMaxValues( std::array{ 4, -2, 9, 0, 7, 11, 3, 5, 1 } );
+		daw_ensure( mm.first == -2 and mm.second == 11 );
+		auto const m =
+		  Moments( std::array{ 2.0, 4.0, 4.0, 4.0, 5.0, 5.0, 7.0, 9.0 } );
+		daw_ensure( m.count == 8.0 and m.mean == 5.0 and m.variance( ) == 4.0 );
+		daw_ensure( Mean( iota_view( 1, 4 ) ) == 2.0 );
+
+		// Accuracy: many small values added to a large one
+		auto data = std::vector<double>( 1'000'000, 0.1 );
+		data[0] = 1.0e10;
+		auto const reference = 1.0e10 + 0.1 * 999'999.0;
+		auto const naive = [&] {
+			auto r = 0.0;
+			for( auto v : data ) {
+				r += v;
+			}
+			return r;
+		}( );
+		auto const lanes = Sum( data );
+		auto const pairwise = SumPairwise( data );
+		auto const kahan = SumKahanBabushkaNeumaier( data );
+		daw::println(
+		  "\tabsolute error naive: {}, lanes: {}, pairwise: {}, kahan: {}",
+		  std::abs( naive - reference ),
+		  std::abs( lanes - reference ),
+		  std::abs( pairwise - reference ),
+		  std::abs( kahan - reference ) );
+		daw_ensure( std::abs( pairwise - reference ) <=
+		            std::abs( naive - reference ) );
+		daw_ensure( std::abs( kahan - reference ) < 1.0e-5 );
+
+		for( auto &v : data ) {
+			v = daw::RandomFloat<double>{ }( );
+		}
+		daw::bench_n_test<10>(
+		  "naive sum of 1M doubles",
+		  []( auto const &d ) {
+			  auto r = 0.0;
+			  for( auto v : d ) {
+				  r += v;
+			  }
+			  daw::do_not_optimize( r );
+			  return r;
+		  },
+		  data );
+		daw::bench_n_test<10>(
+		  "Sum of 1M doubles",
+		  []( auto const &d ) {
+			  return Sum( d );
+		  },
+		  data );
+		daw::bench_n_test<10>(
+		  "SumPairwise of 1M doubles",
+		  []( auto const &d ) {
+			  return SumPairwise( d );
+		  },
+		  data );
+		daw::bench_n_test<10>(
+		  "SumKahanBabushkaNeumaier of 1M doubles",
+		  []( auto const &d ) {
+			  return SumKahanBabushkaNeumaier( d );
+		  },
+		  data );
+		daw::bench_n_test<10>(
+		  "Dot of 1M doubles",
+		  []( auto const &d ) {
+			  return Dot( d )( d );
+		  },
+		  data );
+		daw::bench_n_test<10>(
+		  "Moments of 1M doubles",
+		  []( auto const &d ) {
+			  return Moments( d ).m2;
+		  },
+		  data );
+	}
+	DAW_ATTRIB_NOINLINE void test021( ) {
+		daw::println( "\ntest021: size hints, To preallocation and Into" );
+		auto const ints = pipeline( iota_view( 0, 1000 ), To<std::vector> );
+		auto const mapped = pipeline( ints, Map( []( int i ) {
+			                              return i * 2;
+		                              } ) );
+		daw_ensure( range_size_hint( mapped ).is_exact( ) );
+		daw_ensure( range_size_hint( mapped ).value == 1000 );
+
+		auto const filtered = pipeline( ints, Filter( []( int i ) {
+			                                return i % 3 == 0;
+		                                } ) );
+		daw_ensure( range_size_hint( filtered ).kind ==
+		            size_hint_kind::upper_bound );
+		daw_ensure( range_size_hint( filtered ).value == 1000 );
+
+		auto const taken = pipeline( ints, Take( 10 ) );
+		daw_ensure( range_size_hint( taken ).is_exact( ) and
+		            range_size_hint( taken ).value == 10 );
+		auto const skipped = pipeline( ints, Skip( 990 ) );
+		daw_ensure( range_size_hint( skipped ).is_exact( ) and
+		            range_size_hint( skipped ).value == 10 );
+
+		auto const zipped = zip_view( ints, std::array{ 1, 2, 3 } );
+		daw_ensure( range_size_hint( zipped ).is_exact( ) and
+		            range_size_hint( zipped ).value == 3 );
+		auto const joined = concat_view( ints, std::array{ 1, 2, 3 } );
+		daw_ensure( range_size_hint( joined ).is_exact( ) and
+		            range_size_hint( joined ).value == 1003 );
+
+		auto const multiples = pipeline( filtered, To<std::vector> );
+		daw_ensure( multiples.size( ) == 334 );
+		daw_ensure( multiples.capacity( ) == 1000 );
+		auto const doubled = pipeline( mapped, To<std::vector> );
+		daw_ensure( doubled.size( ) == 1000 and doubled.capacity( ) == 1000 );
+		daw_ensure( doubled.back( ) == 1998 );
+
+		auto buffer = std::vector<int>( );
+		daw_ensure( pipeline( mapped, Into( buffer ) ) == 1000 );
+		daw_ensure( pipeline( taken, Into( buffer ) ) == 10 );
+		daw_ensure( buffer.size( ) == 1010 and buffer[1009] == 9 );
+		auto const *const old_data = buffer.data( );
+		buffer.clear( );
+		daw_ensure( pipeline( filtered, Into( buffer ) ) == 334 );
+		daw_ensure( buffer.data( ) == old_data );
+
+		auto big = pipeline( iota_view( 0, 1'000'000 ), To<std::vector> );
+		daw::bench_n_test<10>(
+		  "To<std::vector> of Filter over 1M ints",
+		  []( auto const &v ) {
+			  return pipeline( v,
+			                   Filter( []( int i ) {
+				                   return i % 2 == 0;
+			                   } ),
+			                   To<std::vector> )
+			    .size( );
+		  },
+		  big );
+		auto out = std::vector<int>( );
+		daw::bench_n_test<10>(
+		  "Into reused std::vector of Filter over 1M ints",
+		  [&]( auto const &v ) {
+			  out.clear( );
+			  return pipeline( v,
+			                   Filter( []( int i ) {
+				                   return i % 2 == 0;
+			                   } ),
+			                   Into( out ) );
+		  },
+		  big );
+	}
 } // namespace tests
 
 int main( ) {
@@ -392,6 +681,10 @@ int main( ) {
 	tests::test015( );
 	tests::test016( );
 	tests::test017( );
+	tests::test018( );
+	tests::test019( );
+	tests::test020( );
+	tests::test021( );
 
 	daw::println( "Done" );
 }
@@ -9,6 +9,9 @@
 #include "daw/daw_benchmark.h"
 #include "daw/daw_poly_value.h"
 
+#include <cstddef>
+#include <vector>
+
 struct Base {
 	Base( ) = default;
 	Base( Base const & ) = default;
@@ -74,7 +77,159 @@ char func6( Base const *b ) {
 	return b->get( );
 }
 
+struct BigChild : Base {
+	char data[128] = { };
+	BigChild( ) = default;
+	BigChild( BigChild const & ) = default;
+	BigChild( BigChild && ) = default;
+	BigChild &operator=( BigChild const & ) = default;
+	BigChild &operator=( BigChild && ) = default;
+	~BigChild( ) override;
+	char get( ) const override {
+		return 'G';
+	}
+};
+BigChild::~BigChild( ) {}
+
+struct CountedChild : Base {
+	int *count;
+	explicit CountedChild( int *c )
+	  : count( c ) {
+		++*count;
+	}
+	CountedChild( CountedChild const &other )
+	  : Base( other )
+	  , count( other.count ) {
+		++*count;
+	}
+	CountedChild( CountedChild &&other ) noexcept
+	  : Base( std::move( other ) )
+	  , count( other.count ) {
+		++*count;
+	}
+	CountedChild &operator=( CountedChild const & ) = delete;
+	CountedChild &operator=( CountedChild && ) = delete;
+	~CountedChild( ) override;
+	char get( ) const override {
+		return 'N';
+	}
+};
+CountedChild::~CountedChild( ) {
+	--*count;
+}
+
+struct ThrowingMoveChild : Base {
+	ThrowingMoveChild( ) = default;
+	ThrowingMoveChild( ThrowingMoveChild const & ) = default;
+	ThrowingMoveChild( ThrowingMoveChild &&other ) noexcept( false )
+	  : Base( std::move( other ) ) {}
+	ThrowingMoveChild &operator=( ThrowingMoveChild const & ) = default;
+	ThrowingMoveChild &operator=( ThrowingMoveChild && ) = default;
+	~ThrowingMoveChild( ) override;
+	char get( ) const override {
+		return 'T';
+	}
+};
+ThrowingMoveChild::~ThrowingMoveChild( ) {}
+
+static_assert(
+  std::is_nothrow_move_constructible_v<daw::sbo_poly_value<Base>> );
+static_assert( std::is_nothrow_move_assignable_v<daw::sbo_poly_value<Base>> );
+
+void sbo_poly_value_test( ) {
+	using value_t = daw::sbo_poly_value<Base>;
+	auto v0 = value_t( );
+	auto v1 = value_t( daw::construct_emplace<Child> );
+	daw::expecting( 'B', v0->get( ) );
+	daw::expecting( 'C', v1->get( ) );
+	daw::expecting( v0.is_local( ) and v1.is_local( ) );
+	v0 = v1;
+	daw::expecting( 'C', v0->get( ) );
+
+	auto big = value_t( BigChild{ } );
+	daw::expecting( not big.is_local( ) );
+	auto big2 = big;
+	daw::expecting( 'G', big2->get( ) );
+	auto moved = std::move( big );
+	daw::expecting( 'G', moved->get( ) );
+	daw::expecting( not big.has_value( ) );
+	big = v1;
+	daw::expecting( 'C', big->get( ) );
+	daw::expecting( 'C', func3( big ) );
+
+	// Small, but allocated as moving it could throw
+	auto throwing = value_t( ThrowingMoveChild{ } );
+	daw::expecting( not throwing.is_local( ) );
+	auto throwing2 = std::move( throwing );
+	daw::expecting( 'T', throwing2->get( ) );
+
+	// Assigning the held value to itself
+	auto &held = static_cast<Child &>( *v1 );
+	v1 = held;
+	daw::expecting( 'C', v1->get( ) );
+	v1 = std::move( static_cast<Child &>( *v1 ) );
+	daw::expecting( 'C', v1->get( ) );
+
+	int live = 0;
+	{
+		auto c0 = value_t( daw::construct_emplace<CountedChild>, &live );
+		daw::expecting( 1, live );
+		auto c1 = c0;
+		daw::expecting( 2, live );
+		auto c2 = std::move( c1 );
+		daw::expecting( 2, live );
+		c2 = BigChild{ };
+		daw::expecting( 1, live );
+		c2.emplace<CountedChild>( &live );
+		daw::expecting( 2, live );
+		daw::expecting( 'N', c2->get( ) );
+	}
+	daw::expecting( 0, live );
+}
+
+template<typename Value>
+std::vector<Value> make_values( std::size_t count ) {
+	auto result = std::vector<Value>( );
+	result.reserve( count );
+	for( std::size_t n = 0; n < count; ++n ) {
+		if( n % 2 == 0 ) {
+			result.emplace_back( daw::construct_emplace<Child> );
+		} else {
+			result.emplace_back( daw::construct_emplace<Base> );
+		}
+	}
+	return result;
+}
+
+template<typename Value>
+void bench_values( std::string const &name ) {
+	constexpr std::size_t count = 200'000;
+	auto const values = make_values<Value>( count );
+	daw::bench_n_test<10>(
+	  name + ": copy 200k",
+	  []( auto const &v ) {
+		  auto copy = v;
+		  return copy.size( );
+	  },
+	  values );
+	auto const sum = daw::bench_n_test<10>(
+	  name + ": iterate 200k",
+	  []( auto const &v ) {
+		  std::size_t result = 0;
+		  for( auto const &p : v ) {
+			  result += static_cast<std::size_t>( p->get( ) );
+		  }
+		  return result;
+	  },
+	  values );
+	daw::expecting( sum.get( ) == ( count / 2 ) * ( 'B' + 'C' ) );
+}
+
 int main( ) {
+	sbo_poly_value_test( );
+	bench_values<daw::poly_value<Base>>( "poly_value" );
+	bench_values<daw::sbo_poly_value<Base>>( "sbo_poly_value" );
+
 	auto v0 = daw::poly_value<Base>( );
 	auto v1 = daw::poly_value<Base>( daw::construct_emplace<Child> );
 	daw::expecting( 'B', v0->get( ) );
@@ -0,0 +1,190 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include "daw/daw_print.h"
+
+#include "daw/daw_benchmark.h"
+#include "daw/daw_do_not_optimize.h"
+#include "daw/daw_ensure.h"
+
+#include <cstddef>
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+#if defined( __cpp_lib_print )
+#include <print>
+#endif
+
+namespace {
+	/// A temporary file that can be read back after printing to it
+	struct temp_file {
+		FILE *f = std::tmpfile( );
+
+		temp_file( ) {
+			daw_ensure( f != nullptr );
+		}
+
+		temp_file( temp_file const & ) = delete;
+		temp_file &operator=( temp_file const & ) = delete;
+
+		~temp_file( ) {
+			std::fclose( f );
+		}
+
+		[[nodiscard]] std::string contents( ) const {
+			std::fflush( f );
+			std::rewind( f );
+			auto result = std::string( );
+			char buff[1024];
+			auto sz = std::size_t{ 0 };
+			while( ( sz = std::fread( buff, 1, sizeof( buff ), f ) ) > 0 ) {
+				result.append( buff, sz );
+			}
+			return result;
+		}
+	};
+
+	void test_print( ) {
+		auto tf = temp_file( );
+		daw::print( tf.f, "{} + {} = {}", 1, 2, 3 );
+		daw::println( tf.f, "!" );
+		daw_ensure( tf.contents( ) == "1 + 2 = 3!\n" );
+	}
+
+	void test_print_large( ) {
+		// Larger than the stack buffer
+		auto tf = temp_file( );
+		auto const big = std::string( 2000, 'a' );
+		daw::print( tf.f, "{}", big );
+		daw::println( tf.f, "{}", big );
+		daw_ensure( tf.contents( ) == big + big + '\n' );
+	}
+
+	void test_print_exact( ) {
+		// Exactly filling the stack buffer, with and without the newline
+		auto tf = temp_file( );
+		auto const exact =
+		  std::string( daw::print_details::stack_buffer_size, 'b' );
+		daw::print( tf.f, "{}", exact );
+		daw::println( tf.f, "{}", exact );
+		daw_ensure( tf.contents( ) == exact + exact + '\n' );
+	}
+
+	void test_print_truncated( ) {
+		auto tf = temp_file( );
+		daw_ensure( not daw::print_truncated<8>( tf.f, "{}", 1234 ) );
+		daw_ensure( daw::print_truncated<8>( tf.f, "{}", "0123456789" ) );
+		daw_ensure( tf.contents( ) == "123401234567" );
+	}
+
+	void test_output_buffer( ) {
+		auto tf = temp_file( );
+		{
+			auto out = daw::output_buffer( tf.f );
+			out.print( "{}:{}", "a", 1 );
+			out.println( "" );
+			out.put( 'x' );
+			out.write( "yz" );
+			daw_ensure( out.size( ) == 7 );
+			// Nothing is written until a flush
+			daw_ensure( tf.contents( ).empty( ) );
+			out.flush( );
+			daw_ensure( out.size( ) == 0 );
+			daw_ensure( tf.contents( ) == "a:1\nxyz" );
+		}
+	}
+
+	void test_output_buffer_overflow( ) {
+		auto tf = temp_file( );
+		auto expected = std::string( );
+		{
+			auto out = daw::output_buffer( tf.f );
+			// Crosses the buffer boundary many times
+			for( int n = 0; n < 5000; ++n ) {
+				out.println( "line {}", n );
+				expected += "line " + std::to_string( n ) + '\n';
+			}
+			// Larger than the buffer
+			auto const big = std::string( daw::output_buffer::capacity + 10, 'c' );
+			out.print( "{}", big );
+			out.write( big );
+			expected += big + big;
+			daw_ensure( out.print_truncated( 4, "{}", 123456 ) );
+			expected += "1234";
+		}
+		daw_ensure( tf.contents( ) == expected );
+	}
+
+	void bench_print( ) {
+		constexpr int line_count = 10'000;
+		auto tf = temp_file( );
+		auto const result_buffer = daw::bench_n_test<10>(
+		  "daw::output_buffer: 10k lines",
+		  []( FILE *f ) {
+			  auto const start = std::ftell( f );
+			  auto out = daw::output_buffer( f );
+			  for( int n = 0; n < line_count; ++n ) {
+				  out.println( "{} {} {}", n, 3.5, "text" );
+			  }
+			  out.flush( );
+			  daw::do_not_optimize( out );
+			  return std::ftell( f ) - start;
+		  },
+		  tf.f );
+		auto const result_print = daw::bench_n_test<10>(
+		  "daw::println: 10k lines",
+		  []( FILE *f ) {
+			  auto const start = std::ftell( f );
+			  for( int n = 0; n < line_count; ++n ) {
+				  daw::println( f, "{} {} {}", n, 3.5, "text" );
+			  }
+			  std::fflush( f );
+			  return std::ftell( f ) - start;
+		  },
+		  tf.f );
+		auto const result_printf = daw::bench_n_test<10>(
+		  "fprintf: 10k lines",
+		  []( FILE *f ) {
+			  auto const start = std::ftell( f );
+			  for( int n = 0; n < line_count; ++n ) {
+				  std::fprintf( f, "%d %g %s\n", n, 3.5, "text" );
+			  }
+			  std::fflush( f );
+			  return std::ftell( f ) - start;
+		  },
+		  tf.f );
+		daw_ensure( result_buffer.get( ) == result_print.get( ) );
+		daw_ensure( result_buffer.get( ) == result_printf.get( ) );
+#if defined( __cpp_lib_print )
+		auto const result_std_print = daw::bench_n_test<10>(
+		  "std::println: 10k lines",
+		  []( FILE *f ) {
+			  auto const start = std::ftell( f );
+			  for( int n = 0; n < line_count; ++n ) {
+				  std::println( f, "{} {} {}", n, 3.5, "text" );
+			  }
+			  std::fflush( f );
+			  return std::ftell( f ) - start;
+		  },
+		  tf.f );
+		daw_ensure( result_buffer.get( ) == result_std_print.get( ) );
+#endif
+	}
+} // namespace
+
+int main( ) {
+	test_print( );
+	test_print_large( );
+	test_print_exact( );
+	test_print_truncated( );
+	test_output_buffer( );
+	test_output_buffer_overflow( );
+	bench_print( );
+	std::cout << "Done\n";
+}
@@ -13,8 +13,11 @@
 
 #include <cstdint>
 #include <cstdlib>
+#include <algorithm>
 #include <iostream>
 #include <limits>
+#include <list>
+#include <random>
 #include <vector>
 
 void daw_random_01( ) {
@@ -185,6 +188,192 @@ void daw_make_random_02( ) {
 	std::cout << "\n\n";
 }
 
+static_assert( [] {
+	// Reference output of the PCG32 demo program
+	auto rng = daw::pcg32( 42U, 54U );
+	return rng( ) == 0xA15C'02B7U and rng( ) == 0x7B47'F409U;
+}( ) );
+
+static_assert( [] {
+	auto a = daw::pcg32( 1U );
+	auto b = a;
+	a.advance( 1000 );
+	b.discard( 0 );
+	for( int n = 0; n < 1000; ++n ) {
+		(void)b( );
+	}
+	return a == b;
+}( ) );
+
+static_assert( [] {
+	auto rng = daw::xoshiro256pp( 3U );
+	for( int n = 0; n < 1000; ++n ) {
+		auto const v = daw::uniform_int( rng, -3, 3 );
+		if( v < -3 or v > 3 ) {
+			return false;
+		}
+	}
+	return true;
+}( ) );
+
+void engine_streams_01( ) {
+	// Lane n of xoshiro256pp_lanes is the base generator jumped n times
+	auto base = daw::xoshiro256pp( 9U );
+	auto lanes = daw::xoshiro256pp_lanes<4>( base );
+	std::uint64_t out[17];
+	(void)lanes( );
+	lanes.generate( out, 17 );
+	for( std::size_t lane = 0; lane < 4; ++lane ) {
+		auto expected = base;
+		for( std::size_t n = 0; n < 18; ++n ) {
+			auto const v = expected( );
+			auto const idx = n * 4 + lane;
+			if( idx > 0 and idx <= 17 ) {
+				daw::expecting( out[idx - 1] == v );
+			}
+		}
+		base.jump( );
+	}
+
+	auto w = daw::wyrand( 1U );
+	auto w2 = w;
+	std::uint64_t bits[5];
+	w2.generate( bits, 5 );
+	for( auto b : bits ) {
+		daw::expecting( b == w( ) );
+	}
+	daw::expecting( w == w2 );
+
+	auto p = daw::pcg32( 5U );
+	auto p2 = p.split( );
+	daw::expecting( p != p2 );
+}
+
+void global_streams_01( ) {
+	// The global engine does not continue into any lane of the bulk engine
+	daw::reseed( 12345U );
+	auto v = std::vector<std::uint64_t>( 64 );
+	daw::random_fill( v.begin( ),
+	                  v.end( ),
+	                  std::uint64_t{ 0 },
+	                  ( std::numeric_limits<std::uint64_t>::max )( ) );
+	for( int n = 0; n < 64; ++n ) {
+		auto const x = daw::impl::global_rng( )( );
+		daw::expecting( std::find( v.begin( ), v.end( ), x ) == v.end( ) );
+	}
+}
+
+template<typename Integer, typename Engine>
+void uniformity_test( Engine rng, Integer a, Integer b ) {
+	// Every value in a small range should be hit about equally often
+	auto const range = static_cast<std::size_t>( b - a ) + 1U;
+	auto bins = std::vector<std::size_t>( range );
+	constexpr std::size_t per_bin = 10'000;
+	for( std::size_t n = 0; n < range * per_bin; ++n ) {
+		auto const v = daw::uniform_int( rng, a, b );
+		daw::expecting( a <= v and v <= b );
+		++bins[static_cast<std::size_t>( v - a )];
+	}
+	for( auto const c : bins ) {
+		daw::expecting( c > per_bin * 9 / 10 and c < per_bin * 11 / 10 );
+	}
+}
+
+void uniform_int_01( ) {
+	uniformity_test( daw::xoshiro256pp( 1U ), -5, 5 );
+	uniformity_test( daw::wyrand( 2U ), std::uint8_t{ 0 }, std::uint8_t{ 6 } );
+	uniformity_test( daw::pcg32( 3U ), std::int64_t{ -20 }, std::int64_t{ 20 } );
+	uniformity_test( std::mt19937( 4U ), 1U, 6U );
+
+	auto rng = daw::xoshiro256pp( 5U );
+	// Full range needs no mapping
+	(void)daw::uniform_int( rng,
+	                        ( std::numeric_limits<std::int64_t>::min )( ),
+	                        ( std::numeric_limits<std::int64_t>::max )( ) );
+	for( int n = 0; n < 10'000; ++n ) {
+		auto const d = daw::uniform_real<double>( rng );
+		daw::expecting( 0.0 <= d and d < 1.0 );
+		auto const f = daw::uniform_real( rng, -2.0f, 2.0f );
+		daw::expecting( -2.0f <= f and f <= 2.0f );
+	}
+}
+
+void random_fill_02( ) {
+	auto ints = std::vector<std::int16_t>( 10'007 );
+	daw::random_fill( ints.begin( ), ints.end( ), std::int16_t{ -3 },
+	                  std::int16_t{ 3 } );
+	for( auto v : ints ) {
+		daw::expecting( -3 <= v and v <= 3 );
+	}
+	auto dbls = std::vector<double>( 10'007 );
+	daw::random_fill( dbls.begin( ), dbls.end( ), 1.0, 2.0 );
+	for( auto v : dbls ) {
+		daw::expecting( 1.0 <= v and v < 2.0 );
+	}
+
+	// The same seed gives the same data
+	auto lst = std::list<int>( 100 );
+	auto rng1 = daw::wyrand( 7U );
+	daw::random_fill( rng1, lst.begin( ), lst.end( ), 0, 1000 );
+	auto vec = std::vector<int>( 100 );
+	auto rng2 = daw::wyrand( 7U );
+	daw::random_fill( rng2, vec.begin( ), vec.end( ), 0, 1000 );
+	daw::expecting( std::equal( lst.begin( ), lst.end( ), vec.begin( ) ) );
+}
+
+void engine_bench( ) {
+	constexpr std::size_t count = 1'000'000ULL;
+	auto values = std::vector<std::uint32_t>( count );
+	daw::bench_n_test<50>(
+	  "mt19937_64 + uniform_int_distribution [0, 1000) * 1,000,000", [&] {
+		  auto rng = std::mt19937_64( 1U );
+		  auto dist = std::uniform_int_distribution<std::uint32_t>( 0, 999 );
+		  for( auto &v : values ) {
+			  v = dist( rng );
+		  }
+		  daw::do_not_optimize( values.data( ) );
+	  } );
+	auto const bench_engine = [&]( char const *title, auto rng ) {
+		daw::bench_n_test<50>( title, [&] {
+			for( auto &v : values ) {
+				v = daw::uniform_below( rng, std::uint32_t{ 1000 } );
+			}
+			daw::do_not_optimize( values.data( ) );
+		} );
+	};
+	bench_engine( "xoshiro256pp + uniform_below [0, 1000) * 1,000,000",
+	              daw::xoshiro256pp( 1U ) );
+	bench_engine( "wyrand + uniform_below [0, 1000) * 1,000,000",
+	              daw::wyrand( 1U ) );
+	bench_engine( "pcg32 + uniform_below [0, 1000) * 1,000,000",
+	              daw::pcg32( 1U ) );
+
+	daw::bench_n_test<50>( "randint [0, 1000) * 1,000,000", [&] {
+		for( auto &v : values ) {
+			v = daw::randint<std::uint32_t>( 0, 999 );
+		}
+		daw::do_not_optimize( values.data( ) );
+	} );
+	daw::bench_n_test<50>( "random_fill [0, 1000) * 1,000,000", [&] {
+		daw::random_fill( values.begin( ), values.end( ), 0U, 999U );
+		daw::do_not_optimize( values.data( ) );
+	} );
+	auto dbls = std::vector<double>( count );
+	daw::bench_n_test<50>(
+	  "mt19937_64 + uniform_real_distribution double * 1,000,000", [&] {
+		  auto rng = std::mt19937_64( 1U );
+		  auto dist = std::uniform_real_distribution<double>( 0.0, 1.0 );
+		  for( auto &v : dbls ) {
+			  v = dist( rng );
+		  }
+		  daw::do_not_optimize( dbls.data( ) );
+	  } );
+	daw::bench_n_test<50>( "random_fill double * 1,000,000", [&] {
+		daw::random_fill( dbls.begin( ), dbls.end( ), 0.0, 1.0 );
+		daw::do_not_optimize( dbls.data( ) );
+	} );
+}
+
 int main( ) {
 	daw_random_01( );
 	daw_random_02( );
@@ -197,4 +386,9 @@ int main( ) {
 	random_class_integer_bench_float( );
 	random_class_integer_bench_double( );
 	daw_make_random_02( );
+	engine_streams_01( );
+	global_streams_01( );
+	uniform_int_01( );
+	random_fill_02( );
+	engine_bench( );
 }
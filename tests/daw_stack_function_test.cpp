@@ -9,11 +9,18 @@
 #include "daw/daw_stack_function.h"
 
 #include "daw/daw_benchmark.h"
+#include "daw/daw_do_not_optimize.h"
+#include "daw/daw_function_ref.h"
+#include "daw/daw_function_view.h"
 #include "daw/daw_mutable_capture.h"
+#include "daw/traits/daw_traits_identity.h"
 #include "daw/daw_utility.h"
 
+#include <cstddef>
 #include <functional>
 #include <iostream>
+#include <memory>
+#include <vector>
 
 std::string strfunc( ) {
 	return "Goodbye";
@@ -90,7 +97,178 @@ void stack_function_test_002( ) {
 	fcvf1( );
 }
 
+// Only callables with a matching signature are accepted
+static_assert( std::is_constructible_v<daw::move_only_function<int( int )>,
+                                       int ( * )( int )> );
+static_assert(
+  not std::is_constructible_v<daw::move_only_function<int( int )>, int> );
+static_assert( not std::is_constructible_v<daw::move_only_function<int( int )>,
+                                           std::string ( * )( )> );
+using nothrow_function_t = daw::move_only_function<int( int ) noexcept>;
+static_assert(
+  not std::is_convertible_v<int ( * )( int ), nothrow_function_t> );
+
+int overloaded( daw::move_only_function<int( int )> f ) {
+	return f( 1 );
+}
+
+int overloaded( daw::move_only_function<int( std::string const & )> f ) {
+	return f( "ab" );
+}
+
+void move_only_function_test_001( ) {
+	auto ptr = std::make_unique<int>( 42 );
+	daw::move_only_function<int( int )> f = [p = std::move( ptr )]( int x ) {
+		return *p + x;
+	};
+	daw::expecting( 44, f( 2 ) );
+	auto f2 = std::move( f );
+	daw::expecting( not f );
+	daw::expecting( 45, f2( 3 ) );
+	try {
+		(void)f( 1 );
+		daw::expecting( false );
+	} catch( std::bad_function_call const & ) {}
+
+	daw::move_only_function<std::string( ) const> cf = strfunc;
+	daw::expecting( std::string( "Goodbye" ), cf( ) );
+	std::string ( *null_fp )( ) = nullptr;
+	cf = null_fp;
+	daw::expecting( cf.empty( ) );
+
+	daw::move_only_function<int( int ) const noexcept> nf =
+	  []( int x ) noexcept {
+		  return x * 2;
+	  };
+	daw::expecting( 8, nf( 4 ) );
+	static_assert( noexcept( nf( 4 ) ) );
+
+	// Too large for the buffer, heap allocated
+	struct big_t {
+		char data[256] = { };
+		int operator( )( ) const {
+			return 7;
+		}
+	};
+	daw::move_only_function<int( ) const> bf = big_t{ };
+	auto bf2 = std::move( bf );
+	daw::expecting( 7, bf2( ) );
+
+	// Non-trivial inline callables are moved and destroyed exactly once
+	auto count = std::make_shared<int>( 0 );
+	{
+		daw::move_only_function<long( )> sf = [count]( ) {
+			return count.use_count( );
+		};
+		daw::expecting( 2L, sf( ) );
+		auto sf2 = std::move( sf );
+		daw::expecting( 2L, sf2( ) );
+		sf2 = nullptr;
+		daw::expecting( 1L, count.use_count( ) );
+		sf2 = [count]( ) {
+			return 3L;
+		};
+	}
+	daw::expecting( 1L, count.use_count( ) );
+
+	daw::move_only_function<int( int ), 8, alignof( void * )> small_buffer =
+	  [a = 1, b = 2, c = 3]( int x ) {
+		  return a + b + c + x;
+	  };
+	daw::expecting( 10, small_buffer( 4 ) );
+	auto sb2 = std::move( small_buffer );
+	daw::expecting( 10, sb2( 4 ) );
+
+	auto in_place =
+	  daw::move_only_function<int( ) const>( std::in_place_type<big_t> );
+	daw::expecting( 7, in_place( ) );
+
+	daw::expecting( 2, overloaded( []( int x ) {
+		                return x + 1;
+	                } ) );
+	daw::expecting( 2, overloaded( []( std::string const &str ) {
+		                return static_cast<int>( str.size( ) );
+	                } ) );
+}
+
+void move_only_function_bench( ) {
+	constexpr std::size_t count = 1000;
+	constexpr std::size_t reps = 1000;
+	auto make = []( int k ) {
+		return [k]( int x ) {
+			return x + k;
+		};
+	};
+	using lambda_t = decltype( make( 0 ) );
+	auto lambdas = std::vector<lambda_t>( );
+	auto std_funcs = std::vector<std::function<int( int )>>( );
+	auto mo_funcs = std::vector<daw::move_only_function<int( int ) const>>( );
+	auto refs = std::vector<daw::function_ref<int( int )>>( );
+	auto views = std::vector<daw::function_view<int( int )>>( );
+	lambdas.reserve( count );
+	std_funcs.reserve( count );
+	mo_funcs.reserve( count );
+	refs.reserve( count );
+	views.reserve( count );
+	for( std::size_t n = 0; n < count; ++n ) {
+		lambdas.push_back( make( static_cast<int>( n ) ) );
+	}
+	for( auto const &l : lambdas ) {
+		std_funcs.emplace_back( l );
+		mo_funcs.emplace_back( l );
+		refs.emplace_back( l );
+		views.emplace_back( l );
+	}
+	auto const call_all = []( auto const &funcs ) {
+		int result = 0;
+		for( std::size_t r = 0; r < reps; ++r ) {
+			for( auto const &f : funcs ) {
+				result = f( result );
+			}
+		}
+		daw::do_not_optimize( result );
+		return result;
+	};
+	auto const expected =
+	  daw::bench_n_test<10>( "std::function: 1M calls", call_all, std_funcs );
+	auto const mo_result = daw::bench_n_test<10>(
+	  "daw::move_only_function: 1M calls", call_all, mo_funcs );
+	auto const ref_result =
+	  daw::bench_n_test<10>( "daw::function_ref: 1M calls", call_all, refs );
+	auto const view_result =
+	  daw::bench_n_test<10>( "daw::function_view: 1M calls", call_all, views );
+	daw::expecting( *expected, *mo_result );
+	daw::expecting( *expected, *ref_result );
+	daw::expecting( *expected, *view_result );
+
+	// A task payload too large for std::function's inline buffer
+	auto const construct_all = []( auto tag, auto const &ls ) {
+		using func_t = typename decltype( tag )::type;
+		std::size_t result = 0;
+		for( auto const &l : ls ) {
+			auto f = func_t( [l, a = result, b = &ls]( int x ) {
+				return l( x ) + static_cast<int>( a ) + static_cast<int>( b->size( ) );
+			} );
+			result += static_cast<bool>( f );
+			daw::do_not_optimize( f );
+		}
+		return result;
+	};
+	daw::bench_n_test<10>(
+	  "std::function: construct and destroy 1k",
+	  construct_all,
+	  daw::traits::identity<std::function<int( int )>>{ },
+	  lambdas );
+	daw::bench_n_test<10>(
+	  "daw::move_only_function: construct and destroy 1k",
+	  construct_all,
+	  daw::traits::identity<daw::move_only_function<int( int ) const>>{ },
+	  lambdas );
+}
+
 int main( ) {
 	stack_function_test_001( );
 	stack_function_test_002( );
+	move_only_function_test_001( );
+	move_only_function_bench( );
 }
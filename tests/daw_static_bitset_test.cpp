@@ -9,9 +9,12 @@
 #include "daw/daw_static_bitset.h"
 
 #include "daw/daw_benchmark.h"
+#include "daw/daw_ensure.h"
 
-#include <bitset>
+#include <cstddef>
 #include <iostream>
+#include <string>
+#include <vector>
 
 static_assert( []( ) {
 	daw::static_bitset<128> b(
@@ -19,6 +22,31 @@ static_assert( []( ) {
 	  "000000000000000000000000000000000000000000000000000000" );
 	daw::expecting( 1U, b.one_count( ) );
 	daw::expecting( 127U, b.zero_count( ) );
+	daw::expecting( 127U, b.find_first( ) );
+	return true;
+}( ) );
+
+static_assert( []( ) {
+	// Top bit masking to BitWidth
+	daw::static_bitset<16> h1( 0xDEAD'BEEFU );
+	daw::static_bitset<16> h2( 0xBEEFU );
+	daw::expecting( h1, h2 );
+	daw::expecting( 16U, ( ~daw::static_bitset<16>( ) ).one_count( ) );
+	return true;
+}( ) );
+
+static_assert( []( ) {
+	daw::static_bitset<200> b{ };
+	b.set_bit( 3 );
+	b.set_bit( 64 );
+	b.set_bit( 199 );
+	daw::expecting( 3U, b.find_first( ) );
+	daw::expecting( 64U, b.find_next( 4 ) );
+	daw::expecting( 199U, b.find_next( 65 ) );
+	daw::expecting( daw::static_bitset<200>::npos, b.find_next( 200 ) );
+	daw::expecting( 2U, b.rank( 65 ) );
+	daw::expecting( 199U, b.select( 2 ) );
+	daw::expecting( daw::static_bitset<200>::npos, b.select( 3 ) );
 	return true;
 }( ) );
 
@@ -26,38 +54,73 @@ bool test_001( ) noexcept {
 	daw::static_bitset<128> b2(
 	  0U, 0b1000000000000000000000000000000000000000000000000000000000000000 );
 	return 127U == b2.zero_count( );
-};
-// static_assert( test_001( ) );
+}
 
 bool test_002( ) noexcept {
 	daw::static_bitset<64> f( 0xFFFF'FFFF'FFFF'FFFF );
 	f >>= 33U;
 	daw::expecting( 31U, f.one_count( ) );
 	return true;
-};
-// static_assert( test_002( ) );
-
-int main( ) {
-	auto tst2 = test_002( );
-	daw::static_bitset<128> a( std::numeric_limits<uintmax_t>::max( ) );
-
-	auto ac = a.one_count( );
+}
 
+void test_shifts( ) {
 	daw::static_bitset<64> e( 0xFFFF'FFFF'FFFF'FFFF );
 	e <<= 5U;
-	std::cout << e << '\n';
+	daw::expecting( 59U, e.one_count( ) );
+	daw::expecting( 5U, e.find_first( ) );
 
 	daw::static_bitset<64> g( 0xFFFF'FFFF'FFFF'FFFF );
 	g >>= 64;
 	daw::expecting( 0U, g.one_count( ) );
-	/*
-	  static_assert( []( ) {
-	    // Top bit masking to BitWidth
-	    daw::static_bitset<16> h1( 0xDEAD'BEEF );
-	    daw::static_bitset<16> h2( 0xBEEF );
-	    daw::expecting( h1, h2 );
-	    return true;
-	  }( ) );*/
-
-	std::cout << '\n';
+
+	daw::static_bitset<130> h{ };
+	h.set_bit( 1 );
+	h <<= 128U;
+	daw::expecting( 129U, h.find_first( ) );
+	h <<= 1U;
+	// Shifted past the width
+	daw_ensure( h.none( ) );
+	h.set_bit( 129 );
+	h >>= 65U;
+	daw::expecting( 64U, h.find_first( ) );
+}
+
+void test_ops( ) {
+	daw::static_bitset<100> a{ };
+	daw::static_bitset<100> b{ };
+	for( std::size_t n = 0; n < 100; n += 2 ) {
+		a.set_bit( n );
+	}
+	for( std::size_t n = 0; n < 100; n += 3 ) {
+		b.set_bit( n );
+	}
+	daw::expecting( 17U, ( a & b ).one_count( ) );
+	daw::expecting( 17U, a.count_and( b ) );
+	daw::expecting( 67U, ( a | b ).one_count( ) );
+	daw::expecting( 50U, ( a ^ b ).one_count( ) );
+	auto c = a;
+	c.and_not( b );
+	daw::expecting( 33U, c.one_count( ) );
+	auto seen = std::vector<std::size_t>( );
+	b.for_each_set_bit( [&]( std::size_t pos ) {
+		seen.push_back( pos );
+	} );
+	daw::expecting( 34U, seen.size( ) );
+	for( std::size_t n = 0; n < seen.size( ); ++n ) {
+		daw::expecting( n * 3U, seen[n] );
+		daw::expecting( n * 3U, b.select( n ) );
+		daw::expecting( n, b.rank( n * 3U ) );
+	}
+	daw::expecting( std::string( "101" ),
+	                daw::static_bitset<3>( 0b101U ).to_string( ) );
+	daw::expecting( std::string( "0000000000000000000000000000000F" ),
+	                daw::static_bitset<128>( 0xFU ).to_string( daw::fmt_hex ) );
+}
+
+int main( ) {
+	daw_ensure( test_001( ) );
+	daw_ensure( test_002( ) );
+	test_shifts( );
+	test_ops( );
+	std::cout << "Done\n";
 }
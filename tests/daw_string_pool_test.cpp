@@ -0,0 +1,198 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include "daw/daw_string_pool.h"
+
+#include "daw/daw_benchmark.h"
+#include "daw/daw_do_not_optimize.h"
+#include "daw/daw_ensure.h"
+
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+	std::vector<std::string> make_names( std::size_t count ) {
+		auto rng = std::mt19937_64( 1234 );
+		auto result = std::vector<std::string>( );
+		result.reserve( count );
+		for( std::size_t n = 0; n < count; ++n ) {
+			auto name = std::string( "metric." );
+			auto const length = 4U + rng( ) % 24U;
+			for( std::size_t m = 0; m < length; ++m ) {
+				name += static_cast<char>( 'a' + rng( ) % 26U );
+			}
+			name += '.';
+			name += std::to_string( n );
+			result.push_back( std::move( name ) );
+		}
+		return result;
+	}
+
+	template<typename Pool>
+	void test_basic( ) {
+		auto pool = Pool( );
+		daw_ensure( pool.empty( ) );
+		daw_ensure( not pool.find( "cpu.load" ) );
+
+		auto const a = pool.intern( "cpu.load" );
+		auto const b = pool.intern( std::string( "cpu.load" ) );
+		auto const c = pool.intern( "cpu.idle" );
+		auto const e = pool.intern( "" );
+		daw_ensure( a == b and a != c and e != a );
+		daw_ensure( pool.size( ) == 3 );
+		daw_ensure( pool.view( a ) == "cpu.load" and pool[c] == "cpu.idle" );
+		daw_ensure( pool.view( e ).empty( ) );
+		daw_ensure( *pool.find( "cpu.idle" ) == c );
+		// Interned strings are null terminated
+		daw_ensure( pool.view( c ).data( )[8] == '\0' );
+		daw_ensure( a != daw::string_pool_handle( ) );
+
+		// Views stay put while the tables and arenas grow
+		auto const first = pool.view( a ).data( );
+		auto const names = make_names( 20'000 );
+		auto handles = std::vector<daw::string_pool_handle>( );
+		for( auto const &name : names ) {
+			handles.push_back( pool.intern( name ) );
+		}
+		daw_ensure( pool.size( ) == names.size( ) + 3 );
+		daw_ensure( pool.view( a ).data( ) == first );
+		for( std::size_t n = 0; n < names.size( ); ++n ) {
+			daw_ensure( pool.view( handles[n] ) == names[n] );
+			daw_ensure( pool.intern( names[n] ) == handles[n] );
+		}
+		auto const unique = std::unordered_set<daw::string_pool_handle>(
+		  handles.begin( ), handles.end( ) );
+		daw_ensure( unique.size( ) == handles.size( ) );
+	}
+
+	void test_threads( ) {
+		auto const names = make_names( 20'000 );
+		auto pool = daw::string_pool( );
+		constexpr std::size_t thread_count = 4;
+		auto results = std::vector<std::vector<daw::string_pool_handle>>(
+		  thread_count,
+		  std::vector<daw::string_pool_handle>( names.size( ) ) );
+		auto threads = std::vector<std::thread>( );
+		for( std::size_t t = 0; t < thread_count; ++t ) {
+			threads.emplace_back( [&, t] {
+				// Each thread walks the names from a different starting point
+				for( std::size_t m = 0; m < names.size( ); ++m ) {
+					auto const n = ( m + t * names.size( ) / thread_count ) %
+					               names.size( );
+					auto const h = pool.intern( names[n] );
+					daw_ensure( pool.view( h ) == names[n] );
+					results[t][n] = h;
+				}
+			} );
+		}
+		for( auto &th : threads ) {
+			th.join( );
+		}
+		daw_ensure( pool.size( ) == names.size( ) );
+		for( std::size_t t = 1; t < thread_count; ++t ) {
+			daw_ensure( results[t] == results[0] );
+		}
+	}
+
+	void benchmarks( ) {
+		auto const names = make_names( 100'000 );
+		std::size_t name_bytes = 0;
+		for( auto const &name : names ) {
+			name_bytes += name.size( );
+		}
+		auto pool = daw::string_pool( );
+		auto handles = std::vector<daw::string_pool_handle>( );
+		handles.reserve( names.size( ) );
+		for( auto const &name : names ) {
+			handles.push_back( pool.intern( name ) );
+		}
+		std::cout << names.size( ) << " strings averaging "
+		          << name_bytes / names.size( ) << " bytes use "
+		          << pool.memory_used( ) / names.size( )
+		          << " bytes each in a string_pool\n";
+
+		auto set = std::unordered_set<std::string>( names.begin( ), names.end( ) );
+		auto lookups = std::vector<daw::string_view>( );
+		auto rng = std::mt19937_64( 7 );
+		for( std::size_t n = 0; n < 250'000; ++n ) {
+			lookups.emplace_back( names[rng( ) % names.size( )] );
+		}
+		std::size_t lookup_bytes = 0;
+		for( auto const &key : lookups ) {
+			lookup_bytes += key.size( );
+		}
+		std::cout << "Looking up " << lookups.size( ) << " keys\n";
+		(void)daw::bench_n_test_mbs<5>(
+		  "std::unordered_set<std::string>::find",
+		  lookup_bytes,
+		  [&]( std::vector<daw::string_view> const &keys ) {
+			  std::size_t result = 0;
+			  for( auto key : keys ) {
+				  result += set.find( std::string( key.data( ), key.size( ) ) )
+				              ->size( );
+			  }
+			  daw::do_not_optimize( result );
+			  return result;
+		  },
+		  lookups );
+		(void)daw::bench_n_test_mbs<5>(
+		  "daw::string_pool::intern of existing strings",
+		  lookup_bytes,
+		  [&]( std::vector<daw::string_view> const &keys ) {
+			  std::size_t result = 0;
+			  for( auto key : keys ) {
+				  result += pool.intern( key ).value( );
+			  }
+			  daw::do_not_optimize( result );
+			  return result;
+		  },
+		  lookups );
+		auto fnv_pool = daw::basic_string_pool<daw::string_pool_fnv1a_hasher>( );
+		for( auto const &name : names ) {
+			(void)fnv_pool.intern( name );
+		}
+		(void)daw::bench_n_test_mbs<5>(
+		  "daw::basic_string_pool<fnv1a>::intern of existing strings",
+		  lookup_bytes,
+		  [&]( std::vector<daw::string_view> const &keys ) {
+			  std::size_t result = 0;
+			  for( auto key : keys ) {
+				  result += fnv_pool.intern( key ).value( );
+			  }
+			  daw::do_not_optimize( result );
+			  return result;
+		  },
+		  lookups );
+		auto const compared = daw::bench_n_test_mbs<5>(
+		  "daw::string_pool_handle equality",
+		  handles.size( ) * sizeof( daw::string_pool_handle ),
+		  []( std::vector<daw::string_pool_handle> const &hs ) {
+			  std::size_t result = 0;
+			  for( std::size_t n = 1; n < hs.size( ); ++n ) {
+				  result += hs[n] == hs[n - 1] ? 1U : 0U;
+			  }
+			  daw::do_not_optimize( result );
+			  return result;
+		  },
+		  handles );
+		daw_ensure( compared.get( ) == 0 );
+	}
+} // namespace
+
+int main( ) {
+	test_basic<daw::string_pool>( );
+	test_basic<daw::basic_string_pool<daw::string_pool_fnv1a_hasher, 0>>( );
+	test_threads( );
+	benchmarks( );
+	std::cout << "Done\n";
+}
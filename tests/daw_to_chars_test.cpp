@@ -0,0 +1,236 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include "daw/daw_to_chars.h"
+
+#include "daw/daw_benchmark.h"
+#include "daw/daw_do_not_optimize.h"
+#include "daw/daw_ensure.h"
+
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+static_assert( [] {
+	char buff[20]{ };
+	auto const result = daw::to_chars( buff, buff + 20, -1234567 );
+	return std::string_view( buff, static_cast<std::size_t>(
+	                                 result.ptr - buff ) ) == "-1234567";
+}( ) );
+
+namespace {
+	/// daw::to_chars must match std::to_chars byte for byte
+	template<typename T>
+	void check( T value ) {
+		char expected[64];
+		char actual[64];
+		auto const e = std::to_chars( expected, expected + 64, value );
+		auto const a = daw::to_chars( actual, actual + 64, value );
+		auto const e_str = std::string_view(
+		  expected, static_cast<std::size_t>( e.ptr - expected ) );
+		auto const a_str =
+		  std::string_view( actual, static_cast<std::size_t>( a.ptr - actual ) );
+		if( e_str != a_str ) {
+			std::cerr << "Expected '" << e_str << "' but got '" << a_str << "'\n";
+		}
+		daw_ensure( e_str == a_str and a.ec == std::errc{ } );
+		daw_ensure( a_str.size( ) <= daw::max_chars_v<T> );
+	}
+
+	template<typename Float, typename Bits>
+	Float from_bits( Bits bits ) {
+		Float result;
+		std::memcpy( &result, &bits, sizeof( Float ) );
+		return result;
+	}
+
+	void test_integers( ) {
+		check( 0 );
+		check( std::numeric_limits<signed char>::min( ) );
+		check( std::numeric_limits<short>::min( ) );
+		check( std::numeric_limits<int>::min( ) );
+		check( std::numeric_limits<unsigned>::max( ) );
+		check( std::numeric_limits<long long>::min( ) );
+		check( std::numeric_limits<long long>::max( ) );
+		check( std::numeric_limits<unsigned long long>::max( ) );
+		std::uint64_t p10 = 1;
+		for( int n = 0; n < 20; ++n ) {
+			check( p10 - 1U );
+			check( p10 );
+			check( p10 + 1U );
+			p10 *= 10U;
+		}
+		auto rng = std::mt19937_64( 1234 );
+		for( int n = 0; n < 1'000'000; ++n ) {
+			auto const bits = rng( );
+			// Spread over all lengths
+			check( bits >> ( bits % 64U ) );
+			check( static_cast<std::int64_t>( bits ) >> ( bits % 64U ) );
+			check( static_cast<std::int32_t>( bits ) );
+			check( static_cast<std::uint16_t>( bits ) );
+		}
+	}
+
+	void test_floats( ) {
+		constexpr double specials[] = {
+		  0.0,
+		  -0.0,
+		  1.0,
+		  0.1,
+		  0.3,
+		  100.0,
+		  1e5,
+		  1e-5,
+		  1e15,
+		  1e16,
+		  1e21,
+		  1e22,
+		  1e23,
+		  123456.0,
+		  1234.5,
+		  0.001,
+		  9007199254740993.0,
+		  5e-324,
+		  2.2250738585072014e-308,
+		  std::numeric_limits<double>::max( ),
+		  std::numeric_limits<double>::lowest( ),
+		  std::numeric_limits<double>::infinity( ),
+		  -std::numeric_limits<double>::infinity( ),
+		  std::numeric_limits<double>::quiet_NaN( ) };
+		for( double d : specials ) {
+			check( d );
+			check( static_cast<float>( d ) );
+		}
+		check( std::numeric_limits<float>::denorm_min( ) );
+		check( std::numeric_limits<float>::max( ) );
+
+		auto rng = std::mt19937_64( 1234 );
+		for( int n = 0; n < 1'000'000; ++n ) {
+			auto const bits = rng( );
+			check( from_bits<double>( bits ) );
+			check( from_bits<float>( static_cast<std::uint32_t>( bits ) ) );
+			// Values with few digits, as found in data files
+			check( static_cast<double>( bits % 100'000'000U ) / 1'000.0 );
+			check( static_cast<float>( bits % 100'000U ) / 100.0f );
+		}
+		// Every power of 2
+		for( int e = -1074; e < 1024; ++e ) {
+			check( std::ldexp( 1.0, e ) );
+		}
+	}
+
+	void test_buffer_too_small( ) {
+		char buff[4];
+		auto const r0 = daw::to_chars( buff, buff + 4, 12345 );
+		daw_ensure( r0.ec == std::errc::value_too_large and r0.ptr == buff + 4 );
+		auto const r1 = daw::to_chars( buff, buff + 4, 0.12345 );
+		daw_ensure( r1.ec == std::errc::value_too_large and r1.ptr == buff + 4 );
+		auto const r2 = daw::to_chars( buff, buff + 4, 1234 );
+		daw_ensure( r2.ec == std::errc{ } and r2.ptr == buff + 4 );
+	}
+
+	void test_output( ) {
+		auto str = std::string( "x=" );
+		daw::write_chars( std::back_inserter( str ), 42 );
+		str += ", y=";
+		daw::write_chars( std::back_inserter( str ), -0.5 );
+		daw_ensure( str == "x=42, y=-0.5" );
+
+		auto appended = std::string( "[" );
+		daw::append_chars( appended, 1.5f );
+		appended += ',';
+		daw::append_chars( appended, std::numeric_limits<std::int64_t>::min( ) );
+		daw_ensure( appended == "[1.5,-9223372036854775808" );
+	}
+
+	template<typename T>
+	void bench( std::string const &title, std::vector<T> const &values ) {
+		std::cout << "Formatting " << values.size( ) << ' ' << title << '\n';
+		auto const bytes = [&] {
+			std::size_t result = 0;
+			char buff[64];
+			for( auto v : values ) {
+				result += static_cast<std::size_t>(
+				  std::to_chars( buff, buff + 64, v ).ptr - buff );
+			}
+			return result;
+		}( );
+		auto out = std::vector<char>( values.size( ) * daw::max_chars_v<T> );
+		auto const r0 = daw::bench_n_test_mbs<10>(
+		  "std::to_chars",
+		  bytes,
+		  [&]( auto const &vals ) {
+			  char *ptr = out.data( );
+			  char *const last = ptr + out.size( );
+			  for( auto v : vals ) {
+				  ptr = std::to_chars( ptr, last, v ).ptr;
+			  }
+			  daw::do_not_optimize( out );
+			  return static_cast<std::size_t>( ptr - out.data( ) );
+		  },
+		  values );
+		auto const r1 = daw::bench_n_test_mbs<10>(
+		  "daw::to_chars",
+		  bytes,
+		  [&]( auto const &vals ) {
+			  char *ptr = out.data( );
+			  char *const last = ptr + out.size( );
+			  for( auto v : vals ) {
+				  ptr = daw::to_chars( ptr, last, v ).ptr;
+			  }
+			  daw::do_not_optimize( out );
+			  return static_cast<std::size_t>( ptr - out.data( ) );
+		  },
+		  values );
+		daw_ensure( r0.get( ) == bytes and r1.get( ) == bytes );
+	}
+
+	void benchmarks( ) {
+		auto rng = std::mt19937_64( 1234 );
+		constexpr std::size_t count = 1'000'000;
+		auto ints = std::vector<std::int64_t>( );
+		auto small_ints = std::vector<std::int32_t>( );
+		auto doubles = std::vector<double>( );
+		auto short_doubles = std::vector<double>( );
+		auto floats = std::vector<float>( );
+		while( ints.size( ) < count ) {
+			auto const bits = rng( );
+			ints.push_back( static_cast<std::int64_t>( bits ) >> ( bits % 64U ) );
+			small_ints.push_back( static_cast<std::int32_t>( bits % 100'000U ) );
+			auto const d = from_bits<double>( bits );
+			doubles.push_back( std::isfinite( d ) ? d : 0.0 );
+			short_doubles.push_back( static_cast<double>( bits % 10'000'000U ) /
+			                         100.0 );
+			auto const f = from_bits<float>( static_cast<std::uint32_t>( bits ) );
+			floats.push_back( std::isfinite( f ) ? f : 0.0f );
+		}
+		bench( "int64 of random length", ints );
+		bench( "int32 under 100000", small_ints );
+		bench( "random double", doubles );
+		bench( "double with 2 decimals", short_doubles );
+		bench( "random float", floats );
+	}
+} // namespace
+
+int main( ) {
+	test_integers( );
+	test_floats( );
+	test_buffer_too_small( );
+	test_output( );
+	benchmarks( );
+	std::cout << "Done\n";
+}
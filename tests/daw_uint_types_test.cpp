@@ -0,0 +1,241 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include "daw/daw_uint_types.h"
+
+#include "daw/daw_benchmark.h"
+#include "daw/daw_do_not_optimize.h"
+#include "daw/daw_ensure.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+static_assert( std::is_same_v<daw::UInt<128>, daw::UInt128> );
+static_assert( std::is_same_v<daw::UInt<256>, daw::UInt256> );
+static_assert( ( daw::UInt128( 0U, ~std::uint64_t{ } ) + daw::UInt128( 1U ) ) ==
+               daw::UInt128( 1U, 0U ) );
+static_assert( ( daw::UInt128( 1U, 0U ) - daw::UInt128( 1U ) ) ==
+               daw::UInt128( 0U, ~std::uint64_t{ } ) );
+static_assert( daw::UInt128( -1 ) == ~daw::UInt128( ) );
+static_assert( daw::mul_hi( ~std::uint64_t{ }, ~std::uint64_t{ } ) ==
+               ~std::uint64_t{ } - 1U );
+static_assert( ( daw::UInt128( 1U ) << 127U ) >> 127U == daw::UInt128( 1U ) );
+static_assert( ( daw::UInt256( 1U ) << 200U ) /
+                 ( daw::UInt256( 1U ) << 100U ) ==
+               ( daw::UInt256( 1U ) << 100U ) );
+static_assert( daw::uint128_divider( daw::UInt128( 10U ) )
+                 .divide( daw::UInt128( 12345U ) ) == daw::UInt128( 1234U ) );
+static_assert( ( std::numeric_limits<daw::UInt128>::max )( ) ==
+               ~daw::UInt128( ) );
+static_assert( std::numeric_limits<daw::UInt128>::digits10 == 38 );
+static_assert( std::numeric_limits<daw::UInt256>::digits10 == 77 );
+
+namespace {
+	/// A textbook 32 bit limb implementation to check against and to measure
+	/// the wide types against
+	struct naive_uint128 {
+		std::uint32_t limbs[4] = { };
+
+		naive_uint128( ) = default;
+
+		explicit naive_uint128( daw::UInt128 const &v )
+		  : limbs{ static_cast<std::uint32_t>( v.lo ),
+		           static_cast<std::uint32_t>( v.lo >> 32U ),
+		           static_cast<std::uint32_t>( v.hi ),
+		           static_cast<std::uint32_t>( v.hi >> 32U ) } {}
+
+		[[nodiscard]] daw::UInt128 to_uint128( ) const {
+			return daw::UInt128( ( std::uint64_t{ limbs[3] } << 32U ) | limbs[2],
+			                     ( std::uint64_t{ limbs[1] } << 32U ) | limbs[0] );
+		}
+
+		friend naive_uint128 operator+( naive_uint128 const &lhs,
+		                                naive_uint128 const &rhs ) {
+			auto result = naive_uint128( );
+			std::uint64_t carry = 0;
+			for( std::size_t n = 0; n < 4; ++n ) {
+				auto const sum = std::uint64_t{ lhs.limbs[n] } + rhs.limbs[n] + carry;
+				result.limbs[n] = static_cast<std::uint32_t>( sum );
+				carry = sum >> 32U;
+			}
+			return result;
+		}
+
+		friend naive_uint128 operator*( naive_uint128 const &lhs,
+		                                naive_uint128 const &rhs ) {
+			auto result = naive_uint128( );
+			for( std::size_t i = 0; i < 4; ++i ) {
+				std::uint64_t carry = 0;
+				for( std::size_t j = 0; i + j < 4; ++j ) {
+					auto const p = std::uint64_t{ lhs.limbs[i] } * rhs.limbs[j] +
+					               result.limbs[i + j] + carry;
+					result.limbs[i + j] = static_cast<std::uint32_t>( p );
+					carry = p >> 32U;
+				}
+			}
+			return result;
+		}
+	};
+
+	daw::UInt128 random_uint128( std::mt19937_64 &rng ) {
+		// Vary the magnitude so that both limbs paths are exercised
+		auto const shift = static_cast<unsigned>( rng( ) % 128U );
+		return daw::UInt128( rng( ), rng( ) ) >> shift;
+	}
+
+	void test_uint128_arithmetic( std::mt19937_64 &rng ) {
+		for( std::size_t n = 0; n < 10'000; ++n ) {
+			auto const a = random_uint128( rng );
+			auto const b = random_uint128( rng );
+			daw_ensure( ( naive_uint128( a ) + naive_uint128( b ) ).to_uint128( ) ==
+			            a + b );
+			daw_ensure( ( naive_uint128( a ) * naive_uint128( b ) ).to_uint128( ) ==
+			            a * b );
+			daw_ensure( ( a + b ) - b == a );
+			if( b ) {
+				auto const qr = divmod( a, b );
+				daw_ensure( qr.rem < b );
+				daw_ensure( qr.quot * b + qr.rem == a );
+				daw_ensure( a / b == qr.quot and a % b == qr.rem );
+			}
+			auto const wide = daw::mul_wide( a, b );
+			daw_ensure( wide.low( ) == a * b );
+			daw_ensure( daw::mul_hi( a, b ) == wide.high( ) );
+			if( a and b ) {
+				daw_ensure( wide / daw::UInt256( b ) == daw::UInt256( a ) );
+			}
+		}
+	}
+
+	void test_uint128_divider( std::mt19937_64 &rng ) {
+		auto divisors = std::vector<daw::UInt128>{
+		  daw::UInt128( 1U ),          daw::UInt128( 3U ),
+		  daw::UInt128( 7U ),          daw::UInt128( 10U ),
+		  daw::UInt128( 1U ) << 64U,   daw::UInt128( 1'000'000'007U ),
+		  ~daw::UInt128( ),
+		  ( daw::UInt128( 1U ) << 127U ) + daw::UInt128( 1U ) };
+		for( std::size_t n = 0; n < 100; ++n ) {
+			auto d = random_uint128( rng );
+			if( d ) {
+				divisors.push_back( d );
+			}
+		}
+		for( auto const &d : divisors ) {
+			auto const divider = daw::uint128_divider( d );
+			daw_ensure( ~daw::UInt128( ) / divider == ~daw::UInt128( ) / d );
+			daw_ensure( d / divider == daw::UInt128( 1U ) );
+			daw_ensure( ( d - daw::UInt128( 1U ) ) / divider == daw::UInt128( ) );
+			for( std::size_t n = 0; n < 200; ++n ) {
+				auto const x = random_uint128( rng );
+				daw_ensure( x / divider == x / d );
+			}
+		}
+	}
+
+	void test_uint256_arithmetic( std::mt19937_64 &rng ) {
+		for( std::size_t n = 0; n < 2'000; ++n ) {
+			auto const a =
+			  daw::UInt256( random_uint128( rng ), random_uint128( rng ) );
+			auto const b = daw::UInt256( random_uint128( rng ) );
+			daw_ensure( ( a + b ) - b == a );
+			daw_ensure( ( ( a ^ b ) ^ b ) == a );
+			daw_ensure( ( a << 17U ) >> 17U == ( a & ( ~daw::UInt256( ) >> 17U ) ) );
+			if( b ) {
+				auto const qr = divmod( a, b );
+				daw_ensure( qr.rem < b );
+				daw_ensure( qr.quot * b + qr.rem == a );
+			}
+		}
+	}
+
+	void bench_uint128( std::mt19937_64 &rng ) {
+		constexpr std::size_t count = 1U << 16U;
+		auto values = std::vector<daw::UInt128>( );
+		auto naive_values = std::vector<naive_uint128>( );
+		values.reserve( count );
+		naive_values.reserve( count );
+		for( std::size_t n = 0; n < count; ++n ) {
+			values.push_back( daw::UInt128( rng( ), rng( ) ) );
+			naive_values.push_back( naive_uint128( values.back( ) ) );
+		}
+
+		auto const naive_result = daw::bench_n_test<20>(
+		  "naive 32 bit limbs: multiply accumulate 64k",
+		  []( auto const &v ) {
+			  auto result = naive_uint128( );
+			  for( std::size_t n = 1; n < v.size( ); ++n ) {
+				  result = result + v[n - 1] * v[n];
+			  }
+			  daw::do_not_optimize( result );
+			  return result.to_uint128( );
+		  },
+		  naive_values );
+		auto const result = daw::bench_n_test<20>(
+		  "UInt128: multiply accumulate 64k",
+		  []( auto const &v ) {
+			  auto r = daw::UInt128( );
+			  for( std::size_t n = 1; n < v.size( ); ++n ) {
+				  r += v[n - 1] * v[n];
+			  }
+			  daw::do_not_optimize( r );
+			  return r;
+		  },
+		  values );
+		daw_ensure( naive_result.get( ) == result.get( ) );
+
+		daw::bench_n_test<20>(
+		  "UInt128: mul_hi 64k",
+		  []( auto const &v ) {
+			  auto r = daw::UInt128( );
+			  for( std::size_t n = 1; n < v.size( ); ++n ) {
+				  r ^= daw::mul_hi( v[n - 1], v[n] );
+			  }
+			  daw::do_not_optimize( r );
+			  return r;
+		  },
+		  values );
+
+		auto const divisor = daw::UInt128( 1'000'000'007U );
+		auto const divider = daw::uint128_divider( divisor );
+		auto const div_result = daw::bench_n_test<20>(
+		  "UInt128: divide 64k by a runtime divisor",
+		  [&]( auto const &v ) {
+			  auto r = daw::UInt128( );
+			  for( auto const &x : v ) {
+				  r ^= x / divisor;
+			  }
+			  daw::do_not_optimize( r );
+			  return r;
+		  },
+		  values );
+		auto const divider_result = daw::bench_n_test<20>(
+		  "UInt128: divide 64k by uint128_divider",
+		  [&]( auto const &v ) {
+			  auto r = daw::UInt128( );
+			  for( auto const &x : v ) {
+				  r ^= x / divider;
+			  }
+			  daw::do_not_optimize( r );
+			  return r;
+		  },
+		  values );
+		daw_ensure( div_result.get( ) == divider_result.get( ) );
+	}
+} // namespace
+
+int main( ) {
+	auto rng = std::mt19937_64( 0x1234'5678U );
+	test_uint128_arithmetic( rng );
+	test_uint128_divider( rng );
+	test_uint256_arithmetic( rng );
+	bench_uint128( rng );
+	std::cout << "Done\n";
+}
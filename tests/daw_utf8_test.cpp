@@ -0,0 +1,264 @@
+// Copyright (c) Darrell Wright
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/beached/header_libraries
+//
+
+#include "daw/daw_utf8.h"
+
+#include "daw/daw_benchmark.h"
+#include "daw/daw_do_not_optimize.h"
+#include "daw/daw_ensure.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+	/// An independent, bit pattern based decoder.  Returns the position of the
+	/// first invalid sequence or npos
+	std::size_t reference_find_invalid( std::string const &str ) {
+		std::size_t pos = 0;
+		while( pos < str.size( ) ) {
+			auto const b0 = static_cast<unsigned char>( str[pos] );
+			std::size_t length = 0;
+			std::uint32_t cp = 0;
+			std::uint32_t min_cp = 0;
+			if( ( b0 & 0x80U ) == 0 ) {
+				length = 1;
+				cp = b0;
+			} else if( ( b0 & 0xE0U ) == 0xC0U ) {
+				length = 2;
+				cp = b0 & 0x1FU;
+				min_cp = 0x80U;
+			} else if( ( b0 & 0xF0U ) == 0xE0U ) {
+				length = 3;
+				cp = b0 & 0x0FU;
+				min_cp = 0x800U;
+			} else if( ( b0 & 0xF8U ) == 0xF0U ) {
+				length = 4;
+				cp = b0 & 0x07U;
+				min_cp = 0x1'0000U;
+			} else {
+				return pos;
+			}
+			if( pos + length > str.size( ) ) {
+				return pos;
+			}
+			for( std::size_t n = 1; n < length; ++n ) {
+				auto const b = static_cast<unsigned char>( str[pos + n] );
+				if( ( b & 0xC0U ) != 0x80U ) {
+					return pos;
+				}
+				cp = ( cp << 6U ) | ( b & 0x3FU );
+			}
+			if( cp < min_cp or cp > 0x10'FFFFU or
+			    ( cp >= 0xD800U and cp <= 0xDFFFU ) ) {
+				return pos;
+			}
+			pos += length;
+		}
+		return daw::utf8::npos;
+	}
+
+	void check( std::string const &str ) {
+		auto const expected = reference_find_invalid( str );
+		daw_ensure( daw::utf8::is_valid( str ) == ( expected == daw::utf8::npos ) );
+		daw_ensure( daw::utf8::find_invalid( str ) == expected );
+	}
+
+	/// Every sequence of up to 3 bytes with a non ASCII lead, at an offset
+	/// that straddles a vector boundary
+	void test_exhaustive( ) {
+		auto const pad = std::string( 30, 'a' );
+		for( unsigned b0 = 0; b0 < 256; ++b0 ) {
+			for( unsigned b1 = 0; b1 < 256; ++b1 ) {
+				auto const two = std::string{ static_cast<char>( b0 ),
+				                              static_cast<char>( b1 ) };
+				check( two );
+				check( pad + two );
+				if( b0 < 0xE0U ) {
+					continue;
+				}
+				for( unsigned b2 = 0; b2 < 256; ++b2 ) {
+					check( pad + two + static_cast<char>( b2 ) );
+				}
+			}
+		}
+		// Four byte leads with interesting continuations
+		constexpr unsigned char tails[] = { 0x00, 0x41, 0x80, 0x8F, 0x90,
+		                                    0x9F, 0xA0, 0xBF, 0xC0, 0xFF };
+		for( unsigned b0 = 0xF0; b0 < 256; ++b0 ) {
+			for( unsigned b1 = 0x80; b1 < 0xC0; ++b1 ) {
+				for( auto b2 : tails ) {
+					for( auto b3 : tails ) {
+						auto const four = std::string{
+						  static_cast<char>( b0 ), static_cast<char>( b1 ),
+						  static_cast<char>( b2 ), static_cast<char>( b3 ) };
+						check( four );
+						check( pad + four );
+						check( pad + four + pad );
+					}
+				}
+			}
+		}
+	}
+
+	std::string random_utf8( std::mt19937_64 &rng, std::size_t code_points ) {
+		auto result = std::string( );
+		char buff[4];
+		for( std::size_t n = 0; n < code_points; ++n ) {
+			char32_t cp = 0;
+			switch( rng( ) % 5U ) {
+			case 0:
+			case 1:
+				cp = static_cast<char32_t>( 0x20U + rng( ) % 0x5FU );
+				break;
+			case 2:
+				cp = static_cast<char32_t>( 0x80U + rng( ) % 0x780U );
+				break;
+			case 3:
+				do {
+					cp = static_cast<char32_t>( 0x800U + rng( ) % 0xF800U );
+				} while( cp >= 0xD800U and cp <= 0xDFFFU );
+				break;
+			default:
+				cp = static_cast<char32_t>( 0x1'0000U + rng( ) % 0x10'0000U );
+				break;
+			}
+			auto const u32 = std::u32string( 1, cp );
+			auto const r = daw::utf8::from_utf32( u32, buff );
+			result.append( buff, r.written );
+		}
+		return result;
+	}
+
+	void test_random( ) {
+		auto rng = std::mt19937_64( 1234 );
+		for( int n = 0; n < 20'000; ++n ) {
+			auto str = random_utf8( rng, rng( ) % 100U );
+			check( str );
+			if( not str.empty( ) ) {
+				// Damage a byte, or cut the end off
+				if( rng( ) % 2U == 0 ) {
+					str[rng( ) % str.size( )] = static_cast<char>( rng( ) );
+				} else {
+					str.pop_back( );
+				}
+				check( str );
+			}
+		}
+	}
+
+	void test_transcode( ) {
+		auto rng = std::mt19937_64( 42 );
+		for( int n = 0; n < 2'000; ++n ) {
+			auto const str = random_utf8( rng, rng( ) % 200U );
+			auto const cps = daw::utf8::count_code_points( str );
+
+			auto u32 = std::u32string( str.size( ), U'\0' );
+			auto const r32 = daw::utf8::to_utf32( str, u32.data( ) );
+			daw_ensure( r32.is_valid and r32.read == str.size( ) );
+			daw_ensure( r32.written == cps );
+			u32.resize( r32.written );
+
+			auto u16 = std::u16string( daw::utf8::utf16_length( str ), u'\0' );
+			auto const r16 = daw::utf8::to_utf16( str, u16.data( ) );
+			daw_ensure( r16.is_valid and r16.written == u16.size( ) );
+
+			auto back16 = std::string( daw::utf8::length_from_utf16( u16 ), '\0' );
+			auto const b16 = daw::utf8::from_utf16( u16, back16.data( ) );
+			daw_ensure( b16.is_valid and b16.written == back16.size( ) );
+			daw_ensure( back16 == str );
+
+			auto back32 = std::string( daw::utf8::length_from_utf32( u32 ), '\0' );
+			auto const b32 = daw::utf8::from_utf32( u32, back32.data( ) );
+			daw_ensure( b32.is_valid and back32 == str );
+		}
+
+		// Errors stop at the start of the bad sequence
+		auto out32 = std::u32string( 16, U'\0' );
+		auto const bad =
+		  daw::utf8::to_utf32( "ab\xC3\xA9\xE2\x82z", out32.data( ) );
+		daw_ensure( not bad.is_valid and bad.read == 4 and bad.written == 3 );
+		daw_ensure( out32[2] == U'é' );
+
+		auto out8 = std::string( 16, '\0' );
+		auto const lone = std::u16string{ u'x', static_cast<char16_t>( 0xD800 ),
+		                                  u'y' };
+		auto const bad16 = daw::utf8::from_utf16( lone, out8.data( ) );
+		daw_ensure( not bad16.is_valid and bad16.read == 1 );
+		auto const big = std::u32string{ U'x', static_cast<char32_t>( 0x11'0000 ) };
+		daw_ensure( not daw::utf8::from_utf32( big, out8.data( ) ).is_valid );
+	}
+
+	void bench( std::string const &title, std::string const &str ) {
+		std::cout << title << ", " << str.size( ) << " bytes\n";
+		auto const scalar = daw::bench_n_test_mbs<10>(
+		  "scalar decoding loop",
+		  str.size( ),
+		  []( std::string const &s ) {
+			  auto const result = reference_find_invalid( s ) == daw::utf8::npos;
+			  daw::do_not_optimize( result );
+			  return result;
+		  },
+		  str );
+		auto const simd = daw::bench_n_test_mbs<10>(
+		  "daw::utf8::is_valid",
+		  str.size( ),
+		  []( std::string const &s ) {
+			  auto const result = daw::utf8::is_valid( s );
+			  daw::do_not_optimize( result );
+			  return result;
+		  },
+		  str );
+		daw_ensure( scalar.get( ) and simd.get( ) );
+		auto u16 = std::u16string( str.size( ), u'\0' );
+		(void)daw::bench_n_test_mbs<10>(
+		  "daw::utf8::to_utf16",
+		  str.size( ),
+		  [&]( std::string const &s ) {
+			  auto const result = daw::utf8::to_utf16( s, u16.data( ) ).written;
+			  daw::do_not_optimize( u16 );
+			  return result;
+		  },
+		  str );
+		(void)daw::bench_n_test_mbs<10>(
+		  "daw::utf8::count_code_points",
+		  str.size( ),
+		  []( std::string const &s ) {
+			  auto const result = daw::utf8::count_code_points( s );
+			  daw::do_not_optimize( result );
+			  return result;
+		  },
+		  str );
+	}
+
+	void benchmarks( ) {
+		constexpr std::size_t size = 16U * 1024U * 1024U;
+		auto ascii = std::string( );
+		auto rng = std::mt19937_64( 1 );
+		while( ascii.size( ) < size ) {
+			ascii += static_cast<char>( 0x20U + rng( ) % 0x5FU );
+		}
+		bench( "ASCII", ascii );
+		auto mixed = std::string( );
+		while( mixed.size( ) < size ) {
+			mixed += random_utf8( rng, 1000 );
+		}
+		bench( "Mixed ASCII, 2, 3 and 4 byte sequences", mixed );
+	}
+} // namespace
+
+int main( ) {
+	test_exhaustive( );
+	test_random( );
+	test_transcode( );
+	benchmarks( );
+	std::cout << "Done\n";
+}
@@ -81,6 +81,16 @@ void daw_hex_test_005( ) {
 	daw::expecting( a_str, "789ABCDE" );
 }
 
+void daw_hex_test_006( ) {
+	struct two_bytes {
+		unsigned char a;
+		unsigned char b;
+	};
+	std::string a_str;
+	(void)daw::hex( two_bytes{ 0x12, 0xAB }, std::back_inserter( a_str ) );
+	daw::expecting( a_str, "12AB" );
+}
+
 namespace daw_pack_index_of_001 {
 	static_assert(
 	  daw::pack_index_of_v<int, std::string, bool, float, int, long> == 3 );
@@ -284,6 +294,7 @@ int main( ) {
 	daw_hex_test_002( );
 	daw_hex_test_003( );
 	daw_hex_test_005( );
+	daw_hex_test_006( );
 	daw_pack_type_at_001( );
 	construct_a_001( );
 	construct_a_002( );
@@ -9,11 +9,17 @@
 #include "daw/daw_visit.h"
 
 #include "daw/daw_benchmark.h"
+#include "daw/daw_do_not_optimize.h"
+#include "daw/daw_ensure.h"
 
 #include <cassert>
+#include <cstddef>
 #include <exception>
 #include <optional>
+#include <random>
+#include <utility>
 #include <variant>
+#include <vector>
 
 constexpr bool visit_nt_001( ) {
 	std::variant<int, double> a = 5.5;
@@ -242,6 +248,222 @@ int foofoo( std::variant<T0,
 	  } );
 }
 
+constexpr bool visit_nt_multi_001( ) {
+	std::variant<int, double> a = 5.5;
+	std::variant<char, int, long> b = 3L;
+	auto result = ::daw::visit_nt(
+	  []( auto x, auto y ) {
+		  return static_cast<double>( x ) * static_cast<double>( y );
+	  },
+	  a,
+	  b );
+	daw::expecting( result == 16.5 );
+	return true;
+}
+static_assert( visit_nt_multi_001( ) );
+
+constexpr bool visit_nt_multi_002( ) {
+	std::variant<int, double> a = 2;
+	std::variant<char, int, long> b = 'a';
+	std::variant<bool, unsigned> c = 7U;
+	// Each combination gets a distinct value
+	auto const id = []( auto x, auto y, auto z ) {
+		int r = std::is_same_v<decltype( x ), double> ? 1 : 0;
+		r = r * 3 + ( std::is_same_v<decltype( y ), int>    ? 1
+		              : std::is_same_v<decltype( y ), long> ? 2
+		                                                    : 0 );
+		return r * 2 + ( std::is_same_v<decltype( z ), unsigned> ? 1 : 0 );
+	};
+	daw::expecting( ::daw::visit_nt<long>( id, a, b, c ) == 1 );
+	std::variant<int, double> d = 1.0;
+	std::variant<char, int, long> e = 5L;
+	std::variant<bool, unsigned> f = false;
+	daw::expecting( ::daw::visit_nt( id, d, e, f ) == 10 );
+	return true;
+}
+static_assert( visit_nt_multi_002( ) );
+
+struct msg_add {
+	int value;
+};
+struct msg_mul {
+	int value;
+};
+struct msg_neg {};
+struct msg_reset {};
+using message = std::variant<msg_add, msg_mul, msg_neg, msg_reset>;
+
+std::vector<message> make_messages( std::size_t count ) {
+	auto rng = std::mt19937( 42 );
+	auto result = std::vector<message>( );
+	result.reserve( count );
+	for( std::size_t n = 0; n < count; ++n ) {
+		auto const v = static_cast<int>( rng( ) % 100U );
+		switch( rng( ) % 4U ) {
+		case 0:
+			result.emplace_back( msg_add{ v } );
+			break;
+		case 1:
+			result.emplace_back( msg_mul{ v } );
+			break;
+		case 2:
+			result.emplace_back( msg_neg{ } );
+			break;
+		default:
+			result.emplace_back( msg_reset{ } );
+			break;
+		}
+	}
+	return result;
+}
+
+/// Order independent totals per message type
+struct message_totals {
+	long long add = 0;
+	long long mul = 0;
+	long long neg = 0;
+	long long reset = 0;
+
+	void operator( )( msg_add const &m ) {
+		add += m.value;
+	}
+	void operator( )( msg_mul const &m ) {
+		mul += m.value * 3;
+	}
+	void operator( )( msg_neg const & ) {
+		++neg;
+	}
+	void operator( )( msg_reset const & ) {
+		++reset;
+	}
+
+	bool operator==( message_totals const &rhs ) const {
+		return add == rhs.add and mul == rhs.mul and neg == rhs.neg and
+		       reset == rhs.reset;
+	}
+};
+
+void visit_batch_001( ) {
+	auto const messages = make_messages( 1000 );
+	auto expected = message_totals{ };
+	for( auto const &m : messages ) {
+		daw::visit_nt( m, [&]( auto const &v ) {
+			expected( v );
+		} );
+	}
+	auto totals = message_totals{ };
+	daw::visit_batch( messages, [&]( auto const &v ) {
+		totals( v );
+	} );
+	daw_ensure( totals == expected );
+
+	// Order within an alternative is kept
+	auto adds = std::vector<int>( );
+	daw::visit_batch(
+	  messages,
+	  [&]( msg_add const &m ) {
+		  adds.push_back( m.value );
+	  },
+	  []( auto const & ) {} );
+	auto expected_adds = std::vector<int>( );
+	for( auto const &m : messages ) {
+		if( auto const *p = std::get_if<msg_add>( &m ) ) {
+			expected_adds.push_back( p->value );
+		}
+	}
+	daw_ensure( adds == expected_adds );
+
+	// Mutable access
+	auto mutable_messages = messages;
+	daw::visit_batch(
+	  mutable_messages,
+	  []( msg_add &m ) {
+		  m.value = 0;
+	  },
+	  []( auto & ) {} );
+	for( auto const &m : mutable_messages ) {
+		daw_ensure( not std::holds_alternative<msg_add>( m ) or
+		            std::get<msg_add>( m ).value == 0 );
+	}
+}
+
+void visit_batch_bench( ) {
+	auto const messages = make_messages( 1'000'000 );
+	auto const r0 = daw::bench_n_test<20>(
+	  "std::visit: 1M random messages",
+	  []( auto const &msgs ) {
+		  auto totals = message_totals{ };
+		  for( auto const &m : msgs ) {
+			  std::visit( totals, m );
+		  }
+		  daw::do_not_optimize( std::as_const( totals ) );
+		  return totals;
+	  },
+	  messages );
+	auto const r1 = daw::bench_n_test<20>(
+	  "daw::visit_nt: 1M random messages",
+	  []( auto const &msgs ) {
+		  auto totals = message_totals{ };
+		  for( auto const &m : msgs ) {
+			  daw::visit_nt( m, [&]( auto const &v ) {
+				  totals( v );
+			  } );
+		  }
+		  daw::do_not_optimize( std::as_const( totals ) );
+		  return totals;
+	  },
+	  messages );
+	auto const r2 = daw::bench_n_test<20>(
+	  "daw::visit_batch: 1M random messages",
+	  []( auto const &msgs ) {
+		  auto totals = message_totals{ };
+		  daw::visit_batch( msgs, [&]( auto const &v ) {
+			  totals( v );
+		  } );
+		  daw::do_not_optimize( std::as_const( totals ) );
+		  return totals;
+	  },
+	  messages );
+	daw_ensure( r0.get( ) == r1.get( ) );
+	daw_ensure( r0.get( ) == r2.get( ) );
+
+	auto const others = make_messages( 1'000'000 );
+	auto const r3 = daw::bench_n_test<20>(
+	  "nested daw::visit_nt: 1M message pairs",
+	  []( auto const &lhs, auto const &rhs ) {
+		  std::size_t count = 0;
+		  for( std::size_t n = 0; n < lhs.size( ); ++n ) {
+			  daw::visit_nt( lhs[n], [&]( auto const &l ) {
+				  daw::visit_nt( rhs[n], [&]( auto const &r ) {
+					  count += sizeof( l ) + sizeof( r );
+				  } );
+			  } );
+		  }
+		  daw::do_not_optimize( count );
+		  return count;
+	  },
+	  messages,
+	  others );
+	auto const r4 = daw::bench_n_test<20>(
+	  "multi daw::visit_nt: 1M message pairs",
+	  []( auto const &lhs, auto const &rhs ) {
+		  std::size_t count = 0;
+		  for( std::size_t n = 0; n < lhs.size( ); ++n ) {
+			  daw::visit_nt(
+			    [&]( auto const &l, auto const &r ) {
+				    count += sizeof( l ) + sizeof( r );
+			    },
+			    lhs[n],
+			    rhs[n] );
+		  }
+		  daw::do_not_optimize( count );
+		  return count;
+	  },
+	  messages,
+	  others );
+	daw_ensure( r3.get( ) == r4.get( ) );
+}
+
 int main( ) {
 	visit_nt_004( );
 	visit_nt_005( );
@@ -262,4 +484,6 @@ int main( ) {
 	assert( foofoo( foobar( 14 ) ) == 14 );
 	assert( foofoo( foobar( 15 ) ) == 15 );
 	assert( foofoo( foobar( 16 ) ) == 16 );
+	visit_batch_001( );
+	visit_batch_bench( );
 }